@@ -165,6 +165,14 @@ void CellmlAdapterBase<nStates_, nAlgebraics_,
   // restore the raw pointer of data_.parameters()
   data_.restoreParameterValues();
 
+  // simplify the parsed source code, before the source file is generated
+  bool optimizeSourceCode =
+      this->specificSettings_.getOptionBool("optimizeSourceCode", true);
+  bool eliminateUnusedAlgebraics =
+      this->specificSettings_.getOptionBool("eliminateUnusedAlgebraics", false);
+  cellmlSourceCodeGenerator_.optimizeSourceCode(
+      optimizeSourceCode, eliminateUnusedAlgebraics, algebraicsForTransfer);
+
   initializeStatesToEquilibrium_ = this->specificSettings_.getOptionBool(
       "initializeStatesToEquilibrium", false);
   if (initializeStatesToEquilibrium_) {
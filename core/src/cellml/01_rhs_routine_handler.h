@@ -55,9 +55,12 @@ protected:
   bool loadRhsLibrary(std::string libraryFilename);
 
   //! create the source filename using the CellmlSourceCodeGenerator, then
-  //! compile to library
+  //! compile to library, on the first rank with the same number of instances
+  //! and the same instruction set flags, instructionSetRanks contains the
+  //! CpuUtility::instructionSetHash of every rank
   void createLibraryOnOneRank(std::string libraryFilename,
-                              const std::vector<int> &nInstancesRanks);
+                              const std::vector<int> &nInstancesRanks,
+                              const std::vector<int> &instructionSetRanks);
 
   std::string
       sourceToCompileFilename_;  //< filename of the processed source file that
@@ -4,11 +4,13 @@
 
 #include <list>
 #include <sstream>
+#include <cstdint>
 #include <sys/stat.h> // stat() to check if file exists
 
 #include "utility/python_utility.h"
 #include "utility/petsc_utility.h"
 #include "utility/string_utility.h"
+#include "utility/cpu_utility.h"
 #include "mesh/mesh_manager/mesh_manager.h"
 
 #include <unistd.h> //dlopen
@@ -109,7 +111,14 @@ void RhsRoutineHandler<nStates, nAlgebraics_,
     for (int i = 0; i < parametersForTransfer.size(); i++)
       baseFilename << parametersForTransfer[i];
 
-    baseFilename << "_" << optimizationType_ << "_" << this->nInstances_;
+    // the library is compiled for the instruction sets of the CPU, ranks on
+    // nodes with different CPUs use different libraries
+    std::string instructionSetFlags = CpuUtility::detectedInstructionSetFlags();
+    int instructionSetHash =
+        CpuUtility::instructionSetHash(instructionSetFlags);
+    baseFilename << "_" << optimizationType_ << "_" << this->nInstances_ << "_"
+                 << CpuUtility::instructionSetName(instructionSetFlags) << "_"
+                 << std::hex << (uint32_t)instructionSetHash << std::dec;
 
     std::stringstream s;
     s << "lib/" << baseFilename.str() << ".so";
@@ -152,13 +161,25 @@ void RhsRoutineHandler<nStates, nAlgebraics_,
                       this->functionSpace_->meshPartition()->mpiCommunicator()),
         "MPI_Allgather");
 
+    // gather the instruction sets of all ranks, ranks with the same flags can
+    // use the same library
+    std::vector<int> instructionSetRanks(nRanksCommunicator);
+    instructionSetRanks[ownRankNoCommunicator] = instructionSetHash;
+
+    MPIUtility::handleReturnValue(
+        MPI_Allgather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
+                      instructionSetRanks.data(), 1, MPI_INT,
+                      this->functionSpace_->meshPartition()->mpiCommunicator()),
+        "MPI_Allgather");
+
     // check if the library already exists by a previous compilation
     struct stat buffer;
     if (stat(libraryFilename.c_str(), &buffer) == 0) {
       LOG(DEBUG) << "Library \"" << libraryFilename << "\" already exists.";
     } else {
       // compile the library on only one rank
-      createLibraryOnOneRank(libraryFilename, nInstancesRanks);
+      createLibraryOnOneRank(libraryFilename, nInstancesRanks,
+                             instructionSetRanks);
     }
 
     // barrier to wait until the one rank that compiles the library has finished
@@ -277,26 +298,27 @@ bool RhsRoutineHandler<nStates, nAlgebraics_, FunctionSpaceType>::
 template <int nStates, int nAlgebraics_, typename FunctionSpaceType>
 void RhsRoutineHandler<nStates, nAlgebraics_, FunctionSpaceType>::
     createLibraryOnOneRank(std::string libraryFilename,
-                           const std::vector<int> &nInstancesRanks) {
+                           const std::vector<int> &nInstancesRanks,
+                           const std::vector<int> &instructionSetRanks) {
   // get the global rank no, needed for the output filenames
   int rankNoWorldCommunicator = DihuContext::ownRankNoCommWorld();
 
+  int ownRankNoCommunicator =
+      this->functionSpace_->meshPartition()->ownRankNo();
+
   // determine if this rank should do compilation, such that each nInstances is
-  // compiled only once, by the rank with lowest number
-  int i = 0;
+  // compiled only once for every set of instruction set flags, by the rank
+  // with lowest number
   int rankWhichCompilesLibrary = 0;
-  for (std::vector<int>::const_iterator iter = nInstancesRanks.begin();
-       iter != nInstancesRanks.end(); iter++, i++) {
-    if (*iter == this->nInstances_) {
+  for (int i = 0; i < nInstancesRanks.size(); i++) {
+    if (nInstancesRanks[i] == this->nInstances_ &&
+        instructionSetRanks[i] == instructionSetRanks[ownRankNoCommunicator]) {
       rankWhichCompilesLibrary = i;
       break;
     }
   }
 
   LOG(DEBUG) << "Library will be compiled on rank " << rankWhichCompilesLibrary;
-
-  int ownRankNoCommunicator =
-      this->functionSpace_->meshPartition()->ownRankNo();
   if (rankWhichCompilesLibrary == ownRankNoCommunicator) {
     LOG(DEBUG) << "compile on this rank";
 
@@ -319,11 +341,23 @@ void RhsRoutineHandler<nStates, nAlgebraics_, FunctionSpaceType>::
 
     std::stringstream compileCommand;
 
+    // compile for the instruction sets of the CPU of this rank, only use
+    // "-march=native" if they cannot be detected, because it also enables
+    // instructions that the other CPUs of the same instruction set may not have
+    std::string instructionSetFlags = CpuUtility::detectedInstructionSetFlags();
+    if (instructionSetFlags.empty())
+      instructionSetFlags = "-march=native";
+
+    LOG(DEBUG) << "Compile library for instruction set \""
+               << CpuUtility::instructionSetName(instructionSetFlags)
+               << "\" on rank " << ownRankNoCommunicator << ".";
+
     // load compiler flags
     std::string compilerFlags = this->specificSettings_.getOptionString(
         "compilerFlags",
-        "-O3 -march=native -fPIC -finstrument-functions -ftree-vectorize "
-        "-fopt-info-vec-optimized=vectorizer_optimized.log -shared ");
+        std::string("-O3 ") + instructionSetFlags +
+            " -mtune=native -fPIC -finstrument-functions -ftree-vectorize "
+            "-fopt-info-vec-optimized=vectorizer_optimized.log -shared ");
 
 #ifdef NDEBUG
     if (compilerFlags.find("-O3") == std::string::npos) {
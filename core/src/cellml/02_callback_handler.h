@@ -8,6 +8,7 @@
 #include "function_space/function_space.h"
 #include "basis_function/lagrange.h"
 #include "cellml/01_rhs_routine_handler.h"
+#include "control/stimulation/stimulation_schedule.h"
 
 /** The is a class that contains cellml equations and can be used with a time
  * stepping scheme. The nStates template parameter specifies the number of state
@@ -96,6 +97,23 @@ protected:
   //! call Py_CLEAR on all python objects
   void clearPyObjects();
 
+  //! load the stimulation schedule if "stimulationScheduleFile" is set, this
+  //! needs setSpecificStatesRepeatAfterFirstCall_ for the default duration
+  void initializeStimulationSchedule();
+
+  //! set the stimulated state at the neuromuscular junction if the motor unit
+  //! is stimulated according to the schedule, this replaces the
+  //! setSpecificStates callback function
+  void applyStimulationSchedule(double currentTime, double *localStates);
+
+  //! call a setSpecificParameters or setSpecificStates callback function that
+  //! gets the values as a writable array of shape (nValuesPerInstance,
+  //! nInstances) which references the local values without copying
+  void callPythonSetFunctionWithArray(PyObject *pythonFunction, int nInstances,
+                                      int timeStepNo, double currentTime,
+                                      double *localValues,
+                                      int nValuesPerInstance);
+
   int setSpecificParametersCallInterval_; //< setSpecificParameters_ will be
                                           // called every callInterval_ time
                                           // steps
@@ -159,7 +177,26 @@ protected:
                                                    // handleResult callback
                                                    // function
 
-  PyObject *pyGlobalNaturalDofsList_; //< python list of global dof nos
+  PyObject *pyGlobalNaturalDofsList_; //< python array of the global natural
+                                      // dof nos of the local dofs, created once
+  bool callbackArgumentsAsArrays_;    //< if the callback functions get the
+                                      // values as arrays that reference the
+                                      // local memory instead of dicts and lists
+
+  std::string stimulationScheduleFilename_; //< filename of the stimulation
+                                            // schedule, empty if the
+                                            // setSpecificStates callback is
+                                            // used
+  Control::StimulationSchedule
+      stimulationSchedule_;    //< the stimulation events of all motor units
+  int stimulationMotorUnitNo_; //< the motor unit of this instance
+  std::size_t stimulationEventIndex_; //< index of the next event to check
+  dof_no_t stimulationDofNoLocal_; //< local dof no of the neuromuscular
+                                   // junction, -1 if it is on another rank
+  int stimulationStateNo_;         //< the state that is set when stimulated
+  double valueForStimulatedPoint_; //< the value of the stimulated state
+  bool currentlyStimulating_; //< if the schedule or the setSpecificStates
+                              // callback stimulated in the last call
 };
 
 #include "cellml/02_callback_handler.tpp"
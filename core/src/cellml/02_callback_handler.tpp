@@ -9,6 +9,7 @@
 #include "utility/petsc_utility.h"
 #include "utility/string_utility.h"
 #include "mesh/mesh_manager/mesh_manager.h"
+#include "control/diagnostic_tool/stimulation_logging.h"
 
 template <int nStates, int nAlgebraics_, typename FunctionSpaceType>
 CallbackHandler<nStates, nAlgebraics_, FunctionSpaceType>::CallbackHandler(
@@ -18,7 +19,10 @@ CallbackHandler<nStates, nAlgebraics_, FunctionSpaceType>::CallbackHandler(
       pythonSetSpecificStatesFunction_(NULL), pythonHandleResultFunction_(NULL),
       pySetFunctionAdditionalParameter_(NULL),
       pyHandleResultFunctionAdditionalParameter_(NULL),
-      pyGlobalNaturalDofsList_(NULL) {}
+      pyGlobalNaturalDofsList_(NULL), callbackArgumentsAsArrays_(false),
+      stimulationMotorUnitNo_(0), stimulationEventIndex_(0),
+      stimulationDofNoLocal_(-1), stimulationStateNo_(0),
+      valueForStimulatedPoint_(20.0), currentlyStimulating_(false) {}
 
 template <int nStates, int nAlgebraics_, typename FunctionSpaceType>
 CallbackHandler<nStates, nAlgebraics_, FunctionSpaceType>::CallbackHandler(
@@ -31,7 +35,10 @@ CallbackHandler<nStates, nAlgebraics_, FunctionSpaceType>::CallbackHandler(
       pythonSetSpecificStatesFunction_(NULL), pythonHandleResultFunction_(NULL),
       pySetFunctionAdditionalParameter_(NULL),
       pyHandleResultFunctionAdditionalParameter_(NULL),
-      pyGlobalNaturalDofsList_(NULL) {}
+      pyGlobalNaturalDofsList_(NULL), callbackArgumentsAsArrays_(false),
+      stimulationMotorUnitNo_(0), stimulationEventIndex_(0),
+      stimulationDofNoLocal_(-1), stimulationStateNo_(0),
+      valueForStimulatedPoint_(20.0), currentlyStimulating_(false) {}
 
 template <int nStates, int nAlgebraics_, typename FunctionSpaceType>
 CallbackHandler<nStates, nAlgebraics_, FunctionSpaceType>::~CallbackHandler() {
@@ -60,6 +67,10 @@ void CallbackHandler<nStates, nAlgebraics_,
                   "\"setSpecificParametersFunction\" instead.";
   }
 
+  // if the values are given to the callbacks as arrays without copying
+  callbackArgumentsAsArrays_ =
+      this->specificSettings_.getOptionBool("callbackArgumentsAsArrays", false);
+
   // parse the setSpecificParametersFunction callback function
   if (this->specificSettings_.hasKey("setSpecificParametersFunction")) {
     pythonSetSpecificParametersFunction_ =
@@ -123,6 +134,104 @@ void CallbackHandler<nStates, nAlgebraics_,
   }
 }
 
+template <int nStates, int nAlgebraics_, typename FunctionSpaceType>
+void CallbackHandler<nStates, nAlgebraics_,
+                     FunctionSpaceType>::initializeStimulationSchedule() {
+  stimulationScheduleFilename_ =
+      this->specificSettings_.getOptionString("stimulationScheduleFile", "");
+  if (stimulationScheduleFilename_.empty())
+    return;
+
+  if (pythonSetSpecificStatesFunction_) {
+    LOG(WARNING) << this->specificSettings_
+                 << "[\"stimulationScheduleFile\"] is set, the "
+                 << "\"setSpecificStatesFunction\" will not be called.";
+  }
+
+  stimulationMotorUnitNo_ = this->specificSettings_.getOptionInt(
+      "stimulationMotorUnitNo", 0, PythonUtility::NonNegative);
+  stimulationStateNo_ = this->specificSettings_.getOptionInt(
+      "stimulationStateNo", 0, PythonUtility::NonNegative);
+  valueForStimulatedPoint_ = this->specificSettings_.getOptionDouble(
+      "valueForStimulatedPoint", 20.0);
+
+  if (stimulationStateNo_ >= nStates) {
+    LOG(ERROR) << this->specificSettings_ << "[\"stimulationStateNo\"] is "
+               << stimulationStateNo_ << ", but there are only " << nStates
+               << " states. Now using state 0.";
+    stimulationStateNo_ = 0;
+  }
+
+  // the default duration of a stimulation is the same as for the callback
+  double defaultDuration = this->specificSettings_.getOptionDouble(
+      "stimulationScheduleDuration",
+      this->setSpecificStatesRepeatAfterFirstCall_, PythonUtility::NonNegative);
+  std::vector<double> jitter;
+  if (this->specificSettings_.hasKey("stimulationScheduleJitter"))
+    this->specificSettings_.getOptionVector("stimulationScheduleJitter",
+                                            jitter);
+
+  stimulationSchedule_.load(
+      stimulationScheduleFilename_,
+      this->functionSpace_->meshPartition()->mpiCommunicator(), defaultDuration,
+      jitter);
+  stimulationEventIndex_ = 0;
+
+  // find the local dof of the neuromuscular junction, by default at the center
+  global_no_t stimulationDofNoGlobalNatural =
+      this->specificSettings_.getOptionInt(
+          "stimulationDofNoGlobalNatural",
+          this->functionSpace_->meshPartition()->nDofsGlobal() / 2,
+          PythonUtility::NonNegative);
+
+  std::vector<global_no_t> dofNosGlobalNatural;
+  this->functionSpace_->meshPartition()->getDofNosGlobalNatural(
+      dofNosGlobalNatural);
+
+  stimulationDofNoLocal_ = -1;
+  for (dof_no_t dofNoLocal = 0;
+       dofNoLocal < (dof_no_t)dofNosGlobalNatural.size(); dofNoLocal++) {
+    if (dofNosGlobalNatural[dofNoLocal] == stimulationDofNoGlobalNatural) {
+      stimulationDofNoLocal_ = dofNoLocal;
+      break;
+    }
+  }
+
+  LOG(DEBUG) << "stimulation schedule with " << stimulationSchedule_.nEvents()
+             << " events, motor unit " << stimulationMotorUnitNo_
+             << ", neuromuscular junction at global dof "
+             << stimulationDofNoGlobalNatural << ", local dof "
+             << stimulationDofNoLocal_;
+}
+
+template <int nStates, int nAlgebraics_, typename FunctionSpaceType>
+void CallbackHandler<nStates, nAlgebraics_, FunctionSpaceType>::
+    applyStimulationSchedule(double currentTime, double *localStates) {
+  bool stimulate = stimulationSchedule_.isStimulated(
+      stimulationMotorUnitNo_, currentTime, stimulationEventIndex_);
+
+  if (!stimulate) {
+    currentlyStimulating_ = false;
+    return;
+  }
+
+  // if this is the first point in time of the current stimulation, log
+  // stimulation time
+  if (!currentlyStimulating_) {
+    currentlyStimulating_ = true;
+    Control::StimulationLogging::logStimulationBegin(
+        currentTime, stimulationMotorUnitNo_, fiberNoGlobal_);
+  }
+
+  // set the state at the neuromuscular junction, if it is on the own rank
+  if (stimulationDofNoLocal_ != -1) {
+    dof_no_t nDofsLocalWithoutGhosts =
+        this->functionSpace_->nDofsLocalWithoutGhosts();
+    localStates[stimulationStateNo_ * nDofsLocalWithoutGhosts +
+                stimulationDofNoLocal_] = valueForStimulatedPoint_;
+  }
+}
+
 template <int nStates, int nAlgebraics_, typename FunctionSpaceType>
 void CallbackHandler<nStates, nAlgebraics_, FunctionSpaceType>::
     callPythonSetSpecificParametersFunction(int nInstances, int timeStepNo,
@@ -132,9 +241,19 @@ void CallbackHandler<nStates, nAlgebraics_, FunctionSpaceType>::
   if (pythonSetSpecificParametersFunction_ == NULL)
     return;
 
+  // start critical section for python API calls
+  PythonUtility::GlobalInterpreterLock lock;
+
   VLOG(1) << "callPythonSetSpecificParametersFunction timeStepNo="
           << timeStepNo;
 
+  if (callbackArgumentsAsArrays_) {
+    callPythonSetFunctionWithArray(pythonSetSpecificParametersFunction_,
+                                   nInstances, timeStepNo, currentTime,
+                                   localParameters, nParameters);
+    return;
+  }
+
   // compose callback function
   PyObject *globalParametersDict = PyDict_New();
   PyObject *arglist = Py_BuildValue(
@@ -240,8 +359,18 @@ void CallbackHandler<nStates, nAlgebraics_, FunctionSpaceType>::
   if (pythonSetSpecificStatesFunction_ == NULL)
     return;
 
+  // start critical section for python API calls
+  PythonUtility::GlobalInterpreterLock lock;
+
   VLOG(1) << "callPythonSetSpecificStatesFunction timeStepNo=" << timeStepNo;
 
+  if (callbackArgumentsAsArrays_) {
+    callPythonSetFunctionWithArray(pythonSetSpecificStatesFunction_,
+                                   nInstances, timeStepNo, currentTime,
+                                   localStates, nStates);
+    return;
+  }
+
   // compose callback function
   PyObject *globalStatesDict = PyDict_New();
   PyObject *arglist = Py_BuildValue(
@@ -313,14 +442,28 @@ void CallbackHandler<nStates, nAlgebraics_, FunctionSpaceType>::
   if (pythonHandleResultFunction_ == NULL)
     return;
 
+  // start critical section for python API calls
+  PythonUtility::GlobalInterpreterLock lock;
+
   // compose callback function
   LOG(DEBUG) << "callPythonHandleResultFunction: nInstances: "
              << this->nInstances_ << ", nStates: " << nStates
              << ", nAlgebraics: " << this->nAlgebraics();
-  PyObject *statesList = PythonUtility::convertToPythonList(
-      nStates * this->nInstances_, localStates);
-  PyObject *algebraicsList = PythonUtility::convertToPythonList(
-      nAlgebraics_ * this->nInstances_, algebraics);
+  PyObject *statesList = NULL;
+  PyObject *algebraicsList = NULL;
+  if (callbackArgumentsAsArrays_) {
+    // read-only arrays of shape (nStates, nInstances) and (nAlgebraics,
+    // nInstances), the results must not be changed by the callback
+    statesList = PythonUtility::createArrayView(localStates, nStates,
+                                                this->nInstances_, false);
+    algebraicsList = PythonUtility::createArrayView(
+        algebraics, nAlgebraics_, this->nInstances_, false);
+  } else {
+    statesList = PythonUtility::convertToPythonList(
+        nStates * this->nInstances_, localStates);
+    algebraicsList = PythonUtility::convertToPythonList(
+        nAlgebraics_ * this->nInstances_, algebraics);
+  }
 
   std::map<std::string, std::vector<std::string>> nameInformation;
   nameInformation["stateNames"] = this->cellmlSourceCodeGenerator_.stateNames();
@@ -348,6 +491,48 @@ void CallbackHandler<nStates, nAlgebraics_, FunctionSpaceType>::
   Py_CLEAR(arglist);
 }
 
+template <int nStates, int nAlgebraics_, typename FunctionSpaceType>
+void CallbackHandler<nStates, nAlgebraics_, FunctionSpaceType>::
+    callPythonSetFunctionWithArray(PyObject *pythonFunction, int nInstances,
+                                   int timeStepNo, double currentTime,
+                                   double *localValues,
+                                   int nValuesPerInstance) {
+  // create the array of global natural dof nos only once, it tells the callback
+  // to which global dofs the columns of the values array belong
+  if (pyGlobalNaturalDofsList_ == NULL) {
+    std::vector<global_no_t> dofNosGlobalNatural;
+    this->functionSpace_->meshPartition()->getDofNosGlobalNatural(
+        dofNosGlobalNatural);
+    pyGlobalNaturalDofsList_ =
+        PythonUtility::convertToPythonArray(dofNosGlobalNatural);
+  }
+
+  // the values are stored in struct-of-array layout, i.e. the value of
+  // instance dofNoLocal is at valueNo*nDofsLocalWithoutGhosts + dofNoLocal,
+  // this is the row-major layout of the array
+  dof_no_t nDofsLocalWithoutGhosts =
+      this->functionSpace_->nDofsLocalWithoutGhosts();
+  PyObject *valuesArray = PythonUtility::createArrayView(
+      localValues, nValuesPerInstance, nDofsLocalWithoutGhosts);
+  if (valuesArray == NULL)
+    return;
+
+  // the callback writes directly into localValues
+  PyObject *arglist = Py_BuildValue(
+      "(i,i,d,O,O,O)", nInstances, timeStepNo, currentTime, valuesArray,
+      pyGlobalNaturalDofsList_, pySetFunctionAdditionalParameter_);
+  PyObject *returnValue = PyObject_CallObject(pythonFunction, arglist);
+
+  // if there was an error while executing the function, print the error message
+  if (returnValue == NULL)
+    PythonUtility::checkForError();
+
+  // decrement reference counters for python objects
+  Py_CLEAR(valuesArray);
+  Py_CLEAR(returnValue);
+  Py_CLEAR(arglist);
+}
+
 template <int nStates, int nAlgebraics_, typename FunctionSpaceType>
 double CallbackHandler<nStates, nAlgebraics_,
                        FunctionSpaceType>::lastCallSpecificStatesTime() {
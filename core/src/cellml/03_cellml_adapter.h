@@ -64,6 +64,16 @@ public:
                                                  int timeStepNo,
                                                  double currentTime);
 
+  //! evaluate rhs only for the given instances, this is used for the
+  //! hyper-reduction (DEIM) in model order reduction. The states and rates
+  //! contain only these instances in struct-of-array order, i.e.
+  //! states[stateNo*instanceNos.size() + i] belongs to instance instanceNos[i].
+  //! The callback "setSpecificStates" is not called.
+  void evaluateRightHandSideOfInstances(const std::vector<int> &instanceNos,
+                                        double currentTime,
+                                        const std::vector<double> &states,
+                                        std::vector<double> &rates);
+
   //! return the mesh
   std::shared_ptr<FunctionSpaceType> functionSpace();
 
@@ -117,6 +117,16 @@ CellmlAdapter<nStates_, nAlgebraics_, FunctionSpaceType>::CellmlAdapter(
       rhs.fiberNoGlobal_; //< the additionalArgument converted to an integer,
                           // interpreted as the global fiber no and used in the
                           // stimulation log
+  this->callbackArgumentsAsArrays_ =
+      rhs.callbackArgumentsAsArrays_; //< if the callback functions get arrays
+  this->stimulationScheduleFilename_ = rhs.stimulationScheduleFilename_;
+  this->stimulationSchedule_ = rhs.stimulationSchedule_;
+  this->stimulationMotorUnitNo_ = rhs.stimulationMotorUnitNo_;
+  this->stimulationEventIndex_ = rhs.stimulationEventIndex_;
+  this->stimulationDofNoLocal_ = rhs.stimulationDofNoLocal_;
+  this->stimulationStateNo_ = rhs.stimulationStateNo_;
+  this->valueForStimulatedPoint_ = rhs.valueForStimulatedPoint_;
+  this->currentlyStimulating_ = rhs.currentlyStimulating_;
 
   this->lastCallSpecificStatesTime_ =
       rhs.lastCallSpecificStatesTime_; //< last time the setSpecificStates_
@@ -257,6 +267,9 @@ void CellmlAdapter<nStates_, nAlgebraics_, FunctionSpaceType>::initialize() {
       this->setSpecificStatesCallEnableBegin_ - 1e-13 -
       1. / (this->setSpecificStatesCallFrequency_ + this->currentJitter_);
 
+  // load the stimulation events, if they are given instead of the callback
+  this->initializeStimulationSchedule();
+
   LOG(DEBUG) << "Cellml end of initialize, " << this->sourceToCompileFilename_
              << ", statesForTransfer: " << this->data_.statesForTransfer();
   this->initialized_ = true;
@@ -393,6 +406,59 @@ void CellmlAdapter<nStates_, nAlgebraics_, FunctionSpaceType>::
   this->internalTimeStepNo_++;
 }
 
+template <int nStates_, int nAlgebraics_, typename FunctionSpaceType>
+void CellmlAdapter<nStates_, nAlgebraics_, FunctionSpaceType>::
+    evaluateRightHandSideOfInstances(const std::vector<int> &instanceNos,
+                                     double currentTime,
+                                     const std::vector<double> &states,
+                                     std::vector<double> &rates) {
+  if (!this->rhsRoutineSingleInstance_) {
+    LOG(FATAL) << "rhsRoutineSingleInstance is not compiled, cannot evaluate "
+                  "the rhs of single instances.";
+  }
+
+  const int nSampledInstances = instanceNos.size();
+  const int nParameters = this->cellmlSourceCodeGenerator_.nParameters();
+  assert(states.size() == nStates_ * nSampledInstances);
+  rates.resize(nStates_ * nSampledInstances);
+
+  // make the parameterValues_ vector available
+  this->data_.prepareParameterValues();
+
+  // handle callback function "setSpecificParameters"
+  checkCallbackParameters(currentTime);
+  double *parameterValues = this->data_.parameterValues();
+
+  std::array<double, nStates_> instanceStates;
+  std::array<double, nStates_> instanceRates;
+  std::array<double, nAlgebraics_> instanceAlgebraics;
+  std::vector<double> instanceParameters(nParameters);
+
+  for (int i = 0; i < nSampledInstances; i++) {
+    const int instanceNo = instanceNos[i];
+    assert(instanceNo >= 0 && instanceNo < this->nInstances_);
+
+    // gather the values of the instance, the parameters are stored in
+    // struct-of-array order for all instances
+    for (int stateNo = 0; stateNo < nStates_; stateNo++)
+      instanceStates[stateNo] = states[stateNo * nSampledInstances + i];
+
+    for (int parameterNo = 0; parameterNo < nParameters; parameterNo++)
+      instanceParameters[parameterNo] =
+          parameterValues[parameterNo * this->nInstances_ + instanceNo];
+
+    this->rhsRoutineSingleInstance_(
+        (void *)this, currentTime, instanceStates.data(), instanceRates.data(),
+        instanceAlgebraics.data(), instanceParameters.data());
+
+    for (int stateNo = 0; stateNo < nStates_; stateNo++)
+      rates[stateNo * nSampledInstances + i] = instanceRates[stateNo];
+  }
+
+  this->data_.restoreParameterValues();
+  this->internalTimeStepNo_++;
+}
+
 template <int nStates_, int nAlgebraics_, typename FunctionSpaceType>
 void CellmlAdapter<nStates_, nAlgebraics_, FunctionSpaceType>::
     checkCallbackParameters(double currentTime) {
@@ -401,7 +467,7 @@ void CellmlAdapter<nStates_, nAlgebraics_, FunctionSpaceType>::
       this->internalTimeStepNo_ % this->setSpecificParametersCallInterval_ ==
           0) {
     // start critical section for python API calls
-    // PythonUtility::GlobalInterpreterLock lock;
+    PythonUtility::GlobalInterpreterLock lock;
 
     VLOG(1) << "call setSpecificParameters";
     this->callPythonSetSpecificParametersFunction(
@@ -418,6 +484,12 @@ void CellmlAdapter<nStates_, nAlgebraics_, FunctionSpaceType>::
   // FastMonodomainSolverBase<>::isCurrentPointStimulated(),
   // specialized_solver/fast_monodomain_solver/fast_monodomain_solver_compute.tpp
 
+  // the stimulation schedule replaces the setSpecificStates callback
+  if (!this->stimulationScheduleFilename_.empty()) {
+    this->applyStimulationSchedule(currentTime, statesLocal);
+    return;
+  }
+
   VLOG(1) << "currentTime: " << currentTime << ", lastCallSpecificStatesTime_: "
           << this->lastCallSpecificStatesTime_
           << ", setSpecificStatesCallFrequency_: "
@@ -488,21 +560,19 @@ void CellmlAdapter<nStates_, nAlgebraics_, FunctionSpaceType>::
             << this->setSpecificStatesCallFrequency_
             << ", set lastCallSpecificStatesTime_ to "
             << this->lastCallSpecificStatesTime_;
-
-    // start critical section for python API calls
-    // PythonUtility::GlobalInterpreterLock lock;
   }
 
   VLOG(1) << "stimulate = " << stimulate;
 
-  static bool currentlyStimulating = false;
+  // the state of the stimulation is stored per instance, the instances can be
+  // computed by multiple threads
   if (stimulate) {
-    VLOG(1) << "currentlyStimulating: " << currentlyStimulating;
+    VLOG(1) << "currentlyStimulating: " << this->currentlyStimulating_;
 
     // if this is the first point in time of the current stimulation, log
     // stimulation time
-    if (!currentlyStimulating) {
-      currentlyStimulating = true;
+    if (!this->currentlyStimulating_) {
+      this->currentlyStimulating_ = true;
       Control::StimulationLogging::logStimulationBegin(currentTime, -1,
                                                        this->fiberNoGlobal_);
     }
@@ -519,7 +589,7 @@ void CellmlAdapter<nStates_, nAlgebraics_, FunctionSpaceType>::
     this->callPythonSetSpecificStatesFunction(
         this->nInstances_, this->internalTimeStepNo_, currentTime, statesLocal);
   } else {
-    currentlyStimulating = false;
+    this->currentlyStimulating_ = false;
   }
 }
 
@@ -531,7 +601,7 @@ void CellmlAdapter<nStates_, nAlgebraics_, FunctionSpaceType>::
   if (this->pythonHandleResultFunction_ &&
       this->internalTimeStepNo_ % this->handleResultCallInterval_ == 0) {
     // start critical section for python API calls
-    // PythonUtility::GlobalInterpreterLock lock;
+    PythonUtility::GlobalInterpreterLock lock;
 
     this->callPythonHandleResultFunction(this->nInstances_,
                                          this->internalTimeStepNo_, currentTime,
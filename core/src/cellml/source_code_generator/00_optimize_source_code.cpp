@@ -0,0 +1,397 @@
+#include "cellml/source_code_generator/00_source_code_generator_base.h"
+
+#include <Python.h> // has to be the first included header
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <map>
+#include <set>
+#include <vector>
+#include "easylogging++.h"
+#include "utility/string_utility.h"
+
+namespace {
+
+//! remove all whitespace, such that equal expressions get equal keys
+std::string removeWhitespace(std::string code) {
+  code.erase(std::remove_if(code.begin(), code.end(),
+                            [](unsigned char c) { return std::isspace(c); }),
+             code.end());
+  return code;
+}
+
+//! if the code is a single number literal, e.g. "-75" or "1.0e-5"
+bool isNumber(const std::string &code) {
+  if (code.empty() ||
+      code.find_first_not_of("0123456789.eE+-") != std::string::npos)
+    return false;
+
+  char *end = nullptr;
+  strtod(code.c_str(), &end);
+  return *end == '\0';
+}
+
+//! format a number literal such that it is a parenthesized double literal,
+//! otherwise "1/CONSTANTS[1]" could become the integer division "1/2"
+std::string doubleLiteral(std::string code) {
+  if (code.find_first_of(".eE") == std::string::npos)
+    code += ".0";
+  if (code[0] == '-' || code[0] == '+')
+    code = std::string("(") + code + ")";
+  return code;
+}
+
+//! if the code is a single variable or a number, reusing it saves nothing
+bool isSingleValue(const std::string &key) {
+  if (isNumber(key))
+    return true;
+
+  std::size_t posBracket = key.find("[");
+  return posBracket != std::string::npos && key.back() == ']' &&
+         key.find_first_of("[]", posBracket + 1) == key.length() - 1;
+}
+
+//! if the code ends with a function name, e.g. "*exp", such that the
+//! following parentheses contain the arguments of a function call
+bool endsWithFunctionName(const std::string &code) {
+  std::size_t pos = code.find_last_not_of(" \t");
+  return pos != std::string::npos &&
+         (std::isalnum((unsigned char)code[pos]) || code[pos] == '_');
+}
+
+} // namespace
+
+void CellmlSourceCodeGeneratorBase::optimizeSourceCode(
+    bool optimizeSourceCode, bool eliminateUnusedAlgebraics,
+    const std::vector<int> &algebraicsForTransfer) {
+  if (!optimizeSourceCode && !eliminateUnusedAlgebraics)
+    return;
+
+  int nOperationsBefore = countOperations();
+  int nFoldedConstants = 0;
+  int nReplacedExpressions = 0;
+  int nRemovedAlgebraics = 0;
+
+  if (optimizeSourceCode) {
+    nFoldedConstants = foldConstants();
+    nReplacedExpressions = eliminateCommonSubexpressions();
+  }
+
+  if (eliminateUnusedAlgebraics)
+    nRemovedAlgebraics = removeUnusedAlgebraics(algebraicsForTransfer);
+
+  // the code for the computation of the equilibrium also uses the lines
+  this->generateSingleInstanceCode();
+
+  LOG(DEBUG) << "optimizeSourceCode: replaced " << nFoldedConstants
+             << " constants by their values, " << nReplacedExpressions
+             << " subexpressions by algebraics, removed " << nRemovedAlgebraics
+             << " unused algebraics. Estimated number of operations per "
+             << "instance: " << nOperationsBefore << " -> "
+             << countOperations();
+}
+
+int CellmlSourceCodeGeneratorBase::foldConstants() {
+  // the code that replaces a constant, for all constants that do not depend on
+  // parameters
+  std::map<int, std::string> constantValues;
+
+  // the constant assignments are ordered such that constants are only
+  // computed from previously assigned constants
+  for (const std::string &line : constantAssignments_) {
+    // the line has the form "CONSTANTS[12] = CONSTANTS[3]/CONSTANTS[4];"
+    std::size_t posEquals = line.find("=");
+    std::size_t posSemicolon = line.rfind(";");
+    if (line.find("CONSTANTS[") != 0 || posEquals == std::string::npos ||
+        posSemicolon == std::string::npos || posSemicolon < posEquals)
+      continue;
+
+    int constantNo = atoi(line.substr(10).c_str());
+
+    // constants that are set by parameters can change during the simulation
+    if (std::find(parametersUsedAsConstant_.begin(),
+                  parametersUsedAsConstant_.end(),
+                  constantNo) != parametersUsedAsConstant_.end())
+      continue;
+
+    std::string valueCode =
+        line.substr(posEquals + 1, posSemicolon - posEquals - 1);
+    StringUtility::trim(valueCode);
+
+    if (isNumber(valueCode)) {
+      constantValues[constantNo] = doubleLiteral(valueCode);
+      continue;
+    }
+
+    // the constant is computed from other constants, it can be replaced by
+    // this computation if all these constants are known, then the compiler
+    // evaluates it
+    code_expression_t value;
+    value.parse(valueCode);
+
+    bool isKnown = true;
+    value.visitLeafs([&constantValues, &isKnown](code_expression_t &expression,
+                                                 bool isFirstVariable) {
+      if (expression.type != code_expression_t::variableName)
+        return;
+
+      std::map<int, std::string>::iterator iter =
+          constantValues.find(expression.arrayIndex);
+      if (expression.code == "CONSTANTS" && iter != constantValues.end()) {
+        expression.type = code_expression_t::otherCode;
+        expression.code = iter->second;
+      } else {
+        isKnown = false;
+      }
+    });
+
+    if (isKnown)
+      constantValues[constantNo] =
+          std::string("((double)(") + value.getCode() + "))";
+  }
+
+  int nFoldedConstants = 0;
+  for (code_expression_t &codeExpression : cellMLCode_.lines) {
+    codeExpression.visitNodes(
+        [&constantValues, &nFoldedConstants](code_expression_t &expression) {
+          if (expression.type != code_expression_t::variableName ||
+              expression.code != "CONSTANTS")
+            return;
+
+          std::map<int, std::string>::iterator iter =
+              constantValues.find(expression.arrayIndex);
+          if (iter != constantValues.end()) {
+            expression.type = code_expression_t::otherCode;
+            expression.code = iter->second;
+            nFoldedConstants++;
+          }
+        });
+
+    // merge the new code with the neighbouring code, e.g. the exponent of
+    // "pow(x, CONSTANTS[3])" becomes ", 3.0" like in "pow(x, 3.0)". Keep
+    // parentheses and ternary operators separate, the generators look for
+    // them.
+    codeExpression.visitNodes([](code_expression_t &expression) {
+      if (expression.type != code_expression_t::tree)
+        return;
+
+      auto isMergeable = [](const code_expression_t &child) {
+        return child.type == code_expression_t::otherCode &&
+               child.code != "(" && child.code != ")" && child.code != "?" &&
+               child.code != ":";
+      };
+
+      std::vector<code_expression_t> treeChildren;
+      for (code_expression_t &child : expression.treeChildren) {
+        if (!treeChildren.empty() && isMergeable(treeChildren.back()) &&
+            isMergeable(child)) {
+          treeChildren.back().code += child.code;
+        } else {
+          treeChildren.push_back(child);
+        }
+      }
+      expression.treeChildren = treeChildren;
+    });
+  }
+
+  return nFoldedConstants;
+}
+
+int CellmlSourceCodeGeneratorBase::eliminateCommonSubexpressions() {
+  // the variable that holds the value, for the code of the right hand side of
+  // every algebraic assignment
+  std::map<std::string, code_expression_t> computedValues;
+  int nReplacedExpressions = 0;
+
+  // every algebraic is assigned only once and before it is used, therefore the
+  // algebraics of the previous lines hold valid values
+  for (code_expression_t &codeExpression : cellMLCode_.lines) {
+    code_expression_t *assignedVariable = nullptr;
+    std::string rightHandSide;
+    if (!codeExpression.getAssignment(assignedVariable, rightHandSide))
+      continue;
+
+    // replace parenthesized subexpressions that have already been computed,
+    // outer parentheses are visited first
+    codeExpression.visitNodes([&computedValues, &nReplacedExpressions](
+                                  code_expression_t &expression) {
+      if (expression.type != code_expression_t::tree)
+        return;
+
+      for (int i = 0; i < expression.treeChildren.size(); i++) {
+        code_expression_t &child = expression.treeChildren[i];
+        if (child.type != code_expression_t::tree ||
+            child.treeChildren.size() != 3 ||
+            child.treeChildren[0].code != "(" ||
+            child.treeChildren[2].code != ")")
+          continue;
+
+        // the parentheses of a function call contain the arguments
+        if (i > 0 &&
+            expression.treeChildren[i - 1].type ==
+                code_expression_t::otherCode &&
+            endsWithFunctionName(expression.treeChildren[i - 1].code))
+          continue;
+
+        std::map<std::string, code_expression_t>::iterator iter =
+            computedValues.find(
+                removeWhitespace(child.treeChildren[1].getCode()));
+        if (iter != computedValues.end()) {
+          child = iter->second;
+          nReplacedExpressions++;
+        }
+      }
+    });
+
+    codeExpression.getAssignment(assignedVariable, rightHandSide);
+    std::string key = removeWhitespace(rightHandSide);
+
+    std::map<std::string, code_expression_t>::iterator iter =
+        computedValues.find(key);
+    if (iter != computedValues.end()) {
+      // the whole right hand side has already been computed, copy the value
+      code_expression_t variable = *assignedVariable;
+
+      code_expression_t assignment;
+      assignment.type = code_expression_t::otherCode;
+      assignment.code = " = ";
+
+      code_expression_t semicolon;
+      semicolon.type = code_expression_t::otherCode;
+      semicolon.code = ";";
+
+      codeExpression.type = code_expression_t::tree;
+      codeExpression.treeChildren = {variable, assignment, iter->second,
+                                     semicolon};
+      nReplacedExpressions++;
+    } else if (assignedVariable->code == "algebraics" && !isSingleValue(key)) {
+      computedValues[key] = *assignedVariable;
+    }
+  }
+
+  return nReplacedExpressions;
+}
+
+int CellmlSourceCodeGeneratorBase::removeUnusedAlgebraics(
+    const std::vector<int> &algebraicsToKeep) {
+  std::set<int> usedAlgebraics(algebraicsToKeep.begin(),
+                               algebraicsToKeep.end());
+  std::vector<bool> isLineUsed(cellMLCode_.lines.size(), true);
+  int nRemovedAlgebraics = 0;
+
+  // visit the lines backwards, then all usages of an algebraic are known when
+  // its assignment is visited
+  for (int lineNo = (int)cellMLCode_.lines.size() - 1; lineNo >= 0; lineNo--) {
+    code_expression_t &codeExpression = cellMLCode_.lines[lineNo];
+
+    code_expression_t *assignedVariable = nullptr;
+    std::string rightHandSide;
+    if (codeExpression.getAssignment(assignedVariable, rightHandSide) &&
+        assignedVariable->code == "algebraics" &&
+        usedAlgebraics.find(assignedVariable->arrayIndex) ==
+            usedAlgebraics.end()) {
+      isLineUsed[lineNo] = false;
+      nRemovedAlgebraics++;
+      continue;
+    }
+
+    // all algebraics that are read in this line are used
+    codeExpression.visitLeafs(
+        [&usedAlgebraics, assignedVariable](code_expression_t &expression,
+                                            bool isFirstVariable) {
+          if (expression.type == code_expression_t::variableName &&
+              expression.code == "algebraics" &&
+              &expression != assignedVariable)
+            usedAlgebraics.insert(expression.arrayIndex);
+        });
+  }
+
+  std::vector<code_expression_t> lines;
+  for (int lineNo = 0; lineNo < cellMLCode_.lines.size(); lineNo++) {
+    if (isLineUsed[lineNo])
+      lines.push_back(cellMLCode_.lines[lineNo]);
+  }
+  cellMLCode_.lines = lines;
+
+  return nRemovedAlgebraics;
+}
+
+int CellmlSourceCodeGeneratorBase::countOperations() {
+  int nOperations = 0;
+  for (code_expression_t &codeExpression : cellMLCode_.lines) {
+    code_expression_t *assignedVariable = nullptr;
+    std::string code;
+    if (!codeExpression.getAssignment(assignedVariable, code))
+      continue;
+
+    code = removeWhitespace(code);
+    for (int i = 0; i < code.length(); i++) {
+      // folded constants are evaluated by the compiler
+      if (code.compare(i, 10, "((double)(") == 0) {
+        for (int nOpenParentheses = 0; i < code.length(); i++) {
+          if (code[i] == '(')
+            nOpenParentheses++;
+          else if (code[i] == ')' && --nOpenParentheses == 0)
+            break;
+        }
+        continue;
+      }
+
+      char previous = (i > 0 ? code[i - 1] : ' ');
+      if (code[i] == '*' || code[i] == '/') {
+        nOperations++;
+      } else if (code[i] == '+' || code[i] == '-') {
+        // do not count signs, e.g. in "(-75.0)" or in literals like "1.0e-5"
+        bool isExponent = (previous == 'e' || previous == 'E') && i >= 2 &&
+                          (std::isdigit((unsigned char)code[i - 2]) ||
+                           code[i - 2] == '.');
+        if (!isExponent && (std::isalnum((unsigned char)previous) ||
+                            previous == ']' || previous == ')' ||
+                            previous == '.'))
+          nOperations++;
+      } else if (code[i] == '(' &&
+                 (std::isalnum((unsigned char)previous) || previous == '_')) {
+        // function call, e.g. exp(...)
+        nOperations++;
+      }
+    }
+  }
+  return nOperations;
+}
+
+bool CellmlSourceCodeGeneratorBase::code_expression_t::getAssignment(
+    code_expression_t *&assignedVariable, std::string &rightHandSide) {
+  assignedVariable = nullptr;
+  bool isAssignment = true;
+  std::stringstream s;
+
+  visitLeafs([&assignedVariable, &isAssignment,
+              &s](code_expression_t &expression, bool isFirstVariable) {
+    if (expression.type == code_expression_t::commented_out) {
+      isAssignment = false;
+    } else if (expression.type == code_expression_t::variableName &&
+               assignedVariable == nullptr) {
+      assignedVariable = &expression;
+    } else if (assignedVariable == nullptr) {
+      // there is code in front of the assigned variable
+      isAssignment = false;
+    } else if (expression.type == code_expression_t::variableName) {
+      s << expression.code << "[" << expression.arrayIndex << "]";
+    } else if (expression.type == code_expression_t::otherCode) {
+      s << expression.code;
+    }
+  });
+
+  rightHandSide = s.str();
+  StringUtility::trim(rightHandSide);
+
+  if (!isAssignment || assignedVariable == nullptr ||
+      rightHandSide.size() < 2 || rightHandSide.front() != '=' ||
+      rightHandSide.back() != ';')
+    return false;
+
+  rightHandSide = rightHandSide.substr(1, rightHandSide.length() - 2);
+  StringUtility::trim(rightHandSide);
+  return true;
+}
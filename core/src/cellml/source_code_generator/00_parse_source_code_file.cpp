@@ -656,3 +656,17 @@ std::string CellmlSourceCodeGeneratorBase::code_expression_t::getString() {
 
   return s.str();
 }
+
+std::string CellmlSourceCodeGeneratorBase::code_expression_t::getCode() {
+  std::stringstream s;
+
+  visitLeafs([&s](code_expression_t &expression, bool isFirstVariable) {
+    if (expression.type == code_expression_t::variableName) {
+      s << expression.code << "[" << expression.arrayIndex << "]";
+    } else if (expression.type == code_expression_t::otherCode) {
+      s << expression.code;
+    }
+  });
+
+  return s.str();
+}
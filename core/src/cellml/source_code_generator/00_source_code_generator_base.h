@@ -32,6 +32,16 @@ public:
                             int maximumNumberOfParameters,
                             double *parameterValues);
 
+  //! simplify the parsed code before the source file is generated.
+  //! If optimizeSourceCode is set, constants that do not depend on parameters
+  //! are replaced by their values and subexpressions that were already
+  //! computed for an algebraic are replaced by this algebraic. If
+  //! eliminateUnusedAlgebraics is set, algebraics that are neither needed for
+  //! the rates nor contained in algebraicsForTransfer are not computed.
+  void optimizeSourceCode(bool optimizeSourceCode,
+                          bool eliminateUnusedAlgebraics,
+                          const std::vector<int> &algebraicsForTransfer);
+
   //! generate the source file according to optimizationType
   //! Possible values are: simd vc openmp
   //! @param approximateExponentialFunction If the exp()-Function should be
@@ -111,6 +121,16 @@ protected:
 
     //! get a debugging string of the current expression
     std::string getString();
+
+    //! get the code of the current expression, with variable names as in the
+    //! parsed source file, e.g. "algebraics[2]"
+    std::string getCode();
+
+    //! if the current expression is an assignment "<variable> = <code>;" that
+    //! is not commented out, set assignedVariable to the variable and
+    //! rightHandSide to the code, otherwise return false
+    bool getAssignment(code_expression_t *&assignedVariable,
+                       std::string &rightHandSide);
   };
 
   //! check if sourceFilename_ is an xml based file and then convert to a c
@@ -126,6 +146,22 @@ protected:
   //! cellMLCode_
   void parseSourceCodeFile();
 
+  //! replace constants that are not parameters by their values
+  //! (or by the expression of literals that computes them)
+  int foldConstants();
+
+  //! replace parenthesized subexpressions and right hand sides that equal
+  //! the right hand side of a previously computed algebraic by this algebraic
+  int eliminateCommonSubexpressions();
+
+  //! remove assignments to algebraics whose values are neither needed for
+  //! the rates nor contained in algebraicsToKeep
+  int removeUnusedAlgebraics(const std::vector<int> &algebraicsToKeep);
+
+  //! estimate the number of floating point operations and function calls to
+  //! compute the rhs of one instance
+  int countOperations();
+
   //! Generate the rhs code for a single instance. This is needed for computing
   //! the equilibrium of the states.
   void generateSingleInstanceCode();
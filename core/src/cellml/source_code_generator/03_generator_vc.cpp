@@ -8,8 +8,35 @@
 
 #include <vector>
 #include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
 #include "easylogging++.h"
 
+namespace {
+//! parse the exponent of a pow function call, e.g. "3", "-2.0000" or "(-2.0)"
+//! for a folded constant, returns false if it is no integral number literal,
+//! e.g. "1.5" or "CONSTANTS[2]"
+bool parseIntegerExponent(std::string codeExponent, int &exponent) {
+  if (codeExponent.size() >= 2 && codeExponent.front() == '(' &&
+      codeExponent.back() == ')')
+    codeExponent = codeExponent.substr(1, codeExponent.size() - 2);
+
+  if (codeExponent.empty() ||
+      codeExponent.find_first_not_of("0123456789+-.eE") != std::string::npos)
+    return false;
+
+  char *end = nullptr;
+  double value = strtod(codeExponent.c_str(), &end);
+  if (*end != '\0' || value == 0 || value != std::round(value) ||
+      std::fabs(value) > std::numeric_limits<int>::max())
+    return false;
+
+  exponent = (int)value;
+  return true;
+}
+} // namespace
+
 void CellmlSourceCodeGeneratorVc::preprocessCode(
     std::set<std::string> &helperFunctions, bool useVc) {
   if (preprocessingDone_)
@@ -91,15 +118,8 @@ void CellmlSourceCodeGeneratorVc::preprocessCode(
                                                  codeExponent.end(), ' '),
                                      codeExponent.end());
 
-                  isIntegerExponent = codeExponent.find_first_not_of(
-                                          "0123456789+-.") == std::string::npos;
-                  // LOG(INFO) << "codeExponent: [" << codeExponent << "],
-                  // isIntegerExponent=" << isIntegerExponent << " (" <<
-                  // codeExponent.find_first_not_of("0123456789+-") << ", " <<
-                  // std::string::npos << ")";
-                  exponent = atoi(codeExponent.c_str());
-                  if (exponent == 0)
-                    isIntegerExponent = false;
+                  isIntegerExponent =
+                      parseIntegerExponent(codeExponent, exponent);
 
                   if (isIntegerExponent) {
                     // remove ", exponent" from code
@@ -120,15 +140,8 @@ void CellmlSourceCodeGeneratorVc::preprocessCode(
                                                  codeExponent.end(), ' '),
                                      codeExponent.end());
 
-                  isIntegerExponent = codeExponent.find_first_not_of(
-                                          "0123456789+-.") == std::string::npos;
-                  // LOG(INFO) << "codeExponent: [" << codeExponent << "],
-                  // isIntegerExponent=" << isIntegerExponent << " (" <<
-                  // codeExponent.find_first_not_of("0123456789+-") << ", " <<
-                  // std::string::npos << ")";
-                  exponent = atoi(codeExponent.c_str());
-                  if (exponent == 0)
-                    isIntegerExponent = false;
+                  isIntegerExponent =
+                      parseIntegerExponent(codeExponent, exponent);
 
                   if (isIntegerExponent) {
                     // remove ", exponent" from code
@@ -0,0 +1,260 @@
+#include "control/diagnostic_tool/hardware_counters.h"
+
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+#include "easylogging++.h"
+
+namespace Control {
+
+bool HardwareCounters::enabled_ = false;
+
+namespace {
+//! if the raw FP_ARITH_INST_RETIRED events can be used, they only exist on
+//! Intel CPUs since Broadwell. Older CPUs use the same event code for other
+//! events, and the hybrid CPUs (Alder Lake and newer client CPUs) need the
+//! event type of the core PMU instead of PERF_TYPE_RAW, therefore only the
+//! known models are accepted.
+bool hasFpArithEvents() {
+#if defined(__x86_64__) || defined(__i386__)
+  unsigned int eax, ebx, ecx, edx;
+  if (!__get_cpuid(0, &eax, &ebx, &ecx, &edx))
+    return false;
+
+  char vendor[13];
+  memcpy(vendor, &ebx, 4);
+  memcpy(vendor + 4, &edx, 4);
+  memcpy(vendor + 8, &ecx, 4);
+  vendor[12] = '\0';
+  if (std::string(vendor) != "GenuineIntel")
+    return false;
+
+  // get the family and model, including the extended model number
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+    return false;
+
+  unsigned int family = (eax >> 8) & 0xf;
+  unsigned int model = ((eax >> 4) & 0xf) | (((eax >> 16) & 0xf) << 4);
+  if (family != 6)
+    return false;
+
+  switch (model) {
+  case 0x3d: // Broadwell
+  case 0x47:
+  case 0x4f:
+  case 0x56:
+  case 0x4e: // Skylake
+  case 0x5e:
+  case 0x55: // Skylake-SP, Cascade Lake, Cooper Lake
+  case 0x8e: // Kaby Lake, Coffee Lake, Whiskey Lake, Comet Lake
+  case 0x9e:
+  case 0xa5:
+  case 0xa6:
+  case 0x66: // Cannon Lake
+  case 0x7d: // Ice Lake
+  case 0x7e:
+  case 0x6a:
+  case 0x6c:
+  case 0x8c: // Tiger Lake
+  case 0x8d:
+  case 0xa7: // Rocket Lake
+  case 0x8f: // Sapphire Rapids
+  case 0xcf: // Emerald Rapids
+  case 0xad: // Granite Rapids
+  case 0xae:
+    return true;
+  default:
+    return false;
+  }
+#else
+  return false;
+#endif
+}
+
+#ifdef __linux__
+//! open a single counter for the calling thread, returns -1 on failure
+int openCounter(uint32_t type, uint64_t config, int groupFd) {
+  struct perf_event_attr attributes;
+  memset(&attributes, 0, sizeof(attributes));
+  attributes.size = sizeof(attributes);
+  attributes.type = type;
+  attributes.config = config;
+  attributes.disabled = 0;
+  attributes.exclude_kernel = 1;
+  attributes.exclude_hv = 1;
+  attributes.read_format = PERF_FORMAT_GROUP |
+                           PERF_FORMAT_TOTAL_TIME_ENABLED |
+                           PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+  // pid 0 and cpu -1: measure the calling thread on any cpu
+  long fd = syscall(__NR_perf_event_open, &attributes, 0, -1, groupFd, 0);
+  return (int)fd;
+}
+#endif
+} // namespace
+
+HardwareCounters::Values::Values() { values.fill(0); }
+
+void HardwareCounters::Values::addDifference(const Values &start,
+                                             const Values &end) {
+  for (int i = 0; i < nCounters; i++)
+    values[i] += end.values[i] - start.values[i];
+}
+
+long long HardwareCounters::Values::flops() const {
+  return values[counterFpScalarDouble] + 2 * values[counterFp128PackedDouble] +
+         4 * values[counterFp256PackedDouble] +
+         8 * values[counterFp512PackedDouble];
+}
+
+double HardwareCounters::Values::bytes() const {
+  // every last level cache miss loads one cache line of 64 bytes
+  return 64.0 * values[counterLlcMisses];
+}
+
+void HardwareCounters::setEnabled(bool enabled) { enabled_ = enabled; }
+
+bool HardwareCounters::enabled() { return enabled_; }
+
+std::string HardwareCounters::counterName(counter_t counter) {
+  switch (counter) {
+  case counterCycles:
+    return "cycles";
+  case counterInstructions:
+    return "instructions";
+  case counterLlcMisses:
+    return "llcMisses";
+  case counterFpScalarDouble:
+    return "fpScalarDouble";
+  case counterFp128PackedDouble:
+    return "fp128PackedDouble";
+  case counterFp256PackedDouble:
+    return "fp256PackedDouble";
+  case counterFp512PackedDouble:
+    return "fp512PackedDouble";
+  default:
+    return "unknown";
+  }
+}
+
+HardwareCounters::ThreadCounters::ThreadCounters() {
+  fileDescriptors.fill(-1);
+  groupLeaders.fill(-1);
+  nGroupMembers.fill(0);
+
+#ifdef __linux__
+  struct CounterDefinition {
+    counter_t counter;
+    int groupNo;
+    uint32_t type;
+    uint64_t config;
+  };
+
+  // the fixed counters go into the first group, the floating point events into
+  // the second group, such that every group fits into the available hardware
+  // counters and is scheduled as a whole
+  std::vector<CounterDefinition> definitions{
+      {counterCycles, 0, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+      {counterInstructions, 0, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+      {counterLlcMisses, 0, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES}};
+
+  // raw event codes of FP_ARITH_INST_RETIRED (event 0xc7) with umask, on
+  // other CPUs the floating point counters are not available
+  if (hasFpArithEvents()) {
+    definitions.push_back({counterFpScalarDouble, 1, PERF_TYPE_RAW, 0x01c7});
+    definitions.push_back({counterFp128PackedDouble, 1, PERF_TYPE_RAW, 0x04c7});
+    definitions.push_back({counterFp256PackedDouble, 1, PERF_TYPE_RAW, 0x10c7});
+    definitions.push_back({counterFp512PackedDouble, 1, PERF_TYPE_RAW, 0x40c7});
+  }
+
+  for (const CounterDefinition &definition : definitions) {
+    int &leader = groupLeaders[definition.groupNo];
+    int fd = openCounter(definition.type, definition.config, leader);
+    if (fd < 0) {
+      VLOG(1) << "Hardware counter \"" << counterName(definition.counter)
+              << "\" is not available: " << strerror(errno);
+      continue;
+    }
+
+    // the first counter that could be opened becomes the group leader
+    if (leader == -1)
+      leader = fd;
+
+    fileDescriptors[definition.counter] = fd;
+    groupMembers[definition.groupNo][nGroupMembers[definition.groupNo]] =
+        definition.counter;
+    nGroupMembers[definition.groupNo]++;
+  }
+#endif
+}
+
+HardwareCounters::ThreadCounters::~ThreadCounters() {
+  for (int fd : fileDescriptors) {
+    if (fd != -1)
+      close(fd);
+  }
+}
+
+void HardwareCounters::ThreadCounters::readGroup(int groupNo, Values &values) {
+  if (groupLeaders[groupNo] == -1)
+    return;
+
+  // layout given by PERF_FORMAT_GROUP with total times
+  std::array<uint64_t, 3 + nCounters> buffer;
+  ssize_t nBytesRead = ::read(groupLeaders[groupNo], buffer.data(),
+                              sizeof(uint64_t) * buffer.size());
+  if (nBytesRead < (ssize_t)(3 * sizeof(uint64_t)))
+    return;
+
+  uint64_t nValues = buffer[0];
+  uint64_t timeEnabled = buffer[1];
+  uint64_t timeRunning = buffer[2];
+
+  // scale the values if the group was multiplexed with other events
+  double scalingFactor = 1.0;
+  if (timeRunning > 0 && timeRunning < timeEnabled)
+    scalingFactor = double(timeEnabled) / timeRunning;
+
+  for (uint64_t i = 0; i < nValues && (int)i < nGroupMembers[groupNo]; i++) {
+    values.values[groupMembers[groupNo][i]] =
+        (long long)(buffer[3 + i] * scalingFactor);
+  }
+}
+
+HardwareCounters::ThreadCounters &HardwareCounters::threadCounters() {
+  static thread_local ThreadCounters counters;
+  return counters;
+}
+
+void HardwareCounters::read(Values &values) {
+  if (!enabled_)
+    return;
+
+  ThreadCounters &counters = threadCounters();
+  for (int groupNo = 0; groupNo < ThreadCounters::nGroups; groupNo++)
+    counters.readGroup(groupNo, values);
+}
+
+bool HardwareCounters::available(counter_t counter) {
+  // do not open the counters if they are not used
+  if (!enabled_)
+    return false;
+
+  return threadCounters().fileDescriptors[counter] != -1;
+}
+
+bool HardwareCounters::flopsAvailable() {
+  return available(counterFpScalarDouble);
+}
+
+} // namespace Control
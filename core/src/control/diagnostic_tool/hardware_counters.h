@@ -0,0 +1,103 @@
+#pragma once
+
+#include <array>
+#include <string>
+
+namespace Control {
+
+/** Hardware performance counters of the calling thread, read in-process via
+ * the linux perf_event_open system call. The counters are opened per thread
+ * on first use. Counters that are not supported by the CPU or not permitted
+ * (see /proc/sys/kernel/perf_event_paranoid) are reported as not available.
+ *
+ *  The counters are not inherited by threads that are started later, e.g. the
+ * OpenMP threads of a parallel region inside of a measured time span only
+ * count for their own measurements and not for the measurement of the thread
+ * that started the parallel region. The values are therefore the work of the
+ * measuring thread only.
+ *
+ *  The floating point events are the Intel FP_ARITH_INST_RETIRED events for
+ * double precision, the number of transferred bytes is estimated from the last
+ * level cache misses. If the counters are disabled, nothing is opened or read
+ * and no counter is available.
+ */
+class HardwareCounters {
+public:
+  //! the counted events
+  enum counter_t {
+    counterCycles,
+    counterInstructions,
+    counterLlcMisses,
+    counterFpScalarDouble,
+    counterFp128PackedDouble,
+    counterFp256PackedDouble,
+    counterFp512PackedDouble,
+    nCounters
+  };
+
+  //! values of all counters at a point in time or accumulated over time spans
+  struct Values {
+    //! constructor, set all values to zero
+    Values();
+
+    //! add the differences end - start to the values
+    void addDifference(const Values &start, const Values &end);
+
+    //! number of double precision floating point operations, packed
+    //! instructions count for multiple operations
+    long long flops() const;
+
+    //! estimated number of bytes loaded from main memory
+    double bytes() const;
+
+    std::array<long long, nCounters> values; //< the counter values
+  };
+
+  //! enable or disable reading of the counters
+  static void setEnabled(bool enabled);
+
+  //! if the counters are read at all
+  static bool enabled();
+
+  //! read the current values of the calling thread, opens the counters on
+  //! first call on a thread, does nothing if not enabled
+  static void read(Values &values);
+
+  //! if the counter was successfully opened on the calling thread, false if
+  //! the counters are disabled
+  static bool available(counter_t counter);
+
+  //! if the floating point counters and therefore the flops are available on
+  //! the calling thread, this is only the case on known Intel CPUs
+  static bool flopsAvailable();
+
+  //! get a short name of the counter that is used in the log file
+  static std::string counterName(counter_t counter);
+
+private:
+  //! the file descriptors of the counters of one thread
+  struct ThreadCounters {
+    //! constructor, opens the counters
+    ThreadCounters();
+
+    //! destructor, closes the counters
+    ~ThreadCounters();
+
+    //! read the values of the group with the given leader
+    void readGroup(int groupNo, Values &values);
+
+    static const int nGroups = 2; //< counters are opened in two groups
+    std::array<int, nCounters> fileDescriptors; //< -1 if not available
+    std::array<int, nGroups> groupLeaders;      //< fd of the group leaders
+    std::array<std::array<int, nCounters>, nGroups>
+        groupMembers; //< counter of each position in the group
+    std::array<int, nGroups> nGroupMembers; //< number of opened counters
+  };
+
+  //! get the counters of the calling thread
+  static ThreadCounters &threadCounters();
+
+  static bool enabled_; //< if the counters are used
+};
+
+} // namespace Control
@@ -11,6 +11,7 @@
 #include <string>
 #include <sys/param.h>
 #include <iomanip>
+#include <omp.h>
 //#include <stdlib.h>  //was only for function getenv()
 
 #include "output_writer/generic.h"
@@ -19,16 +20,31 @@ namespace Control {
 
 std::map<std::string, PerformanceMeasurement::Measurement>
     PerformanceMeasurement::measurements_;
+std::vector<
+    std::map<std::string, PerformanceMeasurement::Measurement>::iterator>
+    PerformanceMeasurement::measurementsById_;
 std::map<std::string, std::string> PerformanceMeasurement::parameters_;
 std::map<std::string, int> PerformanceMeasurement::sums_;
-std::shared_ptr<std::thread> PerformanceMeasurement::perfThread_;
-int PerformanceMeasurement::perfThreadHandle_;
+std::mutex PerformanceMeasurement::mutex_;
+
+namespace {
+//! start point of a measurement that was started inside of a parallel region
+struct ThreadStart {
+  double start;                           //< start point in time
+  HardwareCounters::Values countersStart; //< hardware counters at the start
+};
+
+//! start points of the measurements that are currently running on the calling
+//! thread inside of a parallel region, key is the address of the measurement
+thread_local std::map<const void *, ThreadStart> threadStarts;
+} // namespace
 
 PerformanceMeasurement::Measurement::Measurement()
     : start(0.0), totalDuration(0.0), nTimeSpans(0), totalError(0.0),
-      nErrors(0) {}
+      nErrors(0), traceRegionId(-1) {}
 
-void PerformanceMeasurement::start(std::string name) {
+std::map<std::string, PerformanceMeasurement::Measurement>::iterator
+PerformanceMeasurement::getMeasurement(std::string name) {
   std::map<std::string, Measurement>::iterator iter = measurements_.find(name);
 
   // if there is no entry of name yet, create new
@@ -36,69 +52,167 @@ void PerformanceMeasurement::start(std::string name) {
     auto insertedIter = measurements_.insert(
         std::pair<std::string, Measurement>(name, Measurement()));
     iter = insertedIter.first;
+    iter->second.traceRegionId = PerformanceTrace::registerRegion(name);
+  }
+  return iter;
+}
+
+int PerformanceMeasurement::registerMeasurement(std::string name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // iterators of std::map stay valid when further elements are inserted
+  measurementsById_.push_back(getMeasurement(name));
+  return measurementsById_.size() - 1;
+}
+
+void PerformanceMeasurement::start(std::string name) {
+  Measurement *measurement;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    measurement = &getMeasurement(name)->second;
   }
 
+  PerformanceTrace::begin(measurement->traceRegionId);
+
+  // inside a parallel region, the start point is stored per thread
+  if (omp_in_parallel()) {
+    ThreadStart &threadStart = threadStarts[measurement];
+    HardwareCounters::read(threadStart.countersStart);
+    threadStart.start = MPI_Wtime();
+    return;
+  }
+
+  HardwareCounters::read(measurement->countersStart);
+
   // measure current time
-  iter->second.start = MPI_Wtime();
+  measurement->start = MPI_Wtime();
+}
+
+void PerformanceMeasurement::start(int measurementId) {
+  Measurement *measurement;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    measurement = &measurementsById_[measurementId]->second;
+  }
+
+  PerformanceTrace::begin(measurement->traceRegionId);
+
+  // inside a parallel region, the start point is stored per thread
+  if (omp_in_parallel()) {
+    ThreadStart &threadStart = threadStarts[measurement];
+    HardwareCounters::read(threadStart.countersStart);
+    threadStart.start = MPI_Wtime();
+    return;
+  }
+
+  HardwareCounters::read(measurement->countersStart);
+
+  // measure current time
+  measurement->start = MPI_Wtime();
 }
 
 void PerformanceMeasurement::stop(std::string name, int numberAccumulated) {
   double stopTime = MPI_Wtime();
 
-  if (measurements_.find(name) == measurements_.end()) {
+  Measurement *measurement = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::map<std::string, Measurement>::iterator iter =
+        measurements_.find(name);
+    if (iter != measurements_.end())
+      measurement = &iter->second;
+  }
+
+  if (!measurement) {
     LOG(ERROR) << "PerformanceMeasurement stop with name \"" << name
                << "\", a corresponding start is not present.";
   } else {
-    Measurement &measurement = measurements_[name];
-    double duration = stopTime - measurement.start;
-    measurement.totalDuration += duration;
-    measurement.nTimeSpans += numberAccumulated;
-
-    VLOG(2) << "PerformanceMeasurement::stop(" << name << "), time span ["
-            << measurement.start << "," << stopTime
-            << "], duration=" << duration
-            << ", now total: " << measurement.totalDuration
-            << ", nTimeSpans: " << measurement.nTimeSpans;
+    stopMeasurement(name, *measurement, stopTime, numberAccumulated);
   }
 }
 
-void PerformanceMeasurement::startFlops() {
-  // get process id
-  int pid = getpid();
+void PerformanceMeasurement::stop(int measurementId, int numberAccumulated) {
+  double stopTime = MPI_Wtime();
 
-  perfThread_ = std::make_shared<std::thread>([pid]() {
-    std::stringstream filename;
-    filename << "perf." << DihuContext::ownRankNoCommWorld() << ".txt";
+  std::map<std::string, Measurement>::iterator iter;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    iter = measurementsById_[measurementId];
+  }
+  stopMeasurement(iter->first, iter->second, stopTime, numberAccumulated);
+}
 
-    std::stringstream command;
-    command << "perf stat -e r5301c7 -p " << pid << " -o " << filename.str();
+void PerformanceMeasurement::stopMeasurement(std::string name,
+                                             Measurement &measurement,
+                                             double stopTime,
+                                             int numberAccumulated) {
+  PerformanceTrace::end(measurement.traceRegionId);
+
+  // get the start point, either of the calling thread or of the measurement
+  double startTime = measurement.start;
+  const HardwareCounters::Values *countersStart = &measurement.countersStart;
+  std::map<const void *, ThreadStart>::iterator threadStartIter =
+      threadStarts.end();
+  if (omp_in_parallel()) {
+    threadStartIter = threadStarts.find(&measurement);
+    if (threadStartIter != threadStarts.end()) {
+      startTime = threadStartIter->second.start;
+      countersStart = &threadStartIter->second.countersStart;
+    }
+  }
 
-    LOG(INFO) << "starting perf with command " << command.str();
+  HardwareCounters::Values countersEnd;
+  if (HardwareCounters::enabled())
+    HardwareCounters::read(countersEnd);
 
-    int returnValue = system(command.str().c_str());
-    LOG(DEBUG) << returnValue;
-  });
-  perfThreadHandle_ = perfThread_->native_handle();
+  double duration = stopTime - startTime;
 
-  perfThread_->detach();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (HardwareCounters::enabled())
+    measurement.countersTotal.addDifference(*countersStart, countersEnd);
+
+  measurement.totalDuration += duration;
+  measurement.nTimeSpans += numberAccumulated;
+
+  if (threadStartIter != threadStarts.end())
+    threadStarts.erase(threadStartIter);
+
+  VLOG(2) << "PerformanceMeasurement::stop(" << name << "), time span ["
+          << startTime << "," << stopTime << "], duration=" << duration
+          << ", now total: " << measurement.totalDuration
+          << ", nTimeSpans: " << measurement.nTimeSpans;
+}
+
+void PerformanceMeasurement::startFlops() {
+  if (!HardwareCounters::enabled())
+    return;
+
+  start("flops");
 }
 
 void PerformanceMeasurement::endFlops() {
-  pthread_cancel(perfThreadHandle_);
+  if (!HardwareCounters::enabled())
+    return;
 
-  std::stringstream filename;
-  filename << "perf." << DihuContext::ownRankNoCommWorld() << ".txt";
+  stop("flops");
 
-  // parse file
-  std::ifstream file(filename.str());
-  if (file.is_open()) {
-    std::string content((std::istreambuf_iterator<char>(file)),
-                        (std::istreambuf_iterator<char>()));
-    LOG(DEBUG) << content;
+  std::lock_guard<std::mutex> lock(mutex_);
+  const Measurement &measurement = measurements_["flops"];
+  long long nFlops = measurement.countersTotal.flops();
+  double duration = measurement.totalDuration;
+
+  if (!HardwareCounters::flopsAvailable()) {
+    LOG(DEBUG) << "The flops are unavailable on this CPU.";
+    return;
   }
+
+  LOG(DEBUG) << "Measured " << nFlops << " double precision flops in "
+             << duration << " s, "
+             << (duration > 0 ? nFlops / duration * 1e-9 : 0.0) << " GFLOP/s.";
 }
 
 std::string PerformanceMeasurement::getParameter(std::string key) {
+  std::lock_guard<std::mutex> lock(mutex_);
   if (parameters_.find(key) == parameters_.end())
     return "";
 
@@ -107,6 +221,7 @@ std::string PerformanceMeasurement::getParameter(std::string key) {
 
 double PerformanceMeasurement::getDuration(std::string measurementName,
                                            bool accumulated) {
+  std::lock_guard<std::mutex> lock(mutex_);
   if (measurements_.find(measurementName) == measurements_.end())
     return 0.0;
 
@@ -120,6 +235,7 @@ double PerformanceMeasurement::getDuration(std::string measurementName,
 template <>
 void PerformanceMeasurement::measureError<double>(std::string name,
                                                   double differenceVector) {
+  std::lock_guard<std::mutex> lock(mutex_);
   std::map<std::string, Measurement>::iterator iter = measurements_.find(name);
 
   // if there is no entry of name yet, create new
@@ -134,6 +250,7 @@ void PerformanceMeasurement::measureError<double>(std::string name,
 }
 
 void PerformanceMeasurement::countNumber(std::string name, int number) {
+  std::lock_guard<std::mutex> lock(mutex_);
   std::map<std::string, int>::iterator iter = sums_.find(name);
 
   // if there is no entry of name yet, create new
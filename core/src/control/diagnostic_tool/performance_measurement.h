@@ -2,28 +2,52 @@
 
 #include <Python.h> // has to be the first included header
 #include <map>
+#include <mutex>
 
 #include "control/dihu_context.h"
+#include "control/diagnostic_tool/performance_trace.h"
+#include "control/diagnostic_tool/hardware_counters.h"
 #include "interfaces/runnable.h"
 
 namespace Control {
 
 /** A class used for timing and error performance measurements. Timing is done
- * using MPI_Wtime.
+ * using MPI_Wtime. If tracing is enabled, all measurements are additionally
+ * recorded as regions in the PerformanceTrace. If hardware counters are
+ * enabled, their values are accumulated for every measurement and written to
+ * the log file, together with the derived GFLOP/s and arithmetic intensity.
+ *
+ *  All methods can be called from multiple threads. Measurements that are
+ * started inside an OpenMP parallel region keep their start time per thread,
+ * such that the same measurement can run on several threads at once, the
+ * durations of all threads are summed up.
  */
 class PerformanceMeasurement {
 public:
-  //! start timing measurement for a given keyword
+  //! register a measurement with the given keyword and return a handle that
+  //! can be used for start and stop without lookup of the keyword
+  static int registerMeasurement(std::string name);
+
+  //! start timing measurement for a given keyword, this is also recorded in
+  //! the trace, but needs a lookup of the keyword, code that is executed in
+  //! every time step should use a handle from registerMeasurement instead
   static void start(std::string name);
 
+  //! start timing measurement for a handle obtained by registerMeasurement
+  static void start(int measurementId);
+
   //! stop timing measurement for a given keyword, the counter of number of time
   //! spans is increased by numberAccumulated
   static void stop(std::string name, int numberAccumulated = 1);
 
-  //! execute perf counter to measure flops of the current PID
+  //! stop timing measurement for a handle obtained by registerMeasurement
+  static void stop(int measurementId, int numberAccumulated = 1);
+
+  //! start measurement of flops using the hardware counters, only has an
+  //! effect if hardware counters are enabled
   static void startFlops();
 
-  //! stop perf
+  //! stop the flops measurement and output the result
   static void endFlops();
 
   //! compute the mean magnitude of the given error vector or matrix and store
@@ -71,17 +95,32 @@ private:
 
     double totalError; //< sum of all errors
     int nErrors;       //< number of summands of totalError
+
+    PerformanceTrace::RegionId
+        traceRegionId; //< the region of this measurement in the trace
+
+    HardwareCounters::Values
+        countersStart; //< hardware counter values at the last start point
+    HardwareCounters::Values
+        countersTotal; //< sum of hardware counter values of all time spans
   };
 
+  //! get the measurement with the given name, create it if it does not exist
+  static std::map<std::string, Measurement>::iterator
+  getMeasurement(std::string name);
+
+  //! stop the given measurement, this is called by both variants of stop
+  static void stopMeasurement(std::string name, Measurement &measurement,
+                              double stopTime, int numberAccumulated);
+
   static std::map<std::string, Measurement>
       measurements_;                       //< the currently stored measurements
+  static std::vector<std::map<std::string, Measurement>::iterator>
+      measurementsById_; //< the measurements that were registered, by handle
   static std::map<std::string, int> sums_; //< the currently stored sums
   static std::map<std::string, std::string>
       parameters_; //< arbitrary parameters that will be stored in the log
-
-  static std::shared_ptr<std::thread>
-      perfThread_; //< thread used to execute perf which measures FLOPS
-  static int perfThreadHandle_; //< handle of the perf thread
+  static std::mutex mutex_; //< mutex for all static data of this class
 };
 
 template <>
@@ -19,6 +19,8 @@ template <typename T>
 void PerformanceMeasurement::setParameter(std::string key, T parameter) {
   std::stringstream str;
   str << parameter;
+
+  std::lock_guard<std::mutex> lock(mutex_);
   parameters_[key] = str.str();
 }
 
@@ -74,6 +74,20 @@ void PerformanceMeasurement::writeLogFile(std::string logFileName) {
       header << measurementName << ";n;";
     }
 
+    // write names of hardware counter values and derived quantities
+    if (HardwareCounters::enabled()) {
+      for (std::string measurementName : measurementNames) {
+        for (int i = 0; i < HardwareCounters::nCounters; i++) {
+          header << measurementName << "_"
+                 << HardwareCounters::counterName(
+                        (HardwareCounters::counter_t)i)
+                 << ";";
+        }
+        header << measurementName << "_GFLOPs;" << measurementName
+               << "_arithmeticIntensity;";
+      }
+    }
+
     // write parameter names
     for (std::pair<std::string, std::string> parameter : parameters_) {
       if (parameter.first == "nRanks" || parameter.first == "rankNo")
@@ -105,6 +119,35 @@ void PerformanceMeasurement::writeLogFile(std::string logFileName) {
       }
     }
 
+    // write hardware counter values, GFLOP/s and arithmetic intensity in
+    // flops/byte
+    if (HardwareCounters::enabled()) {
+      for (std::string measurementName : measurementNames) {
+        HardwareCounters::Values counters;
+        double duration = 0;
+        if (measurements_.find(measurementName) != measurements_.end()) {
+          counters = measurements_[measurementName].countersTotal;
+          duration = measurements_[measurementName].totalDuration;
+        }
+
+        for (int i = 0; i < HardwareCounters::nCounters; i++) {
+          if (HardwareCounters::available((HardwareCounters::counter_t)i))
+            data << counters.values[i] << ";";
+          else
+            data << "unavailable;";
+        }
+        if (HardwareCounters::flopsAvailable()) {
+          double gflops =
+              (duration > 0 ? counters.flops() / duration * 1e-9 : 0);
+          double arithmeticIntensity =
+              (counters.bytes() > 0 ? counters.flops() / counters.bytes() : 0);
+          data << gflops << ";" << arithmeticIntensity << ";";
+        } else {
+          data << "unavailable;unavailable;";
+        }
+      }
+    }
+
     // write parameters
     for (std::pair<std::string, std::string> parameter : parameters_) {
       if (parameter.first == "nRanks" || parameter.first == "rankNo")
@@ -144,6 +187,35 @@ void PerformanceMeasurement::writeLogFile(std::string logFileName) {
            << "\":" << measurement.second.totalDuration << ","
            << "\"" << measurement.first
            << " n\":" << measurement.second.nTimeSpans;
+
+      // write hardware counter values
+      if (HardwareCounters::enabled()) {
+        const HardwareCounters::Values &counters =
+            measurement.second.countersTotal;
+        // counters that are not available are written as null
+        for (int i = 0; i < HardwareCounters::nCounters; i++) {
+          HardwareCounters::counter_t counter = (HardwareCounters::counter_t)i;
+          data << ",\"" << measurement.first << "_"
+               << HardwareCounters::counterName(counter) << "\":";
+          if (HardwareCounters::available(counter))
+            data << counters.values[i];
+          else
+            data << "null";
+        }
+        data << ",\"" << measurement.first << "_GFLOPs\":";
+        if (HardwareCounters::flopsAvailable()) {
+          double duration = measurement.second.totalDuration;
+          double gflops =
+              (duration > 0 ? counters.flops() / duration * 1e-9 : 0);
+          double arithmeticIntensity =
+              (counters.bytes() > 0 ? counters.flops() / counters.bytes() : 0);
+          data << gflops << ",\"" << measurement.first
+               << "_arithmeticIntensity\":" << arithmeticIntensity;
+        } else {
+          data << "null,\"" << measurement.first
+               << "_arithmeticIntensity\":null";
+        }
+      }
     }
 
     // write parameters
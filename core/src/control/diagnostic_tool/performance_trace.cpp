@@ -0,0 +1,400 @@
+#include "control/diagnostic_tool/performance_trace.h"
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <set>
+#include <sstream>
+#include <mpi.h>
+
+#include "easylogging++.h"
+#include "control/dihu_context.h"
+#include "output_writer/generic.h"
+#include "utility/mpi_utility.h"
+
+namespace Control {
+
+std::vector<std::string> PerformanceTrace::regionNames_;
+std::map<std::string, PerformanceTrace::RegionId> PerformanceTrace::regionIds_;
+std::vector<std::shared_ptr<PerformanceTrace::ThreadBuffer>>
+    PerformanceTrace::threadBuffers_;
+std::mutex PerformanceTrace::mutex_;
+bool PerformanceTrace::enabled_ = false;
+bool PerformanceTrace::wasEnabled_ = false;
+int PerformanceTrace::ringBufferCapacity_ = 65536;
+std::string PerformanceTrace::traceFilename_ = "logs/trace";
+std::string PerformanceTrace::statisticsFilename_ = "logs/trace_statistics";
+
+namespace {
+//! point in time that corresponds to timestamp 0 in the trace
+const std::chrono::steady_clock::time_point referenceTime =
+    std::chrono::steady_clock::now();
+
+//! escape a string such that it can be used as a json string
+std::string escapeJson(std::string str) {
+  std::stringstream result;
+  for (char c : str) {
+    if (c == '"' || c == '\\')
+      result << '\\' << c;
+    else if (c == '\n')
+      result << "\\n";
+    else
+      result << c;
+  }
+  return result.str();
+}
+} // namespace
+
+PerformanceTrace::RegionStatistics::RegionStatistics()
+    : totalDuration(0), minDuration(std::numeric_limits<int64_t>::max()),
+      maxDuration(0), nCalls(0) {}
+
+PerformanceTrace::RegionId PerformanceTrace::registerRegion(std::string name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  std::map<std::string, RegionId>::iterator iter = regionIds_.find(name);
+  if (iter != regionIds_.end())
+    return iter->second;
+
+  RegionId regionId = regionNames_.size();
+  regionNames_.push_back(name);
+  regionIds_[name] = regionId;
+  return regionId;
+}
+
+std::string PerformanceTrace::regionName(RegionId regionId) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (regionId < 0 || regionId >= (int)regionNames_.size())
+    return std::string("");
+  return regionNames_[regionId];
+}
+
+int64_t PerformanceTrace::now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - referenceTime)
+      .count();
+}
+
+PerformanceTrace::ThreadBuffer &PerformanceTrace::threadBuffer() {
+  static thread_local ThreadBuffer *buffer = nullptr;
+
+  // on first use by this thread, create a new buffer
+  if (!buffer) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::shared_ptr<ThreadBuffer> newBuffer = std::make_shared<ThreadBuffer>();
+    newBuffer->threadNo = threadBuffers_.size();
+    newBuffer->events.resize(ringBufferCapacity_);
+    newBuffer->nEventsRecorded = 0;
+    newBuffer->openRegions.reserve(32);
+
+    threadBuffers_.push_back(newBuffer);
+    buffer = newBuffer.get();
+  }
+  return *buffer;
+}
+
+void PerformanceTrace::begin(RegionId regionId) {
+  if (!enabled_ || regionId < 0)
+    return;
+
+  ThreadBuffer &buffer = threadBuffer();
+
+  // if the region is already the innermost open region, restart it, this
+  // matches the behaviour of PerformanceMeasurement::start
+  if (!buffer.openRegions.empty() &&
+      buffer.openRegions.back().first == regionId) {
+    buffer.openRegions.back().second = now();
+    return;
+  }
+
+  buffer.openRegions.push_back(std::make_pair(regionId, now()));
+}
+
+void PerformanceTrace::end(RegionId regionId) {
+  if (!enabled_ || regionId < 0)
+    return;
+
+  int64_t endTime = now();
+  ThreadBuffer &buffer = threadBuffer();
+
+  // find the region in the stack of open regions, starting from the innermost
+  int index = (int)buffer.openRegions.size() - 1;
+  while (index >= 0 && buffer.openRegions[index].first != regionId)
+    index--;
+
+  // the region was begun before tracing was enabled, ignore it
+  if (index < 0)
+    return;
+
+  if (regionId >= (int)buffer.statistics.size())
+    buffer.statistics.resize(regionId + 1);
+
+  // close the region and all regions that were opened inside and not closed
+  while ((int)buffer.openRegions.size() > index) {
+    std::pair<RegionId, int64_t> openRegion = buffer.openRegions.back();
+    buffer.openRegions.pop_back();
+
+    Event &event =
+        buffer.events[buffer.nEventsRecorded % buffer.events.size()];
+    event.regionId = openRegion.first;
+    event.depth = buffer.openRegions.size();
+    event.begin = openRegion.second;
+    event.duration = endTime - openRegion.second;
+    buffer.nEventsRecorded++;
+
+    if (openRegion.first >= (int)buffer.statistics.size())
+      buffer.statistics.resize(openRegion.first + 1);
+
+    RegionStatistics &statistics = buffer.statistics[openRegion.first];
+    statistics.totalDuration += event.duration;
+    statistics.minDuration = std::min(statistics.minDuration, event.duration);
+    statistics.maxDuration = std::max(statistics.maxDuration, event.duration);
+    statistics.nCalls++;
+  }
+}
+
+void PerformanceTrace::setEnabled(bool enabled, int ringBufferCapacity) {
+  enabled_ = enabled;
+  if (enabled)
+    wasEnabled_ = true;
+  ringBufferCapacity_ = std::max(1, ringBufferCapacity);
+}
+
+bool PerformanceTrace::enabled() { return enabled_; }
+
+void PerformanceTrace::setFilenames(std::string traceFilename,
+                                    std::string statisticsFilename) {
+  traceFilename_ = traceFilename;
+  statisticsFilename_ = statisticsFilename;
+}
+
+void PerformanceTrace::writeFiles() {
+  if (!wasEnabled_)
+    return;
+
+  writeTraceFile(traceFilename_);
+  writeStatisticsFile(statisticsFilename_);
+}
+
+void PerformanceTrace::writeTraceFile(std::string filename) {
+  int ownRankNo = DihuContext::ownRankNoCommWorld();
+
+  std::stringstream fullFilename;
+  fullFilename << filename << "." << std::setw(7) << std::setfill('0')
+               << ownRankNo << ".json";
+
+  std::ofstream file;
+  OutputWriter::Generic::openFile(file, fullFilename.str());
+
+  if (!file.is_open()) {
+    LOG(ERROR) << "Could not write trace file \"" << fullFilename.str()
+               << "\".";
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // metadata that names the process after the rank
+  file << "{\"traceEvents\":[" << std::endl
+       << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << ownRankNo
+       << ",\"tid\":0,\"args\":{\"name\":\"rank " << ownRankNo << "\"}}";
+
+  long long nEventsTotal = 0;
+  long long nEventsLost = 0;
+  file << std::fixed << std::setprecision(3);
+
+  for (std::shared_ptr<ThreadBuffer> buffer : threadBuffers_) {
+    // if the ring buffer has wrapped around, the oldest event is at the current
+    // write position
+    long long capacity = buffer->events.size();
+    long long nEvents = std::min(buffer->nEventsRecorded, capacity);
+    long long firstIndex =
+        (buffer->nEventsRecorded > capacity ? buffer->nEventsRecorded : 0);
+
+    nEventsTotal += nEvents;
+    nEventsLost += buffer->nEventsRecorded - nEvents;
+
+    // timestamps in the Chrome trace format are in microseconds
+    for (long long i = 0; i < nEvents; i++) {
+      const Event &event = buffer->events[(firstIndex + i) % capacity];
+      file << "," << std::endl
+           << "{\"name\":\"" << escapeJson(regionNames_[event.regionId])
+           << "\",\"ph\":\"X\",\"pid\":" << ownRankNo
+           << ",\"tid\":" << buffer->threadNo
+           << ",\"ts\":" << event.begin * 1e-3
+           << ",\"dur\":" << event.duration * 1e-3
+           << ",\"args\":{\"depth\":" << event.depth << "}}";
+    }
+  }
+  file << std::endl << "],\"displayTimeUnit\":\"ms\"}" << std::endl;
+  file.close();
+
+  if (nEventsLost > 0) {
+    LOG(INFO) << "Trace file \"" << fullFilename.str()
+              << "\" contains the last " << nEventsTotal << " events, "
+              << nEventsLost
+              << " older events were overwritten. Increase "
+                 "\"traceBufferSize\" to keep them.";
+  } else {
+    LOG(DEBUG) << "Wrote " << nEventsTotal << " events to trace file \""
+               << fullFilename.str() << "\".";
+  }
+}
+
+void PerformanceTrace::writeStatisticsFile(std::string filename) {
+  int ownRankNo = DihuContext::ownRankNoCommWorld();
+  int nRanks = DihuContext::nRanksCommWorld();
+
+  // regions can be registered on some ranks only, therefore collect the union
+  // of all region names on rank 0 and send it back to all ranks
+  std::stringstream ownNames;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const std::string &name : regionNames_)
+      ownNames << name << "\n";
+  }
+  std::string ownNamesString = ownNames.str();
+  int ownLength = ownNamesString.length();
+
+  std::vector<int> lengths(nRanks, 0);
+  MPIUtility::handleReturnValue(MPI_Gather(&ownLength, 1, MPI_INT,
+                                           lengths.data(), 1, MPI_INT, 0,
+                                           MPI_COMM_WORLD),
+                                "MPI_Gather");
+
+  std::vector<int> offsets(nRanks, 0);
+  int totalLength = 0;
+  for (int rankNo = 0; rankNo < nRanks; rankNo++) {
+    offsets[rankNo] = totalLength;
+    totalLength += lengths[rankNo];
+  }
+
+  std::vector<char> allNames(std::max(1, totalLength));
+  MPIUtility::handleReturnValue(
+      MPI_Gatherv(ownNamesString.c_str(), ownLength, MPI_CHAR, allNames.data(),
+                  lengths.data(), offsets.data(), MPI_CHAR, 0, MPI_COMM_WORLD),
+      "MPI_Gatherv");
+
+  std::string unionNamesString;
+  if (ownRankNo == 0) {
+    std::set<std::string> unionNames;
+    std::stringstream stream(std::string(allNames.data(), totalLength));
+    std::string name;
+    while (std::getline(stream, name))
+      unionNames.insert(name);
+
+    std::stringstream unionNamesStream;
+    for (const std::string &unionName : unionNames)
+      unionNamesStream << unionName << "\n";
+    unionNamesString = unionNamesStream.str();
+  }
+
+  int unionLength = unionNamesString.length();
+  MPIUtility::handleReturnValue(
+      MPI_Bcast(&unionLength, 1, MPI_INT, 0, MPI_COMM_WORLD), "MPI_Bcast");
+  unionNamesString.resize(unionLength);
+  MPIUtility::handleReturnValue(MPI_Bcast(&unionNamesString[0], unionLength,
+                                          MPI_CHAR, 0, MPI_COMM_WORLD),
+                                "MPI_Bcast");
+
+  std::vector<std::string> names;
+  {
+    std::stringstream stream(unionNamesString);
+    std::string name;
+    while (std::getline(stream, name))
+      names.push_back(name);
+  }
+  int nRegions = names.size();
+
+  // accumulate the local values of all threads, durations in s
+  std::vector<double> localDuration(nRegions, 0.0);
+  std::vector<double> localDurationForMinimum(
+      nRegions, std::numeric_limits<double>::max());
+  std::vector<long long> localNCalls(nRegions, 0);
+  std::vector<int> localHasRegion(nRegions, 0);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (int i = 0; i < nRegions; i++) {
+      std::map<std::string, RegionId>::iterator iter =
+          regionIds_.find(names[i]);
+      if (iter == regionIds_.end())
+        continue;
+
+      RegionId regionId = iter->second;
+      for (std::shared_ptr<ThreadBuffer> buffer : threadBuffers_) {
+        if (regionId < (int)buffer->statistics.size()) {
+          localDuration[i] += buffer->statistics[regionId].totalDuration * 1e-9;
+          localNCalls[i] += buffer->statistics[regionId].nCalls;
+        }
+      }
+      if (localNCalls[i] > 0) {
+        localHasRegion[i] = 1;
+        localDurationForMinimum[i] = localDuration[i];
+      }
+    }
+  }
+
+  std::vector<double> minDuration(nRegions), maxDuration(nRegions),
+      sumDuration(nRegions);
+  std::vector<long long> sumNCalls(nRegions);
+  std::vector<int> nRanksWithRegion(nRegions);
+
+  if (nRegions > 0) {
+    MPIUtility::handleReturnValue(
+        MPI_Reduce(localDurationForMinimum.data(), minDuration.data(), nRegions,
+                   MPI_DOUBLE, MPI_MIN, 0, MPI_COMM_WORLD),
+        "MPI_Reduce");
+    MPIUtility::handleReturnValue(
+        MPI_Reduce(localDuration.data(), maxDuration.data(), nRegions,
+                   MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD),
+        "MPI_Reduce");
+    MPIUtility::handleReturnValue(
+        MPI_Reduce(localDuration.data(), sumDuration.data(), nRegions,
+                   MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD),
+        "MPI_Reduce");
+    MPIUtility::handleReturnValue(
+        MPI_Reduce(localNCalls.data(), sumNCalls.data(), nRegions,
+                   MPI_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD),
+        "MPI_Reduce");
+    MPIUtility::handleReturnValue(
+        MPI_Reduce(localHasRegion.data(), nRanksWithRegion.data(), nRegions,
+                   MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD),
+        "MPI_Reduce");
+  }
+
+  if (ownRankNo != 0)
+    return;
+
+  std::ofstream file;
+  OutputWriter::Generic::openFile(file, filename + ".csv");
+
+  if (!file.is_open()) {
+    LOG(ERROR) << "Could not write trace statistics file \"" << filename
+               << ".csv\".";
+    return;
+  }
+
+  // the imbalance is max/mean - 1 over the ranks that have the region
+  file << "# region;nRanks;nCalls;min;mean;max;imbalance" << std::endl;
+  for (int i = 0; i < nRegions; i++) {
+    if (nRanksWithRegion[i] == 0)
+      continue;
+
+    double meanDuration = sumDuration[i] / nRanksWithRegion[i];
+    double imbalance =
+        (meanDuration > 0 ? maxDuration[i] / meanDuration - 1.0 : 0.0);
+
+    file << names[i] << ";" << nRanksWithRegion[i] << ";" << sumNCalls[i] << ";"
+         << minDuration[i] << ";" << meanDuration << ";" << maxDuration[i]
+         << ";" << imbalance << std::endl;
+  }
+  file.close();
+
+  LOG(INFO) << "Wrote trace statistics of " << nRegions << " regions to \""
+            << filename << ".csv\".";
+}
+
+} // namespace Control
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace Control {
+
+/** Low-overhead hierarchical instrumentation of code regions.
+ *  A region is registered once by its name and afterwards referred to by an
+ * integer handle, such that begin() and end() do not need any string
+ * operations or map lookups. Every thread records its events into an own ring
+ * buffer of fixed capacity, timing is done using std::chrono::steady_clock.
+ * Regions can be nested, the nesting depth is stored with every event.
+ *
+ *  At the end of the program, every rank writes a trace file in the Chrome
+ * trace event format (can be opened with chrome://tracing or
+ * https://ui.perfetto.dev) and the accumulated durations of the regions are
+ * reduced over all ranks to a statistics file that contains min, max, mean and
+ * the load imbalance.
+ *
+ *  All regions that are timed by PerformanceMeasurement::start/stop also
+ * appear in the trace, if tracing is enabled.
+ */
+class PerformanceTrace {
+public:
+  typedef int RegionId;
+
+  //! register a region with the given name and return its handle, repeated
+  //! calls with the same name return the same handle
+  static RegionId registerRegion(std::string name);
+
+  //! get the name of a registered region
+  static std::string regionName(RegionId regionId);
+
+  //! enter the region, this is a no-op if tracing is not enabled
+  static void begin(RegionId regionId);
+
+  //! leave the region, it should be the innermost open region of the current
+  //! thread, if not, all inner open regions are closed as well
+  static void end(RegionId regionId);
+
+  //! enable or disable recording of events, set the number of events that are
+  //! kept per thread
+  static void setEnabled(bool enabled, int ringBufferCapacity = 65536);
+
+  //! if events are currently recorded
+  static bool enabled();
+
+  //! set the file names (without suffix) for the trace and statistics files
+  static void setFilenames(std::string traceFilename,
+                           std::string statisticsFilename);
+
+  //! write the trace file of the own rank and the statistics file, collective
+  //! over MPI_COMM_WORLD, does nothing if tracing was never enabled
+  static void writeFiles();
+
+  //! write the recorded events of the own rank in Chrome trace event format to
+  //! <filename>.<rankNo>.json
+  static void writeTraceFile(std::string filename);
+
+  //! reduce the accumulated region durations over all ranks and write min, max,
+  //! mean and imbalance to <filename>.csv on rank 0, collective
+  static void writeStatisticsFile(std::string filename);
+
+  /** RAII helper that calls begin() in the constructor and end() in the
+   * destructor
+   */
+  class Scope {
+  public:
+    //! constructor, enter region
+    Scope(RegionId regionId) : regionId_(regionId) { begin(regionId_); }
+
+    //! destructor, leave region
+    ~Scope() { end(regionId_); }
+
+  private:
+    RegionId regionId_; //< the region that is measured
+  };
+
+private:
+  //! one completed region, times in ns since the reference time
+  struct Event {
+    RegionId regionId; //< handle of the region
+    int depth;         //< nesting depth, 0 for outermost regions
+    int64_t begin;     //< point in time when the region was entered
+    int64_t duration;  //< duration of the region
+  };
+
+  //! accumulated information of a region on one thread
+  struct RegionStatistics {
+    //! constructor
+    RegionStatistics();
+
+    int64_t totalDuration; //< sum of all durations
+    int64_t minDuration;   //< minimum duration of a single call
+    int64_t maxDuration;   //< maximum duration of a single call
+    long long nCalls;      //< number of completed calls
+  };
+
+  //! all data that is recorded by a single thread
+  struct ThreadBuffer {
+    int threadNo;              //< number of the thread in order of first use
+    std::vector<Event> events; //< ring buffer of the last events
+    long long nEventsRecorded; //< total number of recorded events, the next
+                               // event goes to nEventsRecorded % capacity
+    std::vector<std::pair<RegionId, int64_t>>
+        openRegions; //< stack of currently open regions and their begin times
+    std::vector<RegionStatistics>
+        statistics; //< statistics for every region, indexed by region id
+  };
+
+  //! get the buffer of the calling thread, create it on first use
+  static ThreadBuffer &threadBuffer();
+
+  //! get the current time in ns since the reference time
+  static int64_t now();
+
+  static std::vector<std::string> regionNames_; //< names of the regions, the
+                                                // index is the region id
+  static std::map<std::string, RegionId>
+      regionIds_; //< region ids by name, for registerRegion
+  static std::vector<std::shared_ptr<ThreadBuffer>>
+      threadBuffers_;       //< the buffers of all threads that recorded events
+  static std::mutex mutex_; //< mutex for regionNames_ and threadBuffers_
+  static bool enabled_;     //< if events are recorded
+  static bool wasEnabled_;  //< if recording was enabled at some point
+  static int ringBufferCapacity_; //< number of events per thread buffer
+  static std::string traceFilename_; //< file name of the trace file
+  static std::string statisticsFilename_; //< file name of the statistics
+};
+
+} // namespace Control
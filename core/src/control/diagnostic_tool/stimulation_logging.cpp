@@ -9,6 +9,7 @@ namespace Control {
 std::string StimulationLogging::filename_;
 std::vector<StimulationLogging::StimulationLogEntry>
     StimulationLogging::logEntries_;
+std::mutex StimulationLogging::mutex_;
 
 StimulationLogging::StimulationLogging(PythonConfig specificSettings) {
   // get python config
@@ -24,6 +25,9 @@ void StimulationLogging::logStimulationBegin(double currentTime,
   logEntry.time = currentTime;
   logEntry.fiberNo = fiberNo;
   logEntry.motorUnitNo = motorUnitNo;
+
+  // the instances of MultipleInstances can be computed by multiple threads
+  std::lock_guard<std::mutex> lock(mutex_);
   logEntries_.push_back(logEntry);
 }
 
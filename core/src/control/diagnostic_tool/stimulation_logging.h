@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Python.h> // has to be the first included header
+#include <mutex>
 
 #include "control/dihu_context.h"
 #include "control/python_config/python_config.h"
@@ -36,6 +37,7 @@ private:
   static std::vector<StimulationLogEntry>
       logEntries_; //< all entries that will be written from the current MPI
                    // rank to the log file
+  static std::mutex mutex_; //< mutex for logEntries_
 };
 
 //! output operator for StimulationLogEntry
@@ -34,6 +34,7 @@
 #include "easylogging++.h"
 #include "control/python_config/settings_file_name.h"
 #include "utility/mpi_utility.h"
+#include "utility/cpu_utility.h"
 #ifdef HAVE_PAT
 #include <pat_api.h> // perftools, only available on hazel hen
 #endif
@@ -166,8 +167,17 @@ DihuContext::DihuContext(int argc, char *argv[], bool doNotFinalizeMpi,
 #endif
 
     // initialize MPI, this is necessary to be able to call PetscFinalize
-    // without MPI shutting down
-    MPI_Init(&argc, &argv);
+    // without MPI shutting down. Only the main thread calls MPI, unless more
+    // than one OpenMP thread is available. Then, full thread support is
+    // requested, such that the local instances of MultipleInstances can be
+    // computed by multiple threads, the provided level is checked there with
+    // MPI_Query_thread.
+    int mpiThreadSupportRequired = MPI_THREAD_FUNNELED;
+    if (omp_get_max_threads() > 1)
+      mpiThreadSupportRequired = MPI_THREAD_MULTIPLE;
+
+    int mpiThreadSupport;
+    MPI_Init_thread(&argc, &argv, mpiThreadSupportRequired, &mpiThreadSupport);
 
     // the following three lines output the MPI version during compilation, use
     // for debugging
@@ -215,6 +225,10 @@ DihuContext::DihuContext(int argc, char *argv[], bool doNotFinalizeMpi,
     LOG(INFO) << mpiVersion;
     LOG(DEBUG) << "MPI version: \"" << mpiVersion << "\".";
 
+    // the vectorized code is fixed to the instruction set of the build, check
+    // that it matches the CPU
+    CpuUtility::logInstructionSets();
+
     // warn if OpenMPI 4 is used, remove this warning if you know if the bug has
     // been fixed (try running fibers_emg with at least 64 ranks)
     if (mpiVersion.find("Open MPI v4") != std::string::npos &&
@@ -575,6 +589,7 @@ DihuContext::~DihuContext() {
     writeSolverStructureDiagram();
     Control::StimulationLogging::writeLogFile();
     Control::PerformanceMeasurement::writeLogFile();
+    Control::PerformanceTrace::writeFiles();
     MappingBetweenMeshes::Manager::writeLogFile();
 
     // After a call to MPI_Finalize we cannot call MPI_Initialize() anymore.
@@ -77,6 +77,11 @@ public:
   //! return a text giving meta information
   static std::string metaText();
 
+  //! create the python module with the functions serialize_settings() and
+  //! deserialize_settings(data) that transfer the variables of the settings
+  //! script to other ranks, returns a new reference
+  static PyObject *settingsSerializationModule();
+
   //! create a context object, like with the operator[] but with given config
   //! and rankSubset, if rankSubset is not given, reuse own rankSubset
   DihuContext
@@ -156,6 +161,16 @@ private:
   //! execute python script and store global variables
   void loadPythonScript(std::string text);
 
+  //! execute the python script in pythonScriptText_, abort on errors
+  void executePythonScript();
+
+  //! execute the settings script on rank 0, serialize its variables and load
+  //! them on all other ranks, for the command line option
+  //! -settings_on_rank_zero. Returns false on ranks that did not get the
+  //! variables and have to execute the script themselves, e.g. if the script
+  //! reads the own rank number.
+  bool broadcastPythonSettings();
+
   //! parse the scenarioName and data under "meta" and set as global parameters
   void parseGlobalParameters();
 
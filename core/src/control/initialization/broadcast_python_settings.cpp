@@ -0,0 +1,272 @@
+#include "control/dihu_context.h"
+
+#include <Python.h> // this has to be the first included header
+#include <algorithm>
+
+#include "utility/python_utility.h"
+#include "utility/mpi_utility.h"
+#include "utility/vector_operators.h"
+
+namespace {
+
+/** Python code to serialize the variables of all modules that belong to the
+ * settings, i.e. __main__ and imported modules that are not installed
+ * packages. Modules are pickled by name and functions of the settings are
+ * pickled by their byte code, such that callback functions can be called on the
+ * receiving ranks. Numpy arrays are pickled as binary data.
+ */
+const char *settingsSerializationCode = R"(
+import importlib
+import io
+import marshal
+import os
+import pickle
+import sys
+import types
+
+def _is_user_module(module):
+  if module.__name__ == "__main__":
+    return True
+  filename = getattr(module, "__file__", None)
+  if not filename:
+    return False
+  filename = os.path.realpath(filename)
+  for prefix in set([sys.prefix, sys.base_prefix, sys.exec_prefix]):
+    if filename.startswith(os.path.realpath(prefix) + os.sep):
+      return False
+  return "site-packages" not in filename and "dist-packages" not in filename
+
+def _get_user_module(name):
+  module = sys.modules.get(name)
+  if module is None:
+    module = types.ModuleType(name)
+    sys.modules[name] = module
+  return module
+
+def _make_cell(value):
+  return (lambda: value).__closure__[0]
+
+class _NullWriter:
+  def write(self, data):
+    return len(data)
+
+class _SettingsPickler(pickle.Pickler):
+  def persistent_id(self, obj):
+    if isinstance(obj, types.ModuleType):
+      if _is_user_module(obj):
+        return ("user_module", obj.__name__)
+      if getattr(obj, "__spec__", None) is None:
+        raise pickle.PicklingError(
+          "module {} cannot be imported".format(obj.__name__))
+      return ("module", obj.__name__)
+    if isinstance(obj, types.FunctionType):
+      module = sys.modules.get(obj.__module__)
+      if module is None or not _is_user_module(module) \
+        or obj.__globals__ is not module.__dict__:
+        return None
+      closure = None
+      if obj.__closure__ is not None:
+        closure = tuple(cell.cell_contents for cell in obj.__closure__)
+      return ("function", obj.__module__, obj.__name__, obj.__qualname__,
+        marshal.dumps(obj.__code__), obj.__defaults__, obj.__kwdefaults__,
+        closure, obj.__dict__ or None)
+    return None
+
+class _SettingsUnpickler(pickle.Unpickler):
+  def persistent_load(self, pid):
+    if pid[0] == "module":
+      return importlib.import_module(pid[1])
+    if pid[0] == "user_module":
+      return _get_user_module(pid[1])
+    if pid[0] == "function":
+      _, module_name, name, qualname, code, defaults, kwdefaults, closure, \
+        attributes = pid
+      if closure is not None:
+        closure = tuple(_make_cell(value) for value in closure)
+      function = types.FunctionType(marshal.loads(code),
+        _get_user_module(module_name).__dict__, name, defaults, closure)
+      function.__qualname__ = qualname
+      function.__kwdefaults__ = kwdefaults
+      if attributes:
+        function.__dict__.update(attributes)
+      return function
+    raise pickle.UnpicklingError("unknown persistent id {}".format(pid[0]))
+
+class _ArgvRecorder(list):
+  """sys.argv that records if the own rank number, sys.argv[-2], is read"""
+  rank_no_read = False
+
+  def __getitem__(self, index):
+    n = len(self)
+    if isinstance(index, slice):
+      if n - 2 in range(*index.indices(n)):
+        self.rank_no_read = True
+    elif index == -2 or index == n - 2:
+      self.rank_no_read = True
+    return list.__getitem__(self, index)
+
+  def __iter__(self):
+    self.rank_no_read = True
+    return list.__iter__(self)
+
+def record_rank_no_access():
+  sys.argv = _ArgvRecorder(sys.argv)
+
+def get_rank_dependency():
+  """return why the settings can depend on the own rank, or None"""
+  rank_no_read = getattr(sys.argv, "rank_no_read", False)
+  sys.argv = list.__getitem__(sys.argv, slice(None))
+  if rank_no_read:
+    return "it reads the own rank number sys.argv[-2]"
+  if "mpi4py.MPI" in sys.modules:
+    return "it imports mpi4py"
+  return None
+
+def serialize_settings():
+  modules = {}
+  skipped = []
+  for module_name, module in list(sys.modules.items()):
+    if not isinstance(module, types.ModuleType) or not _is_user_module(module):
+      continue
+    variables = {}
+    for key, value in list(module.__dict__.items()):
+      if key in ["__builtins__", "__loader__", "__spec__", "__cached__"]:
+        continue
+      try:
+        _SettingsPickler(_NullWriter(), pickle.HIGHEST_PROTOCOL).dump(value)
+      except Exception:
+        skipped.append("{}.{}".format(module_name, key))
+        continue
+      variables[key] = value
+    modules[module_name] = variables
+  data = io.BytesIO()
+  _SettingsPickler(data, pickle.HIGHEST_PROTOCOL).dump(modules)
+  return data.getvalue(), skipped
+
+def deserialize_settings(data):
+  modules = _SettingsUnpickler(io.BytesIO(data)).load()
+  for module_name, variables in modules.items():
+    _get_user_module(module_name).__dict__.update(variables)
+)";
+
+//! broadcast a large buffer in chunks, because MPI counts are int
+void broadcastBuffer(char *data, unsigned long long nBytes) {
+  const unsigned long long chunkSize = 1ull << 30;
+  for (unsigned long long offset = 0; offset < nBytes; offset += chunkSize) {
+    int count = (int)std::min(chunkSize, nBytes - offset);
+    MPIUtility::handleReturnValue(
+        MPI_Bcast(data + offset, count, MPI_BYTE, 0, MPI_COMM_WORLD),
+        "MPI_Bcast");
+  }
+}
+
+} // namespace
+
+PyObject *DihuContext::settingsSerializationModule() {
+  // create a module that is not registered in sys.modules, to hold the
+  // serialization functions without adding them to the settings
+  PyObject *helperModule = PyModule_New("opendihu_settings_serialization");
+  PyObject *helperDict = PyModule_GetDict(helperModule); // borrowed reference
+  PyDict_SetItemString(helperDict, "__builtins__", PyEval_GetBuiltins());
+
+  PyObject *result = PyRun_String(settingsSerializationCode, Py_file_input,
+                                  helperDict, helperDict);
+  if (result == NULL)
+    PythonUtility::checkForError();
+  Py_CLEAR(result);
+
+  return helperModule; // return value: new reference
+}
+
+bool DihuContext::broadcastPythonSettings() {
+  PyObject *helperModule = settingsSerializationModule();
+  PyObject *result = NULL;
+
+  // on rank 0, execute the settings script and serialize all its variables
+  unsigned long long nBytes = 0;
+  PyObject *data = NULL;
+  if (ownRankNoCommWorld_ == 0) {
+    // record if the script reads the own rank number, then the other ranks
+    // would get wrong values
+    result = PyObject_CallMethod(helperModule, "record_rank_no_access", NULL);
+    if (result == NULL)
+      PythonUtility::checkForError();
+    Py_CLEAR(result);
+
+    executePythonScript();
+
+    std::string rankDependency;
+    result = PyObject_CallMethod(helperModule, "get_rank_dependency", NULL);
+    if (result == NULL)
+      PythonUtility::checkForError();
+    else if (result != Py_None)
+      rankDependency =
+          PythonUtility::convertFromPython<std::string>::get(result);
+    Py_CLEAR(result);
+
+    if (!rankDependency.empty()) {
+      LOG(WARNING) << "The settings script can depend on the rank, because "
+                   << rankDependency << ". All ranks execute the settings "
+                   << "script, -settings_on_rank_zero has no effect.";
+    } else {
+      result = PyObject_CallMethod(helperModule, "serialize_settings", NULL);
+      if (result == NULL) {
+        PythonUtility::checkForError();
+        LOG(WARNING) << "Could not serialize the python settings, all ranks "
+                     << "execute the settings script.";
+      } else {
+        data = PyTuple_GetItem(result, 0); // borrowed reference
+        Py_INCREF(data);
+        nBytes = PyBytes_Size(data);
+
+        std::vector<std::string> skipped =
+            PythonUtility::convertFromPython<std::vector<std::string>>::get(
+                PyTuple_GetItem(result, 1));
+        if (!skipped.empty()) {
+          LOG(WARNING) << "The following variables of the settings cannot be "
+                       << "transferred to the other ranks: " << skipped;
+        }
+
+        // without the config dict the other ranks cannot use the settings
+        if (std::find(skipped.begin(), skipped.end(), "__main__.config") !=
+            skipped.end()) {
+          LOG(WARNING) << "The variable \"config\" of the settings cannot be "
+                       << "transferred, all ranks execute the settings script.";
+          nBytes = 0;
+        }
+        LOG(DEBUG) << "Serialized python settings: " << nBytes << " bytes.";
+      }
+      Py_CLEAR(result);
+    }
+  }
+
+  // a size of 0 means that the serialization failed or is incomplete
+  MPIUtility::handleReturnValue(
+      MPI_Bcast(&nBytes, 1, MPI_UNSIGNED_LONG_LONG, 0, MPI_COMM_WORLD),
+      "MPI_Bcast");
+
+  bool settingsReceived = true;
+  if (nBytes == 0) {
+    settingsReceived = (ownRankNoCommWorld_ == 0);
+  } else if (ownRankNoCommWorld_ == 0) {
+    broadcastBuffer(PyBytes_AsString(data), nBytes);
+  } else {
+    // receive directly into the memory of a bytes object
+    data = PyBytes_FromStringAndSize(NULL, nBytes);
+    broadcastBuffer(PyBytes_AsString(data), nBytes);
+
+    result = PyObject_CallMethod(helperModule, "deserialize_settings", "(O)",
+                                 data);
+    if (result == NULL) {
+      PythonUtility::checkForError();
+      LOG(WARNING) << "Could not load the python settings from rank 0, "
+                   << "execute the settings script on this rank.";
+      settingsReceived = false;
+    }
+    Py_CLEAR(result);
+  }
+
+  Py_CLEAR(data);
+  Py_CLEAR(helperModule);
+  return settingsReceived;
+}
@@ -220,6 +220,36 @@ void DihuContext::loadPythonScript(std::string text) {
                     0, std::min(std::size_t(80), pythonScriptText_.length()))
              << ")";
 
+  // with the command line option -settings_on_rank_zero, only rank 0 executes
+  // the script and the other ranks get the resulting variables from rank 0
+  PetscBool settingsOnRankZero = PETSC_FALSE;
+  PetscOptionsHasName(NULL, NULL, "-settings_on_rank_zero",
+                      &settingsOnRankZero);
+
+  bool settingsReceived = false;
+  if (settingsOnRankZero && nRanksCommWorld_ > 1)
+    settingsReceived = broadcastPythonSettings();
+
+  if (!settingsReceived)
+    executePythonScript();
+
+  // load main module and extract config
+  PyObject *mainModule = PyImport_AddModule("__main__");
+  PyObject *config = PyObject_GetAttrString(mainModule, "config");
+  VLOG(4) << "create pythonConfig_ (initialize ref to 1)";
+
+  // check if type is valid
+  if (config == NULL || !PyDict_Check(config)) {
+    LOG(FATAL)
+        << "Python config file does not contain a dict named \"config\".";
+  }
+
+  pythonConfig_.setPyObject(config);
+
+  parseGlobalParameters();
+}
+
+void DihuContext::executePythonScript() {
   // execute python code
   int ret = 0;
   std::string errorBuffer;
@@ -304,21 +334,6 @@ void DihuContext::loadPythonScript(std::string text) {
     LOG(INFO) << std::string(37, '-') << "- end python error output -"
               << std::string(37, '-');
   }
-
-  // load main module and extract config
-  PyObject *mainModule = PyImport_AddModule("__main__");
-  PyObject *config = PyObject_GetAttrString(mainModule, "config");
-  VLOG(4) << "create pythonConfig_ (initialize ref to 1)";
-
-  // check if type is valid
-  if (config == NULL || !PyDict_Check(config)) {
-    LOG(FATAL)
-        << "Python config file does not contain a dict named \"config\".";
-  }
-
-  pythonConfig_.setPyObject(config);
-
-  parseGlobalParameters();
 }
 
 void DihuContext::parseGlobalParameters() {
@@ -339,6 +354,29 @@ void DihuContext::parseGlobalParameters() {
     setLogFormat(logFormatCsv);
   }
 
+  // parse options for the trace of all performance measurements
+  if (pythonConfig_.hasKey("traceFile") &&
+      !pythonConfig_.isEmpty("traceFile")) {
+    std::string traceFilename =
+        pythonConfig_.getOptionString("traceFile", "logs/trace");
+    int traceBufferSize = pythonConfig_.getOptionInt(
+        "traceBufferSize", 65536, PythonUtility::Positive);
+
+    Control::PerformanceTrace::setFilenames(traceFilename,
+                                            traceFilename + "_statistics");
+    Control::PerformanceTrace::setEnabled(true, traceBufferSize);
+    LOG(DEBUG) << "Recording performance trace to \"" << traceFilename
+               << "\", buffer size: " << traceBufferSize;
+  }
+
+  // parse if hardware performance counters should be recorded for all
+  // duration measurements
+  if (pythonConfig_.hasKey("hardwareCounters")) {
+    bool hardwareCounters =
+        pythonConfig_.getOptionBool("hardwareCounters", false);
+    Control::HardwareCounters::setEnabled(hardwareCounters);
+  }
+
   // parse all keys under meta and add forward them directly to the log file
   // These parameters are not used by opendihu but can hold information that the
   // user wants to have in the log file.
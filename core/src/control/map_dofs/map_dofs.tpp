@@ -106,10 +106,11 @@ void MapDofs<FunctionSpaceType, NestedSolverType>::performMappings(
                << mapping.connectorSlotNoFrom << " -> "
                << mapping.connectorSlotNosTo << ", " << modeString;
 
-    // static variables for input and output of values
-    static std::map<int, std::vector<double>> valuesToSendToRanks;
+    // static variables for input and output of values, one per thread, because
+    // MapDofs can be part of instances that are computed by multiple threads
+    static thread_local std::map<int, std::vector<double>> valuesToSendToRanks;
     std::vector<double> &inputValues = valuesToSendToRanks[ownRankNo];
-    static std::vector<double> valuesToSet;
+    static thread_local std::vector<double> valuesToSet;
 
     valuesToSet.clear();
     inputValues.clear();
@@ -120,6 +121,9 @@ void MapDofs<FunctionSpaceType, NestedSolverType>::performMappings(
                     mapping.slotConnectorArrayIndexFrom, mapping.inputDofs,
                     inputValues);
 
+      // start critical section for python API calls
+      PythonUtility::GlobalInterpreterLock lock;
+
 #ifndef NDEBUG
       std::string stdoutBuffer;
 
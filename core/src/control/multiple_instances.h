@@ -5,6 +5,7 @@
 #include <functional>
 #include <vector>
 
+#include "easylogging++.h"
 #include "interfaces/runnable.h"
 #include "interfaces/multipliable.h"
 #include "control/dihu_context.h"
@@ -88,6 +89,14 @@ public:
   void restoreFiberDataCheckpoint();
 
 protected:
+  //! disable all log levels except fatal while the instances are computed by
+  //! multiple threads, the easylogging++ library is not built thread-safe
+  void disableLoggingForThreads();
+
+  //! enable the log levels again that were disabled by
+  //! disableLoggingForThreads
+  void restoreLoggingAfterThreads();
+
   DihuContext
       context_; //< the context object that holds the config for this class
   PythonConfig specificSettings_; //< config for this object
@@ -118,9 +127,15 @@ protected:
                                        // object
   std::string logKey_; //< the key under which the duration of all instances
                        // together is saved in the log
+  int logKeyId_;       //< handle of the duration measurement logKey_
 
   bool outputInitializeThisInstance_; //< if this instance displays progress of
                                       // initialization
+  int nThreads_; //< number of threads that compute the local instances in
+                 // advanceTimeSpan, 1 for serial execution
+  std::vector<el::Level>
+      disabledLogLevels_; //< log levels that were disabled by
+                          // disableLoggingForThreads
 };
 
 extern bool outputInitialize_; //< if the message about initialization was
@@ -20,7 +20,7 @@ template <typename TimeSteppingScheme>
 MultipleInstances<TimeSteppingScheme>::MultipleInstances(DihuContext context)
     : context_(context["MultipleInstances"]),
       specificSettings_(context_.getPythonConfig()), data_(context_),
-      outputInitializeThisInstance_(false) {
+      logKeyId_(-1), outputInitializeThisInstance_(false) {
   std::vector<std::string> configKeys;
   specificSettings_.getKeys(configKeys);
   LOG(DEBUG) << "initialize outputWriterManager_, keys: " << configKeys;
@@ -33,6 +33,8 @@ MultipleInstances<TimeSteppingScheme>::MultipleInstances(DihuContext context)
     } else {
       this->logKey_ = specificSettings_.getOptionString("durationLogKey", "");
     }
+    this->logKeyId_ =
+        Control::PerformanceMeasurement::registerMeasurement(this->logKey_);
   }
 
   outputWriterManager_.initialize(context_, specificSettings_);
@@ -44,6 +46,12 @@ MultipleInstances<TimeSteppingScheme>::MultipleInstances(DihuContext context)
   nInstances_ =
       specificSettings_.getOptionInt("nInstances", 1, PythonUtility::Positive);
 
+  // number of threads for the local instances, 0 means all OpenMP threads
+  nThreads_ =
+      specificSettings_.getOptionInt("nThreads", 1, PythonUtility::NonNegative);
+  if (nThreads_ == 0)
+    nThreads_ = omp_get_max_threads();
+
   // parse all instance configs
   std::vector<std::shared_ptr<PythonConfig>> instanceConfigs;
 
@@ -257,18 +265,37 @@ void MultipleInstances<TimeSteppingScheme>::advanceTimeSpan(
 
   // start duration measurement
   if (this->logKey_ != "")
-    Control::PerformanceMeasurement::start(this->logKey_);
+    Control::PerformanceMeasurement::start(this->logKeyId_);
 
   // This method advances the simulation by the specified time span. It will be
   // needed when this MultipleInstances object is part of a parent control
   // element, like a coupling to 3D model.
-  for (int i = 0; i < nInstancesLocal_; i++) {
-    instancesLocal_[i].advanceTimeSpan(withOutputWritersEnabled);
+  if (nThreads_ > 1 && nInstancesLocal_ > 1) {
+    // The instances are independent of each other and are computed by
+    // multiple threads. Python code that is called by the instances, e.g.
+    // callbacks, acquires the GIL in PythonUtility::GlobalInterpreterLock,
+    // therefore the main thread has to release it.
+    PythonUtility::GlobalInterpreterLock::setMultithreaded(true);
+    PyThreadState *mainThreadState = PyEval_SaveThread();
+    disableLoggingForThreads();
+
+#pragma omp parallel for num_threads(nThreads_) schedule(dynamic)
+    for (int i = 0; i < nInstancesLocal_; i++) {
+      instancesLocal_[i].advanceTimeSpan(withOutputWritersEnabled);
+    }
+
+    restoreLoggingAfterThreads();
+    PyEval_RestoreThread(mainThreadState);
+    PythonUtility::GlobalInterpreterLock::setMultithreaded(false);
+  } else {
+    for (int i = 0; i < nInstancesLocal_; i++) {
+      instancesLocal_[i].advanceTimeSpan(withOutputWritersEnabled);
+    }
   }
 
   // stop duration measurement
   if (this->logKey_ != "")
-    Control::PerformanceMeasurement::stop(this->logKey_);
+    Control::PerformanceMeasurement::stop(this->logKeyId_);
 
   LOG(DEBUG) << "multipleInstances::advanceTimeSpan() complete, now call "
                 "writeOutput, hasOutputWriters: "
@@ -280,6 +307,31 @@ void MultipleInstances<TimeSteppingScheme>::advanceTimeSpan(
   }
 }
 
+template <typename TimeSteppingScheme>
+void MultipleInstances<TimeSteppingScheme>::disableLoggingForThreads() {
+  // only levels that are enabled are disabled and later enabled again
+  el::Logger *logger = el::Loggers::getLogger("default");
+  disabledLogLevels_.clear();
+  for (el::Level level :
+       {el::Level::Info, el::Level::Debug, el::Level::Verbose, el::Level::Trace,
+        el::Level::Warning, el::Level::Error}) {
+    if (logger->typedConfigurations()->enabled(level)) {
+      disabledLogLevels_.push_back(level);
+      el::Loggers::reconfigureAllLoggers(level, el::ConfigurationType::Enabled,
+                                         "false");
+    }
+  }
+}
+
+template <typename TimeSteppingScheme>
+void MultipleInstances<TimeSteppingScheme>::restoreLoggingAfterThreads() {
+  for (el::Level level : disabledLogLevels_) {
+    el::Loggers::reconfigureAllLoggers(level, el::ConfigurationType::Enabled,
+                                       "true");
+  }
+  disabledLogLevels_.clear();
+}
+
 template <typename TimeSteppingScheme>
 void MultipleInstances<TimeSteppingScheme>::setTimeSpan(double startTime,
                                                         double endTime) {
@@ -358,6 +410,50 @@ void MultipleInstances<TimeSteppingScheme>::initialize() {
 
   DihuContext::solverStructureVisualizer()->enable();
 
+  // check if the local instances can be computed by multiple threads
+  if (nThreads_ > 1) {
+    int mpiThreadSupport;
+    MPI_Query_thread(&mpiThreadSupport);
+
+    // instances that are computed on multiple ranks would need the same order
+    // of execution on all their ranks, otherwise their communication could
+    // deadlock
+    bool allInstancesSerial = true;
+    for (int i = 0; i < nInstancesLocal_; i++) {
+      if (rankSubsetsLocal_[i]->size() > 1)
+        allInstancesSerial = false;
+    }
+
+    // MPI_THREAD_MULTIPLE is only requested if OMP_NUM_THREADS is not 1
+    if (mpiThreadSupport < MPI_THREAD_MULTIPLE) {
+      LOG(WARNING) << "MultipleInstances: \"nThreads\" is " << nThreads_
+                   << ", but the MPI library does not provide "
+                   << "MPI_THREAD_MULTIPLE or only one OpenMP thread is "
+                   << "available. The instances are computed serially.";
+      nThreads_ = 1;
+    }
+#if defined(PETSC_USE_DEBUG) && !defined(PETSC_HAVE_THREADSAFETY)
+    // the debug build of PETSc keeps a global stack of the called functions
+    else if (nThreads_ > 1) {
+      LOG(WARNING) << "MultipleInstances: \"nThreads\" is " << nThreads_
+                   << ", but PETSc is a debug build that is not thread-safe. "
+                   << "The instances are computed serially.";
+      nThreads_ = 1;
+    }
+#endif
+    else if (!allInstancesSerial) {
+      LOG(WARNING) << "MultipleInstances: \"nThreads\" is " << nThreads_
+                   << ", but not all local instances are computed only on "
+                   << "the own rank. The instances are computed serially.";
+      nThreads_ = 1;
+    } else {
+      LOG(DEBUG) << "MultipleInstances: compute " << nInstancesLocal_
+                 << " local instances with " << nThreads_ << " threads.";
+    }
+  }
+  PerformanceMeasurement::setParameter("nThreadsMultipleInstances",
+                                       nThreads_);
+
   // end output of progress
   if (outputInitializeThisInstance_ && this->context_.ownRankNo() == 0) {
     std::cout << "\b\b\b\bdone." << std::endl;
@@ -7,6 +7,9 @@
 
 //! constructor from python object
 PythonConfig::PythonConfig(PyObject *specificSettings) {
+  // start critical section for python API calls
+  PythonUtility::GlobalInterpreterLock lock;
+
   pythonConfig_ = specificSettings;
   VLOG(1) << "PythonConfig::constructor "
           << PythonUtility::getString(pythonConfig_);
@@ -15,6 +18,9 @@ PythonConfig::PythonConfig(PyObject *specificSettings) {
 
 //! constructor as sub scope of another python config
 PythonConfig::PythonConfig(const PythonConfig &rhs, std::string key) {
+  // start critical section for python API calls
+  PythonUtility::GlobalInterpreterLock lock;
+
   pythonConfig_ = rhs.getOptionPyObject(key);
   VLOG(1) << "PythonConfig::constructor(rhs,key=\"" << key << "\") "
           << PythonUtility::getString(pythonConfig_);
@@ -28,6 +34,9 @@ PythonConfig::PythonConfig(const PythonConfig &rhs, std::string key) {
 
 //! constructor as sub scope of another python config which is a list
 PythonConfig::PythonConfig(const PythonConfig &rhs, int i) {
+  // start critical section for python API calls
+  PythonUtility::GlobalInterpreterLock lock;
+
   // store updated path
   int pathSize = std::distance(rhs.pathBegin(), rhs.pathEnd());
   path_.resize(pathSize + 1);
@@ -55,6 +64,9 @@ PythonConfig::PythonConfig(const PythonConfig &rhs, int i) {
 //! constructor directly from PyObject*, path from rhs + key
 PythonConfig::PythonConfig(const PythonConfig &rhs, std::string key,
                            PyObject *config, int listIndex) {
+  // start critical section for python API calls
+  PythonUtility::GlobalInterpreterLock lock;
+
   pythonConfig_ = config;
   VLOG(1) << "PythonConfig::constructor(rhs,key=\"" << key << "\",config) "
           << PythonUtility::getString(pythonConfig_);
@@ -77,6 +89,9 @@ PythonConfig::PythonConfig(const PythonConfig &rhs, std::string key,
 //! constructor directly from PyObject*, path from rhs + key
 PythonConfig::PythonConfig(const PythonConfig &rhs, std::string key,
                            std::string key2, PyObject *config) {
+  // start critical section for python API calls
+  PythonUtility::GlobalInterpreterLock lock;
+
   pythonConfig_ = config;
   VLOG(1) << "PythonConfig::constructor(rhs,key=\"" << key << "\",config) "
           << PythonUtility::getString(pythonConfig_);
@@ -94,6 +109,9 @@ PythonConfig::~PythonConfig() {
 }
 
 PythonConfig &PythonConfig::operator=(const PythonConfig &rhs) {
+  // start critical section for python API calls
+  PythonUtility::GlobalInterpreterLock lock;
+
   pythonConfig_ = rhs.pythonConfig_;
   VLOG(1) << "PythonConfig::operator=(rhs)"
           << PythonUtility::getString(pythonConfig_);
@@ -109,6 +127,9 @@ PythonConfig &PythonConfig::operator=(const PythonConfig &rhs) {
 PyObject *PythonConfig::pyObject() const { return pythonConfig_; }
 
 void PythonConfig::setPyObject(PyObject *pyObject) {
+  // start critical section for python API calls
+  PythonUtility::GlobalInterpreterLock lock;
+
   pythonConfig_ = pyObject;
   Py_XINCREF(pythonConfig_);
 }
@@ -0,0 +1,175 @@
+#include "control/stimulation/stimulation_schedule.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+
+#include "easylogging++.h"
+#include "utility/mpi_utility.h"
+
+namespace Control {
+
+StimulationSchedule::StimulationSchedule() : nEvents_(0) {}
+
+void StimulationSchedule::load(std::string filename, MPI_Comm mpiCommunicator,
+                               double defaultDuration,
+                               const std::vector<double> &jitter) {
+  events_.clear();
+  nEvents_ = 0;
+
+  std::string fileContents = MPIUtility::loadFile(filename, mpiCommunicator);
+
+  // the binary format is identified by its header
+  const std::string binaryHeader = "DIHUSTIM";
+  if (fileContents.compare(0, binaryHeader.size(), binaryHeader) == 0) {
+    parseBinary(fileContents);
+  } else {
+    parseText(fileContents, defaultDuration);
+  }
+
+  for (std::vector<Event> &events : events_) {
+    // sort the events by start time, this is the order in which the jitter
+    // values are applied
+    std::stable_sort(events.begin(), events.end(),
+                     [](const Event &a, const Event &b) {
+                       return a.startTime < b.startTime;
+                     });
+
+    if (!jitter.empty()) {
+      for (std::size_t eventNo = 0; eventNo < events.size(); eventNo++) {
+        double offset = jitter[eventNo % jitter.size()];
+        events[eventNo].startTime += offset;
+        events[eventNo].endTime += offset;
+      }
+
+      std::sort(events.begin(), events.end(),
+                [](const Event &a, const Event &b) {
+                  return a.startTime < b.startTime;
+                });
+    }
+
+    // merge overlapping events, then also the end times are sorted
+    std::vector<Event> mergedEvents;
+    for (const Event &event : events) {
+      if (!mergedEvents.empty() &&
+          event.startTime <= mergedEvents.back().endTime) {
+        mergedEvents.back().endTime =
+            std::max(mergedEvents.back().endTime, event.endTime);
+      } else {
+        mergedEvents.push_back(event);
+      }
+    }
+    events.swap(mergedEvents);
+    nEvents_ += events.size();
+  }
+
+  LOG(DEBUG) << "Loaded stimulation schedule \"" << filename << "\" with "
+             << nEvents_ << " events for " << events_.size() << " motor units.";
+}
+
+void StimulationSchedule::parseText(const std::string &fileContents,
+                                    double defaultDuration) {
+  std::istringstream file(fileContents);
+  std::string line;
+  int lineNo = 0;
+
+  while (std::getline(file, line)) {
+    lineNo++;
+
+    // skip empty lines and comments
+    std::size_t pos = line.find_first_not_of(" \t\r");
+    if (pos == std::string::npos || line[pos] == '#')
+      continue;
+
+    std::istringstream lineStream(line);
+    int motorUnitNo = 0;
+    double startTime = 0;
+    double duration = defaultDuration;
+
+    if (!(lineStream >> motorUnitNo >> startTime)) {
+      LOG(ERROR) << "Could not parse line " << lineNo
+                 << " of stimulation schedule: \"" << line
+                 << "\", expected \"<motorUnitNo> <startTime> [<duration>]\".";
+      continue;
+    }
+    lineStream >> duration;
+
+    addEvent(motorUnitNo, startTime, duration);
+  }
+}
+
+void StimulationSchedule::parseBinary(const std::string &fileContents) {
+  const std::size_t headerSize = 8;
+  const std::size_t eventSize = sizeof(int32_t) + 2 * sizeof(double);
+
+  int32_t nEvents = 0;
+  if (fileContents.size() >= headerSize + sizeof(int32_t))
+    memcpy(&nEvents, fileContents.data() + headerSize, sizeof(int32_t));
+
+  std::size_t expectedSize = headerSize + sizeof(int32_t) + nEvents * eventSize;
+  if (nEvents < 0 || fileContents.size() < expectedSize) {
+    LOG(FATAL) << "Binary stimulation schedule is truncated, it has "
+               << fileContents.size() << " bytes, but " << expectedSize
+               << " bytes are needed for " << nEvents << " events.";
+  }
+
+  const char *data = fileContents.data() + headerSize + sizeof(int32_t);
+  for (int32_t eventNo = 0; eventNo < nEvents; eventNo++) {
+    int32_t motorUnitNo;
+    double startTime, duration;
+    memcpy(&motorUnitNo, data, sizeof(int32_t));
+    memcpy(&startTime, data + sizeof(int32_t), sizeof(double));
+    memcpy(&duration, data + sizeof(int32_t) + sizeof(double), sizeof(double));
+    data += eventSize;
+
+    addEvent(motorUnitNo, startTime, duration);
+  }
+}
+
+void StimulationSchedule::addEvent(int motorUnitNo, double startTime,
+                                   double duration) {
+  if (motorUnitNo < 0) {
+    LOG(ERROR) << "Stimulation schedule contains an event for motor unit "
+               << motorUnitNo << ", motor unit numbers must not be negative.";
+    return;
+  }
+
+  if (motorUnitNo >= (int)events_.size())
+    events_.resize(motorUnitNo + 1);
+
+  Event event;
+  event.startTime = startTime;
+  event.endTime = startTime + duration;
+  events_[motorUnitNo].push_back(event);
+}
+
+bool StimulationSchedule::empty() const { return nEvents_ == 0; }
+
+int StimulationSchedule::nEvents() const { return nEvents_; }
+
+bool StimulationSchedule::isStimulated(int motorUnitNo, double currentTime,
+                                       std::size_t &eventIndex) const {
+  if (motorUnitNo < 0 || motorUnitNo >= (int)events_.size())
+    return false;
+
+  const std::vector<Event> &events = events_[motorUnitNo];
+  if (eventIndex > events.size())
+    eventIndex = events.size();
+
+  // go back if the time was reset, e.g. when the next point is computed
+  while (eventIndex > 0 && events[eventIndex - 1].endTime > currentTime)
+    eventIndex--;
+
+  // skip events that are already over
+  while (eventIndex < events.size() &&
+         events[eventIndex].endTime <= currentTime)
+    eventIndex++;
+
+  if (eventIndex == events.size())
+    return false;
+
+  return events[eventIndex].startTime <= currentTime + 1e-13;
+}
+
+} // namespace Control
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <Python.h> // has to be the first included header
+#include <mpi.h>
+#include <string>
+#include <vector>
+
+namespace Control {
+
+/** A precomputed list of stimulation events for every motor unit. This is an
+ * alternative to the setSpecificStates callback function and the firing times
+ * file, the stimulation is then decided without calling python code.
+ *
+ *  The schedule is loaded from a text or binary file. The text file contains
+ * one event per line, "<motorUnitNo> <startTime> [<duration>]", lines starting
+ * with # are comments. If the duration is omitted, the default duration is
+ * used. The binary file starts with the 8 characters "DIHUSTIM", followed by
+ * the number of events as int32 and then for every event the motor unit no as
+ * int32, the start time and the duration as float64.
+ *
+ *  The events of every motor unit are sorted by start time. A caller keeps an
+ * event index per motor unit, which is advanced while the time progresses,
+ * such that every query takes amortized constant time.
+ */
+class StimulationSchedule {
+public:
+  //! constructor, creates an empty schedule
+  StimulationSchedule();
+
+  //! load the schedule from a text or binary file, the file is read
+  //! collectively by all ranks of mpiCommunicator. The jitter values [ms] are
+  //! added cyclically to the start times of consecutive events of each motor
+  //! unit.
+  void load(std::string filename, MPI_Comm mpiCommunicator,
+            double defaultDuration, const std::vector<double> &jitter);
+
+  //! if no events were loaded
+  bool empty() const;
+
+  //! number of events of all motor units
+  int nEvents() const;
+
+  //! if the given motor unit is stimulated at currentTime, i.e. currentTime is
+  //! in [startTime, startTime + duration) of one of its events. eventIndex is
+  //! the index of the event to check first, it is updated for the next call
+  //! and should initially be 0.
+  bool isStimulated(int motorUnitNo, double currentTime,
+                    std::size_t &eventIndex) const;
+
+protected:
+  //! parse the file contents in text format
+  void parseText(const std::string &fileContents, double defaultDuration);
+
+  //! parse the file contents in binary format
+  void parseBinary(const std::string &fileContents);
+
+  //! add an event to the list of the motor unit
+  void addEvent(int motorUnitNo, double startTime, double duration);
+
+  struct Event {
+    double startTime; //< time when the stimulation begins
+    double endTime;   //< time when the stimulation is over
+  };
+
+  std::vector<std::vector<Event>>
+      events_; //< for every motor unit the events, sorted by start time
+  int nEvents_; //< number of events of all motor units
+};
+
+} // namespace Control
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <Python.h> // has to be the first included header
+#include <petscmat.h>
+#include <memory>
+#include <vector>
+
+#include "control/types.h"
+#include "mesh/mesh.h"
+#include "data_management/data.h"
+#include "data_management/time_stepping/time_stepping.h"
+#include "field_variable/field_variable.h"
+
+namespace Data {
+
+/**  The datastructures used for multi-stage timestepping schemes like
+ * SspRungeKutta3 and RungeKuttaChebyshev, store all data as of timestepping
+ * schemes and a given number of additional stage vectors.
+ */
+template <typename FunctionSpaceType, int nComponents>
+class TimeSteppingMultiStage
+    : public TimeStepping<FunctionSpaceType, nComponents> {
+public:
+  typedef FieldVariable::FieldVariable<FunctionSpaceType, nComponents>
+      FieldVariableType;
+
+  //! constructor, nStageVectors is the number of additional vectors
+  TimeSteppingMultiStage(DihuContext context, int nStageVectors);
+
+  //! return a reference to the stage vector with the given number, the PETSc
+  //! Vec can be obtained via fieldVariable->valuesGlobal()
+  std::shared_ptr<FieldVariableType> stage(int stageNo);
+
+  //! print all stored data to stdout
+  void print() override;
+
+private:
+  //! initializes the vectors with size
+  void createPetscObjects() override;
+
+  int nStageVectors_; //< the number of additional stage vectors
+  std::vector<std::shared_ptr<FieldVariableType>>
+      stages_; //< the additional vectors for intermediate stages
+};
+
+} // namespace Data
+
+#include "data_management/time_stepping/time_stepping_multi_stage.tpp"
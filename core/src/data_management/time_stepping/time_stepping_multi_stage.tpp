@@ -0,0 +1,59 @@
+#include "data_management/time_stepping/time_stepping_multi_stage.h"
+
+#include <sstream>
+#include <memory>
+
+#include "easylogging++.h"
+
+#include "control/dihu_context.h"
+
+namespace Data {
+
+template <typename FunctionSpaceType, int nComponents>
+TimeSteppingMultiStage<FunctionSpaceType, nComponents>::TimeSteppingMultiStage(
+    DihuContext context, int nStageVectors)
+    : TimeStepping<FunctionSpaceType, nComponents>::TimeStepping(context),
+      nStageVectors_(nStageVectors) {
+  this->debuggingName_ = "multiStage";
+}
+
+template <typename FunctionSpaceType, int nComponents>
+void TimeSteppingMultiStage<FunctionSpaceType,
+                            nComponents>::createPetscObjects() {
+  TimeStepping<FunctionSpaceType, nComponents>::createPetscObjects();
+
+  LOG(DEBUG) << "TimeSteppingMultiStage<FunctionSpaceType,nComponents>::"
+             << "createPetscObjects(" << nComponents << "), "
+             << nStageVectors_ << " stage vectors";
+
+  stages_.resize(nStageVectors_);
+  for (int stageNo = 0; stageNo < nStageVectors_; stageNo++) {
+    std::stringstream name;
+    name << "stage" << stageNo;
+    stages_[stageNo] =
+        this->functionSpace_->template createFieldVariable<nComponents>(
+            name.str());
+  }
+}
+
+template <typename FunctionSpaceType, int nComponents>
+std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceType, nComponents>>
+TimeSteppingMultiStage<FunctionSpaceType, nComponents>::stage(int stageNo) {
+  assert(stageNo >= 0 && stageNo < (int)stages_.size());
+  return stages_[stageNo];
+}
+
+template <typename FunctionSpaceType, int nComponents>
+void TimeSteppingMultiStage<FunctionSpaceType, nComponents>::print() {
+  if (!VLOG_IS_ON(4))
+    return;
+
+  VLOG(4) << "======================";
+  for (std::shared_ptr<FieldVariableType> &stage : stages_)
+    VLOG(4) << *stage;
+  VLOG(4) << *this->increment_;
+  VLOG(4) << *this->solution_;
+  VLOG(4) << "======================";
+}
+
+} // namespace Data
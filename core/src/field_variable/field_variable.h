@@ -1,6 +1,7 @@
 #pragma once
 
 #include "field_variable/09_field_variable_composite.h"
+#include "field_variable/values_view.h"
 
 namespace FieldVariable {
 
@@ -63,6 +64,11 @@ public:
 
   //! check if the field variable contains Nan or Inf values
   bool containsNanOrInf();
+
+  //! get direct array access to the local values including ghosts, to gather
+  //! and scatter element values without VecGetValues/VecSetValues. The field
+  //! variable must not be accessed otherwise until the view is destroyed.
+  ValuesView<FunctionSpaceType, nComponents> valuesView(bool writable = false);
 };
 
 // output operator
@@ -113,4 +113,10 @@ bool FieldVariable<FunctionSpaceType, nComponents>::containsNanOrInf() {
   return false;
 }
 
+template <typename FunctionSpaceType, int nComponents>
+ValuesView<FunctionSpaceType, nComponents>
+FieldVariable<FunctionSpaceType, nComponents>::valuesView(bool writable) {
+  return ValuesView<FunctionSpaceType, nComponents>(*this, writable);
+}
+
 } // namespace FieldVariable
@@ -640,10 +640,10 @@ void FieldVariableData<
   } lineType = nothing;
 
   // loop over file content line-wise
-  unsigned int pos = 0;
+  std::size_t pos = 0;
   while (pos < content.size()) {
     // extract next line
-    unsigned int posNewline = content.find("\n", pos);
+    std::size_t posNewline = content.find("\n", pos);
     std::string line = content.substr(pos, posNewline - pos);
     if (posNewline == std::string::npos)
       pos = content.size();
@@ -773,16 +773,7 @@ void FieldVariableData<
     // values
     if (lineType == valuesFollow) {
       VLOG(2) << "valuesFollow";
-      trim(line);
-      while (!line.empty()) {
-        blockValues.push_back(atof(line.c_str()));
-        // proceed to next number
-        if (line.find(" ") != std::string::npos) {
-          extractUntil(line, " ");
-          trim(line);
-        } else
-          break;
-      }
+      appendNumbers(line, blockValues);
       VLOG(2) << "extract values block " << blockValues;
     }
   } // while
@@ -239,6 +239,33 @@ std::shared_ptr<NodeToDofMapping> ElementToDofMapping::setup(
   return nodeToDofMapping;
 }
 
+void ElementToDofMapping::renumberDofsNodeWise(
+    std::shared_ptr<NodeToDofMapping> nodeToDofMapping) {
+  // new dof no for every previous dof no
+  std::vector<dof_no_t> newDofNos(nDofs_, -1);
+  dof_no_t dofNo = 0;
+
+  // loop over nodes and assign new dof nos in the order of the nodes
+  for (node_no_t nodeNo = 0; nodeNo < nodeToDofMapping->nNodes(); nodeNo++) {
+    if (!nodeToDofMapping->containsNode(nodeNo)) {
+      LOG(FATAL) << "Node " << nodeNo << " is not contained in any element!";
+    }
+
+    for (dof_no_t &nodeDofNo : nodeToDofMapping->getNodeDofs(nodeNo)) {
+      assert(newDofNos[nodeDofNo] == -1);
+      newDofNos[nodeDofNo] = dofNo++;
+      nodeDofNo = newDofNos[nodeDofNo];
+    }
+  }
+  assert(dofNo == nDofs_);
+
+  // update the dofs of the elements
+  for (std::vector<dof_no_t> &elementDofs : elementDofs_) {
+    for (dof_no_t &elementDofNo : elementDofs)
+      elementDofNo = newDofNos[elementDofNo];
+  }
+}
+
 dof_no_t ElementToDofMapping::nDofsLocal() const { return nDofs_; }
 
 element_no_t ElementToDofMapping::nElementsLocal() const {
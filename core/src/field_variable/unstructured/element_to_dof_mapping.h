@@ -30,6 +30,12 @@ public:
         std::shared_ptr<ElementToNodeMapping> elementToNodeMapping,
         const int nDofsPerNode);
 
+  //! change the dof numbering such that the dofs of node 0 come first, then
+  //! those of node 1 etc., this is needed for distributed meshes where the
+  //! non-ghost nodes have the lowest local numbers, the nodes have to be
+  //! numbered contiguously
+  void renumberDofsNodeWise(std::shared_ptr<NodeToDofMapping> nodeToDofMapping);
+
   //! get all dofs of an element
   const std::vector<dof_no_t> &
   getElementDofs(element_no_t elementGlobalNo) const;
@@ -54,37 +54,20 @@ void ElementToNodeMapping::parseElementFromExelemFile(std::string content) {
     }
 
     if (nodesFollow) {
-      trim(line);
       VLOG(2) << "parse line with nodes: [" << line << "]";
 
-      while (!line.empty()) {
-        node_no_t nodeGlobalNo = atoi(line.c_str()) - 1;
-        // VLOG(2) << "       node: " << nodeGlobalNo;
-        elements_[elementNo].nodeGlobalNo.push_back(nodeGlobalNo);
-
-        // proceed to next number
-        if (line.find(" ") != std::string::npos) {
-          extractUntil(line, " ");
-          trim(line);
-        } else
-          break;
-      }
+      // the node numbers in the file start with 1
+      std::vector<int> &nodeGlobalNos = elements_[elementNo].nodeGlobalNo;
+      const std::size_t nNodesBefore = nodeGlobalNos.size();
+      appendNumbers(line, nodeGlobalNos);
+      for (std::size_t i = nNodesBefore; i < nodeGlobalNos.size(); i++)
+        nodeGlobalNos[i]--;
+
       nodesFollow = false;
     }
 
     if (scaleFactorsFollow) {
-      trim(line);
-      while (!line.empty()) {
-        double scaleFactor = atof(line.c_str());
-        // VLOG(2) << "       scaleFactor: " << scaleFactor;
-        elements_[elementNo].scaleFactors.push_back(scaleFactor);
-        // proceed to next number
-        if (line.find(" ") != std::string::npos) {
-          extractUntil(line, " ");
-          trim(line);
-        } else
-          break;
-      }
+      appendNumbers(line, elements_[elementNo].scaleFactors);
     }
   }
 }
@@ -12,12 +12,6 @@ using namespace StringUtility;
 void ExfileRepresentation::parseHeaderFromExelemFile(std::string content) {
   VLOG(1) << "ExfileRepresentation::parseHeaderFromExelemFile";
 
-  std::stringstream str;
-  for (unsigned int i = 0; i < representation_.size(); i++) {
-    str << representation_[i];
-  }
-  VLOG(1) << str.str();
-
   currentElementRepresentation_ =
       std::make_shared<ExfileElementRepresentation>();
   currentElementRepresentation_->parseFromExelemFile(content);
@@ -26,12 +20,14 @@ void ExfileRepresentation::parseHeaderFromExelemFile(std::string content) {
 
   // replace by earlier representation object if there exists one that is equal
   // to the just created one
+  // consecutive elements mostly share the same object, compare it only once
+  ExfileElementRepresentation *previousRepresentation = nullptr;
   for (std::vector<std::shared_ptr<ExfileElementRepresentation>>::iterator
            iter = representation_.begin();
        iter != representation_.end(); iter++) {
 
-    VLOG(1) << "." << (*iter) << "-" << currentElementRepresentation_;
-    if (*iter != nullptr) {
+    if (*iter != nullptr && iter->get() != previousRepresentation) {
+      previousRepresentation = iter->get();
       if (**iter == *currentElementRepresentation_) {
         currentElementRepresentation_ = *iter;
         break;
@@ -41,17 +37,12 @@ void ExfileRepresentation::parseHeaderFromExelemFile(std::string content) {
 }
 
 void ExfileRepresentation::parseElementFromExelemFile(std::string content) {
-  VLOG(1) << "ExfileRepresentation::parseElementFromExelemFile ";
-  std::stringstream str;
-  for (unsigned int i = 0; i < representation_.size(); i++) {
-    str << representation_[i];
-  }
-  VLOG(1) << str.str();
+  VLOG(2) << "ExfileRepresentation::parseElementFromExelemFile ";
 
   // parse element no
   int elementNo = getNumberAfterString(content, "Element:") - 1;
-  if ((element_no_t)representation_.size() < elementNo)
-    representation_.resize(elementNo);
+  if ((element_no_t)representation_.size() <= elementNo)
+    representation_.resize(elementNo + 1);
 
   VLOG(1) << " assign current representation for element " << elementNo;
   assert(currentElementRepresentation_);
@@ -95,15 +86,26 @@ void ExfileRepresentation::unifyExfileElementRepresentations() {
   if (representation_.size() < 2)
     return;
 
-  for (element_no_t elementGlobalNo1 = 0;
-       elementGlobalNo1 < representation_.size() - 1; elementGlobalNo1++) {
-    for (element_no_t elementGlobalNo2 = elementGlobalNo1 + 1;
-         elementGlobalNo2 < representation_.size(); elementGlobalNo2++) {
-      if (*representation_[elementGlobalNo1] ==
-          *representation_[elementGlobalNo2]) {
-        representation_[elementGlobalNo2] = representation_[elementGlobalNo1];
+  // compare every element only to the distinct representations found so far,
+  // there are usually only very few of them
+  std::vector<std::shared_ptr<ExfileElementRepresentation>>
+      uniqueRepresentations;
+  for (std::shared_ptr<ExfileElementRepresentation> &representation :
+       representation_) {
+    assert(representation);
+
+    bool found = false;
+    for (std::shared_ptr<ExfileElementRepresentation> &uniqueRepresentation :
+         uniqueRepresentations) {
+      if (representation == uniqueRepresentation ||
+          *representation == *uniqueRepresentation) {
+        representation = uniqueRepresentation;
+        found = true;
+        break;
       }
     }
+    if (!found)
+      uniqueRepresentations.push_back(representation);
   }
 }
 
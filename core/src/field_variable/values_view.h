@@ -0,0 +1,93 @@
+#pragma once
+
+#include <Python.h> // has to be the first included header
+
+#include <array>
+#include <memory>
+#include <vector>
+#include <petscvec.h>
+
+#include "control/types.h"
+
+namespace FieldVariable {
+
+// forward declaration
+template <typename FunctionSpaceType, int nComponents> class FieldVariable;
+
+/** Direct array access to the local values of a field variable, including the
+ * ghost values, without calling VecGetValues or VecSetValues for every element.
+ * The constructor gets the arrays of the local PETSc Vecs of all components,
+ * the destructor restores them. While the view exists, the field variable must
+ * not be accessed otherwise.
+ *
+ *  Element values are gathered and scattered using the element-to-dof table
+ * of the function space. The ghost values are only up to date if
+ * startGhostManipulation() was called before the view was created. After
+ * writing to a view, finishGhostManipulation() has to be called to
+ * communicate the ghost values.
+ */
+template <typename FunctionSpaceType, int nComponents> class ValuesView {
+public:
+  //! the values of all dofs of an element for all components
+  typedef std::array<std::array<double, nComponents>,
+                     FunctionSpaceType::nDofsPerElement()>
+      ElementValues;
+
+  //! constructor, get the arrays of the local vectors, read-only if writable
+  //! is false
+  ValuesView(FieldVariable<FunctionSpaceType, nComponents> &fieldVariable,
+             bool writable);
+
+  //! move constructor, rhs is no longer valid afterwards
+  ValuesView(ValuesView &&rhs);
+
+  //! the arrays can only be restored once, therefore no copies are allowed
+  ValuesView(const ValuesView &rhs) = delete;
+  ValuesView &operator=(const ValuesView &rhs) = delete;
+
+  //! destructor, restore the arrays
+  ~ValuesView();
+
+  //! number of local dofs including ghosts, i.e. the size of every component
+  //! array
+  dof_no_t nDofsLocalWithGhosts() const;
+
+  //! get the local values of a component, in local dof numbering
+  const double *values(int componentNo) const;
+
+  //! get the local values of a component for writing, the view has to be
+  //! writable
+  double *values(int componentNo);
+
+  //! gather the values of all dofs of a local element
+  void getElementValues(element_no_t elementNoLocal,
+                        ElementValues &values) const;
+
+  //! scatter values to all dofs of a local element, the view has to be
+  //! writable, petscInsertMode is INSERT_VALUES or ADD_VALUES
+  void setElementValues(element_no_t elementNoLocal,
+                        const ElementValues &values,
+                        InsertMode petscInsertMode = INSERT_VALUES);
+
+  //! gather the values of all local elements into buffer in structure of
+  //! arrays layout, such that consecutive elements are contiguous in memory.
+  //! The value of component componentNo at dof dofIndex of element elementNo
+  //! is stored at buffer[(componentNo*nDofsPerElement + dofIndex)*nElements +
+  //! elementNo].
+  void getAllElementValues(std::vector<double> &buffer) const;
+
+private:
+  std::array<Vec, nComponents> vectors_; //< the local vectors of the components
+  std::array<double *, nComponents>
+      arrays_; //< the arrays of the local vectors
+  const std::vector<dof_no_t>
+      *elementDofNos_;      //< the element-to-dof table of the function space
+  element_no_t nElements_;  //< number of local elements
+  dof_no_t nDofs_;          //< number of local dofs including ghosts
+  bool writable_;           //< if the arrays were obtained by VecGetArray
+  bool isValid_;            //< false after the view was moved
+};
+
+} // namespace FieldVariable
+
+#include "field_variable/values_view.tpp"
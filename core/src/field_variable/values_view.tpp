@@ -0,0 +1,152 @@
+#include "field_variable/values_view.h"
+
+#include <cassert>
+
+#include "easylogging++.h"
+
+namespace FieldVariable {
+
+template <typename FunctionSpaceType, int nComponents>
+ValuesView<FunctionSpaceType, nComponents>::ValuesView(
+    FieldVariable<FunctionSpaceType, nComponents> &fieldVariable,
+    bool writable)
+    : writable_(writable), isValid_(true) {
+  if (!fieldVariable.partitionedPetscVec()) {
+    LOG(FATAL) << "Field variable \"" << fieldVariable.name()
+               << "\" has no values vector, cannot create a ValuesView.";
+  }
+
+  std::shared_ptr<FunctionSpaceType> functionSpace =
+      fieldVariable.functionSpace();
+  elementDofNos_ = &functionSpace->elementDofNosLocalTable();
+  nElements_ = functionSpace->nElementsLocal();
+  nDofs_ = functionSpace->nDofsLocalWithGhosts();
+
+  for (int componentNo = 0; componentNo < nComponents; componentNo++) {
+    vectors_[componentNo] =
+        fieldVariable.partitionedPetscVec()->valuesLocal(componentNo);
+
+    PetscErrorCode ierr;
+    if (writable_) {
+      ierr = VecGetArray(vectors_[componentNo], &arrays_[componentNo]);
+    } else {
+      ierr = VecGetArrayRead(vectors_[componentNo],
+                             (const double **)&arrays_[componentNo]);
+    }
+    CHKERRABORT(PETSC_COMM_SELF, ierr);
+  }
+}
+
+template <typename FunctionSpaceType, int nComponents>
+ValuesView<FunctionSpaceType, nComponents>::ValuesView(ValuesView &&rhs)
+    : vectors_(rhs.vectors_), arrays_(rhs.arrays_),
+      elementDofNos_(rhs.elementDofNos_), nElements_(rhs.nElements_),
+      nDofs_(rhs.nDofs_), writable_(rhs.writable_), isValid_(rhs.isValid_) {
+  rhs.isValid_ = false;
+}
+
+template <typename FunctionSpaceType, int nComponents>
+ValuesView<FunctionSpaceType, nComponents>::~ValuesView() {
+  if (!isValid_)
+    return;
+
+  for (int componentNo = 0; componentNo < nComponents; componentNo++) {
+    PetscErrorCode ierr;
+    if (writable_) {
+      ierr = VecRestoreArray(vectors_[componentNo], &arrays_[componentNo]);
+    } else {
+      ierr = VecRestoreArrayRead(vectors_[componentNo],
+                                 (const double **)&arrays_[componentNo]);
+    }
+    CHKERRABORT(PETSC_COMM_SELF, ierr);
+  }
+}
+
+template <typename FunctionSpaceType, int nComponents>
+dof_no_t
+ValuesView<FunctionSpaceType, nComponents>::nDofsLocalWithGhosts() const {
+  return nDofs_;
+}
+
+template <typename FunctionSpaceType, int nComponents>
+const double *
+ValuesView<FunctionSpaceType, nComponents>::values(int componentNo) const {
+  assert(isValid_);
+  assert(componentNo >= 0 && componentNo < nComponents);
+  return arrays_[componentNo];
+}
+
+template <typename FunctionSpaceType, int nComponents>
+double *ValuesView<FunctionSpaceType, nComponents>::values(int componentNo) {
+  assert(isValid_);
+  assert(writable_);
+  assert(componentNo >= 0 && componentNo < nComponents);
+  return arrays_[componentNo];
+}
+
+template <typename FunctionSpaceType, int nComponents>
+void ValuesView<FunctionSpaceType, nComponents>::getElementValues(
+    element_no_t elementNoLocal, ElementValues &values) const {
+  assert(isValid_);
+  assert(elementNoLocal >= 0 && elementNoLocal < nElements_);
+
+  const int nDofsPerElement = FunctionSpaceType::nDofsPerElement();
+  const dof_no_t *dofNos =
+      elementDofNos_->data() + elementNoLocal * nDofsPerElement;
+
+  for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++) {
+    for (int componentNo = 0; componentNo < nComponents; componentNo++) {
+      values[dofIndex][componentNo] = arrays_[componentNo][dofNos[dofIndex]];
+    }
+  }
+}
+
+template <typename FunctionSpaceType, int nComponents>
+void ValuesView<FunctionSpaceType, nComponents>::setElementValues(
+    element_no_t elementNoLocal, const ElementValues &values,
+    InsertMode petscInsertMode) {
+  assert(isValid_);
+  assert(writable_);
+  assert(elementNoLocal >= 0 && elementNoLocal < nElements_);
+  assert(petscInsertMode == INSERT_VALUES || petscInsertMode == ADD_VALUES);
+
+  const int nDofsPerElement = FunctionSpaceType::nDofsPerElement();
+  const dof_no_t *dofNos =
+      elementDofNos_->data() + elementNoLocal * nDofsPerElement;
+
+  for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++) {
+    for (int componentNo = 0; componentNo < nComponents; componentNo++) {
+      if (petscInsertMode == ADD_VALUES)
+        arrays_[componentNo][dofNos[dofIndex]] += values[dofIndex][componentNo];
+      else
+        arrays_[componentNo][dofNos[dofIndex]] = values[dofIndex][componentNo];
+    }
+  }
+}
+
+template <typename FunctionSpaceType, int nComponents>
+void ValuesView<FunctionSpaceType, nComponents>::getAllElementValues(
+    std::vector<double> &buffer) const {
+  assert(isValid_);
+
+  const int nDofsPerElement = FunctionSpaceType::nDofsPerElement();
+  buffer.resize(nComponents * nDofsPerElement * nElements_);
+
+  // loop over the elements innermost, this writes the buffer contiguously
+  for (int componentNo = 0; componentNo < nComponents; componentNo++) {
+    const double *componentValues = arrays_[componentNo];
+    for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++) {
+      double *bufferValues =
+          buffer.data() +
+          (componentNo * nDofsPerElement + dofIndex) * nElements_;
+      const dof_no_t *dofNos = elementDofNos_->data() + dofIndex;
+
+      for (element_no_t elementNo = 0; elementNo < nElements_; elementNo++) {
+        bufferValues[elementNo] =
+            componentValues[dofNos[elementNo * nDofsPerElement]];
+      }
+    }
+  }
+}
+
+} // namespace FieldVariable
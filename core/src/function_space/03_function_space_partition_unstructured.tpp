@@ -22,6 +22,13 @@ void FunctionSpacePartition<Mesh::UnstructuredDeformableOfDimension<D>,
 
   VLOG(1) << "FunctionSpacePartition<Unstructured>::initialize()";
 
+  // a distributed partitioning is created before the local mesh is set up,
+  // in initializeFromNodesAndElements(), then keep it
+  if (this->meshPartition_) {
+    this->initialized_ = true;
+    return;
+  }
+
   // create partitioning
   assert(this->partitionManager_ != nullptr);
 
@@ -3,6 +3,7 @@
 #include <Python.h> // has to be the first included header
 
 #include <array>
+#include <string>
 #include "control/types.h"
 
 #include "function_space/03_function_space_partition.h"
@@ -61,9 +62,9 @@ public:
   node_no_t getNodeNo(element_no_t elementNo, int nodeIndex) const;
 
   //! return the global/natural node number of element-local node nodeIndex of
-  //! element elementNo, nElements is the total number of elements, this is the
-  //! same as getNodeNo because there are no global numbers for unstructured
-  //! meshes
+  //! element elementNo, nElements is the total number of elements, for serial
+  //! meshes this is the same as getNodeNo, for distributed meshes the element
+  //! has to be on the local domain
   global_no_t getNodeNoGlobalNatural(global_no_t elementNoGlobalNatural,
                                      int nodeIndex) const;
 
@@ -100,6 +101,18 @@ public:
   virtual void initialize();
 
 protected:
+  /** an element as given in the settings, with the node no and the version
+   * no for every node of the element
+   */
+  struct Element {
+    struct ElementNode {
+      node_no_t nodeGlobalNo; //< the node no, after distributeNodesAndElements
+                              // this is the local node no
+      unsigned int versionNo; //< the version of the node that is used
+    };
+    std::vector<ElementNode> nodes; //< the nodes of the element
+  };
+
   //! parse a given *.exelem file and prepare fieldVariable_
   void parseExelemFile(std::string exelemFilename);
 
@@ -116,6 +129,54 @@ protected:
   //! parse the element and node positions from python settings
   void parseFromSettings(PythonConfig settings);
 
+  //! read the geometry field of the global mesh from the exfiles or their
+  //! binary cache on every rank and distribute it if needed
+  void parseExfilesGeometry(std::string filenameExelem,
+                            std::string filenameExnode);
+
+  //! parse the exfiles of the global mesh and extract the node positions, the
+  //! elements and the nodal dof values of the geometry field
+  void parseExfilesGlobal(std::string filenameExelem,
+                          std::string filenameExnode,
+                          std::vector<Vec3> &nodePositions,
+                          std::vector<Element> &elements,
+                          std::vector<Vec3> &nodalDofValues);
+
+  //! get the values that identify a valid cache file of the exfiles: the
+  //! format version, the mesh type and the size and modification time of the
+  //! exfiles
+  std::array<long long, 8> getExfileCacheKey(std::string filenameExelem,
+                                             std::string filenameExnode);
+
+  //! load the global mesh from the binary cache file of the exfiles, returns
+  //! false if there is no cache file or it is outdated
+  bool readExfileCache(std::string cacheFilename, std::string filenameExelem,
+                       std::string filenameExnode,
+                       std::vector<Vec3> &nodePositions,
+                       std::vector<Element> &elements,
+                       std::vector<Vec3> &nodalDofValues);
+
+  //! write the global mesh to the binary cache file of the exfiles
+  void writeExfileCache(std::string cacheFilename, std::string filenameExelem,
+                        std::string filenameExnode,
+                        const std::vector<Vec3> &nodePositions,
+                        const std::vector<Element> &elements,
+                        const std::vector<Vec3> &nodalDofValues);
+
+  //! create the distributed meshPartition and replace the global node
+  //! positions and elements by the local ones, including ghost nodes,
+  //! nodalDofValues contains nDofsPerNode values per node or is empty
+  void distributeNodesAndElements(std::vector<Vec3> &nodePositions,
+                                  std::vector<Element> &elements,
+                                  std::vector<Vec3> &nodalDofValues);
+
+  //! create the mappings, the meshPartition and the geometry field from the
+  //! node positions and the elements, if nodalDofValues is empty, derivative
+  //! dofs are set to 0
+  void initializeFromNodesAndElements(const std::vector<Vec3> &nodePositions,
+                                      const std::vector<Element> &elements,
+                                      const std::vector<Vec3> &nodalDofValues);
+
   //! initialize the meshPartition of this mesh (by calling
   //! FunctionSpacePartition::initialize()), then create the partitioned Petsc
   //! vectors in each field variable
@@ -134,6 +195,15 @@ protected:
   dof_no_t nDofs_ =
       0; //< number of degrees of freedom. This can be different from nNodes *
          // nDofsPerNode because of versions and shared nodes
+  bool distributeMesh_ = false; //< if the mesh is partitioned over multiple
+                                // ranks or renumbered, set in initialize()
+  std::string localNumbering_; //< the ordering of the local nodes and
+                               // elements, "input", "morton" or "rcm"
+  bool exfileCache_; //< if the exfiles are converted to a binary cache file
+                     // that is loaded instead of the exfiles at later runs
+  bool measureReadExfiles_ = true; //< if the duration of reading the
+                                   // exfiles is measured, false for the
+                                   // function space of parseExfilesGlobal
   bool noGeometryField_; //< this is set if there is no geometry field stored.
                          // this is only needed for solid mechanics mixed
                          // formulation where the lower order basisOnMesh does
@@ -144,4 +214,5 @@ protected:
 
 #include "function_space/04_function_space_data_unstructured.tpp"
 #include "function_space/04_function_space_data_unstructured_parse_exfiles.tpp"
+#include "function_space/04_function_space_data_unstructured_exfile_cache.tpp"
 #include "function_space/04_function_space_data_unstructured_parse_settings.tpp"
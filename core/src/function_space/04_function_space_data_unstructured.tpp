@@ -10,6 +10,7 @@
 #include "utility/string_utility.h"
 #include "utility/math_utility.h"
 #include "control/dihu_context.h"
+#include "control/diagnostic_tool/performance_measurement.h"
 
 #include "field_variable/unstructured/exfile_representation.h"
 #include "field_variable/unstructured/element_to_dof_mapping.h"
@@ -29,6 +30,20 @@ FunctionSpaceDataUnstructured<D, BasisFunctionType>::
                                                      settings),
       noGeometryField_(noGeometryField) {
   LOG(TRACE) << "FunctionSpaceDataUnstructured constructor";
+
+  // locality preserving renumbering of the nodes and elements
+  localNumbering_ =
+      this->specificSettings_.getOptionString("localNumbering", "input");
+  if (localNumbering_ != "input" && localNumbering_ != "morton" &&
+      localNumbering_ != "rcm") {
+    LOG(WARNING) << this->specificSettings_ << "[\"localNumbering\"] is \""
+                 << localNumbering_ << "\", but has to be one of \"input\", "
+                 << "\"morton\" or \"rcm\". Using \"input\".";
+    localNumbering_ = "input";
+  }
+
+  // binary cache of the geometry in the exfiles
+  exfileCache_ = this->specificSettings_.getOptionBool("exfileCache", false);
 }
 
 template <int D, typename BasisFunctionType>
@@ -42,13 +57,14 @@ FunctionSpaceDataUnstructured<D, BasisFunctionType>::
 
 template <int D, typename BasisFunctionType>
 void FunctionSpaceDataUnstructured<D, BasisFunctionType>::initialize() {
-  if (DihuContext::nRanksCommWorld() > 1) {
-    LOG(FATAL)
-        << "Unstructured grids are not implemented for parallel execution! "
-        << std::endl
-        << "Use structured or regular grids instead or run with a single "
-           "process.";
-  }
+  // if the rank subset of the mesh contains more than one rank or the mesh
+  // should be renumbered, the global mesh is read on every rank and then
+  // partitioned
+  assert(this->partitionManager_);
+  this->distributeMesh_ =
+      this->partitionManager_->rankSubsetForNextCreatedPartitioning()
+              ->size() > 1 ||
+      this->localNumbering_ != "input";
 
   if (this->specificSettings_.hasKey("exelem")) {
     std::string filenameExelem =
@@ -56,6 +72,17 @@ void FunctionSpaceDataUnstructured<D, BasisFunctionType>::initialize() {
     std::string filenameExnode =
         this->specificSettings_.getOptionString("exnode", "input.exnode");
 
+    // the nested function space of parseExfilesGlobal is not measured, its
+    // duration is part of the duration of the outer function space
+    if (this->measureReadExfiles_)
+      Control::PerformanceMeasurement::start("durationReadExfiles");
+
+    if (this->distributeMesh_ || this->exfileCache_) {
+      this->parseExfilesGeometry(filenameExelem, filenameExnode);
+      Control::PerformanceMeasurement::stop("durationReadExfiles");
+      return;
+    }
+
     // read in exelem file
     this->parseExelemFile(filenameExelem);
 
@@ -70,6 +97,8 @@ void FunctionSpaceDataUnstructured<D, BasisFunctionType>::initialize() {
 
     // read in exnode file
     this->parseExnodeFile(filenameExnode);
+    if (this->measureReadExfiles_)
+      Control::PerformanceMeasurement::stop("durationReadExfiles");
 
     // eliminate scale factors (not yet tested)
     // this->eliminateScaleFactors();
@@ -107,7 +136,16 @@ template <int D, typename BasisFunctionType>
 global_no_t
 FunctionSpaceDataUnstructured<D, BasisFunctionType>::getNodeNoGlobalNatural(
     global_no_t elementNoGlobalNatural, int nodeIndex) const {
-  return this->getNodeNo(elementNoGlobalNatural, nodeIndex);
+  if (!this->meshPartition_)
+    return this->getNodeNo(elementNoGlobalNatural, nodeIndex);
+
+  // only the local elements are known, for serial meshes all elements are local
+  bool isOnLocalDomain = false;
+  element_no_t elementNoLocal = this->meshPartition_->getElementNoLocal(
+      elementNoGlobalNatural, isOnLocalDomain);
+  assert(isOnLocalDomain);
+  return this->meshPartition_->getNodeNoGlobalNatural(
+      this->getNodeNo(elementNoLocal, nodeIndex));
 }
 
 template <int D, typename BasisFunctionType>
@@ -150,6 +188,8 @@ FunctionSpaceDataUnstructured<D, BasisFunctionType>::nElementsLocal() const {
 template <int D, typename BasisFunctionType>
 global_no_t
 FunctionSpaceDataUnstructured<D, BasisFunctionType>::nElementsGlobal() const {
+  if (this->meshPartition_)
+    return this->meshPartition_->nElementsGlobal();
   assert(geometryField_);
   return this->geometryField_->nElements();
 }
@@ -158,9 +198,9 @@ template <int D, typename BasisFunctionType>
 global_no_t FunctionSpaceDataUnstructured<D, BasisFunctionType>::
     getNodeNoGlobalNaturalFromElementNoLocal(element_no_t elementNoLocal,
                                              int nodeIndex) const {
-  global_no_t elementNoGlobalNatural =
-      this->meshPartition_->getElementNoGlobalNatural(elementNoLocal);
-  return this->getNodeNoGlobalNatural(elementNoGlobalNatural, nodeIndex);
+  // the element to node mapping contains the local node nos
+  node_no_t nodeNoLocal = this->getNodeNo(elementNoLocal, nodeIndex);
+  return this->meshPartition_->getNodeNoGlobalNatural(nodeNoLocal);
 }
 
 } // namespace FunctionSpace
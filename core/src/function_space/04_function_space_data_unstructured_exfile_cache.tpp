@@ -0,0 +1,163 @@
+#include "function_space/04_function_space_data_unstructured.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sys/stat.h>
+
+#include "easylogging++.h"
+#include "utility/memory_mapped_file.h"
+
+namespace FunctionSpace {
+
+template <int D, typename BasisFunctionType>
+std::array<long long, 8>
+FunctionSpaceDataUnstructured<D, BasisFunctionType>::getExfileCacheKey(
+    std::string filenameExelem, std::string filenameExnode) {
+  // the first entry identifies the file format, "dihuEXC" and the version
+  std::array<long long, 8> key = {
+      0x6469687545584331ll, D, this->nNodesPerElement(), this->nDofsPerNode(),
+      -1, -1, -1, -1};
+
+  // the size and modification time of the exfiles invalidate the cache when
+  // the exfiles are changed
+  struct stat fileStatus;
+  if (stat(filenameExelem.c_str(), &fileStatus) == 0) {
+    key[4] = fileStatus.st_size;
+    key[5] = fileStatus.st_mtime;
+  }
+  if (stat(filenameExnode.c_str(), &fileStatus) == 0) {
+    key[6] = fileStatus.st_size;
+    key[7] = fileStatus.st_mtime;
+  }
+  return key;
+}
+
+template <int D, typename BasisFunctionType>
+bool FunctionSpaceDataUnstructured<D, BasisFunctionType>::readExfileCache(
+    std::string cacheFilename, std::string filenameExelem,
+    std::string filenameExnode, std::vector<Vec3> &nodePositions,
+    std::vector<Element> &elements, std::vector<Vec3> &nodalDofValues) {
+  // there is no cache file yet at the first run, this is no error
+  struct stat fileStatus;
+  if (stat(cacheFilename.c_str(), &fileStatus) != 0)
+    return false;
+
+  MemoryMappedFile file(cacheFilename);
+  std::array<long long, 8> key;
+  std::array<long long, 2> sizes; // number of nodes and elements
+  if (!file.isOpen() || !file.read(0, sizeof(key), key.data()) ||
+      !file.read(sizeof(key), sizeof(sizes), sizes.data()))
+    return false;
+
+  if (key != this->getExfileCacheKey(filenameExelem, filenameExnode)) {
+    LOG(INFO) << "Cache file \"" << cacheFilename << "\" does not match \""
+              << filenameExelem << "\" and \"" << filenameExnode
+              << "\", parse the exfiles again.";
+    return false;
+  }
+
+  const long long nNodes = sizes[0];
+  const long long nElements = sizes[1];
+  const int nDofsPerNode = this->nDofsPerNode();
+  const int nNodesPerElement = this->nNodesPerElement();
+
+  // check the size before allocating memory, the file could be truncated
+  const std::size_t expectedSize =
+      sizeof(key) + sizeof(sizes) +
+      nNodes * (1 + nDofsPerNode) * sizeof(Vec3) +
+      nElements * nNodesPerElement * sizeof(long long);
+  if (nNodes < 0 || nElements < 0 || file.size() != expectedSize) {
+    LOG(WARNING) << "Cache file \"" << cacheFilename
+                 << "\" is incomplete, parse the exfiles again.";
+    return false;
+  }
+
+  std::size_t offset = sizeof(key) + sizeof(sizes);
+  nodePositions.resize(nNodes);
+  nodalDofValues.resize(nNodes * nDofsPerNode);
+  std::vector<long long> elementNodes(nElements * nNodesPerElement);
+
+  bool successful =
+      file.read(offset, nNodes * sizeof(Vec3), nodePositions.data());
+  offset += nNodes * sizeof(Vec3);
+  successful = successful && file.read(offset, nodalDofValues.size() *
+                                                   sizeof(Vec3),
+                                       nodalDofValues.data());
+  offset += nodalDofValues.size() * sizeof(Vec3);
+  successful = successful && file.read(offset, elementNodes.size() *
+                                                   sizeof(long long),
+                                       elementNodes.data());
+
+  if (!successful) {
+    LOG(WARNING) << "Could not read cache file \"" << cacheFilename
+                 << "\", parse the exfiles again.";
+    return false;
+  }
+
+  elements.resize(nElements);
+  for (element_no_t elementNo = 0; elementNo < nElements; elementNo++) {
+    elements[elementNo].nodes.resize(nNodesPerElement);
+    for (int nodeIndex = 0; nodeIndex < nNodesPerElement; nodeIndex++) {
+      elements[elementNo].nodes[nodeIndex].nodeGlobalNo =
+          elementNodes[elementNo * nNodesPerElement + nodeIndex];
+      elements[elementNo].nodes[nodeIndex].versionNo = 0;
+    }
+  }
+
+  LOG(DEBUG) << "loaded " << nElements << " elements and " << nNodes
+             << " nodes from cache file \"" << cacheFilename << "\"";
+  return true;
+}
+
+template <int D, typename BasisFunctionType>
+void FunctionSpaceDataUnstructured<D, BasisFunctionType>::writeExfileCache(
+    std::string cacheFilename, std::string filenameExelem,
+    std::string filenameExnode, const std::vector<Vec3> &nodePositions,
+    const std::vector<Element> &elements,
+    const std::vector<Vec3> &nodalDofValues) {
+  const int nNodesPerElement = this->nNodesPerElement();
+
+  std::array<long long, 8> key =
+      this->getExfileCacheKey(filenameExelem, filenameExnode);
+  std::array<long long, 2> sizes = {(long long)nodePositions.size(),
+                                    (long long)elements.size()};
+
+  std::vector<long long> elementNodes(elements.size() * nNodesPerElement);
+  for (std::size_t elementNo = 0; elementNo < elements.size(); elementNo++) {
+    for (int nodeIndex = 0; nodeIndex < nNodesPerElement; nodeIndex++) {
+      elementNodes[elementNo * nNodesPerElement + nodeIndex] =
+          elements[elementNo].nodes[nodeIndex].nodeGlobalNo;
+    }
+  }
+
+  // write to a temporary file first, such that no other process reads a
+  // partially written cache file
+  std::string temporaryFilename = cacheFilename + ".tmp";
+  std::ofstream file(temporaryFilename.c_str(),
+                     std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    LOG(WARNING) << "Could not write cache file \"" << cacheFilename << "\".";
+    return;
+  }
+
+  file.write((const char *)key.data(), sizeof(key));
+  file.write((const char *)sizes.data(), sizeof(sizes));
+  file.write((const char *)nodePositions.data(),
+             nodePositions.size() * sizeof(Vec3));
+  file.write((const char *)nodalDofValues.data(),
+             nodalDofValues.size() * sizeof(Vec3));
+  file.write((const char *)elementNodes.data(),
+             elementNodes.size() * sizeof(long long));
+  file.close();
+
+  if (!file || std::rename(temporaryFilename.c_str(), cacheFilename.c_str())) {
+    LOG(WARNING) << "Could not write cache file \"" << cacheFilename << "\".";
+    std::remove(temporaryFilename.c_str());
+    return;
+  }
+
+  LOG(INFO) << "Wrote cache file \"" << cacheFilename << "\" for \""
+            << filenameExelem << "\" and \"" << filenameExnode << "\".";
+}
+
+} // namespace FunctionSpace
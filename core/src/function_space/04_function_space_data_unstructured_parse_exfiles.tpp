@@ -5,6 +5,7 @@
 
 #include "basis_function/basis_function.h"
 #include "field_variable/factory.h"
+#include "utility/memory_mapped_file.h"
 
 #include <iostream>
 #include <fstream>
@@ -14,27 +15,26 @@ namespace FunctionSpace {
 template <int D, typename BasisFunctionType>
 void FunctionSpaceDataUnstructured<D, BasisFunctionType>::parseExelemFile(
     std::string exelemFilename) {
-  std::ifstream file_exelem(exelemFilename.c_str(),
-                            std::ios::in | std::ios::binary);
-  if (!file_exelem.is_open()) {
+  // read the whole file at once, the lines are then extracted from memory
+  std::string content;
+  MemoryMappedFile fileExelem(exelemFilename);
+  if (!fileExelem.isOpen() || !fileExelem.readAll(content)) {
     LOG(WARNING) << "Could not open exelem file \"" << exelemFilename
                  << "\" for reading.";
   }
 
   VLOG(1) << "parseExelemFile";
 
-  // first pass of file: find out number of elements in file
+  // first pass: find out number of elements in file, only the positions of
+  // "Element:" are visited
   this->nElements_ = 0;
-  std::string line;
-  while (!file_exelem.eof()) {
-    getline(file_exelem, line);
-    if (file_exelem.eof())
-      break;
-
-    if (line.find("Element:") != std::string::npos) {
-      element_no_t elementGlobalNo = getNumberAfterString(line, "Element:");
-      this->nElements_ = std::max(this->nElements_, elementGlobalNo);
-    }
+  const std::string elementKey = "Element:";
+  for (std::size_t keyPos = content.find(elementKey);
+       keyPos != std::string::npos;
+       keyPos = content.find(elementKey, keyPos + elementKey.length())) {
+    element_no_t elementGlobalNo =
+        atoi(content.c_str() + keyPos + elementKey.length());
+    this->nElements_ = std::max(this->nElements_, elementGlobalNo);
   }
 
   if (this->elementToNodeMapping_ == nullptr)
@@ -44,10 +44,6 @@ void FunctionSpaceDataUnstructured<D, BasisFunctionType>::parseExelemFile(
 
   VLOG(1) << "nElements: " << this->nElements_;
 
-  // reset file stream
-  file_exelem.clear();
-  file_exelem.seekg(0, std::ios::beg);
-
   // second pass of file: read in dofs for each element
   int fieldNo = 0;
   // int nFields;
@@ -66,11 +62,15 @@ void FunctionSpaceDataUnstructured<D, BasisFunctionType>::parseExelemFile(
   std::vector<int> valueIndices, scaleFactorIndices;
 
   // loop over lines of file
-  while (!file_exelem.eof()) {
-    // parse line
-    getline(file_exelem, line);
-    if (file_exelem.eof())
-      break;
+  std::string line;
+  std::size_t pos = 0;
+  while (pos < content.size()) {
+    // extract next line
+    std::size_t posNewline = content.find('\n', pos);
+    if (posNewline == std::string::npos)
+      posNewline = content.size();
+    line.assign(content, pos, posNewline - pos);
+    pos = posNewline + 1;
 
     // check if line contains "Shape."
     if (line.find("Shape.") != std::string::npos &&
@@ -108,7 +108,7 @@ void FunctionSpaceDataUnstructured<D, BasisFunctionType>::parseExelemFile(
         for (auto &fieldVariable : this->fieldVariable_) {
           fieldVariable.second->parseElementFromExelemFile(elementContent);
         }
-        elementContent = "";
+        elementContent.clear();
       }
 
       continue;
@@ -171,7 +171,7 @@ void FunctionSpaceDataUnstructured<D, BasisFunctionType>::parseExelemFile(
           // parse whole field description block inside component object
           this->fieldVariable_[fieldName]->parseHeaderFromExelemFile(
               fieldContent);
-          fieldContent = "";
+          fieldContent.clear();
         }
 
         // get name of current fieldVariable, if there is one starting here
@@ -192,10 +192,11 @@ void FunctionSpaceDataUnstructured<D, BasisFunctionType>::parseExelemFile(
       // if a block with elements begins at current line
       if (line.find("Element:") != std::string::npos) {
         lineType = elementsFollow;
-        elementContent = "";
+        elementContent.clear();
       } else {
         // collect lines of current field description block
-        fieldContent += line + "\n";
+        fieldContent += line;
+        fieldContent += '\n';
       }
     }
 
@@ -212,12 +213,13 @@ void FunctionSpaceDataUnstructured<D, BasisFunctionType>::parseExelemFile(
           for (auto &fieldVariable : this->fieldVariable_) {
             fieldVariable.second->parseElementFromExelemFile(elementContent);
           }
-          elementContent = "";
+          elementContent.clear();
         }
       }
 
       // collect lines for current element block
-      elementContent += line + "\n";
+      elementContent += line;
+      elementContent += '\n';
     }
   }
 
@@ -273,18 +275,16 @@ void FunctionSpaceDataUnstructured<D, BasisFunctionType>::parseExelemFile(
 template <int D, typename BasisFunctionType>
 void FunctionSpaceDataUnstructured<D, BasisFunctionType>::parseExnodeFile(
     std::string exnodeFilename) {
-  std::ifstream file_exnode(exnodeFilename.c_str(),
-                            std::ios::in | std::ios::binary);
-  if (!file_exnode.is_open()) {
+  VLOG(1) << "parseExnodeFile";
+
+  // read in file content
+  std::string content;
+  MemoryMappedFile fileExnode(exnodeFilename);
+  if (!fileExnode.isOpen() || !fileExnode.readAll(content)) {
     LOG(WARNING) << "Could not open exnode file \"" << exnodeFilename
                  << "\" for reading.";
   }
 
-  VLOG(1) << "parseExnodeFile";
-  // read in file content
-  std::string content((std::istreambuf_iterator<char>(file_exnode)),
-                      (std::istreambuf_iterator<char>()));
-
   // parse geometry field
   if (this->geometryField_) {
     // set all values to 0.0
@@ -406,4 +406,119 @@ void FunctionSpaceDataUnstructured<
   if (geometryField_)
     this->geometryField_->initializeValuesVector();
 }
+
+template <int D, typename BasisFunctionType>
+void FunctionSpaceDataUnstructured<D, BasisFunctionType>::parseExfilesGeometry(
+    std::string filenameExelem, std::string filenameExnode) {
+  std::shared_ptr<Partition::RankSubset> rankSubset =
+      this->partitionManager_->rankSubsetForNextCreatedPartitioning();
+
+  std::vector<Vec3> nodePositions;
+  std::vector<Element> elements;
+  std::vector<Vec3> nodalDofValues;
+
+  // load the binary cache of the exfiles if it is up to date, otherwise parse
+  // the exfiles and create the cache
+  const std::string cacheFilename = filenameExelem + ".cache";
+  if (!this->exfileCache_ ||
+      !this->readExfileCache(cacheFilename, filenameExelem, filenameExnode,
+                             nodePositions, elements, nodalDofValues)) {
+    this->parseExfilesGlobal(filenameExelem, filenameExnode, nodePositions,
+                             elements, nodalDofValues);
+
+    if (this->exfileCache_ && rankSubset->ownRankNo() == 0) {
+      this->writeExfileCache(cacheFilename, filenameExelem, filenameExnode,
+                             nodePositions, elements, nodalDofValues);
+    }
+  }
+
+  LOG(DEBUG) << "read global unstructured mesh from \"" << filenameExelem
+             << "\" with " << elements.size() << " elements and "
+             << nodePositions.size() << " nodes, distribute to "
+             << rankSubset->size() << " ranks";
+
+  if (this->distributeMesh_)
+    this->distributeNodesAndElements(nodePositions, elements, nodalDofValues);
+  this->initializeFromNodesAndElements(nodePositions, elements,
+                                       nodalDofValues);
+}
+
+template <int D, typename BasisFunctionType>
+void FunctionSpaceDataUnstructured<D, BasisFunctionType>::parseExfilesGlobal(
+    std::string filenameExelem, std::string filenameExnode,
+    std::vector<Vec3> &nodePositions, std::vector<Element> &elements,
+    std::vector<Vec3> &nodalDofValues) {
+  // read the whole mesh on every rank into a function space that only
+  // contains the own rank
+  std::shared_ptr<Partition::RankSubset> rankSubset =
+      this->partitionManager_->rankSubsetForNextCreatedPartitioning();
+  this->partitionManager_->setRankSubsetForNextCreatedPartitioning(
+      std::make_shared<Partition::RankSubset>(rankSubset->ownRankNo(),
+                                              rankSubset));
+
+  std::shared_ptr<FunctionSpaceType> globalFunctionSpace =
+      std::make_shared<FunctionSpaceType>(this->partitionManager_,
+                                          this->specificSettings_);
+  globalFunctionSpace->localNumbering_ = "input";
+  globalFunctionSpace->exfileCache_ = false;
+  globalFunctionSpace->measureReadExfiles_ = false; // measured by this space
+  globalFunctionSpace->initialize();
+
+  this->partitionManager_->setRankSubsetForNextCreatedPartitioning(
+      rankSubset);
+
+  // renumbering is requested explicitly, it must not silently drop fields
+  if (!globalFunctionSpace->fieldVariable_.empty() &&
+      this->localNumbering_ != "input") {
+    LOG(FATAL) << this->specificSettings_ << "[\"exelem\"]: "
+               << "The exfiles contain "
+               << globalFunctionSpace->fieldVariable_.size()
+               << " field variables other than the geometry field, which "
+               << "cannot be renumbered. Set \"localNumbering\" to "
+               << "\"input\" to load them.";
+  } else if (!globalFunctionSpace->fieldVariable_.empty()) {
+    LOG(WARNING) << this->specificSettings_ << "[\"exelem\"]: "
+                 << "The exfiles contain "
+                 << globalFunctionSpace->fieldVariable_.size()
+                 << " field variables other than the geometry field. "
+                 << "They are not loaded, because the mesh is distributed "
+                 << "or stored in the \"exfileCache\".";
+  }
+
+  // extract node positions and all nodal dof values of the geometry field
+  const int nDofsPerNode = this->nDofsPerNode();
+  node_no_t nNodes = globalFunctionSpace->nNodesLocalWithGhosts();
+
+  nodePositions.resize(nNodes);
+  nodalDofValues.resize(nNodes * nDofsPerNode);
+  for (node_no_t nodeNo = 0; nodeNo < nNodes; nodeNo++) {
+    std::vector<dof_no_t> nodeDofs;
+    globalFunctionSpace->getNodeDofs(nodeNo, nodeDofs);
+
+    if (nodeDofs.size() != nDofsPerNode) {
+      LOG(FATAL) << "Node " << nodeNo << " in \"" << filenameExnode
+                 << "\" has multiple versions. This is not supported for "
+                 << "unstructured meshes that are distributed to multiple "
+                 << "ranks, renumbered or stored in the \"exfileCache\".";
+    }
+
+    for (int dofIndex = 0; dofIndex < nDofsPerNode; dofIndex++) {
+      nodalDofValues[nodeNo * nDofsPerNode + dofIndex] =
+          globalFunctionSpace->geometryField().getValue(nodeDofs[dofIndex]);
+    }
+    nodePositions[nodeNo] = nodalDofValues[nodeNo * nDofsPerNode];
+  }
+
+  // extract the elements
+  elements.resize(globalFunctionSpace->nElementsLocal());
+  for (element_no_t elementNo = 0; elementNo < elements.size(); elementNo++) {
+    elements[elementNo].nodes.resize(this->nNodesPerElement());
+    for (int nodeIndex = 0; nodeIndex < this->nNodesPerElement();
+         nodeIndex++) {
+      elements[elementNo].nodes[nodeIndex].nodeGlobalNo =
+          globalFunctionSpace->getNodeNo(elementNo, nodeIndex);
+      elements[elementNo].nodes[nodeIndex].versionNo = 0;
+    }
+  }
+}
 } // namespace FunctionSpace
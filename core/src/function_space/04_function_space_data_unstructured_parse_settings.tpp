@@ -6,6 +6,7 @@
 
 #include "basis_function/basis_function.h"
 #include "field_variable/factory.h"
+#include "partition/locality_ordering.h"
 
 #include <iostream>
 #include <fstream>
@@ -26,12 +27,19 @@ void FunctionSpaceDataUnstructured<D, BasisFunctionType>::parseFromSettings(
   bool listWarningIssued =
       false; // if the warning about lists was already shown
 
+  // a numpy array with shape (nNodes,3) is copied at once
+  bool nodePositionsParsed =
+      settings.hasKey("nodePositions") &&
+      PythonUtility::convertFromBuffer<Vec3>::get(
+          settings.getOptionPyObject("nodePositions"), nodePositions);
+
   // get the first node position from the list
-  PyObject *pyNodePositions =
-      settings.getOptionListBegin<PyObject *>("nodePositions");
+  PyObject *pyNodePositions = nullptr;
+  if (!nodePositionsParsed)
+    pyNodePositions = settings.getOptionListBegin<PyObject *>("nodePositions");
 
   // loop over other entries of list
-  for (; !settings.getOptionListEnd("nodePositions");
+  for (; !nodePositionsParsed && !settings.getOptionListEnd("nodePositions");
        settings.getOptionListNext<PyObject *>("nodePositions",
                                               pyNodePositions)) {
     if (!PythonUtility::isTypeList(pyNodePositions) && !listWarningIssued) {
@@ -46,13 +54,6 @@ void FunctionSpaceDataUnstructured<D, BasisFunctionType>::parseFromSettings(
   }
 
   // parse elements
-  struct Element {
-    struct ElementNode {
-      node_no_t nodeGlobalNo;
-      unsigned int versionNo;
-    };
-    std::vector<ElementNode> nodes;
-  };
   std::vector<Element> elements;
 
   // example input in settings:
@@ -90,6 +91,141 @@ void FunctionSpaceDataUnstructured<D, BasisFunctionType>::parseFromSettings(
     elements.push_back(currentElement);
   }
 
+  // for multiple ranks, only keep the local elements and nodes
+  std::vector<Vec3> nodalDofValues;
+  if (this->distributeMesh_)
+    this->distributeNodesAndElements(nodePositions, elements, nodalDofValues);
+
+  this->initializeFromNodesAndElements(nodePositions, elements,
+                                       nodalDofValues);
+}
+
+template <int D, typename BasisFunctionType>
+void FunctionSpaceDataUnstructured<D, BasisFunctionType>::
+    distributeNodesAndElements(std::vector<Vec3> &nodePositions,
+                               std::vector<Element> &elements,
+                               std::vector<Vec3> &nodalDofValues) {
+  const int nDofsPerNode = this->nDofsPerNode();
+  const int nRanks =
+      this->partitionManager_->rankSubsetForNextCreatedPartitioning()->size();
+
+  // multiple versions per node are only possible with the serial numbering
+  if (nRanks == 1) {
+    for (const Element &element : elements) {
+      for (const typename Element::ElementNode &elementNode : element.nodes) {
+        if (elementNode.versionNo != 0) {
+          LOG(WARNING) << this->specificSettings_ << "[\"localNumbering\"] "
+                       << "is \"" << this->localNumbering_ << "\", but the "
+                       << "mesh has multiple versions per node. The mesh is "
+                       << "not renumbered.";
+          this->distributeMesh_ = false;
+          return;
+        }
+      }
+    }
+  }
+
+  // get the global node nos and the centroid of every element
+  std::vector<std::vector<global_no_t>> nodeNosOfElementsGlobal(
+      elements.size());
+  std::vector<Vec3> elementCentroids(elements.size(), Vec3({0.0, 0.0, 0.0}));
+
+  for (global_no_t elementNoGlobal = 0; elementNoGlobal < elements.size();
+       elementNoGlobal++) {
+    for (const typename Element::ElementNode &elementNode :
+         elements[elementNoGlobal].nodes) {
+      if (elementNode.versionNo != 0) {
+        LOG(FATAL) << "Element " << elementNoGlobal << " uses version "
+                   << elementNode.versionNo << " of node "
+                   << elementNode.nodeGlobalNo
+                   << ". Multiple versions per node are not supported for "
+                   << "unstructured meshes that are distributed to multiple "
+                   << "ranks.";
+      }
+      if (elementNode.nodeGlobalNo >= nodePositions.size()) {
+        LOG(FATAL) << "Element " << elementNoGlobal
+                   << " contains node global no. " << elementNode.nodeGlobalNo
+                   << " which is >= the number of nodes ("
+                   << nodePositions.size() << ")";
+      }
+
+      nodeNosOfElementsGlobal[elementNoGlobal].push_back(
+          elementNode.nodeGlobalNo);
+      elementCentroids[elementNoGlobal] +=
+          nodePositions[elementNode.nodeGlobalNo];
+    }
+    elementCentroids[elementNoGlobal] /= (double)this->nNodesPerElement();
+  }
+
+  // compute the locality preserving ordering of the nodes and elements
+  std::vector<global_no_t> nodeNosOrdering;
+  std::vector<global_no_t> elementNosOrdering;
+  if (this->localNumbering_ == "morton") {
+    nodeNosOrdering = Partition::LocalityOrdering::morton(nodePositions);
+  } else if (this->localNumbering_ == "rcm") {
+    nodeNosOrdering = Partition::LocalityOrdering::reverseCuthillMcKee(
+        nodeNosOfElementsGlobal, nodePositions.size());
+  }
+  if (!nodeNosOrdering.empty()) {
+    elementNosOrdering = Partition::LocalityOrdering::elementsByNodes(
+        nodeNosOfElementsGlobal, nodeNosOrdering);
+  }
+
+  // create the meshPartition, this assigns the elements to the ranks
+  this->meshPartition_ =
+      this->partitionManager_
+          ->template createPartitioningUnstructured<FunctionSpaceType>(
+              nodeNosOfElementsGlobal, elementCentroids, nodePositions.size(),
+              nDofsPerNode, nodeNosOrdering, elementNosOrdering);
+
+  // keep only the local nodes, in local order
+  const std::vector<global_no_t> &nodeNosGlobalNatural =
+      this->meshPartition_->nodeNosGlobalNatural();
+
+  std::vector<Vec3> localNodePositions;
+  std::vector<Vec3> localNodalDofValues;
+  localNodePositions.reserve(nodeNosGlobalNatural.size());
+
+  for (global_no_t nodeNoGlobal : nodeNosGlobalNatural) {
+    localNodePositions.push_back(nodePositions[nodeNoGlobal]);
+
+    if (!nodalDofValues.empty()) {
+      localNodalDofValues.insert(
+          localNodalDofValues.end(),
+          nodalDofValues.begin() + nodeNoGlobal * nDofsPerNode,
+          nodalDofValues.begin() + (nodeNoGlobal + 1) * nDofsPerNode);
+    }
+  }
+
+  // keep only the local elements and use local node nos in them
+  std::vector<Element> localElements;
+  for (global_no_t elementNoGlobal :
+       this->meshPartition_->elementNosGlobalNatural()) {
+    Element element = elements[elementNoGlobal];
+    for (typename Element::ElementNode &elementNode : element.nodes) {
+      bool isOnLocalDomain = false;
+      elementNode.nodeGlobalNo =
+          this->meshPartition_->getNodeNoLocalFromGlobalNatural(
+              elementNode.nodeGlobalNo, isOnLocalDomain);
+      assert(isOnLocalDomain);
+    }
+    localElements.push_back(element);
+  }
+
+  LOG(DEBUG) << "distributed unstructured mesh, local: "
+             << localElements.size() << " elements, "
+             << localNodePositions.size() << " nodes (with ghosts)";
+
+  nodePositions.swap(localNodePositions);
+  nodalDofValues.swap(localNodalDofValues);
+  elements.swap(localElements);
+}
+
+template <int D, typename BasisFunctionType>
+void FunctionSpaceDataUnstructured<D, BasisFunctionType>::
+    initializeFromNodesAndElements(const std::vector<Vec3> &nodePositions,
+                                   const std::vector<Element> &elements,
+                                   const std::vector<Vec3> &nodalDofValues) {
   this->nElements_ = elements.size();
 
   LOG(DEBUG) << nodePositions.size() << " node positions, " << elements.size()
@@ -184,6 +320,11 @@ void FunctionSpaceDataUnstructured<D, BasisFunctionType>::parseFromSettings(
                                  this->elementToNodeMapping_,
                                  this->nDofsPerNode());
 
+  // for distributed meshes, the non-ghost dofs have to come first, because
+  // the local nodes are ordered like that, number the dofs by nodes
+  if (this->distributeMesh_)
+    elementToDofMapping->renumberDofsNodeWise(nodeToDofMapping);
+
   VLOG(1) << "nodeToDofMapping: " << *nodeToDofMapping;
 
   this->nDofs_ = elementToDofMapping->nDofsLocal();
@@ -217,8 +358,8 @@ void FunctionSpaceDataUnstructured<D, BasisFunctionType>::parseFromSettings(
   this->geometryField_->unifyMappings(this->elementToNodeMapping_,
                                       this->nDofsPerNode());
 
-  // create meshPartition and redistribute elements if necessary, this needs
-  // information about mesh size
+  // create meshPartition if it was not yet created by
+  // distributeNodesAndElements, this needs information about mesh size
   FunctionSpacePartition<Mesh::UnstructuredDeformableOfDimension<D>,
                          BasisFunctionType>::initialize();
 
@@ -246,6 +387,19 @@ void FunctionSpaceDataUnstructured<D, BasisFunctionType>::parseFromSettings(
       // create vector containing all dofs of the current node
       std::vector<double> nodeValues(this->nDofsPerNode() * nVersions, 0.0);
 
+      // if all nodal dof values are given, e.g. from exfiles, use them,
+      // there is only one version in this case
+      if (!nodalDofValues.empty()) {
+        assert(nVersions == 1);
+        for (int dofIndex = 0; dofIndex < this->nDofsPerNode(); dofIndex++) {
+          nodeValues[dofIndex] =
+              nodalDofValues[nodeGlobalNo * this->nDofsPerNode() + dofIndex]
+                            [componentNo];
+        }
+        iter->setNodeValues(nodeGlobalNo, nodeValues.begin());
+        continue;
+      }
+
       // set first dof of every version for the particular component (this
       // leaves derivative dofs of Hermite at 0)
       for (int versionNo = 0; versionNo < nVersions; versionNo++) {
@@ -23,6 +23,10 @@ template <int D, typename BasisFunctionType>
 node_no_t
 FunctionSpaceDofsNodes<Mesh::UnstructuredDeformableOfDimension<D>,
                        BasisFunctionType>::nNodesLocalWithoutGhosts() const {
+  // for distributed meshes, the geometry field also contains the ghost nodes
+  if (this->meshPartition_)
+    return this->meshPartition_->nNodesLocalWithoutGhosts();
+
   // assert that geometry field variable is set
   assert(this->geometryField_);
 
@@ -33,8 +37,7 @@ template <int D, typename BasisFunctionType>
 dof_no_t
 FunctionSpaceDofsNodes<Mesh::UnstructuredDeformableOfDimension<D>,
                        BasisFunctionType>::nDofsLocalWithGhosts() const {
-  // parallelism not implemented for unstructured grids, therefore there is no
-  // distinction between global and local numbers
+  // nDofs_ is the number of dofs of the local elements, including ghost dofs
   return this->nDofs_;
 }
 
@@ -42,16 +45,22 @@ template <int D, typename BasisFunctionType>
 dof_no_t
 FunctionSpaceDofsNodes<Mesh::UnstructuredDeformableOfDimension<D>,
                        BasisFunctionType>::nDofsLocalWithoutGhosts() const {
-  // parallelism not implemented for unstructured grids, therefore there is no
-  // distinction between global and local numbers
+  if (this->meshPartition_)
+    return this->meshPartition_->nDofsLocalWithoutGhosts();
+
+  // without meshPartition, there is no distinction between global and local
+  // numbers
   return this->nDofs_;
 }
 
 template <int D, typename BasisFunctionType>
 global_no_t FunctionSpaceDofsNodes<Mesh::UnstructuredDeformableOfDimension<D>,
                                    BasisFunctionType>::nNodesGlobal() const {
-  // parallelism not implemented for unstructured grids, therefore there is no
-  // distinction between global and local numbers
+  if (this->meshPartition_)
+    return this->meshPartition_->nNodesGlobal();
+
+  // without meshPartition, there is no distinction between global and local
+  // numbers
   assert(this->geometryField_);
   return this->geometryField_->nNodes();
 }
@@ -59,7 +68,8 @@ global_no_t FunctionSpaceDofsNodes<Mesh::UnstructuredDeformableOfDimension<D>,
 template <int D, typename BasisFunctionType>
 global_no_t FunctionSpaceDofsNodes<Mesh::UnstructuredDeformableOfDimension<D>,
                                    BasisFunctionType>::nDofsGlobal() const {
-  // parallelism not implemented for unstructured grids
+  if (this->meshPartition_)
+    return this->meshPartition_->nDofsGlobal();
   return this->nDofs_;
 }
 
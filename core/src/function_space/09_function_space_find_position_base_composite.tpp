@@ -55,6 +55,9 @@ bool FunctionSpaceStructuredFindPositionBase<
         startSearchInCurrentElement, residual, searchedAllElements,
         xiTolerance);
     if (nodeFound) {
+      // the sub mesh no. is only informative, concurrent calls from multiple
+      // threads may overwrite each other's value
+#pragma omp atomic write
       subMeshNoWherePointWasFound_ = subMeshNo;
 
       // transform elementOnMeshNoLocal, which is the element local no in the
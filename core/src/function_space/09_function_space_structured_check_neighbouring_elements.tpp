@@ -88,8 +88,8 @@ bool FunctionSpaceStructuredCheckNeighbouringElements<
   const int D = 2;
 
   // define the order in which the neighbors are considered
-  static std::array<int, 3> xOffset;
-  static std::array<int, 3> yOffset;
+  std::array<int, 3> xOffset;
+  std::array<int, 3> yOffset;
 
   // x direction
   if (xi[0] < 0) {
@@ -655,9 +655,9 @@ bool FunctionSpaceStructuredCheckNeighbouringElements<
   const int D = 3;
 
   // define the order in which the neighbors are considered
-  static std::array<int, 3> xOffset;
-  static std::array<int, 3> yOffset;
-  static std::array<int, 3> zOffset;
+  std::array<int, 3> xOffset;
+  std::array<int, 3> yOffset;
+  std::array<int, 3> zOffset;
 
   // x direction
   if (xi[0] < 0) {
@@ -52,6 +52,15 @@ public:
 
   //! get a description of the function space, with mesh name and type
   std::string getDescription() const;
+
+  //! get the local dof nos of all local elements, including ghost dofs. The
+  //! dofs of element elementNo are stored at elementNo*nDofsPerElement, ...,
+  //! the table is created on the first call
+  const std::vector<dof_no_t> &elementDofNosLocalTable();
+
+protected:
+  std::vector<dof_no_t>
+      elementDofNosLocalTable_; //< cache for elementDofNosLocalTable()
 };
 
 } // namespace FunctionSpace
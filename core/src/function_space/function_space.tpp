@@ -113,4 +113,23 @@ std::string FunctionSpace<MeshType, BasisFunctionType>::getDescription() const {
   return description.str();
 }
 
+template <typename MeshType, typename BasisFunctionType>
+const std::vector<dof_no_t> &
+FunctionSpace<MeshType, BasisFunctionType>::elementDofNosLocalTable() {
+  const int nDofsPerElement =
+      FunctionSpaceFunction<MeshType, BasisFunctionType>::nDofsPerElement();
+  const element_no_t nElementsLocal = this->nElementsLocal();
+
+  if (elementDofNosLocalTable_.size() != nElementsLocal * nDofsPerElement) {
+    elementDofNosLocalTable_.resize(nElementsLocal * nDofsPerElement);
+    for (element_no_t elementNo = 0; elementNo < nElementsLocal; elementNo++) {
+      for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++) {
+        elementDofNosLocalTable_[elementNo * nDofsPerElement + dofIndex] =
+            this->getDofNo(elementNo, dofIndex);
+      }
+    }
+  }
+  return elementDofNosLocalTable_;
+}
+
 } // namespace FunctionSpace
@@ -16,7 +16,10 @@ template <typename FieldVariableTargetType>
 void ManagerImplementation::prepareMappingLowToHigh(
     std::shared_ptr<FieldVariableTargetType> fieldVariableTarget,
     int componentNoTarget) {
-  Control::PerformanceMeasurement::start("durationMapPrepare");
+  static const int durationId =
+      Control::PerformanceMeasurement::registerMeasurement(
+          "durationMapPrepare");
+  Control::PerformanceMeasurement::start(durationId);
 
   VLOG(1) << "prepareMappingLowToHigh, fieldVariableTarget: "
           << fieldVariableTarget->name()
@@ -60,7 +63,7 @@ void ManagerImplementation::prepareMappingLowToHigh(
   // zero the entries of the component that will be set
   zeroTargetFieldVariable(fieldVariableTarget, componentNoTarget);
 
-  Control::PerformanceMeasurement::stop("durationMapPrepare");
+  Control::PerformanceMeasurement::stop(durationId);
 }
 
 template <typename FieldVariableTargetType>
@@ -150,7 +153,9 @@ void ManagerImplementation::mapLowToHighDimension(
       fieldVariableSource->functionSpace(),
       fieldVariableTarget->functionSpace());
 
-  Control::PerformanceMeasurement::start("durationMap");
+  static const int durationId =
+      Control::PerformanceMeasurement::registerMeasurement("durationMap");
+  Control::PerformanceMeasurement::start(durationId);
 
   // assert that targetFactorSum_ field variable exists, this should have been
   // created by prepareMapping()
@@ -195,7 +200,7 @@ void ManagerImplementation::mapLowToHighDimension(
         componentNoTarget, *targetFactorSum);
   }
 
-  Control::PerformanceMeasurement::stop("durationMap");
+  Control::PerformanceMeasurement::stop(durationId);
 }
 
 // helper function, calls the map function of the mapping if field variables
@@ -262,7 +267,9 @@ void ManagerImplementation::mapHighToLowDimension(
       fieldVariableTarget->functionSpace(),
       fieldVariableSource->functionSpace());
 
-  Control::PerformanceMeasurement::start("durationMap");
+  static const int durationId =
+      Control::PerformanceMeasurement::registerMeasurement("durationMap");
+  Control::PerformanceMeasurement::start(durationId);
 
   // assert that both or none of the componentNos are -1
   assert((componentNoSource == -1) == (componentNoTarget == -1));
@@ -280,7 +287,7 @@ void ManagerImplementation::mapHighToLowDimension(
         componentNoTarget);
   }
 
-  Control::PerformanceMeasurement::stop("durationMap");
+  Control::PerformanceMeasurement::stop(durationId);
 }
 
 //! finalize the mapping to the fieldVariableTarget, this computes the final
@@ -299,7 +306,10 @@ void ManagerImplementation::finalizeMappingLowToHigh(
           << fieldVariableTarget->name()
           << ", componentNoTarget: " << componentNoTarget;
 
-  Control::PerformanceMeasurement::start("durationMapFinalize");
+  static const int durationId =
+      Control::PerformanceMeasurement::registerMeasurement(
+          "durationMapFinalize");
+  Control::PerformanceMeasurement::start(durationId);
 
   std::string targetFactorSumName =
       fieldVariableTarget->functionSpace()->meshName() + std::string("_") +
@@ -393,7 +403,7 @@ void ManagerImplementation::finalizeMappingLowToHigh(
   // set the computed values
   fieldVariableTarget->setValuesWithoutGhosts(componentNoTarget, targetValues);
 
-  Control::PerformanceMeasurement::stop("durationMapFinalize");
+  Control::PerformanceMeasurement::stop(durationId);
 }
 
 //! finalize the mapping to the fieldVariableTarget, this computes the final
@@ -402,7 +412,10 @@ void ManagerImplementation::finalizeMappingLowToHigh(
 template <typename FieldVariableTargetType>
 void ManagerImplementation::finalizeMappingLowToHigh(
     std::shared_ptr<FieldVariableTargetType> fieldVariableTarget) {
-  Control::PerformanceMeasurement::start("durationMapFinalize");
+  static const int durationId =
+      Control::PerformanceMeasurement::registerMeasurement(
+          "durationMapFinalize");
+  Control::PerformanceMeasurement::start(durationId);
 
   VLOG(1) << "finalizeMappingLowToHigh, fieldVariableTarget: "
           << fieldVariableTarget->name();
@@ -493,7 +506,7 @@ void ManagerImplementation::finalizeMappingLowToHigh(
   // set the computed values
   fieldVariableTarget->setValuesWithoutGhosts(targetValues);
 
-  Control::PerformanceMeasurement::stop("durationMapFinalize");
+  Control::PerformanceMeasurement::stop(durationId);
 }
 
 } // namespace MappingBetweenMeshes
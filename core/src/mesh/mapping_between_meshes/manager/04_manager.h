@@ -2,6 +2,7 @@
 
 #include <Python.h> // has to be the first included header
 #include <map>
+#include <mutex>
 #include <vector>
 
 #include "mesh/mapping_between_meshes/manager/03_manager_implementation.h"
@@ -113,7 +114,9 @@ namespace MappingBetweenMeshes {
  * componentNoTarget)  // set both componentNos to -1 to map all components
  * finalizeMapping(fieldVariableSource, fieldVariableTarget)
  *
- *
+ * The simplified methods can be called from multiple threads, e.g. by the
+ * instances of MultipleInstances that are computed in parallel. They are
+ * serialized by a mutex because the mappings and target factor sums are shared.
  */
 class Manager : public ManagerImplementation {
 public:
@@ -166,6 +169,8 @@ protected:
       std::shared_ptr<FieldVariableSourceType> fieldVariableSource,
       std::shared_ptr<FieldVariableTargetType> fieldVariableTarget,
       bool &mapLowToHigh, bool &mapHighToLow);
+
+  std::recursive_mutex mutex_; //< mutex for the simplified mapping methods
 };
 
 } // namespace MappingBetweenMeshes
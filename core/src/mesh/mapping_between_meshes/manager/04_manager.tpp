@@ -111,6 +111,41 @@ struct RestoreExtractedComponent<
   };
 };
 
+template <typename FieldVariableSourceType, typename FieldVariableTargetType,
+          typename Dummy = void>
+struct CopyComponent {
+  // copy the global vectors, this can change the representation of all
+  // components
+  static void call(std::shared_ptr<FieldVariableSourceType> fieldVariableSource,
+                   int componentNoSource,
+                   std::shared_ptr<FieldVariableTargetType> fieldVariableTarget,
+                   int componentNoTarget) {
+    PetscErrorCode ierr;
+    ierr = VecCopy(fieldVariableSource->valuesGlobal(componentNoSource),
+                   fieldVariableTarget->valuesGlobal(componentNoTarget));
+    CHKERRV(ierr);
+  }
+};
+
+template <typename FieldVariableSourceType, typename FieldVariableTargetType>
+struct CopyComponent<
+    FieldVariableSourceType, FieldVariableTargetType,
+    typename std::enable_if<
+        std::is_same<typename FieldVariableSourceType::FunctionSpace,
+                     typename FieldVariableTargetType::FunctionSpace>::value,
+        void>::type> {
+  // copy only the values of the component, vectors in contiguous
+  // representation stay contiguous
+  static void call(std::shared_ptr<FieldVariableSourceType> fieldVariableSource,
+                   int componentNoSource,
+                   std::shared_ptr<FieldVariableTargetType> fieldVariableTarget,
+                   int componentNoTarget) {
+    fieldVariableTarget->partitionedPetscVec()->setComponentValues(
+        componentNoTarget, *fieldVariableSource->partitionedPetscVec(),
+        componentNoSource);
+  }
+};
+
 template <typename FieldVariableSourceType, typename FieldVariableTargetType>
 void Manager::determineMappingAlgorithm(
     std::shared_ptr<FieldVariableSourceType> fieldVariableSource,
@@ -202,6 +237,8 @@ void Manager::map(std::shared_ptr<FieldVariableSourceType> fieldVariableSource,
                   std::shared_ptr<FieldVariableTargetType> &fieldVariableTarget,
                   int componentNoSource, int componentNoTarget,
                   bool avoidCopyIfPossible) {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+
   VLOG(1) << "map " << fieldVariableSource->name() << "." << componentNoSource
           << " (dim " << FieldVariableSourceType::FunctionSpace::dim() << ", "
           << FieldVariableSourceType::nComponents() << " components total)"
@@ -431,14 +468,15 @@ void Manager::map(std::shared_ptr<FieldVariableSourceType> fieldVariableSource,
 
           // Here, we copy the all components of fieldVariableSource to the
           // corresponding components of fieldVariableTarget.
-          PetscErrorCode ierr;
           for (int componentNo = 0;
                componentNo < std::min(FieldVariableSourceType::nComponents(),
                                       FieldVariableTargetType::nComponents());
                componentNo++) {
-            ierr = VecCopy(fieldVariableSource->valuesGlobal(componentNo),
-                           fieldVariableTarget->valuesGlobal(componentNo));
-            CHKERRV(ierr);
+            CopyComponent<FieldVariableSourceType,
+                          FieldVariableTargetType>::call(fieldVariableSource,
+                                                         componentNo,
+                                                         fieldVariableTarget,
+                                                         componentNo);
           }
         } else {
           VLOG(1) << "copy one component, source component "
@@ -446,11 +484,16 @@ void Manager::map(std::shared_ptr<FieldVariableSourceType> fieldVariableSource,
                   << componentNoTarget;
 
           // Here, we copy the given component of fieldVariableSource to the
-          // componentNoTarget of fieldVariableTarget.
-          PetscErrorCode ierr;
-          ierr = VecCopy(fieldVariableSource->valuesGlobal(componentNoSource),
-                         fieldVariableTarget->valuesGlobal(componentNoTarget));
-          CHKERRV(ierr);
+          // componentNoTarget of fieldVariableTarget. If one of the field
+          // variables is in contiguous representation, e.g. the states of a
+          // CellML adapter, only this component is copied directly from or to
+          // the contiguous vector. Using valuesGlobal() would instead copy all
+          // components out of the contiguous vector and back again later.
+          CopyComponent<FieldVariableSourceType,
+                        FieldVariableTargetType>::call(fieldVariableSource,
+                                                       componentNoSource,
+                                                       fieldVariableTarget,
+                                                       componentNoTarget);
 
           VLOG(1) << "afterwards, source representation: "
                   << fieldVariableSource->partitionedPetscVec()
@@ -558,6 +601,8 @@ void Manager::prepareMapping(
     std::shared_ptr<FieldVariableSourceType> fieldVariableSource,
     std::shared_ptr<FieldVariableTargetType> fieldVariableTarget,
     int componentNoTarget) {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+
   bool mapLowToHigh = false;
   bool mapHighToLow = false;
   determineMappingAlgorithm(fieldVariableSource, fieldVariableTarget,
@@ -605,6 +650,8 @@ void Manager::finalizeMapping(
     std::shared_ptr<FieldVariableSourceType> fieldVariableSource,
     std::shared_ptr<FieldVariableTargetType> fieldVariableTarget,
     int componentNoSource, int componentNoTarget, bool avoidCopyIfPossible) {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+
   bool mapLowToHigh = false;
   bool mapHighToLow = false;
   determineMappingAlgorithm(fieldVariableSource, fieldVariableTarget,
@@ -3,6 +3,7 @@
 #include "function_space/function_space.h"
 #include "mesh/structured_regular_fixed.h"
 #include "mesh/unstructured_deformable.h"
+#include "utility/memory_mapped_file.h"
 
 namespace Mesh {
 
@@ -81,9 +82,23 @@ void Manager::storePreconfiguredMeshes() {
                       nodePositionsFromFile_[key] = NodePositionsFromFile();
                       nodePositionsFromFile_[key].filename = filename;
 
-                      nodePositionsFromFile_[key]
-                          .chunks = PythonUtility::convertFromPython<
-                          std::vector<std::pair<MPI_Offset, int>>>::get(item);
+                      // the chunks can also be a numpy array with shape
+                      // (nChunks,2), which is converted at once
+                      std::vector<std::pair<MPI_Offset, int>> &chunks =
+                          nodePositionsFromFile_[key].chunks;
+                      std::vector<std::array<MPI_Offset, 2>> chunksArray;
+                      if (PythonUtility::convertFromBuffer<
+                              std::array<MPI_Offset, 2>>::get(item,
+                                                              chunksArray)) {
+                        chunks.reserve(chunksArray.size());
+                        for (const std::array<MPI_Offset, 2> &chunk :
+                             chunksArray)
+                          chunks.push_back(std::make_pair(chunk[0],
+                                                          (int)chunk[1]));
+                      } else {
+                        chunks = PythonUtility::convertFromPython<
+                            std::vector<std::pair<MPI_Offset, int>>>::get(item);
+                      }
                     } else {
                       LOG(WARNING) << specificSettings_.getStringPath()
                                    << "[\"nodePositions\"]: If nodePositions "
@@ -116,167 +131,75 @@ void Manager::storePreconfiguredMeshes() {
 void Manager::loadGeometryFromFile() {
   Control::PerformanceMeasurement::start("durationReadGeometry");
 
-  // at this point all ranks in MPI_COMM_WORLD execute collectively
-  MPI_Comm mpiCommunicator = MPI_COMM_WORLD;
-  ;
-  // check if some nodePositions of at least one rank are in a file
-  int nodePositionsAreInFileOnRank =
-      -1; // -1 means there are no nodePositions in a file
-  if (!nodePositionsFromFile_.empty()) {
-    nodePositionsAreInFileOnRank = DihuContext::ownRankNoCommWorld();
-  }
-  int nodePositionsAreInFileOnRankGlobal = 0;
-  MPIUtility::handleReturnValue(
-      MPI_Allreduce(&nodePositionsAreInFileOnRank,
-                    &nodePositionsAreInFileOnRankGlobal, 1, MPI_INT, MPI_MAX,
-                    mpiCommunicator),
-      "MPI_Allreduce");
-
-  LOG(DEBUG) << "nodePositionsAreInFileOnRankGlobal: "
-             << nodePositionsAreInFileOnRankGlobal;
-
-  if (nodePositionsAreInFileOnRankGlobal != -1) {
-    // now nodePositionsAreInFileOnRankGlobal holds a rank that has a file name
-    std::string filename;
-    if (DihuContext::ownRankNoCommWorld() ==
-        nodePositionsAreInFileOnRankGlobal) {
-      filename = nodePositionsFromFile_.begin()->second.filename;
-      LOG(DEBUG) << "there is a file on this rank, " << filename;
-    }
-    int filenameLength = filename.length();
-
-    // broadcast length of filename
-    MPIUtility::handleReturnValue(MPI_Bcast(&filenameLength, 1, MPI_INT,
-                                            nodePositionsAreInFileOnRankGlobal,
-                                            mpiCommunicator),
-                                  "MPI_Bcast (1)");
-
-    // broadcast filename
-    std::vector<char> receiveBuffer(filenameLength + 1, char(0));
-    strcpy(receiveBuffer.data(), filename.c_str());
-    MPIUtility::handleReturnValue(
-        MPI_Bcast(receiveBuffer.data(), filenameLength, MPI_CHAR,
-                  nodePositionsAreInFileOnRankGlobal, mpiCommunicator),
-        "MPI_Bcast (2)");
-
-    std::string openFileName(receiveBuffer.begin(), receiveBuffer.end());
-    while (openFileName[openFileName.length() - 1] == 0) {
-      openFileName = openFileName.substr(0, openFileName.length() - 1);
-    }
-
-    LOG(DEBUG) << "openFileName: " << openFileName;
-
-    // MPI-reduce maximum number of times (number of meshes) to read
-    int nTimesInFile = 0;
-    for (std::map<std::string, NodePositionsFromFile>::iterator iter =
-             nodePositionsFromFile_.begin();
-         iter != nodePositionsFromFile_.end(); iter++) {
-      std::string filename = iter->second.filename;
-      LOG(DEBUG) << "check filename [" << filename << "] == [" << openFileName
-                 << "] length: " << filename.length() << ","
-                 << openFileName.length();
-      if (std::string(filename) == std::string(openFileName)) {
-        LOG(DEBUG) << "yes";
-        nTimesInFile += iter->second.chunks.size();
+  // Every rank reads only the chunks of its own subdomain. The files are
+  // memory-mapped, such that only the pages that contain local node positions
+  // are loaded and no collective operation per chunk is needed.
+  std::map<std::string, std::shared_ptr<MemoryMappedFile>> files;
+  int nChunksRead = 0;
+  std::size_t nBytesRead = 0;
+
+  for (std::map<std::string, NodePositionsFromFile>::iterator
+           nodePositionsFromFileIter = nodePositionsFromFile_.begin();
+       nodePositionsFromFileIter != nodePositionsFromFile_.end();
+       nodePositionsFromFileIter++) {
+    NodePositionsFromFile &nodePositions = nodePositionsFromFileIter->second;
+    std::string filename = nodePositions.filename;
+
+    // open every file only once
+    if (files.find(filename) == files.end()) {
+      files[filename] = std::make_shared<MemoryMappedFile>(filename);
+      if (!files[filename]->isOpen()) {
+        LOG(FATAL) << "Could not open file \"" << filename
+                   << "\" with node positions for mesh \""
+                   << nodePositionsFromFileIter->first << "\".";
       }
     }
-    int nTimesInFileGlobal = 0;
-    MPIUtility::handleReturnValue(MPI_Allreduce(&nTimesInFile,
-                                                &nTimesInFileGlobal, 1, MPI_INT,
-                                                MPI_MAX, mpiCommunicator),
-                                  "MPI_Allreduce");
-
-    LOG(DEBUG) << "number times that node positions for a mesh are given by a "
-                  "file: local: "
-               << nTimesInFile << ", global: " << nTimesInFileGlobal;
-
-    LOG(INFO) << "Read from file \"" << openFileName << "\", "
-              << nTimesInFileGlobal << " collective chunks.";
-
-    // collectively open the file for reading
-    MPI_File fileHandle;
-    MPIUtility::handleReturnValue(
-        MPI_File_open(
-            mpiCommunicator, openFileName.c_str(),
-            // MPI_MODE_WRONLY | MPI_MODE_CREATE | MPI_MODE_UNIQUE_OPEN,
-            MPI_MODE_RDONLY, MPI_INFO_NULL, &fileHandle),
-        "MPI_File_open");
-
-    double progress = 0;
-    // loop over node positions in file to be read
-    int nNodePositionsRead = 0;
-    for (std::map<std::string, NodePositionsFromFile>::iterator
-             nodePositionsFromFileIter = nodePositionsFromFile_.begin();
-         nodePositionsFromFileIter != nodePositionsFromFile_.end();
-         nodePositionsFromFileIter++) {
-      NodePositionsFromFile &nodePositions = nodePositionsFromFileIter->second;
-      std::string filename = nodePositionsFromFileIter->second.filename;
-      if (filename == openFileName) {
-        // loop over chunks
-        for (std::vector<std::pair<MPI_Offset, int>>::iterator chunksIter =
-                 nodePositions.chunks.begin();
-             chunksIter != nodePositions.chunks.end(); chunksIter++) {
-          double newProgress = (double)nNodePositionsRead / nTimesInFileGlobal;
-          if (int(newProgress * 10) != int(progress * 10)) {
-            progress = newProgress;
-            if (DihuContext::ownRankNoCommWorld() == 0) {
-              std::cout << "\b\b\b\b" << int(progress * 100) << "%"
-                        << std::flush;
-            }
-          }
-          progress = newProgress;
-
-          MPI_Offset offset = chunksIter->first;
-          int nValues = chunksIter->second * 3;
-
-          int oldSize = nodePositions.data.size();
-          int newSize = oldSize + nValues;
-          nodePositions.data.resize(newSize);
-
-          MPIUtility::handleReturnValue(
-              MPI_File_read_at_all(fileHandle, offset,
-                                   nodePositions.data.data() + oldSize, nValues,
-                                   MPI_DOUBLE, MPI_STATUS_IGNORE),
-              "MPI_Read_at_all");
-
-          LOG(DEBUG) << "for mesh \"" << nodePositionsFromFileIter->first
-                     << "\" read from file \"" << openFileName << "\" offset "
-                     << offset << ", nValues (number of values): " << nValues
-                     << ", last 3 values: "
-                     << "[" << nodePositions.data[nodePositions.data.size() - 3]
-                     << "," << nodePositions.data[nodePositions.data.size() - 2]
-                     << "," << nodePositions.data[nodePositions.data.size() - 1]
-                     << "]";
-
-          nNodePositionsRead++;
-        }
+    std::shared_ptr<MemoryMappedFile> file = files[filename];
+
+    // allocate memory for all chunks of this mesh at once
+    std::size_t nValues = 0;
+    for (const std::pair<MPI_Offset, int> &chunk : nodePositions.chunks)
+      nValues += chunk.second * 3;
+    nodePositions.data.resize(nValues);
+
+    // loop over chunks, each chunk is (offset, number of points)
+    std::size_t valueNo = 0;
+    for (const std::pair<MPI_Offset, int> &chunk : nodePositions.chunks) {
+      MPI_Offset offset = chunk.first;
+      std::size_t nBytes = chunk.second * 3 * sizeof(double);
+
+      if (offset < 0 || !file->read(offset, nBytes,
+                                    nodePositions.data.data() + valueNo)) {
+        LOG(FATAL) << "Could not read " << chunk.second
+                   << " node positions at offset " << offset << " from file \""
+                   << filename << "\" with " << file->size()
+                   << " bytes, for mesh \"" << nodePositionsFromFileIter->first
+                   << "\".";
       }
+      valueNo += chunk.second * 3;
+      nBytesRead += nBytes;
+      nChunksRead++;
     }
-    LOG(DEBUG)
-        << "collectively read other node positions, only on other ranks ("
-        << nTimesInFileGlobal - nNodePositionsRead << " remaining)";
-    for (; nNodePositionsRead < nTimesInFileGlobal; nNodePositionsRead++) {
-      double newProgress = (double)nNodePositionsRead / nTimesInFileGlobal;
-      if (int(newProgress * 10) != int(progress * 10)) {
-        progress = newProgress;
-        if (DihuContext::ownRankNoCommWorld() == 0) {
-          std::cout << "\b\b\b\b" << int(progress * 100) << "%" << std::flush;
-        }
-      }
-      progress = newProgress;
 
-      std::vector<double> readBuffer(1);
-      MPIUtility::handleReturnValue(
-          MPI_File_read_at_all(fileHandle, 0, readBuffer.data(), 0, MPI_DOUBLE,
-                               MPI_STATUS_IGNORE),
-          "MPI_Read_at_all");
-    }
-    if (DihuContext::ownRankNoCommWorld() == 0) {
-      std::cout << "\b\b\b\bdone." << std::endl;
-    }
+    VLOG(1) << "for mesh \"" << nodePositionsFromFileIter->first
+            << "\" read " << nodePositions.chunks.size()
+            << " chunks from file \"" << filename << "\", "
+            << nodePositions.data.size() / 3 << " node positions";
+  }
 
-    MPIUtility::handleReturnValue(MPI_File_close(&fileHandle),
-                                  "MPI_File_close");
+  // only output a summary of all ranks
+  std::array<long long, 2> localCounts({nChunksRead, (long long)nBytesRead});
+  std::array<long long, 2> globalCounts({0, 0});
+  MPIUtility::handleReturnValue(MPI_Reduce(localCounts.data(),
+                                           globalCounts.data(), 2,
+                                           MPI_LONG_LONG, MPI_SUM, 0,
+                                           MPI_COMM_WORLD),
+                                "MPI_Reduce");
+
+  if (globalCounts[0] > 0 && DihuContext::ownRankNoCommWorld() == 0) {
+    LOG(INFO) << "Read " << globalCounts[0] << " chunks of node positions ("
+              << globalCounts[1] / 1024 / 1024 << " MiB on all ranks) from "
+              << files.size() << " file(s).";
   }
 
   Control::PerformanceMeasurement::stop("durationReadGeometry");
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <vector>
+
+#include "easylogging++.h"
+#include "cellml/03_cellml_adapter.h"
+
+namespace ModelOrderReduction {
+
+/** Evaluation of the right hand side only at the instances that are sampled by
+ * the discrete empirical interpolation method (DEIM). This is only possible
+ * for CellML problems where every instance can be evaluated independently.
+ */
+template <typename DiscretizableInTime> struct DeimRightHandSide {
+  //! evaluate the rhs for the given instances
+  static void evaluateInstances(DiscretizableInTime &discretizableInTime,
+                                const std::vector<int> &instanceNos,
+                                double currentTime,
+                                const std::vector<double> &states,
+                                std::vector<double> &rates) {
+    LOG(FATAL) << "DEIM is only implemented for CellML right hand sides.";
+  }
+};
+
+/** Partial specialization for CellML
+ */
+template <int nStates, int nAlgebraics, typename FunctionSpaceType>
+struct DeimRightHandSide<
+    CellmlAdapter<nStates, nAlgebraics, FunctionSpaceType>> {
+  //! evaluate the rhs for the given instances
+  static void evaluateInstances(
+      CellmlAdapter<nStates, nAlgebraics, FunctionSpaceType> &cellmlAdapter,
+      const std::vector<int> &instanceNos, double currentTime,
+      const std::vector<double> &states, std::vector<double> &rates) {
+    cellmlAdapter.evaluateRightHandSideOfInstances(instanceNos, currentTime,
+                                                   states, rates);
+  }
+};
+
+} // namespace ModelOrderReduction
@@ -49,39 +49,49 @@ void ExplicitEulerReduced<TimeSteppingExplicitType>::advanceTimeSpan(
                 << "/" << this->numberTimeSteps_ << ", t=" << currentTime;
     }
 
-    // full state recovery
-    // required in case of operator splitting because only the reduced solutions
-    // is transferred.
-    this->MatMultFull(basis, redSolution, solution);
-
-    VLOG(1) << "starting from full-order solution: "
-            << *this->fullTimestepping_.data().solution();
-
-    // advance computed value
-    // compute next delta_u = f(u)
-    this->evaluateTimesteppingRightHandSideExplicit(solution, increment,
-                                                    timeStepNo, currentTime);
-
-    VLOG(2) << "computed full-order increment: "
-            << *this->fullTimestepping_.data().increment()
-            << ", dt=" << this->timeStepWidth_;
-
-    // reduction step
-    // solution may has been changed inside
-    // evaluateTimesteppingRightHandSideExplicit in case of the stimulation in
-    // electrophysiology examples. Therefore, the reduced solution has to be
-    // updated.
-    this->MatMultReduced(basisTransp, solution, redSolution);
-
-    VLOG(2) << "reduced solution before adding the reduced increment"
-            << *this->data().solution();
-
-    // reduction of increment
-    // modified version of MatMult for MOR
-    this->MatMultReduced(basisTransp, increment, redIncrement);
-
-    VLOG(2) << "reduced increment: " << *this->data().increment()
-            << ", dt=" << this->timeStepWidth_;
+    if (this->deimEnabled()) {
+      // hyper-reduction, compute delta_z = V^T f(V z) with only the sampled
+      // instances of f, the full state is not needed
+      this->evaluateReducedRightHandSideDeim(redSolution, redIncrement,
+                                             timeStepNo, currentTime);
+
+      VLOG(2) << "reduced increment (DEIM): " << *this->data().increment()
+              << ", dt=" << this->timeStepWidth_;
+    } else {
+      // full state recovery
+      // required in case of operator splitting because only the reduced
+      // solutions is transferred.
+      this->MatMultFull(basis, redSolution, solution);
+
+      VLOG(1) << "starting from full-order solution: "
+              << *this->fullTimestepping_.data().solution();
+
+      // advance computed value
+      // compute next delta_u = f(u)
+      this->evaluateTimesteppingRightHandSideExplicit(solution, increment,
+                                                      timeStepNo, currentTime);
+
+      VLOG(2) << "computed full-order increment: "
+              << *this->fullTimestepping_.data().increment()
+              << ", dt=" << this->timeStepWidth_;
+
+      // reduction step
+      // solution may has been changed inside
+      // evaluateTimesteppingRightHandSideExplicit in case of the stimulation
+      // in electrophysiology examples. Therefore, the reduced solution has to
+      // be updated.
+      this->MatMultReduced(basisTransp, solution, redSolution);
+
+      VLOG(2) << "reduced solution before adding the reduced increment"
+              << *this->data().solution();
+
+      // reduction of increment
+      // modified version of MatMult for MOR
+      this->MatMultReduced(basisTransp, increment, redIncrement);
+
+      VLOG(2) << "reduced increment: " << *this->data().increment()
+              << ", dt=" << this->timeStepWidth_;
+    }
 
     // integrate, z += dt * delta_z
     VecAXPY(redSolution, this->timeStepWidth_, redIncrement);
@@ -96,9 +106,12 @@ void ExplicitEulerReduced<TimeSteppingExplicitType>::advanceTimeSpan(
     // write the current output values of the full-order timestepping
     // full state recovery
 
-    this->MatMultFull(basis, redSolution, solution);
-    VLOG(1) << "solution after integration"
-            << *this->fullTimestepping_.data().solution();
+    // with DEIM, the full state is only needed for the output
+    if (!this->deimEnabled() || withOutputWritersEnabled) {
+      this->MatMultFull(basis, redSolution, solution);
+      VLOG(1) << "solution after integration"
+              << *this->fullTimestepping_.data().solution();
+    }
 
     if (withOutputWritersEnabled) {
       this->fullTimestepping_.outputWriterManager().writeOutput(
@@ -110,6 +123,10 @@ void ExplicitEulerReduced<TimeSteppingExplicitType>::advanceTimeSpan(
     }
   }
 
+  // full state recovery at the end of the time span
+  if (this->deimEnabled() && !withOutputWritersEnabled)
+    this->MatMultFull(basis, redSolution, solution);
+
   this->fullTimestepping_.data().solution()->restoreValuesContiguous();
   this->fullTimestepping_.data().increment()->restoreValuesContiguous();
 }
@@ -16,7 +16,7 @@ void ImplicitEulerReduced<TimeSteppingImplicitType>::advanceTimeSpan(
   // start duration measurement, the name of the output variable can be set by
   // "durationLogKey" in the config
   if (this->durationLogKey_ != "")
-    Control::PerformanceMeasurement::start(this->durationLogKey_);
+    Control::PerformanceMeasurement::start(this->durationLogKeyId_);
 
   // compute timestep width
   double timeSpan = this->endTime_ - this->startTime_;
@@ -79,7 +79,7 @@ void ImplicitEulerReduced<TimeSteppingImplicitType>::advanceTimeSpan(
 
     // stop duration measurement
     if (this->durationLogKey_ != "")
-      Control::PerformanceMeasurement::stop(this->durationLogKey_);
+      Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
 
     if (withOutputWritersEnabled) {
       // write the current output values of the full timestepping
@@ -93,12 +93,12 @@ void ImplicitEulerReduced<TimeSteppingImplicitType>::advanceTimeSpan(
 
     // start duration measurement
     if (this->durationLogKey_ != "")
-      Control::PerformanceMeasurement::start(this->durationLogKey_);
+      Control::PerformanceMeasurement::start(this->durationLogKeyId_);
   }
 
   // stop duration measurement
   if (this->durationLogKey_ != "")
-    Control::PerformanceMeasurement::stop(this->durationLogKey_);
+    Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
 }
 
 template <typename TimeSteppingImplicitType>
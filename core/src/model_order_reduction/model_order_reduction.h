@@ -25,6 +25,10 @@ public:
   //! Set the basis V as Petsc Mat
   void setBasis();
 
+  //! Set the basis V from a binary file that was written by the PodBasis
+  //! output writer
+  void loadBasis(std::string filename);
+
   //! data object for model order reduction
   DataMOR &dataMOR();
 
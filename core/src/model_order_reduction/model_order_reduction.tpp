@@ -2,6 +2,7 @@
 #include "data_management/data.h"
 //#include <petscmat.h>
 #include <array>
+#include <petscviewer.h>
 #include "utility/svd_utility.h"
 
 namespace ModelOrderReduction {
@@ -38,6 +39,13 @@ void MORBase<FunctionSpaceRowsType>::setBasis() {
   LOG(DEBUG) << "basis, mat_sz_1: " << mat_sz_1
              << "basis, mat_sz_2: " << mat_sz_2 << "==============";
 
+  // use a basis that was computed during the full-order simulation
+  std::string basisFile = specificSettingsMOR_.getOptionString("basisFile", "");
+  if (!basisFile.empty()) {
+    loadBasis(basisFile);
+    return;
+  }
+
   // input data is the transpose of the snapshot matrix
   std::string inputData = specificSettingsMOR_.getOptionString("snapshots", "");
   std::cout << inputData;
@@ -145,6 +153,111 @@ void MORBase<FunctionSpaceRowsType>::setBasis() {
   }
 }
 
+template <typename FunctionSpaceRowsType>
+void MORBase<FunctionSpaceRowsType>::loadBasis(std::string filename) {
+  LOG(TRACE) << "MORBase::loadBasis(" << filename << ")";
+
+  PetscErrorCode ierr;
+  Mat &basis = this->dataMOR_->basis()->valuesGlobal();
+  Mat &basisTransp = this->dataMOR_->basisTransp()->valuesGlobal();
+
+  PetscInt nRows, nColumns;
+  MatGetSize(basis, &nRows, &nColumns);
+
+  std::shared_ptr<Partition::MeshPartition<FunctionSpaceRowsType>>
+      meshPartition = this->dataMOR_->basis()->meshPartitionRows();
+  MPI_Comm mpiCommunicator = meshPartition->mpiCommunicator();
+
+  // the file contains the singular values, followed by the basis vectors, all
+  // ranks read it together into distributed vectors
+  PetscViewer viewer;
+  ierr = PetscViewerBinaryOpen(mpiCommunicator, filename.c_str(),
+                               FILE_MODE_READ, &viewer);
+  CHKERRV(ierr);
+
+  Vec singularValues;
+  ierr = VecCreate(mpiCommunicator, &singularValues);
+  CHKERRV(ierr);
+  ierr = VecLoad(singularValues, viewer);
+  CHKERRV(ierr);
+
+  PetscInt nBasesFile;
+  VecGetSize(singularValues, &nBasesFile);
+  VecDestroy(&singularValues);
+  if (nBasesFile < nColumns) {
+    LOG(FATAL) << "File \"" << filename << "\" contains " << nBasesFile
+               << " basis vectors, but " << nColumns
+               << " modes are required for the basis.";
+  }
+
+  // the rows of the basis are the first component of the vectors in the file,
+  // in global PETSc dof numbering, every rank gets its own rows
+  const dof_no_t nRowsLocal = meshPartition->nDofsLocalWithoutGhosts();
+  std::vector<PetscInt> rowNos(nRowsLocal);
+  for (dof_no_t dofNoLocal = 0; dofNoLocal < nRowsLocal; dofNoLocal++)
+    rowNos[dofNoLocal] = meshPartition->getDofNoGlobalPetsc(dofNoLocal);
+
+  IS rowsIndexSet;
+  ierr = ISCreateGeneral(PETSC_COMM_SELF, nRowsLocal, rowNos.data(),
+                         PETSC_COPY_VALUES, &rowsIndexSet);
+  CHKERRV(ierr);
+  Vec localValues;
+  ierr = VecCreateSeq(PETSC_COMM_SELF, nRowsLocal, &localValues);
+  CHKERRV(ierr);
+
+  for (PetscInt columnNo = 0; columnNo < nColumns; columnNo++) {
+    Vec basisVector;
+    ierr = VecCreate(mpiCommunicator, &basisVector);
+    CHKERRV(ierr);
+    ierr = VecLoad(basisVector, viewer);
+    CHKERRV(ierr);
+
+    PetscInt nRowsFile;
+    VecGetSize(basisVector, &nRowsFile);
+    if (nRowsFile < nRows) {
+      LOG(FATAL) << "basis vectors in \"" << filename << "\" have the length "
+                 << nRowsFile << " but the basis has the length " << nRows;
+    }
+
+    VecScatter scatter;
+    ierr = VecScatterCreate(basisVector, rowsIndexSet, localValues, NULL,
+                            &scatter);
+    CHKERRV(ierr);
+    ierr = VecScatterBegin(scatter, basisVector, localValues, INSERT_VALUES,
+                           SCATTER_FORWARD);
+    CHKERRV(ierr);
+    ierr = VecScatterEnd(scatter, basisVector, localValues, INSERT_VALUES,
+                         SCATTER_FORWARD);
+    CHKERRV(ierr);
+    VecScatterDestroy(&scatter);
+    VecDestroy(&basisVector);
+
+    const double *values;
+    VecGetArrayRead(localValues, &values);
+    ierr = MatSetValues(basis, nRowsLocal, rowNos.data(), 1, &columnNo, values,
+                        INSERT_VALUES);
+    CHKERRV(ierr);
+    VecRestoreArrayRead(localValues, &values);
+  }
+  PetscViewerDestroy(&viewer);
+  VecDestroy(&localValues);
+  ISDestroy(&rowsIndexSet);
+
+  MatAssemblyBegin(basis, MAT_FINAL_ASSEMBLY);
+  MatAssemblyEnd(basis, MAT_FINAL_ASSEMBLY);
+
+  // the transposed matrix has the same parallel layout as basisTransp
+  Mat transposedBasis;
+  ierr = MatTranspose(basis, MAT_INITIAL_MATRIX, &transposedBasis);
+  CHKERRV(ierr);
+  ierr = MatCopy(transposedBasis, basisTransp, SAME_NONZERO_PATTERN);
+  CHKERRV(ierr);
+  MatDestroy(&transposedBasis);
+
+  MatAssemblyBegin(basisTransp, MAT_FINAL_ASSEMBLY);
+  MatAssemblyEnd(basisTransp, MAT_FINAL_ASSEMBLY);
+}
+
 template <typename FunctionSpaceRowsType>
 Data::ModelOrderReduction<FunctionSpaceRowsType> &
 MORBase<FunctionSpaceRowsType>::dataMOR() {
@@ -3,6 +3,7 @@
 #include "control/dihu_context.h"
 #include "function_space/function_space.h"
 #include "model_order_reduction/time_stepping_scheme_ode_reduced.h"
+#include "model_order_reduction/deim_right_hand_side.h"
 
 namespace ModelOrderReduction {
 template <typename TimeSteppingExplicitType>
@@ -23,7 +24,33 @@ public:
                                                  int timeStepNo,
                                                  double currentTime);
 
+  //! evaluates the reduced right hand side V^T f(V*input) with the discrete
+  //! empirical interpolation method (DEIM), only the sampled instances of the
+  //! full-order right hand side are computed
+  void evaluateReducedRightHandSideDeim(Vec &redInput, Vec &redOutput,
+                                        int timeStepNo, double currentTime);
+
+  //! if the nonlinear term is approximated by DEIM, i.e. the option
+  //! "nonlinearSnapshots" was given
+  bool deimEnabled();
+
 protected:
+  //! compute the DEIM basis from the snapshots of the nonlinear term, select
+  //! the interpolation indices and precompute the projection matrix
+  void initializeDeim();
+
+  bool deimEnabled_; //< if DEIM is used for the right hand side
+  std::vector<int>
+      deimInstanceNos_; //< the instances that contain a DEIM index, in order
+  std::vector<int> deimSampledRowNos_; //< for every DEIM index the row in
+                                       // deimStates_ and deimRates_
+  std::vector<double>
+      deimBasisSampled_; //< rows of the basis V for all states of the sampled
+                         // instances, row-major
+  std::vector<double> deimProjection_; //< V^T U (P^T U)^-1, nReducedBases x
+                                       // nDeimBases, row-major
+  std::vector<double> deimStates_; //< states of the sampled instances
+  std::vector<double> deimRates_;  //< rates of the sampled instances
 };
 
 } // namespace ModelOrderReduction
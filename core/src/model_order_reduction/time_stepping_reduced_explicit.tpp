@@ -2,14 +2,19 @@
 
 #include <Python.h>
 #include <petscmat.h>
+#include <algorithm>
+#include <numeric>
+#include <set>
 #include "utility/python_utility.h"
 #include "utility/petsc_utility.h"
+#include "utility/svd_utility.h"
 
 namespace ModelOrderReduction {
 template <typename TimeSteppingExplicitType>
 TimeSteppingSchemeOdeReducedExplicit<TimeSteppingExplicitType>::
     TimeSteppingSchemeOdeReducedExplicit(DihuContext context, std::string name)
-    : TimeSteppingSchemeOdeReduced<TimeSteppingExplicitType>(context, name) {}
+    : TimeSteppingSchemeOdeReduced<TimeSteppingExplicitType>(context, name),
+      deimEnabled_(false) {}
 
 template <typename TimeSteppingExplicitType>
 void TimeSteppingSchemeOdeReducedExplicit<
@@ -22,6 +27,8 @@ void TimeSteppingSchemeOdeReducedExplicit<
 
   TimeSteppingSchemeOdeReduced<TimeSteppingExplicitType>::initialize();
 
+  initializeDeim();
+
   this->initialized_ = true;
 }
 
@@ -33,10 +40,197 @@ void TimeSteppingSchemeOdeReducedExplicit<TimeSteppingExplicitType>::
   this->fullTimestepping_.discretizableInTime()
       .evaluateTimesteppingRightHandSideExplicit(input, output, timeStepNo,
                                                  currentTime);
+}
+
+template <typename TimeSteppingExplicitType>
+void TimeSteppingSchemeOdeReducedExplicit<
+    TimeSteppingExplicitType>::initializeDeim() {
+  typedef typename TimeSteppingExplicitType::DiscretizableInTime
+      DiscretizableInTime;
+
+  // the snapshots of the nonlinear term, i.e. of the full-order right hand
+  // side, input data is the transpose of the snapshot matrix
+  std::string nonlinearSnapshots =
+      this->specificSettingsMOR_.getOptionString("nonlinearSnapshots", "");
+  deimEnabled_ = !nonlinearSnapshots.empty();
+  if (!deimEnabled_)
+    return;
+
+  LOG(TRACE) << "TimeSteppingSchemeOdeReducedExplicit::initializeDeim()";
+
+  // the basis values are gathered with MatGetValues, which only gets values
+  // of the own rank
+  int nRanks =
+      this->fullTimestepping_.data().functionSpace()->meshPartition()->nRanks();
+  if (nRanks > 1) {
+    LOG(FATAL) << this->specificSettingsMOR_ << "[\"nonlinearSnapshots\"] "
+               << "is set, but DEIM is only implemented for serial execution.";
+  }
+
+  // get the sizes of the full-order solution and the basis
+  PetscInt nRowsFull;
+  Vec &solution =
+      this->fullTimestepping_.data().solution()->getValuesContiguous();
+  VecGetSize(solution, &nRowsFull);
+  this->fullTimestepping_.data().solution()->restoreValuesContiguous();
+
+  const int nStates = DiscretizableInTime::nComponents();
+  const int nInstances = nRowsFull / nStates;
+
+  Mat &basis = this->dataMOR_->basis()->valuesGlobal();
+  PetscInt nRowsBasis, nReducedBases;
+  MatGetSize(basis, &nRowsBasis, &nReducedBases);
+
+  std::vector<double> parsedCSV = SvdUtility::readCSV(nonlinearSnapshots);
+  int nSnapshots = SvdUtility::getCSVRowCount(nonlinearSnapshots);
+  int rowsSnapshots = SvdUtility::getCSVColumnCount(nonlinearSnapshots);
+  if (rowsSnapshots < nRowsFull || nRowsBasis < nRowsFull) {
+    LOG(FATAL) << "Snapshots of the nonlinear term have the length "
+               << rowsSnapshots << " and the basis has the length "
+               << nRowsBasis << " but the full-order solution has the length "
+               << nRowsFull << ".";
+  }
+
+  int n = std::min(rowsSnapshots, nSnapshots);
+  int nDeimBases = this->specificSettingsMOR_.getOptionInt(
+      "nDeimBases", nReducedBases, PythonUtility::Positive);
+  if (nDeimBases > n) {
+    LOG(WARNING) << this->specificSettingsMOR_ << "[\"nDeimBases\"] is "
+                 << nDeimBases << ", but there are only " << n
+                 << " singular vectors of the nonlinear snapshots. Using "
+                 << n << " DEIM bases.";
+    nDeimBases = n;
+  }
+
+  // the DEIM basis U consists of the first left singular vectors of the
+  // nonlinear snapshots, restricted to the rows of the full-order solution
+  std::vector<double> leftSingVec(rowsSnapshots * n);
+  std::vector<double> sigma(n * n);
+  std::vector<double> rightSingVecT(n * nSnapshots);
+  SvdUtility::getSVD(parsedCSV.data(), rowsSnapshots, nSnapshots,
+                     leftSingVec.data(), sigma.data(), rightSingVecT.data());
+
+  std::vector<double> deimBasis(nRowsFull * nDeimBases);
+  for (int j = 0; j < nDeimBases; j++)
+    for (int i = 0; i < nRowsFull; i++)
+      deimBasis[j * nRowsFull + i] = leftSingVec[j * rowsSnapshots + i];
+
+  // select the interpolation indices P
+  std::vector<int> deimIndices =
+      SvdUtility::getDEIMIndices(deimBasis.data(), nRowsFull, nDeimBases);
+
+  // get the values of the basis V, row-major
+  std::vector<double> basisValues(nRowsFull * nReducedBases);
+  std::vector<PetscInt> columnNos(nReducedBases);
+  std::iota(columnNos.begin(), columnNos.end(), 0);
+  for (PetscInt rowNo = 0; rowNo < nRowsFull; rowNo++) {
+    MatGetValues(basis, 1, &rowNo, nReducedBases, columnNos.data(),
+                 basisValues.data() + rowNo * nReducedBases);
+  }
+
+  // compute the projection M = V^T U (P^T U)^-1 by solving
+  // (P^T U)^T M^T = U^T V, the column-major M^T is the row-major M
+  std::vector<double> interpolationMatrixT(nDeimBases * nDeimBases);
+  for (int i = 0; i < nDeimBases; i++)
+    for (int j = 0; j < nDeimBases; j++)
+      interpolationMatrixT[i * nDeimBases + j] =
+          deimBasis[j * nRowsFull + deimIndices[i]];
 
-  // for implementing DEIM
-  // ISCreateGeneral(comm,n, idx[],mode,&is);
-  // VecGetSubVector(X,is,&Y) should it be called every time step?
+  deimProjection_.assign(nReducedBases * nDeimBases, 0.0);
+  for (int k = 0; k < nReducedBases; k++)
+    for (int j = 0; j < nDeimBases; j++)
+      for (int i = 0; i < nRowsFull; i++)
+        deimProjection_[k * nDeimBases + j] +=
+            deimBasis[j * nRowsFull + i] * basisValues[i * nReducedBases + k];
+
+  if (!SvdUtility::solveLinearSystem(interpolationMatrixT.data(), nDeimBases,
+                                     deimProjection_.data(), nReducedBases)) {
+    LOG(FATAL) << "The DEIM interpolation matrix P^T U of the nonlinear "
+               << "snapshots \"" << nonlinearSnapshots << "\" is singular.";
+  }
+
+  // determine the instances that have to be evaluated, the values are stored
+  // in struct-of-array order, i.e. row = stateNo*nInstances + instanceNo
+  std::set<int> instanceNos;
+  for (int index : deimIndices)
+    instanceNos.insert(index % nInstances);
+  deimInstanceNos_.assign(instanceNos.begin(), instanceNos.end());
+  const int nSampledInstances = deimInstanceNos_.size();
+
+  deimSampledRowNos_.clear();
+  for (int index : deimIndices) {
+    int stateNo = index / nInstances;
+    int position = std::lower_bound(deimInstanceNos_.begin(),
+                                    deimInstanceNos_.end(),
+                                    index % nInstances) -
+                   deimInstanceNos_.begin();
+    deimSampledRowNos_.push_back(stateNo * nSampledInstances + position);
+  }
+
+  // extract the rows of V for all states of the sampled instances
+  deimBasisSampled_.resize(nStates * nSampledInstances * nReducedBases);
+  for (int stateNo = 0; stateNo < nStates; stateNo++) {
+    for (int i = 0; i < nSampledInstances; i++) {
+      int rowNo = stateNo * nInstances + deimInstanceNos_[i];
+      std::copy(basisValues.begin() + rowNo * nReducedBases,
+                basisValues.begin() + (rowNo + 1) * nReducedBases,
+                deimBasisSampled_.begin() +
+                    (stateNo * nSampledInstances + i) * nReducedBases);
+    }
+  }
+
+  deimStates_.resize(nStates * nSampledInstances);
+  deimRates_.resize(nStates * nSampledInstances);
+
+  LOG(INFO) << "DEIM with " << nDeimBases << " bases evaluates "
+            << nSampledInstances << " of " << nInstances << " instances.";
+}
+
+template <typename TimeSteppingExplicitType>
+void TimeSteppingSchemeOdeReducedExplicit<TimeSteppingExplicitType>::
+    evaluateReducedRightHandSideDeim(Vec &redInput, Vec &redOutput,
+                                     int timeStepNo, double currentTime) {
+  typedef typename TimeSteppingExplicitType::DiscretizableInTime
+      DiscretizableInTime;
+
+  const int nDeimBases = deimSampledRowNos_.size();
+  const int nSampledRows = deimStates_.size();
+  PetscInt nReducedBases;
+  VecGetLocalSize(redInput, &nReducedBases);
+
+  // reconstruct the states of the sampled instances from the reduced solution
+  const double *redInputValues;
+  VecGetArrayRead(redInput, &redInputValues);
+  for (int rowNo = 0; rowNo < nSampledRows; rowNo++) {
+    double value = 0;
+    for (int k = 0; k < nReducedBases; k++)
+      value += deimBasisSampled_[rowNo * nReducedBases + k] * redInputValues[k];
+    deimStates_[rowNo] = value;
+  }
+  VecRestoreArrayRead(redInput, &redInputValues);
+
+  // evaluate the full-order right hand side only for the sampled instances
+  DeimRightHandSide<DiscretizableInTime>::evaluateInstances(
+      this->fullTimestepping_.discretizableInTime(), deimInstanceNos_,
+      currentTime, deimStates_, deimRates_);
+
+  // project the interpolated right hand side, redOutput = M P^T f
+  double *redOutputValues;
+  VecGetArray(redOutput, &redOutputValues);
+  for (int k = 0; k < nReducedBases; k++) {
+    double value = 0;
+    for (int j = 0; j < nDeimBases; j++)
+      value += deimProjection_[k * nDeimBases + j] *
+               deimRates_[deimSampledRowNos_[j]];
+    redOutputValues[k] = value;
+  }
+  VecRestoreArray(redOutput, &redOutputValues);
+}
+
+template <typename TimeSteppingExplicitType>
+bool TimeSteppingSchemeOdeReducedExplicit<
+    TimeSteppingExplicitType>::deimEnabled() {
+  return deimEnabled_;
 }
 
 } // namespace ModelOrderReduction
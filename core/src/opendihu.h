@@ -31,6 +31,9 @@
 #include "time_stepping_scheme/explicit_euler.h"
 #include "time_stepping_scheme/implicit_euler.h"
 #include "time_stepping_scheme/heun.h"
+#include "time_stepping_scheme/ssp_runge_kutta_3.h"
+#include "time_stepping_scheme/runge_kutta_chebyshev.h"
+#include "time_stepping_scheme/adaptive_runge_kutta.h"
 #include "time_stepping_scheme/repeated_call.h"
 #include "time_stepping_scheme/repeated_call_static.h"
 #include "specialized_solver/multidomain_solver/multidomain_solver.h"
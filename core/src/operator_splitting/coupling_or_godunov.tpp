@@ -13,7 +13,7 @@ void CouplingOrGodunov<TimeStepping1, TimeStepping2>::advanceTimeSpan(
   // start duration measurement, the name of the output variable can be set by
   // "durationLogKey" in the config
   if (this->durationLogKey_ != "")
-    Control::PerformanceMeasurement::start(this->durationLogKey_);
+    Control::PerformanceMeasurement::start(this->durationLogKeyId_);
 
   // compute timestep width
   double timeSpan = this->endTime_ - this->startTime_;
@@ -52,7 +52,7 @@ void CouplingOrGodunov<TimeStepping1, TimeStepping2>::advanceTimeSpan(
 
     if (this->durationLogKey_ != "") {
       Control::PerformanceMeasurement::start(
-          this->logKeyTimeStepping1AdvanceTimeSpan_);
+          this->logKeyTimeStepping1AdvanceTimeSpanId_);
     }
 
     // advance simulation by time span
@@ -60,8 +60,8 @@ void CouplingOrGodunov<TimeStepping1, TimeStepping2>::advanceTimeSpan(
 
     if (this->durationLogKey_ != "") {
       Control::PerformanceMeasurement::stop(
-          this->logKeyTimeStepping1AdvanceTimeSpan_);
-      Control::PerformanceMeasurement::start(this->logKeyTransfer12_);
+          this->logKeyTimeStepping1AdvanceTimeSpanId_);
+      Control::PerformanceMeasurement::start(this->logKeyTransfer12Id_);
     }
 
     // --------------- data transfer 1->2 -------------------------
@@ -103,9 +103,9 @@ void CouplingOrGodunov<TimeStepping1, TimeStepping2>::advanceTimeSpan(
                      getString(this->timeStepping2_.getSlotConnectorData());
 
     if (this->durationLogKey_ != "") {
-      Control::PerformanceMeasurement::stop(this->logKeyTransfer12_);
+      Control::PerformanceMeasurement::stop(this->logKeyTransfer12Id_);
       Control::PerformanceMeasurement::start(
-          this->logKeyTimeStepping2AdvanceTimeSpan_);
+          this->logKeyTimeStepping2AdvanceTimeSpanId_);
     }
 
     // --------------- time stepping 2, time span = [0,dt]
@@ -124,8 +124,8 @@ void CouplingOrGodunov<TimeStepping1, TimeStepping2>::advanceTimeSpan(
 
     if (this->durationLogKey_ != "") {
       Control::PerformanceMeasurement::stop(
-          this->logKeyTimeStepping2AdvanceTimeSpan_);
-      Control::PerformanceMeasurement::start(this->logKeyTransfer21_);
+          this->logKeyTimeStepping2AdvanceTimeSpanId_);
+      Control::PerformanceMeasurement::start(this->logKeyTransfer21Id_);
     }
 
     // --------------- data transfer 2->1 -------------------------
@@ -153,7 +153,7 @@ void CouplingOrGodunov<TimeStepping1, TimeStepping2>::advanceTimeSpan(
           << this->timeStepping1_.getSlotConnectorData();
 
     if (this->durationLogKey_ != "") {
-      Control::PerformanceMeasurement::stop(this->logKeyTransfer21_);
+      Control::PerformanceMeasurement::stop(this->logKeyTransfer21Id_);
     }
 
     // advance simulation time
@@ -169,6 +169,6 @@ void CouplingOrGodunov<TimeStepping1, TimeStepping2>::advanceTimeSpan(
 
   // stop duration measurement
   if (this->durationLogKey_ != "")
-    Control::PerformanceMeasurement::stop(this->durationLogKey_);
+    Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
 }
 } // namespace OperatorSplitting
@@ -94,6 +94,12 @@ protected:
                                  // transfer from timestepping 1 to 2
   std::string logKeyTransfer21_; //< key for logging of the duration of data
                                  // transfer from timestepping 2 to 1
+  int logKeyTimeStepping1AdvanceTimeSpanId_; //< handle of the duration
+                                             // measurement of timeStepping1
+  int logKeyTimeStepping2AdvanceTimeSpanId_; //< handle of the duration
+                                             // measurement of timeStepping2
+  int logKeyTransfer12Id_; //< handle of the measurement logKeyTransfer12_
+  int logKeyTransfer21Id_; //< handle of the measurement logKeyTransfer21_
 
   std::shared_ptr<SlotsConnection>
       slotsConnection_; //< information regarding the mapping between the data
@@ -24,7 +24,9 @@ OperatorSplitting<TimeStepping1, TimeStepping2>::OperatorSplitting(
     : ::TimeSteppingScheme::TimeSteppingScheme(context),
       timeStepping1_(context_[schemeName]["Term1"]),
       timeStepping2_(context_[schemeName]["Term2"]),
-      data_(context_[schemeName]), initialized_(false) {
+      data_(context_[schemeName]), logKeyTimeStepping1AdvanceTimeSpanId_(-1),
+      logKeyTimeStepping2AdvanceTimeSpanId_(-1), logKeyTransfer12Id_(-1),
+      logKeyTransfer21Id_(-1), initialized_(false) {
 
   PythonConfig topLevelSettings = context_.getPythonConfig();
   specificSettings_ = PythonConfig(topLevelSettings, schemeName);
@@ -40,7 +42,9 @@ OperatorSplitting<TimeStepping1, TimeStepping2>::OperatorSplitting(
     : ::TimeSteppingScheme::TimeSteppingScheme(context),
       timeStepping1_(std::move(timeStepping1)),
       timeStepping2_(std::move(timeStepping2)), data_(context_),
-      initialized_(false) {
+      logKeyTimeStepping1AdvanceTimeSpanId_(-1),
+      logKeyTimeStepping2AdvanceTimeSpanId_(-1), logKeyTransfer12Id_(-1),
+      logKeyTransfer21Id_(-1), initialized_(false) {
   specificSettings_ = context_.getPythonConfig();
   schemeName_ = schemeName;
 
@@ -147,6 +151,21 @@ void OperatorSplitting<TimeStepping1, TimeStepping2>::initialize() {
       std::string("_transfer21"); //< key for logging of the duration of data
                                   // transfer from timestepping 2 to 1
 
+  // register the measurements of the splitting steps, they are only used if
+  // durationLogKey is set
+  if (this->durationLogKey_ != "") {
+    logKeyTimeStepping1AdvanceTimeSpanId_ =
+        Control::PerformanceMeasurement::registerMeasurement(
+            logKeyTimeStepping1AdvanceTimeSpan_);
+    logKeyTimeStepping2AdvanceTimeSpanId_ =
+        Control::PerformanceMeasurement::registerMeasurement(
+            logKeyTimeStepping2AdvanceTimeSpan_);
+    logKeyTransfer12Id_ =
+        Control::PerformanceMeasurement::registerMeasurement(logKeyTransfer12_);
+    logKeyTransfer21Id_ =
+        Control::PerformanceMeasurement::registerMeasurement(logKeyTransfer21_);
+  }
+
   // add the slot connections that were given in the global field
   // "connectedSlots" to the slotConnection_ object of this splitting scheme
   DihuContext::globalConnectionsBySlotName()->addConnections(
@@ -15,6 +15,19 @@ public:
 
   //! advance time stepping by span
   void advanceTimeSpan(bool withOutputWritersEnabled = true);
+
+protected:
+  bool fuseHalfSteps_; //< if the second half step of timeStepping1 of a time
+                       // step is combined with the first half step of the next
+                       // time step to a single call over the full step width
+  int fuseHalfStepsOutputInterval_; //< when fuseHalfSteps_ is set, every this
+                                    // number of time steps the full Strang
+                                    // step is completed, 0 means only at the
+                                    // end of the time span
+  bool isFusedNumberTimeStepsWarningShown_; //< if the warning was shown that
+                                            // timeStepping1 cannot compute the
+                                            // fused half steps with the time
+                                            // step width of a half step
 };
 
 } // namespace OperatorSplitting
@@ -6,10 +6,47 @@
 
 namespace OperatorSplitting {
 
+namespace StrangFusedHalfSteps {
+
+//! get the number of time steps of a time stepping scheme in its current time
+//! span, -1 if the scheme does not have a number of time steps
+template <typename TimeStepping>
+auto numberTimeSteps(TimeStepping &timeStepping, int)
+    -> decltype(int(timeStepping.numberTimeSteps())) {
+  return timeStepping.numberTimeSteps();
+}
+
+template <typename TimeStepping>
+int numberTimeSteps(TimeStepping &, long) {
+  return -1;
+}
+
+//! set the number of time steps of a time stepping scheme in its current time
+//! span, return false if the scheme does not allow this
+template <typename TimeStepping>
+auto setNumberTimeSteps(TimeStepping &timeStepping, int numberTimeSteps, int)
+    -> decltype(timeStepping.setNumberTimeSteps(numberTimeSteps), bool()) {
+  timeStepping.setNumberTimeSteps(numberTimeSteps);
+  return true;
+}
+
+template <typename TimeStepping>
+bool setNumberTimeSteps(TimeStepping &, int, long) {
+  return false;
+}
+
+} // namespace StrangFusedHalfSteps
+
 template <typename TimeStepping1, typename TimeStepping2>
 Strang<TimeStepping1, TimeStepping2>::Strang(DihuContext context)
     : OperatorSplitting<TimeStepping1, TimeStepping2>(context,
-                                                      "StrangSplitting") {}
+                                                      "StrangSplitting") {
+  fuseHalfSteps_ =
+      this->specificSettings_.getOptionBool("fuseHalfSteps", false);
+  fuseHalfStepsOutputInterval_ = this->specificSettings_.getOptionInt(
+      "fuseHalfStepsOutputInterval", 0, PythonUtility::NonNegative);
+  isFusedNumberTimeStepsWarningShown_ = false;
+}
 
 template <typename TimeStepping1, typename TimeStepping2>
 void Strang<TimeStepping1, TimeStepping2>::advanceTimeSpan(
@@ -19,7 +56,7 @@ void Strang<TimeStepping1, TimeStepping2>::advanceTimeSpan(
   // start duration measurement, the name of the output variable can be set by
   // "durationLogKey" in the config
   if (this->durationLogKey_ != "")
-    Control::PerformanceMeasurement::start(this->durationLogKey_);
+    Control::PerformanceMeasurement::start(this->durationLogKeyId_);
 
   // compute timestep width
   double timeSpan = this->endTime_ - this->startTime_;
@@ -39,9 +76,42 @@ void Strang<TimeStepping1, TimeStepping2>::advanceTimeSpan(
   //        |
   //        2
 
+  // With fuseHalfSteps_, the second half step of timeStepping1 of time step n
+  // is not computed at the end of step n, but together with the first half
+  // step of step n+1 in a single call over [midTime_n, midTime_n+1]. This is
+  // the same as before, because there is no transfer between these two half
+  // steps. The state at the end of a full time step is then not computed,
+  // therefore the last half step is done at the end of the time span and every
+  // fuseHalfStepsOutputInterval_ time steps, where timeStepping1 then has
+  // Strang-accurate values, e.g. for output. The output writers of the nested
+  // solvers see intermediate states that are half a step ahead in the fused
+  // steps, therefore they are disabled except in the second half step of
+  // timeStepping1 and in timeStepping2 of the completed time steps.
+  // ===== t ==>
+  // -1->
+  //  /
+  // ---2--->
+  //      /
+  //     ---1--->
+  //           /
+  //        ---2--->
+  //             /
+  //            -1->
+
   // loop over time steps
   double currentTime = this->startTime_;
   double midTime = 0.0;
+  double previousMidTime = 0.0;
+
+  // if the second half step of timeStepping1 of the previous time step has not
+  // yet been computed
+  bool isHalfStepPending = false;
+
+  // number of time steps of timeStepping1 in a half step, -1 if unknown
+  int nTimeSteps1HalfStep = -1;
+
+  // number of time steps of timeStepping1 in a fused step, if it was doubled
+  int nTimeSteps1Fused = -1;
 
   for (int timeStepNo = 0; timeStepNo < this->numberTimeSteps_;) {
     // compute midTime once per step to reuse it. [currentTime,
@@ -59,27 +129,83 @@ void Strang<TimeStepping1, TimeStepping2>::advanceTimeSpan(
 
     LOG(DEBUG) << "  Strang: time step " << timeStepNo
                << ", t: " << currentTime;
-    LOG(DEBUG) << "  Strang: timeStepping1 (first half) setTimeSpan ["
-               << currentTime << ", " << midTime << "]";
+
+    // determine if the second half step is deferred to the next time step
+    bool isLastTimeStep = timeStepNo == this->numberTimeSteps_ - 1;
+    bool completeTimeStep =
+        !fuseHalfSteps_ || isLastTimeStep ||
+        (fuseHalfStepsOutputInterval_ > 0 &&
+         (timeStepNo + 1) % fuseHalfStepsOutputInterval_ == 0);
+
+    // with fuseHalfSteps_, the nested output writers only write the completed
+    // time steps
+    bool withNestedOutputWritersEnabled =
+        withOutputWritersEnabled && completeTimeStep;
 
     // --------------- time stepping 1, time span = [0,midTime]
     // -------------------------
     if (this->durationLogKey_ != "")
       Control::PerformanceMeasurement::start(
-          this->logKeyTimeStepping1AdvanceTimeSpan_);
+          this->logKeyTimeStepping1AdvanceTimeSpanId_);
 
     // set timespan for timestepping1
-    this->timeStepping1_.setTimeSpan(currentTime, midTime);
+    if (isHalfStepPending) {
+      // fused second half of the previous step and first half of this step
+      LOG(DEBUG) << "  Strang: timeStepping1 (fused halves) setTimeSpan ["
+                 << previousMidTime << ", " << midTime << "]";
+      this->timeStepping1_.setTimeSpan(previousMidTime, midTime);
+      isHalfStepPending = false;
+
+      // a scheme with a fixed numberTimeSteps would compute the fused span of
+      // the full time step width with the number of time steps of a half step,
+      // i.e. with twice the time step width, then double its number of steps
+      nTimeSteps1Fused = StrangFusedHalfSteps::numberTimeSteps(
+          this->timeStepping1_, 0);
+      if (nTimeSteps1Fused > 0 && nTimeSteps1Fused == nTimeSteps1HalfStep) {
+        if (StrangFusedHalfSteps::setNumberTimeSteps(
+                this->timeStepping1_, 2 * nTimeSteps1HalfStep, 0)) {
+          LOG(DEBUG) << "  Strang: timeStepping1 (fused halves) uses "
+                     << 2 * nTimeSteps1HalfStep << " time steps";
+        } else {
+          nTimeSteps1Fused = -1;
+          if (!isFusedNumberTimeStepsWarningShown_) {
+            LOG(WARNING) << "StrangSplitting with \"fuseHalfSteps\": The "
+                         << "first timestepping scheme uses a fixed number "
+                         << "of time steps, the fused half steps are computed "
+                         << "with twice the time step width. Specify "
+                         << "\"timeStepWidth\" instead of \"numberTimeSteps"
+                         << "\" for this scheme.";
+            isFusedNumberTimeStepsWarningShown_ = true;
+          }
+        }
+      } else {
+        nTimeSteps1Fused = -1;
+      }
+    } else {
+      LOG(DEBUG) << "  Strang: timeStepping1 (first half) setTimeSpan ["
+                 << currentTime << ", " << midTime << "]";
+      this->timeStepping1_.setTimeSpan(currentTime, midTime);
+      nTimeSteps1HalfStep =
+          StrangFusedHalfSteps::numberTimeSteps(this->timeStepping1_, 0);
+    }
 
     LOG(DEBUG) << "  Strang: timeStepping1 (first half) advanceTimeSpan";
 
     // advance simulation by time span
-    this->timeStepping1_.advanceTimeSpan(withOutputWritersEnabled);
+    this->timeStepping1_.advanceTimeSpan(withOutputWritersEnabled &&
+                                         !fuseHalfSteps_);
+
+    // restore the number of time steps of a half step
+    if (nTimeSteps1Fused > 0) {
+      StrangFusedHalfSteps::setNumberTimeSteps(this->timeStepping1_,
+                                               nTimeSteps1HalfStep, 0);
+      nTimeSteps1Fused = -1;
+    }
 
     if (this->durationLogKey_ != "") {
       Control::PerformanceMeasurement::stop(
-          this->logKeyTimeStepping1AdvanceTimeSpan_);
-      Control::PerformanceMeasurement::start(this->logKeyTransfer12_);
+          this->logKeyTimeStepping1AdvanceTimeSpanId_);
+      Control::PerformanceMeasurement::start(this->logKeyTransfer12Id_);
     }
 
     // --------------- data transfer 1->2 -------------------------
@@ -96,9 +222,9 @@ void Strang<TimeStepping1, TimeStepping2>::advanceTimeSpan(
                  *this->slotsConnection_);
 
     if (this->durationLogKey_ != "") {
-      Control::PerformanceMeasurement::stop(this->logKeyTransfer12_);
+      Control::PerformanceMeasurement::stop(this->logKeyTransfer12Id_);
       Control::PerformanceMeasurement::start(
-          this->logKeyTimeStepping2AdvanceTimeSpan_);
+          this->logKeyTimeStepping2AdvanceTimeSpanId_);
     }
 
     // --------------- time stepping 2, time span = [0,dt]
@@ -112,12 +238,12 @@ void Strang<TimeStepping1, TimeStepping2>::advanceTimeSpan(
                                      currentTime + this->timeStepWidth_);
 
     // advance simulation by time span
-    this->timeStepping2_.advanceTimeSpan(withOutputWritersEnabled);
+    this->timeStepping2_.advanceTimeSpan(withNestedOutputWritersEnabled);
 
     if (this->durationLogKey_ != "") {
       Control::PerformanceMeasurement::stop(
-          this->logKeyTimeStepping2AdvanceTimeSpan_);
-      Control::PerformanceMeasurement::start(this->logKeyTransfer21_);
+          this->logKeyTimeStepping2AdvanceTimeSpanId_);
+      Control::PerformanceMeasurement::start(this->logKeyTransfer21Id_);
     }
 
     // --------------- data transfer 2->1 -------------------------
@@ -133,26 +259,35 @@ void Strang<TimeStepping1, TimeStepping2>::advanceTimeSpan(
                  this->timeStepping1_.getSlotConnectorData(),
                  *this->slotsConnection_);
 
-    if (this->durationLogKey_ != "") {
-      Control::PerformanceMeasurement::stop(this->logKeyTransfer21_);
-      Control::PerformanceMeasurement::start(
-          this->logKeyTimeStepping1AdvanceTimeSpan_);
-    }
-
-    // --------------- time stepping 1, time span = [midTime,dt]
-    // -------------------------
-    LOG(DEBUG) << "  Strang: timeStepping1 (second half) advanceTimeSpan ["
-               << midTime << ", " << currentTime + this->timeStepWidth_ << "]";
-    // set timespan for timestepping1
-    this->timeStepping1_.setTimeSpan(midTime,
-                                     currentTime + this->timeStepWidth_);
-
-    // advance simulation by time span
-    this->timeStepping1_.advanceTimeSpan(withOutputWritersEnabled);
-
-    if (this->durationLogKey_ != "") {
-      Control::PerformanceMeasurement::stop(
-          this->logKeyTimeStepping1AdvanceTimeSpan_);
+    if (this->durationLogKey_ != "")
+      Control::PerformanceMeasurement::stop(this->logKeyTransfer21Id_);
+
+    if (!completeTimeStep) {
+      LOG(DEBUG) << "  Strang: timeStepping1 (second half) is fused with the "
+                 << "next time step";
+      isHalfStepPending = true;
+      previousMidTime = midTime;
+    } else {
+      if (this->durationLogKey_ != "")
+        Control::PerformanceMeasurement::start(
+            this->logKeyTimeStepping1AdvanceTimeSpanId_);
+
+      // --------------- time stepping 1, time span = [midTime,dt]
+      // -------------------------
+      LOG(DEBUG) << "  Strang: timeStepping1 (second half) advanceTimeSpan ["
+                 << midTime << ", " << currentTime + this->timeStepWidth_
+                 << "]";
+      // set timespan for timestepping1
+      this->timeStepping1_.setTimeSpan(midTime,
+                                       currentTime + this->timeStepWidth_);
+
+      // advance simulation by time span
+      this->timeStepping1_.advanceTimeSpan(withNestedOutputWritersEnabled);
+
+      if (this->durationLogKey_ != "") {
+        Control::PerformanceMeasurement::stop(
+            this->logKeyTimeStepping1AdvanceTimeSpanId_);
+      }
     }
 
     /* option 1. (implemented)
@@ -197,7 +332,7 @@ void Strang<TimeStepping1, TimeStepping2>::advanceTimeSpan(
 
   // stop duration measurement
   if (this->durationLogKey_ != "")
-    Control::PerformanceMeasurement::stop(this->durationLogKey_);
+    Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
 }
 
 } // namespace OperatorSplitting
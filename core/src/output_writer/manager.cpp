@@ -8,6 +8,7 @@
 #include "output_writer/paraview/paraview.h"
 #include "output_writer/exfile/exfile.h"
 #include "output_writer/megamol/megamol.h"
+#include "output_writer/pod_basis/pod_basis.h"
 
 namespace OutputWriter {
 
@@ -104,10 +105,14 @@ void Manager::createOutputWriterFromSettings(
       LOG(ERROR) << "Not compiled with ADIOS, but a \"MegaMol\" output writer "
                     "was specified. Ignoring this output writer.";
 #endif
+    } else if (typeString == "PodBasis") {
+      outputWriter_.push_back(
+          std::make_shared<PodBasis>(context, settings, rankSubset));
     } else {
       LOG(WARNING) << "Unknown output writer type \"" << typeString << "\". "
                    << "Valid options are: \"Paraview\", \"PythonCallback\", "
-                      "\"PythonFile\", \"Exfile\", \"MegaMol\"";
+                      "\"PythonFile\", \"Exfile\", \"MegaMol\", "
+                      "\"PodBasis\"";
     }
   }
 }
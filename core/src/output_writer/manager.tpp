@@ -5,6 +5,7 @@
 #include "output_writer/paraview/paraview.h"
 #include "output_writer/exfile/exfile.h"
 #include "output_writer/megamol/megamol.h"
+#include "output_writer/pod_basis/pod_basis.h"
 #include "control/diagnostic_tool/performance_measurement.h"
 
 namespace OutputWriter {
@@ -12,68 +13,97 @@ namespace OutputWriter {
 template <typename DataType>
 void Manager::writeOutput(DataType &problemData, int timeStepNo,
                           double currentTime, int callCountIncrement) const {
-  // start duration measurement
-  Control::PerformanceMeasurement::start("durationWriteOutput");
+  // start duration measurement, the handles are registered at the first call
+  static const int durationWriteOutputId =
+      Control::PerformanceMeasurement::registerMeasurement(
+          "durationWriteOutput");
+  Control::PerformanceMeasurement::start(durationWriteOutputId);
 
   for (auto &outputWriter : this->outputWriter_) {
     if (std::dynamic_pointer_cast<Exfile>(outputWriter) != nullptr) {
       LogScope s("WriteOutputExfile");
-      Control::PerformanceMeasurement::start("durationWriteOutputExfile");
+      static const int durationId =
+          Control::PerformanceMeasurement::registerMeasurement(
+              "durationWriteOutputExfile");
+      Control::PerformanceMeasurement::start(durationId);
 
       std::shared_ptr<Exfile> writer =
           std::static_pointer_cast<Exfile>(outputWriter);
       writer->write<DataType>(problemData, timeStepNo, currentTime,
                               callCountIncrement);
 
-      Control::PerformanceMeasurement::stop("durationWriteOutputExfile");
+      Control::PerformanceMeasurement::stop(durationId);
     } else if (std::dynamic_pointer_cast<Paraview>(outputWriter) != nullptr) {
       LogScope s("WriteOutputParaview");
-      Control::PerformanceMeasurement::start("durationWriteOutputParaview");
+      static const int durationId =
+          Control::PerformanceMeasurement::registerMeasurement(
+              "durationWriteOutputParaview");
+      Control::PerformanceMeasurement::start(durationId);
 
       std::shared_ptr<Paraview> writer =
           std::static_pointer_cast<Paraview>(outputWriter);
       writer->write<DataType>(problemData, timeStepNo, currentTime,
                               callCountIncrement);
 
-      Control::PerformanceMeasurement::stop("durationWriteOutputParaview");
+      Control::PerformanceMeasurement::stop(durationId);
     } else if (std::dynamic_pointer_cast<PythonCallback>(outputWriter) !=
                nullptr) {
       LogScope s("WriteOutputPythonCallback");
-      Control::PerformanceMeasurement::start(
-          "durationWriteOutputPythonCallback");
+      static const int durationId =
+          Control::PerformanceMeasurement::registerMeasurement(
+              "durationWriteOutputPythonCallback");
+      Control::PerformanceMeasurement::start(durationId);
 
       std::shared_ptr<PythonCallback> writer =
           std::static_pointer_cast<PythonCallback>(outputWriter);
       writer->write<DataType>(problemData, timeStepNo, currentTime,
                               callCountIncrement);
 
-      Control::PerformanceMeasurement::stop(
-          "durationWriteOutputPythonCallback");
+      Control::PerformanceMeasurement::stop(durationId);
     } else if (std::dynamic_pointer_cast<PythonFile>(outputWriter) != nullptr) {
       LogScope s("WriteOutputPythonFile");
-      Control::PerformanceMeasurement::start("durationWriteOutputPythonFile");
+      static const int durationId =
+          Control::PerformanceMeasurement::registerMeasurement(
+              "durationWriteOutputPythonFile");
+      Control::PerformanceMeasurement::start(durationId);
 
       std::shared_ptr<PythonFile> writer =
           std::static_pointer_cast<PythonFile>(outputWriter);
       writer->write<DataType>(problemData, timeStepNo, currentTime,
                               callCountIncrement);
 
-      Control::PerformanceMeasurement::stop("durationWriteOutputPythonFile");
+      Control::PerformanceMeasurement::stop(durationId);
     } else if (std::dynamic_pointer_cast<MegaMol>(outputWriter) != nullptr) {
       LogScope s("WriteOutputMegamol");
-      Control::PerformanceMeasurement::start("durationWriteOutputMegamol");
+      static const int durationId =
+          Control::PerformanceMeasurement::registerMeasurement(
+              "durationWriteOutputMegamol");
+      Control::PerformanceMeasurement::start(durationId);
 
       std::shared_ptr<MegaMol> writer =
           std::static_pointer_cast<MegaMol>(outputWriter);
       writer->write<DataType>(problemData, timeStepNo, currentTime,
                               callCountIncrement);
 
-      Control::PerformanceMeasurement::stop("durationWriteOutputMegamol");
+      Control::PerformanceMeasurement::stop(durationId);
+    } else if (std::dynamic_pointer_cast<PodBasis>(outputWriter) != nullptr) {
+      LogScope s("WriteOutputPodBasis");
+      static const int durationId =
+          Control::PerformanceMeasurement::registerMeasurement(
+              "durationWriteOutputPodBasis");
+      Control::PerformanceMeasurement::start(durationId);
+
+      std::shared_ptr<PodBasis> writer =
+          std::static_pointer_cast<PodBasis>(outputWriter);
+      writer->write<DataType>(problemData, timeStepNo, currentTime,
+                              callCountIncrement);
+
+      Control::PerformanceMeasurement::stop(durationId);
     }
   }
 
   // stop duration measurement
-  Control::PerformanceMeasurement::stop("durationWriteOutput");
+  Control::PerformanceMeasurement::stop(durationWriteOutputId);
 }
 
 } // namespace OutputWriter
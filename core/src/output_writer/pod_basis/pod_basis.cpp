@@ -0,0 +1,271 @@
+#include "output_writer/pod_basis/pod_basis.h"
+
+#include <Python.h> // has to be the first included header
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <petscviewer.h>
+
+#include "easylogging++.h"
+#include "utility/python_utility.h"
+#include "utility/svd_utility.h"
+#include "utility/vector_operators.h"
+
+namespace OutputWriter {
+
+PodBasis::PodBasis(DihuContext context, PythonConfig settings,
+                   std::shared_ptr<Partition::RankSubset> rankSubset)
+    : Generic(context, settings, rankSubset), mpiCommunicator_(MPI_COMM_NULL),
+      nValuesLocal_(0), nRowsGlobal_(0), nSnapshotsInBlock_(0),
+      nSnapshots_(0) {
+  nBases_ = settings.getOptionInt("nBases", 10, PythonUtility::Positive);
+  blockSize_ = settings.getOptionInt("blockSize", 10, PythonUtility::Positive);
+  truncationTolerance_ = settings.getOptionDouble(
+      "truncationTolerance", 1e-12, PythonUtility::NonNegative);
+}
+
+PodBasis::~PodBasis() {
+  // PETSc is finalized after the solvers and their output writers are
+  // destroyed, if not, nothing can be done here
+  PetscBool isFinalized;
+  PetscFinalized(&isFinalized);
+  if (isFinalized)
+    return;
+
+  // merge the snapshots of the last incomplete block
+  if (nSnapshotsInBlock_ > 0) {
+    updateBasis();
+    writeBasis();
+  }
+
+  for (std::vector<Vec> *vectors : {&basis_, &snapshots_, &newBasis_}) {
+    for (Vec &vector : *vectors)
+      VecDestroy(&vector);
+  }
+}
+
+void PodBasis::addSnapshot(const std::vector<double> &values,
+                           const std::vector<PetscInt> &rowNos,
+                           PetscInt nRowsGlobal, MPI_Comm mpiCommunicator) {
+  PetscErrorCode ierr;
+
+  // create the vectors of the block on the first call, every rank holds as
+  // many rows as it has values, but not necessarily its own values
+  if (snapshots_.empty()) {
+    mpiCommunicator_ = mpiCommunicator;
+    nValuesLocal_ = values.size();
+    nRowsGlobal_ = nRowsGlobal;
+    snapshots_.resize(blockSize_);
+    for (Vec &snapshot : snapshots_) {
+      ierr = VecCreateMPI(mpiCommunicator_, nValuesLocal_, nRowsGlobal_,
+                          &snapshot);
+      CHKERRV(ierr);
+    }
+  }
+
+  // the size is the same on all ranks, therefore all ranks ignore the
+  // snapshot together
+  if (nRowsGlobal != nRowsGlobal_) {
+    LOG(ERROR) << "PodBasis output writer \"" << filenameBase_
+               << "\": Snapshot has " << nRowsGlobal
+               << " values, but previous snapshots had " << nRowsGlobal_
+               << ". Ignoring this snapshot.";
+    return;
+  }
+
+  // set the values at their rows in global struct-of-array order, the values
+  // of other components are sent to the ranks that own these rows
+  Vec snapshot = snapshots_[nSnapshotsInBlock_];
+  ierr = VecSetValues(snapshot, values.size(), rowNos.data(), values.data(),
+                      INSERT_VALUES);
+  CHKERRV(ierr);
+  ierr = VecAssemblyBegin(snapshot);
+  CHKERRV(ierr);
+  ierr = VecAssemblyEnd(snapshot);
+  CHKERRV(ierr);
+
+  nSnapshotsInBlock_++;
+  nSnapshots_++;
+
+  if (nSnapshotsInBlock_ == blockSize_) {
+    updateBasis();
+    writeBasis();
+  }
+}
+
+void PodBasis::updateBasis() {
+  // The current decomposition of the previous snapshots is U*S*V^T. With the
+  // new block A = U*P + Q*R, where Q is orthonormal to U, the decomposition of
+  // all snapshots is [U Q] * K * diag(V,I)^T with K = [S P; 0 R]. The new left
+  // singular vectors are [U Q] times the left singular vectors of the small
+  // matrix K.
+  PetscErrorCode ierr;
+  const int nOldBases = basis_.size();
+  const int nNewSnapshots = nSnapshotsInBlock_;
+  const int n = nOldBases + nNewSnapshots;
+
+  // project the new snapshots onto the basis, twice for numerical stability,
+  // P = U^T A, A := A - U*P
+  std::vector<double> projection(nOldBases * nNewSnapshots, 0.0);
+  std::vector<double> snapshotNorms(nNewSnapshots);
+  std::vector<double> coefficients(nOldBases);
+  for (int i = 0; i < nNewSnapshots; i++) {
+    ierr = VecNorm(snapshots_[i], NORM_2, &snapshotNorms[i]);
+    CHKERRV(ierr);
+
+    for (int passNo = 0; passNo < 2 && nOldBases > 0; passNo++) {
+      ierr = VecMDot(snapshots_[i], nOldBases, basis_.data(),
+                     coefficients.data());
+      CHKERRV(ierr);
+      for (int j = 0; j < nOldBases; j++) {
+        projection[i * nOldBases + j] += coefficients[j];
+        coefficients[j] = -coefficients[j];
+      }
+      ierr = VecMAXPY(snapshots_[i], nOldBases, coefficients.data(),
+                      basis_.data());
+      CHKERRV(ierr);
+    }
+  }
+
+  // orthonormalize the residuals by modified Gram-Schmidt, A = Q*R, residuals
+  // that are numerically zero are discarded
+  std::vector<double> triangular(nNewSnapshots * nNewSnapshots, 0.0);
+  for (int i = 0; i < nNewSnapshots; i++) {
+    for (int l = 0; l < i; l++) {
+      double value;
+      ierr = VecDot(snapshots_[l], snapshots_[i], &value);
+      CHKERRV(ierr);
+      triangular[i * nNewSnapshots + l] = value;
+      ierr = VecAXPY(snapshots_[i], -value, snapshots_[l]);
+      CHKERRV(ierr);
+    }
+
+    double norm;
+    ierr = VecNorm(snapshots_[i], NORM_2, &norm);
+    CHKERRV(ierr);
+    if (norm <= truncationTolerance_ * snapshotNorms[i]) {
+      ierr = VecSet(snapshots_[i], 0.0);
+      CHKERRV(ierr);
+      norm = 0.0;
+    } else {
+      ierr = VecScale(snapshots_[i], 1.0 / norm);
+      CHKERRV(ierr);
+    }
+    triangular[i * nNewSnapshots + i] = norm;
+  }
+
+  // assemble K = [S P; 0 R] in column-major order
+  std::vector<double> matrix(n * n, 0.0);
+  for (int j = 0; j < nOldBases; j++)
+    matrix[j * n + j] = singularValues_[j];
+  for (int i = 0; i < nNewSnapshots; i++) {
+    for (int j = 0; j < nOldBases; j++)
+      matrix[(nOldBases + i) * n + j] = projection[i * nOldBases + j];
+    for (int l = 0; l <= i; l++)
+      matrix[(nOldBases + i) * n + nOldBases + l] =
+          triangular[i * nNewSnapshots + l];
+  }
+
+  std::vector<double> leftSingVec(n * n);
+  std::vector<double> singVal(n);
+  SvdUtility::getSVDJacobi(matrix.data(), n, n, leftSingVec.data(),
+                           singVal.data());
+
+  // truncate to at most nBases_ vectors with non-negligible singular values
+  int nBases = 0;
+  while (nBases < std::min(n, nBases_) &&
+         singVal[nBases] > truncationTolerance_ * singVal[0])
+    nBases++;
+
+  // rotate the basis, U_new = [U Q] * U_K
+  std::vector<Vec> vectors(basis_);
+  vectors.insert(vectors.end(), snapshots_.begin(),
+                 snapshots_.begin() + nNewSnapshots);
+
+  while ((int)newBasis_.size() < nBases) {
+    Vec vector;
+    ierr = VecDuplicate(snapshots_[0], &vector);
+    CHKERRV(ierr);
+    newBasis_.push_back(vector);
+  }
+
+  for (int j = 0; j < nBases; j++) {
+    ierr = VecSet(newBasis_[j], 0.0);
+    CHKERRV(ierr);
+    ierr = VecMAXPY(newBasis_[j], n, leftSingVec.data() + j * n,
+                    vectors.data());
+    CHKERRV(ierr);
+  }
+
+  // the new vectors become the basis, the vectors of the old basis and the
+  // unused new vectors are kept for the next update
+  std::vector<Vec> unusedVectors(newBasis_.begin() + nBases, newBasis_.end());
+  newBasis_.resize(nBases);
+  std::swap(basis_, newBasis_);
+  newBasis_.insert(newBasis_.end(), unusedVectors.begin(),
+                   unusedVectors.end());
+
+  singularValues_.assign(singVal.begin(), singVal.begin() + nBases);
+  nSnapshotsInBlock_ = 0;
+
+  VLOG(1) << "PodBasis \"" << filenameBase_ << "\": " << nSnapshots_
+          << " snapshots, singular values: " << singularValues_;
+}
+
+void PodBasis::writeBasis() {
+  if (basis_.empty())
+    return;
+
+  PetscErrorCode ierr;
+  const int nBases = basis_.size();
+  std::string filename = filenameBase_ + ".bin";
+
+  // create the output directory if necessary
+  int ownRankNo = 0;
+  MPI_Comm_rank(mpiCommunicator_, &ownRankNo);
+  if (ownRankNo == 0) {
+    std::ofstream file;
+    openFile(file, filename);
+    file.close();
+  }
+  MPI_Barrier(mpiCommunicator_);
+
+  // the singular values are stored on rank 0
+  Vec singularValues;
+  ierr = VecCreateMPI(mpiCommunicator_, ownRankNo == 0 ? nBases : 0, nBases,
+                      &singularValues);
+  CHKERRV(ierr);
+  if (ownRankNo == 0) {
+    std::vector<PetscInt> indices(nBases);
+    for (int i = 0; i < nBases; i++)
+      indices[i] = i;
+    ierr = VecSetValues(singularValues, nBases, indices.data(),
+                        singularValues_.data(), INSERT_VALUES);
+    CHKERRV(ierr);
+  }
+  ierr = VecAssemblyBegin(singularValues);
+  CHKERRV(ierr);
+  ierr = VecAssemblyEnd(singularValues);
+  CHKERRV(ierr);
+
+  // write the singular values, followed by the basis vectors
+  PetscViewer viewer;
+  ierr = PetscViewerBinaryOpen(mpiCommunicator_, filename.c_str(),
+                               FILE_MODE_WRITE, &viewer);
+  CHKERRV(ierr);
+  ierr = VecView(singularValues, viewer);
+  CHKERRV(ierr);
+  for (Vec &vector : basis_) {
+    ierr = VecView(vector, viewer);
+    CHKERRV(ierr);
+  }
+  ierr = PetscViewerDestroy(&viewer);
+  CHKERRV(ierr);
+  ierr = VecDestroy(&singularValues);
+  CHKERRV(ierr);
+
+  LOG(DEBUG) << "PodBasis: wrote " << nBases << " basis vectors of "
+             << nSnapshots_ << " snapshots to \"" << filename << "\".";
+}
+
+} // namespace OutputWriter
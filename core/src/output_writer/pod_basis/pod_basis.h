@@ -0,0 +1,72 @@
+#pragma once
+
+#include <Python.h> // has to be the first included header
+#include <vector>
+#include <petscvec.h>
+
+#include "control/types.h"
+#include "output_writer/generic.h"
+
+namespace OutputWriter {
+
+/** Output writer that computes a proper orthogonal decomposition (POD) basis
+ * for model order reduction while the full-order simulation runs. Every call
+ * adds the values of the first output field variable, with all components in
+ * struct-of-array order, as snapshot to an incremental truncated SVD.
+ *
+ *  The snapshots are collected in blocks of "blockSize" vectors and then merged
+ * into the current left singular vectors. The memory is bounded by
+ * 2*nBases + blockSize distributed vectors, independent of the number of
+ * snapshots. After every block, the singular values and the basis vectors are
+ * written to <filename>.bin in PETSc binary format.
+ *
+ *  The rows of the basis are in global struct-of-array order, i.e. component
+ * after component and within a component in global PETSc dof numbering. In
+ * serial execution, this is the order of the "snapshots" CSV file.
+ */
+class PodBasis : public Generic {
+public:
+  //! constructor
+  PodBasis(DihuContext context, PythonConfig specificSettings,
+           std::shared_ptr<Partition::RankSubset> rankSubset = nullptr);
+
+  //! destructor, merges the remaining snapshots and writes the basis
+  virtual ~PodBasis();
+
+  //! add the current solution as snapshot
+  template <typename DataType>
+  void write(DataType &data, int timeStepNo = -1, double currentTime = -1,
+             int callCountIncrement = 1);
+
+protected:
+  //! add the local values of a snapshot at the given global rows, update the
+  //! basis if the block is full
+  void addSnapshot(const std::vector<double> &values,
+                   const std::vector<PetscInt> &rowNos, PetscInt nRowsGlobal,
+                   MPI_Comm mpiCommunicator);
+
+  //! merge the collected snapshots into the basis
+  void updateBasis();
+
+  //! write singular values and basis vectors to the binary file
+  void writeBasis();
+
+  int nBases_;   //< maximum number of basis vectors
+  int blockSize_; //< number of snapshots that are merged at once
+  double truncationTolerance_; //< relative tolerance below which singular
+                               // values are discarded
+
+  MPI_Comm mpiCommunicator_; //< communicator of the snapshot vectors
+  int nValuesLocal_;         //< number of local values of a snapshot
+  PetscInt nRowsGlobal_;     //< global size of a snapshot
+  std::vector<Vec> basis_;   //< the current left singular vectors
+  std::vector<double> singularValues_; //< the current singular values
+  std::vector<Vec> snapshots_; //< snapshots of the current block
+  std::vector<Vec> newBasis_;  //< temporary vectors for the update
+  int nSnapshotsInBlock_;      //< number of snapshots in snapshots_
+  long long nSnapshots_;       //< total number of added snapshots
+};
+
+} // namespace OutputWriter
+
+#include "output_writer/pod_basis/pod_basis.tpp"
@@ -0,0 +1,32 @@
+#include "output_writer/pod_basis/pod_basis.h"
+
+#include "easylogging++.h"
+#include "output_writer/pod_basis/pod_basis_snapshot.h"
+
+namespace OutputWriter {
+
+template <typename DataType>
+void PodBasis::write(DataType &data, int timeStepNo, double currentTime,
+                     int callCountIncrement) {
+  // check if a snapshot should be taken in this timestep
+  if (!Generic::prepareWrite(data, timeStepNo, currentTime,
+                             callCountIncrement)) {
+    return;
+  }
+
+  LOG(TRACE) << "PodBasis::write timeStepNo=" << timeStepNo
+             << ", currentTime=" << currentTime;
+
+  std::vector<double> values;
+  std::vector<PetscInt> rowNos;
+  PetscInt nRowsGlobal = 0;
+  MPI_Comm mpiCommunicator;
+  if (!PodBasisSnapshot<typename DataType::FieldVariablesForOutputWriter>::
+          getValues(data.getFieldVariablesForOutputWriter(), values, rowNos,
+                    nRowsGlobal, mpiCommunicator))
+    return;
+
+  addSnapshot(values, rowNos, nRowsGlobal, mpiCommunicator);
+}
+
+} // namespace OutputWriter
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <Python.h> // has to be the first included header
+#include <vector>
+#include <tuple>
+#include <memory>
+
+#include "field_variable/field_variable.h"
+
+namespace OutputWriter {
+
+/** Extract the local values of a snapshot for the PodBasis output writer from
+ * the field variables for the output writer. Only the first field variable is
+ * used, the general case does not support snapshots.
+ */
+template <typename FieldVariablesForOutputWriterType> struct PodBasisSnapshot {
+  //! get the local values without ghosts and their rows in the global
+  //! snapshot vector, return false if not possible
+  static bool getValues(FieldVariablesForOutputWriterType fieldVariables,
+                        std::vector<double> &values,
+                        std::vector<PetscInt> &rowNos,
+                        PetscInt &nRowsGlobal, MPI_Comm &mpiCommunicator);
+};
+
+/** Partial specialization for a tuple whose first entry is a field variable
+ */
+template <typename FunctionSpaceType, int nComponents,
+          typename... FieldVariableTypes>
+struct PodBasisSnapshot<
+    std::tuple<std::shared_ptr<FieldVariable::FieldVariable<
+                   FunctionSpaceType, nComponents>>,
+               FieldVariableTypes...>> {
+  typedef FieldVariable::FieldVariable<FunctionSpaceType, nComponents>
+      FieldVariableType;
+
+  //! get the local values without ghosts of all components, the row of a
+  //! value in the global snapshot vector is componentNo*nDofsGlobal plus the
+  //! global PETSc dof no, i.e. the global struct-of-array order, return true
+  static bool
+  getValues(std::tuple<std::shared_ptr<FieldVariableType>,
+                       FieldVariableTypes...>
+                fieldVariables,
+            std::vector<double> &values, std::vector<PetscInt> &rowNos,
+            PetscInt &nRowsGlobal, MPI_Comm &mpiCommunicator);
+};
+
+} // namespace OutputWriter
+
+#include "output_writer/pod_basis/pod_basis_snapshot.tpp"
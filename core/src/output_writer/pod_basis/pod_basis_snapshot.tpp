@@ -0,0 +1,58 @@
+#include "output_writer/pod_basis/pod_basis_snapshot.h"
+
+#include "easylogging++.h"
+
+namespace OutputWriter {
+
+template <typename FieldVariablesForOutputWriterType>
+bool PodBasisSnapshot<FieldVariablesForOutputWriterType>::getValues(
+    FieldVariablesForOutputWriterType fieldVariables,
+    std::vector<double> &values, std::vector<PetscInt> &rowNos,
+    PetscInt &nRowsGlobal, MPI_Comm &mpiCommunicator) {
+  LOG_N_TIMES(1, ERROR) << "The PodBasis output writer needs a field variable "
+                        << "as first output field variable, no snapshots "
+                        << "are collected.";
+  return false;
+}
+
+template <typename FunctionSpaceType, int nComponents,
+          typename... FieldVariableTypes>
+bool PodBasisSnapshot<
+    std::tuple<std::shared_ptr<FieldVariable::FieldVariable<
+                   FunctionSpaceType, nComponents>>,
+               FieldVariableTypes...>>::
+    getValues(std::tuple<std::shared_ptr<FieldVariableType>,
+                         FieldVariableTypes...>
+                  fieldVariables,
+              std::vector<double> &values, std::vector<PetscInt> &rowNos,
+              PetscInt &nRowsGlobal, MPI_Comm &mpiCommunicator) {
+  std::shared_ptr<FieldVariableType> fieldVariable =
+      std::get<0>(fieldVariables);
+  auto meshPartition = fieldVariable->functionSpace()->meshPartition();
+
+  // the components are appended one after another, this is the same order as
+  // in getValuesContiguous()
+  values.clear();
+  for (int componentNo = 0; componentNo < nComponents; componentNo++)
+    fieldVariable->getValuesWithoutGhosts(componentNo, values);
+
+  // in parallel, the local values are not contiguous in the global vector,
+  // every component is a block of nDofsGlobal rows in global PETSc numbering,
+  // as in the serial case
+  const dof_no_t nDofsLocal = meshPartition->nDofsLocalWithoutGhosts();
+  const global_no_t nDofsGlobal = meshPartition->nDofsGlobal();
+  rowNos.resize(values.size());
+  for (int componentNo = 0; componentNo < nComponents; componentNo++) {
+    for (dof_no_t dofNoLocal = 0; dofNoLocal < nDofsLocal; dofNoLocal++) {
+      rowNos[componentNo * nDofsLocal + dofNoLocal] =
+          componentNo * nDofsGlobal +
+          meshPartition->getDofNoGlobalPetsc(dofNoLocal);
+    }
+  }
+  nRowsGlobal = nComponents * nDofsGlobal;
+
+  mpiCommunicator = meshPartition->mpiCommunicator();
+  return true;
+}
+
+} // namespace OutputWriter
@@ -103,7 +103,7 @@ PyObject *Python<FunctionSpace::FunctionSpace<Mesh::CompositeOfDimension<D>,
   LOG(DEBUG) << "PythonStructuredDeformable";
 
   // start critical section for python API calls
-  // PythonUtility::GlobalInterpreterLock lock;
+  PythonUtility::GlobalInterpreterLock lock;
 
   // build python dict that will contain all information and data
   PyObject *data = Py_BuildValue(
@@ -104,7 +104,7 @@ Python<FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<D>,
   LOG(DEBUG) << "PythonStructuredDeformable";
 
   // start critical section for python API calls
-  // PythonUtility::GlobalInterpreterLock lock;
+  PythonUtility::GlobalInterpreterLock lock;
 
   // build python dict that will contain all information and data
   PyObject *data = Py_BuildValue(
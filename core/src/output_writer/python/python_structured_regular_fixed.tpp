@@ -105,7 +105,7 @@ Python<FunctionSpace::FunctionSpace<Mesh::StructuredRegularFixedOfDimension<D>,
   LOG(DEBUG) << "PythonRegularFixed, meshName \"" << meshName << "\"";
 
   // start critical section for python API calls
-  // PythonUtility::GlobalInterpreterLock lock;
+  PythonUtility::GlobalInterpreterLock lock;
 
   // build python dict that will contain all information and data
   PyObject *data = Py_BuildValue(
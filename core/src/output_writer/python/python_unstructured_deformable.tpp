@@ -60,7 +60,7 @@ Python<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>,
   int ownRankNo = mesh->meshPartition()->ownRankNo();
 
   // start critical section for python API calls
-  // PythonUtility::GlobalInterpreterLock lock;
+  PythonUtility::GlobalInterpreterLock lock;
 
   PyObject *pyElementalDofs =
       Python<FunctionSpaceType, FieldVariablesForOutputWriterType>::
@@ -30,7 +30,7 @@ void PythonCallbackWriter<FunctionSpaceType,
       fieldVariables, meshNames);
 
   // start critical section for python API calls
-  // PythonUtility::GlobalInterpreterLock lock;
+  PythonUtility::GlobalInterpreterLock lock;
 
   PyObject *pyDataList = PyList_New((Py_ssize_t)meshNames.size());
 
@@ -0,0 +1,165 @@
+#include "partition/locality_ordering.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <queue>
+
+namespace Partition {
+
+namespace {
+//! spread the lowest 21 bits of value such that there are two zero bits
+//! between each of them
+uint64_t spreadBits(uint64_t value) {
+  value &= 0x1fffff;
+  value = (value | value << 32) & 0x1f00000000ffffull;
+  value = (value | value << 16) & 0x1f0000ff0000ffull;
+  value = (value | value << 8) & 0x100f00f00f00f00full;
+  value = (value | value << 4) & 0x10c30c30c30c30c3ull;
+  value = (value | value << 2) & 0x1249249249249249ull;
+  return value;
+}
+} // namespace
+
+std::vector<global_no_t>
+LocalityOrdering::morton(const std::vector<Vec3> &points) {
+  // determine the bounding box
+  Vec3 minimum, maximum;
+  minimum.fill(std::numeric_limits<double>::max());
+  maximum.fill(std::numeric_limits<double>::lowest());
+  for (const Vec3 &point : points) {
+    for (int i = 0; i < 3; i++) {
+      minimum[i] = std::min(minimum[i], point[i]);
+      maximum[i] = std::max(maximum[i], point[i]);
+    }
+  }
+
+  // compute the Morton key of every point on a grid with 2^21 cells per
+  // coordinate direction
+  const double nCells = (1 << 21) - 1;
+  std::vector<uint64_t> keys(points.size());
+  for (global_no_t pointNo = 0; pointNo < points.size(); pointNo++) {
+    uint64_t key = 0;
+    for (int i = 0; i < 3; i++) {
+      double extent = maximum[i] - minimum[i];
+      uint64_t cellNo = 0;
+      if (extent > 0)
+        cellNo = (points[pointNo][i] - minimum[i]) / extent * nCells;
+      key |= spreadBits(cellNo) << i;
+    }
+    keys[pointNo] = key;
+  }
+
+  // sort the point nos by key, ties are broken by the point no
+  std::vector<global_no_t> ordering(points.size());
+  std::iota(ordering.begin(), ordering.end(), 0);
+  std::sort(ordering.begin(), ordering.end(),
+            [&keys](global_no_t a, global_no_t b) {
+              if (keys[a] != keys[b])
+                return keys[a] < keys[b];
+              return a < b;
+            });
+  return ordering;
+}
+
+std::vector<global_no_t> LocalityOrdering::reverseCuthillMcKee(
+    const std::vector<std::vector<global_no_t>> &nodeNosOfElements,
+    global_no_t nNodes) {
+  // create the adjacency lists of the nodes
+  std::vector<std::vector<global_no_t>> neighbours(nNodes);
+  for (const std::vector<global_no_t> &nodeNos : nodeNosOfElements) {
+    for (global_no_t nodeNo : nodeNos) {
+      for (global_no_t neighbourNodeNo : nodeNos) {
+        if (neighbourNodeNo != nodeNo)
+          neighbours[nodeNo].push_back(neighbourNodeNo);
+      }
+    }
+  }
+  for (std::vector<global_no_t> &nodeNeighbours : neighbours) {
+    std::sort(nodeNeighbours.begin(), nodeNeighbours.end());
+    nodeNeighbours.erase(
+        std::unique(nodeNeighbours.begin(), nodeNeighbours.end()),
+        nodeNeighbours.end());
+  }
+
+  // visit the neighbours in order of increasing degree
+  auto compareDegree = [&neighbours](global_no_t a, global_no_t b) {
+    if (neighbours[a].size() != neighbours[b].size())
+      return neighbours[a].size() < neighbours[b].size();
+    return a < b;
+  };
+
+  // start nodes of the connected components, the nodes with the lowest degree
+  std::vector<global_no_t> startNodes(nNodes);
+  std::iota(startNodes.begin(), startNodes.end(), 0);
+  std::sort(startNodes.begin(), startNodes.end(), compareDegree);
+
+  std::vector<global_no_t> ordering;
+  ordering.reserve(nNodes);
+  std::vector<bool> visited(nNodes, false);
+
+  for (global_no_t startNode : startNodes) {
+    if (visited[startNode])
+      continue;
+
+    // breadth-first search from the start node
+    std::queue<global_no_t> queue;
+    queue.push(startNode);
+    visited[startNode] = true;
+
+    while (!queue.empty()) {
+      global_no_t nodeNo = queue.front();
+      queue.pop();
+      ordering.push_back(nodeNo);
+
+      std::vector<global_no_t> unvisitedNeighbours;
+      for (global_no_t neighbourNodeNo : neighbours[nodeNo]) {
+        if (!visited[neighbourNodeNo])
+          unvisitedNeighbours.push_back(neighbourNodeNo);
+      }
+      std::sort(unvisitedNeighbours.begin(), unvisitedNeighbours.end(),
+                compareDegree);
+
+      for (global_no_t neighbourNodeNo : unvisitedNeighbours) {
+        visited[neighbourNodeNo] = true;
+        queue.push(neighbourNodeNo);
+      }
+    }
+  }
+
+  std::reverse(ordering.begin(), ordering.end());
+  return ordering;
+}
+
+std::vector<global_no_t> LocalityOrdering::elementsByNodes(
+    const std::vector<std::vector<global_no_t>> &nodeNosOfElements,
+    const std::vector<global_no_t> &nodeOrdering) {
+  // get the new no of every node
+  std::vector<global_no_t> newNodeNos(nodeOrdering.size());
+  for (global_no_t newNodeNo = 0; newNodeNo < nodeOrdering.size();
+       newNodeNo++) {
+    newNodeNos[nodeOrdering[newNodeNo]] = newNodeNo;
+  }
+
+  // the key of an element is the lowest new no of its nodes
+  std::vector<global_no_t> keys(nodeNosOfElements.size(),
+                                std::numeric_limits<global_no_t>::max());
+  for (global_no_t elementNo = 0; elementNo < nodeNosOfElements.size();
+       elementNo++) {
+    for (global_no_t nodeNo : nodeNosOfElements[elementNo])
+      keys[elementNo] = std::min(keys[elementNo], newNodeNos[nodeNo]);
+  }
+
+  std::vector<global_no_t> ordering(nodeNosOfElements.size());
+  std::iota(ordering.begin(), ordering.end(), 0);
+  std::sort(ordering.begin(), ordering.end(),
+            [&keys](global_no_t a, global_no_t b) {
+              if (keys[a] != keys[b])
+                return keys[a] < keys[b];
+              return a < b;
+            });
+  return ordering;
+}
+
+} // namespace Partition
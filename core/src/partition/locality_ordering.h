@@ -0,0 +1,34 @@
+#pragma once
+
+#include <vector>
+
+#include "control/types.h"
+
+namespace Partition {
+
+/** Orderings of the nodes and elements of unstructured meshes that improve
+ * the memory locality of element loops. Every method returns the old numbers
+ * in their new order, i.e. result[newNo] = oldNo. The results only depend on
+ * the input, such that all ranks compute the same ordering.
+ */
+class LocalityOrdering {
+public:
+  //! order the points along the Morton (Z-order) space-filling curve of their
+  //! bounding box
+  static std::vector<global_no_t> morton(const std::vector<Vec3> &points);
+
+  //! order the nodes by the reverse Cuthill-McKee algorithm on the graph where
+  //! nodes are adjacent if they share an element, this reduces the bandwidth
+  //! of the system matrix
+  static std::vector<global_no_t> reverseCuthillMcKee(
+      const std::vector<std::vector<global_no_t>> &nodeNosOfElements,
+      global_no_t nNodes);
+
+  //! order the elements by the lowest new number of their nodes, such that
+  //! consecutive elements access nearby nodes
+  static std::vector<global_no_t> elementsByNodes(
+      const std::vector<std::vector<global_no_t>> &nodeNosOfElements,
+      const std::vector<global_no_t> &nodeOrdering);
+};
+
+} // namespace Partition
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <memory>
+#include <map>
+#include <vector>
 #include <petscdmda.h>
 
 #include "partition/mesh_partition/00_mesh_partition_base.h"
@@ -17,10 +19,16 @@ template <typename MeshType, typename BasisFunctionType> class FunctionSpace;
 
 namespace Partition {
 
-/** Partial specialization for unstructured meshes
- *  use petsc IS
- *  not implemented yet
- *  Unstructured meshes should work for non-parallel execution, as usual.
+/** Partial specialization for unstructured meshes.
+ *  The serial constructor creates a partition where all local numbers equal the
+ * global numbers. The distributed constructor assigns every element to a rank
+ * and every node to the lowest rank of its adjacent elements. The local nodes
+ * are the owned nodes, ordered by their global natural number or by a given
+ * locality ordering, followed by the ghost nodes. The global PETSc numbering
+ * contains the owned nodes of rank 0, then those of rank 1 etc. Dofs are
+ * numbered node-wise in both numberings, i.e. dof = node*nDofsPerNode +
+ * nodalDofIndex, multiple versions per node are therefore only possible with
+ * the serial constructor.
  */
 template <int D, typename BasisFunctionType>
 class MeshPartition<
@@ -33,6 +41,26 @@ public:
                 global_no_t nDofsGlobal,
                 std::shared_ptr<RankSubset> rankSubset);
 
+  //! constructor for a distributed partition, from the global node nos of all
+  //! elements and the rank no of every element. The optional orderings contain
+  //! the global natural node and element nos in the order in which they should
+  //! be numbered locally and in the petsc numbering, empty means natural order
+  MeshPartition(
+      const std::vector<std::vector<global_no_t>> &nodeNosOfElementsGlobal,
+      const std::vector<int> &elementRankNos, global_no_t nNodesGlobal,
+      int nDofsPerNode, std::shared_ptr<RankSubset> rankSubset,
+      const std::vector<global_no_t> &nodeNosOrdering =
+          std::vector<global_no_t>(),
+      const std::vector<global_no_t> &elementNosOrdering =
+          std::vector<global_no_t>());
+
+  //! destructor, destroys the local to global mapping
+  virtual ~MeshPartition();
+
+  //! if the mesh is partitioned over multiple ranks, i.e. the distributed
+  //! constructor was used
+  bool isDistributed() const;
+
   //! number of elements in the local partition
   element_no_t nElementsLocal() const;
 
@@ -72,7 +100,8 @@ public:
   //! for structured meshes, not for unstructured meshes
   global_no_t getElementNoGlobalNatural(element_no_t elementNoLocal) const;
 
-  //! get the local to global mapping for the current partition
+  //! get the local to global mapping for the current partition, it is created
+  //! on the first call and owned by the partition
   ISLocalToGlobalMapping localToGlobalMappingDofs();
 
   //! from a vector of values of global node numbers remove all that are
@@ -121,6 +150,18 @@ public:
   node_no_t getNodeNoLocalFromGlobalNatural(global_no_t nodeNoGlobalNatural,
                                             bool &isOnLocalDomain) const;
 
+  //! get the global natural node no of a local node, including ghost nodes
+  global_no_t getNodeNoGlobalNatural(node_no_t nodeNoLocal) const;
+
+  //! get the global natural element nos of the local elements
+  const std::vector<global_no_t> &elementNosGlobalNatural() const;
+
+  //! get the global natural node nos of the local nodes, non-ghost nodes first
+  const std::vector<global_no_t> &nodeNosGlobalNatural() const;
+
+  //! get the global petsc dof nos of the ghost dofs, in local order
+  const std::vector<PetscInt> &ghostDofNosGlobalPetsc() const;
+
   //! get the local element no from the global element no, isOnLocalDomain is
   //! true
   element_no_t getElementNoLocal(global_no_t elementNoGlobalPetsc,
@@ -157,6 +198,31 @@ protected:
   global_no_t nNodes_;    //< the global size, i.e. the number of nodes of the
                           // whole problem
   global_no_t nDofs_;     //< the number of dofs
+
+  bool isDistributed_ = false; //< if the distributed constructor was used, if
+                               // false, local and global numbers are the same
+  int nDofsPerNode_ = 1;       //< number of dofs per node, for the distributed
+                               // partition
+  node_no_t nNodesLocalWithoutGhosts_ = 0; //< number of owned nodes
+  global_no_t nodeNoGlobalPetscBegin_ = 0; //< global petsc no of the first
+                                           // owned node
+  std::vector<global_no_t>
+      elementNosGlobalNatural_; //< global natural nos of the local elements
+  std::map<global_no_t, element_no_t>
+      elementNoLocalFromGlobalNatural_; //< inverse of elementNosGlobalNatural_
+  std::vector<global_no_t>
+      nodeNosGlobalNatural_; //< global natural nos of the local nodes, first
+                             // the owned nodes, then the ghost nodes
+  std::map<global_no_t, node_no_t>
+      nodeNoLocalFromGlobalNatural_; //< inverse of nodeNosGlobalNatural_
+  std::vector<global_no_t>
+      nodeNosGlobalPetsc_; //< global petsc nos of the local nodes
+  std::vector<int> nodeRankNosGlobal_; //< for every global natural node no the
+                                       // rank that owns the node
+  std::vector<PetscInt>
+      ghostDofNosGlobalPetsc_; //< global petsc nos of the ghost dofs
+  ISLocalToGlobalMapping localToGlobalPetscMappingDofs_ =
+      nullptr; //< local to global mapping for dofs, created on first use
 };
 
 } // namespace Partition
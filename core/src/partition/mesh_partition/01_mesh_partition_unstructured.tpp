@@ -1,8 +1,13 @@
 #include "partition/mesh_partition/01_mesh_partition_unstructured.h"
 
-namespace Partition {
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <numeric>
+
+#include "easylogging++.h"
 
-// this is not yet implemented in parallel, it should however work serially
+namespace Partition {
 
 template <int D, typename BasisFunctionType>
 MeshPartition<
@@ -18,22 +23,182 @@ MeshPartition<
   this->createLocalDofOrderings();
 }
 
+template <int D, typename BasisFunctionType>
+MeshPartition<
+    FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>,
+                                 BasisFunctionType>,
+    Mesh::UnstructuredDeformableOfDimension<D>>::
+    MeshPartition(
+        const std::vector<std::vector<global_no_t>> &nodeNosOfElementsGlobal,
+        const std::vector<int> &elementRankNos, global_no_t nNodesGlobal,
+        int nDofsPerNode, std::shared_ptr<RankSubset> rankSubset,
+        const std::vector<global_no_t> &nodeNosOrdering,
+        const std::vector<global_no_t> &elementNosOrdering)
+    : MeshPartitionBase(rankSubset),
+      nElements_(nodeNosOfElementsGlobal.size()), nNodes_(nNodesGlobal),
+      nDofs_(nNodesGlobal * nDofsPerNode), isDistributed_(true),
+      nDofsPerNode_(nDofsPerNode) {
+  assert(elementRankNos.size() == nodeNosOfElementsGlobal.size());
+  assert(nodeNosOrdering.empty() || nodeNosOrdering.size() == nNodesGlobal);
+  assert(elementNosOrdering.empty() ||
+         elementNosOrdering.size() == nodeNosOfElementsGlobal.size());
+
+  // the global natural node and element nos in the order in which they are
+  // numbered locally and in the petsc numbering, by default the natural order
+  auto nodeNoInOrder = [&nodeNosOrdering](global_no_t i) {
+    return nodeNosOrdering.empty() ? i : nodeNosOrdering[i];
+  };
+  auto elementNoInOrder = [&elementNosOrdering](global_no_t i) {
+    return elementNosOrdering.empty() ? i : elementNosOrdering[i];
+  };
+
+  const int ownRankNo = this->ownRankNo();
+  const int nRanks = this->nRanks();
+
+  // every node is owned by the lowest rank of its adjacent elements, nodes
+  // that are not part of any element are owned by rank 0
+  nodeRankNosGlobal_.assign(nNodesGlobal, INT_MAX);
+  for (global_no_t elementNo = 0; elementNo < nElements_; elementNo++) {
+    for (global_no_t nodeNo : nodeNosOfElementsGlobal[elementNo]) {
+      nodeRankNosGlobal_[nodeNo] =
+          std::min(nodeRankNosGlobal_[nodeNo], elementRankNos[elementNo]);
+    }
+  }
+  for (int &rankNo : nodeRankNosGlobal_) {
+    if (rankNo == INT_MAX)
+      rankNo = 0;
+  }
+
+  // the petsc numbering contains the owned nodes of rank 0, then rank 1 etc.,
+  // in the given order
+  std::vector<global_no_t> nNodesOwned(nRanks, 0);
+  for (int rankNo : nodeRankNosGlobal_)
+    nNodesOwned[rankNo]++;
+
+  std::vector<global_no_t> nodeNoGlobalPetscBegin(nRanks, 0);
+  for (int rankNo = 1; rankNo < nRanks; rankNo++) {
+    nodeNoGlobalPetscBegin[rankNo] =
+        nodeNoGlobalPetscBegin[rankNo - 1] + nNodesOwned[rankNo - 1];
+  }
+  nodeNoGlobalPetscBegin_ = nodeNoGlobalPetscBegin[ownRankNo];
+
+  std::vector<global_no_t> nodeNosGlobalPetsc(nNodesGlobal);
+  std::vector<global_no_t> nextNodeNoGlobalPetsc = nodeNoGlobalPetscBegin;
+  for (global_no_t i = 0; i < nNodesGlobal; i++) {
+    global_no_t nodeNo = nodeNoInOrder(i);
+    nodeNosGlobalPetsc[nodeNo] =
+        nextNodeNoGlobalPetsc[nodeRankNosGlobal_[nodeNo]]++;
+  }
+
+  // collect the local elements and the ghost nodes
+  std::vector<global_no_t> ghostNodeNos;
+  for (global_no_t i = 0; i < nElements_; i++) {
+    global_no_t elementNo = elementNoInOrder(i);
+    if (elementRankNos[elementNo] != ownRankNo)
+      continue;
+
+    elementNoLocalFromGlobalNatural_[elementNo] =
+        elementNosGlobalNatural_.size();
+    elementNosGlobalNatural_.push_back(elementNo);
+
+    for (global_no_t nodeNo : nodeNosOfElementsGlobal[elementNo]) {
+      if (nodeRankNosGlobal_[nodeNo] != ownRankNo)
+        ghostNodeNos.push_back(nodeNo);
+    }
+  }
+  // the ghost nodes are sorted by their petsc no, which follows the order
+  std::sort(ghostNodeNos.begin(), ghostNodeNos.end(),
+            [&nodeNosGlobalPetsc](global_no_t a, global_no_t b) {
+              return nodeNosGlobalPetsc[a] < nodeNosGlobalPetsc[b];
+            });
+  ghostNodeNos.erase(std::unique(ghostNodeNos.begin(), ghostNodeNos.end()),
+                     ghostNodeNos.end());
+
+  // the local nodes are the owned nodes followed by the ghost nodes
+  for (global_no_t i = 0; i < nNodesGlobal; i++) {
+    global_no_t nodeNo = nodeNoInOrder(i);
+    if (nodeRankNosGlobal_[nodeNo] == ownRankNo)
+      nodeNosGlobalNatural_.push_back(nodeNo);
+  }
+  nNodesLocalWithoutGhosts_ = nodeNosGlobalNatural_.size();
+  nodeNosGlobalNatural_.insert(nodeNosGlobalNatural_.end(),
+                               ghostNodeNos.begin(), ghostNodeNos.end());
+
+  nodeNosGlobalPetsc_.resize(nodeNosGlobalNatural_.size());
+  for (node_no_t nodeNoLocal = 0; nodeNoLocal < nodeNosGlobalNatural_.size();
+       nodeNoLocal++) {
+    global_no_t nodeNoGlobalNatural = nodeNosGlobalNatural_[nodeNoLocal];
+    nodeNoLocalFromGlobalNatural_[nodeNoGlobalNatural] = nodeNoLocal;
+    nodeNosGlobalPetsc_[nodeNoLocal] = nodeNosGlobalPetsc[nodeNoGlobalNatural];
+  }
+
+  for (global_no_t nodeNo : ghostNodeNos) {
+    for (int nodalDofIndex = 0; nodalDofIndex < nDofsPerNode_;
+         nodalDofIndex++) {
+      ghostDofNosGlobalPetsc_.push_back(nodeNosGlobalPetsc[nodeNo] *
+                                            nDofsPerNode_ +
+                                        nodalDofIndex);
+    }
+  }
+
+  LOG(DEBUG) << "MeshPartition<Unstructured> distributed, "
+             << elementNosGlobalNatural_.size() << " of " << nElements_
+             << " elements, " << nNodesLocalWithoutGhosts_ << " owned and "
+             << ghostNodeNos.size() << " ghost nodes of " << nNodes_;
+
+  // initialize dofNosLocalIS_ and dofNosLocalNonGhostIS_
+  this->createLocalDofOrderings();
+}
+
+template <int D, typename BasisFunctionType>
+bool MeshPartition<
+    FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>,
+                                 BasisFunctionType>,
+    Mesh::UnstructuredDeformableOfDimension<D>>::isDistributed() const {
+  return isDistributed_;
+}
+
+template <int D, typename BasisFunctionType>
+MeshPartition<
+    FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>,
+                                 BasisFunctionType>,
+    Mesh::UnstructuredDeformableOfDimension<D>>::~MeshPartition() {
+  // the partition can be destroyed after PETSc was finalized, then nothing can
+  // be done here
+  PetscBool isFinalized;
+  PetscFinalized(&isFinalized);
+  if (isFinalized || !localToGlobalPetscMappingDofs_)
+    return;
+
+  ISLocalToGlobalMappingDestroy(&localToGlobalPetscMappingDofs_);
+}
+
 //! get the local to global mapping for the current partition
 template <int D, typename BasisFunctionType>
 ISLocalToGlobalMapping MeshPartition<
     FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>,
                                  BasisFunctionType>,
     Mesh::UnstructuredDeformableOfDimension<D>>::localToGlobalMappingDofs() {
+  // the mapping is only created once, every matrix references the same mapping
+  if (localToGlobalPetscMappingDofs_)
+    return localToGlobalPetscMappingDofs_;
+
   PetscErrorCode ierr;
-  std::vector<PetscInt> globalDofNos(nDofs_);
-  std::iota(globalDofNos.begin(), globalDofNos.end(), 0);
-  ISLocalToGlobalMapping localToGlobalMapping;
-  ierr = ISLocalToGlobalMappingCreate(mpiCommunicator(), 1, nDofs_,
-                                      globalDofNos.data(), PETSC_COPY_VALUES,
-                                      &localToGlobalMapping);
+  std::vector<PetscInt> globalDofNos(nDofsLocalWithGhosts());
+  if (isDistributed_) {
+    for (dof_no_t dofNoLocal = 0; dofNoLocal < globalDofNos.size();
+         dofNoLocal++) {
+      globalDofNos[dofNoLocal] = getDofNoGlobalPetsc(dofNoLocal);
+    }
+  } else {
+    std::iota(globalDofNos.begin(), globalDofNos.end(), 0);
+  }
+  ierr = ISLocalToGlobalMappingCreate(
+      mpiCommunicator(), 1, globalDofNos.size(), globalDofNos.data(),
+      PETSC_COPY_VALUES, &localToGlobalPetscMappingDofs_);
   CHKERRABORT(mpiCommunicator(), ierr);
 
-  return localToGlobalMapping;
+  return localToGlobalPetscMappingDofs_;
 }
 
 //! number of entries in the current partition
@@ -42,6 +207,8 @@ element_no_t MeshPartition<
     FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>,
                                  BasisFunctionType>,
     Mesh::UnstructuredDeformableOfDimension<D>>::nElementsLocal() const {
+  if (isDistributed_)
+    return elementNosGlobalNatural_.size();
   return nElements_;
 }
 
@@ -60,6 +227,8 @@ node_no_t MeshPartition<
     FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>,
                                  BasisFunctionType>,
     Mesh::UnstructuredDeformableOfDimension<D>>::nNodesLocalWithGhosts() const {
+  if (isDistributed_)
+    return nodeNosGlobalNatural_.size();
   return nNodes_;
 }
 
@@ -69,6 +238,8 @@ dof_no_t MeshPartition<
     FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>,
                                  BasisFunctionType>,
     Mesh::UnstructuredDeformableOfDimension<D>>::nDofsLocalWithGhosts() const {
+  if (isDistributed_)
+    return nodeNosGlobalNatural_.size() * nDofsPerNode_;
   return nDofs_;
 }
 
@@ -79,6 +250,8 @@ dof_no_t MeshPartition<
                                  BasisFunctionType>,
     Mesh::UnstructuredDeformableOfDimension<D>>::nDofsLocalWithoutGhosts()
     const {
+  if (isDistributed_)
+    return nNodesLocalWithoutGhosts_ * nDofsPerNode_;
   return nDofs_;
 }
 
@@ -90,7 +263,7 @@ dof_no_t MeshPartition<
     Mesh::UnstructuredDeformableOfDimension<D>>::
     nNodesLocalWithGhosts(int coordinateDirection) const {
   if (coordinateDirection == 0)
-    return nNodes_;
+    return nNodesLocalWithGhosts();
   return 1;
 }
 
@@ -101,6 +274,8 @@ node_no_t MeshPartition<
                                  BasisFunctionType>,
     Mesh::UnstructuredDeformableOfDimension<D>>::nNodesLocalWithoutGhosts()
     const {
+  if (isDistributed_)
+    return nNodesLocalWithoutGhosts_;
   return nNodes_;
 }
 
@@ -150,6 +325,8 @@ global_no_t MeshPartition<
                                  BasisFunctionType>,
     Mesh::UnstructuredDeformableOfDimension<D>>::
     getElementNoGlobalNatural(element_no_t elementNoLocal) const {
+  if (isDistributed_)
+    return elementNosGlobalNatural_[elementNoLocal];
   return (global_no_t)(elementNoLocal);
 }
 
@@ -162,6 +339,12 @@ element_no_t MeshPartition<
     Mesh::UnstructuredDeformableOfDimension<D>>::
     getElementNoLocal(global_no_t elementNoGlobalPetsc,
                       bool &isOnLocalDomain) const {
+  if (isDistributed_) {
+    std::map<global_no_t, element_no_t>::const_iterator iter =
+        elementNoLocalFromGlobalNatural_.find(elementNoGlobalPetsc);
+    isOnLocalDomain = iter != elementNoLocalFromGlobalNatural_.end();
+    return isOnLocalDomain ? iter->second : -1;
+  }
   isOnLocalDomain = true;
   return elementNoGlobalPetsc;
 }
@@ -173,14 +356,30 @@ void MeshPartition<
                                  BasisFunctionType>,
     Mesh::UnstructuredDeformableOfDimension<D>>::
     extractLocalNodesWithoutGhosts(std::vector<T> &vector,
-                                   int nComponents) const {}
+                                   int nComponents) const {
+  if (!isDistributed_)
+    return;
+
+  std::vector<T> result(nNodesLocalWithoutGhosts_ * nComponents);
+  for (node_no_t nodeNoLocal = 0; nodeNoLocal < nNodesLocalWithoutGhosts_;
+       nodeNoLocal++) {
+    for (int componentNo = 0; componentNo < nComponents; componentNo++) {
+      result[nodeNoLocal * nComponents + componentNo] =
+          vector[nodeNosGlobalNatural_[nodeNoLocal] * nComponents +
+                 componentNo];
+    }
+  }
+  vector.swap(result);
+}
 
 template <int D, typename BasisFunctionType>
 void MeshPartition<
     FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>,
                                  BasisFunctionType>,
     Mesh::UnstructuredDeformableOfDimension<D>>::
-    extractLocalDofsWithoutGhosts(std::vector<double> &vector) const {}
+    extractLocalDofsWithoutGhosts(std::vector<double> &vector) const {
+  this->template extractLocalDofsWithoutGhosts<double>(vector);
+}
 
 template <int D, typename BasisFunctionType>
 template <typename T>
@@ -188,7 +387,11 @@ void MeshPartition<
     FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>,
                                  BasisFunctionType>,
     Mesh::UnstructuredDeformableOfDimension<D>>::
-    extractLocalDofsWithoutGhosts(std::vector<T> &vector) const {}
+    extractLocalDofsWithoutGhosts(std::vector<T> &vector) const {
+  // the dofs are numbered node-wise, therefore this is the same as for nodes
+  // with nDofsPerNode components
+  extractLocalNodesWithoutGhosts(vector, nDofsPerNode_);
+}
 
 template <int D, typename BasisFunctionType>
 std::array<int, D> MeshPartition<
@@ -213,7 +416,17 @@ void MeshPartition<
     getDofNosGlobalNatural(
         std::vector<global_no_t> &dofNosGlobalNatural) const {
   dofNosGlobalNatural.resize(nDofsLocalWithoutGhosts());
-  std::iota(dofNosGlobalNatural.begin(), dofNosGlobalNatural.end(), 0);
+  if (!isDistributed_) {
+    std::iota(dofNosGlobalNatural.begin(), dofNosGlobalNatural.end(), 0);
+    return;
+  }
+
+  for (dof_no_t dofNoLocal = 0; dofNoLocal < dofNosGlobalNatural.size();
+       dofNoLocal++) {
+    dofNosGlobalNatural[dofNoLocal] =
+        nodeNosGlobalNatural_[dofNoLocal / nDofsPerNode_] * nDofsPerNode_ +
+        dofNoLocal % nDofsPerNode_;
+  }
 }
 
 template <int D, typename BasisFunctionType>
@@ -222,6 +435,14 @@ node_no_t MeshPartition<
                                  BasisFunctionType>,
     Mesh::UnstructuredDeformableOfDimension<D>>::
     getNodeNoLocal(global_no_t nodeNoGlobalPetsc, bool &isLocal) const {
+  if (isDistributed_) {
+    // the owned nodes have contiguous global petsc nos
+    isLocal = nodeNoGlobalPetsc >= nodeNoGlobalPetscBegin_ &&
+              nodeNoGlobalPetsc <
+                  nodeNoGlobalPetscBegin_ + nNodesLocalWithoutGhosts_;
+    return isLocal ? (node_no_t)(nodeNoGlobalPetsc - nodeNoGlobalPetscBegin_)
+                   : -1;
+  }
   isLocal = true;
   return (node_no_t)nodeNoGlobalPetsc;
 }
@@ -232,6 +453,13 @@ dof_no_t MeshPartition<
                                  BasisFunctionType>,
     Mesh::UnstructuredDeformableOfDimension<D>>::
     getDofNoLocal(global_no_t dofNoGlobalPetsc, bool &isLocal) const {
+  if (isDistributed_) {
+    node_no_t nodeNoLocal =
+        getNodeNoLocal(dofNoGlobalPetsc / nDofsPerNode_, isLocal);
+    return isLocal ? nodeNoLocal * nDofsPerNode_ +
+                         dofNoGlobalPetsc % nDofsPerNode_
+                   : -1;
+  }
   isLocal = true;
   return (dof_no_t)dofNoGlobalPetsc;
 }
@@ -275,7 +503,14 @@ dof_no_t MeshPartition<
     Mesh::UnstructuredDeformableOfDimension<D>>::
     getNodeNoLocalFromGlobalNatural(global_no_t nodeNoGlobalNatural,
                                     bool &isOnLocalDomain) const {
-  // global natural makes no sense for unstructured meshes
+  if (isDistributed_) {
+    std::map<global_no_t, node_no_t>::const_iterator iter =
+        nodeNoLocalFromGlobalNatural_.find(nodeNoGlobalNatural);
+    isOnLocalDomain = iter != nodeNoLocalFromGlobalNatural_.end();
+    return isOnLocalDomain ? iter->second : -1;
+  }
+
+  // global natural makes no sense for serial unstructured meshes
   return -1;
 }
 
@@ -286,6 +521,11 @@ void MeshPartition<
     Mesh::UnstructuredDeformableOfDimension<D>>::output(std::ostream &stream) {
   stream << "MeshPartition<Unstructured>, nElements_: " << nElements_
          << ", nNodes_: " << nNodes_ << ", nDofs_: " << nDofs_;
+  if (isDistributed_) {
+    stream << ", local elements: " << elementNosGlobalNatural_.size()
+           << ", local nodes without ghosts: " << nNodesLocalWithoutGhosts_
+           << ", with ghosts: " << nodeNosGlobalNatural_.size();
+  }
 }
 
 //! check if the given dof is owned by the own rank, then return true, if not,
@@ -296,7 +536,11 @@ bool MeshPartition<
                                  BasisFunctionType>,
     Mesh::UnstructuredDeformableOfDimension<D>>::
     isNonGhost(node_no_t nodeNoLocal, int &neighbourRankNo) const {
-  return true;
+  if (!isDistributed_ || nodeNoLocal < nNodesLocalWithoutGhosts_)
+    return true;
+
+  neighbourRankNo = nodeRankNosGlobal_[nodeNosGlobalNatural_[nodeNoLocal]];
+  return false;
 }
 
 //! get the rank on which the global natural node is located
@@ -306,6 +550,8 @@ int MeshPartition<
                                  BasisFunctionType>,
     Mesh::UnstructuredDeformableOfDimension<D>>::
     getRankOfNodeNoGlobalNatural(global_no_t nodeNoGlobalNatural) const {
+  if (isDistributed_)
+    return nodeRankNosGlobal_[nodeNoGlobalNatural];
   return 0;
 }
 
@@ -316,6 +562,8 @@ int MeshPartition<
                                  BasisFunctionType>,
     Mesh::UnstructuredDeformableOfDimension<D>>::
     getRankOfDofNoGlobalNatural(global_no_t dofNoGlobalNatural) const {
+  if (isDistributed_)
+    return nodeRankNosGlobal_[dofNoGlobalNatural / nDofsPerNode_];
   return 0;
 }
 
@@ -326,9 +574,49 @@ global_no_t MeshPartition<
                                  BasisFunctionType>,
     Mesh::UnstructuredDeformableOfDimension<D>>::
     getNodeNoGlobalPetsc(node_no_t nodeNoLocal) const {
+  if (isDistributed_)
+    return nodeNosGlobalPetsc_[nodeNoLocal];
+  return (global_no_t)nodeNoLocal;
+}
+
+//! get the global natural node no of a local node, including ghost nodes
+template <int D, typename BasisFunctionType>
+global_no_t MeshPartition<
+    FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>,
+                                 BasisFunctionType>,
+    Mesh::UnstructuredDeformableOfDimension<D>>::
+    getNodeNoGlobalNatural(node_no_t nodeNoLocal) const {
+  if (isDistributed_)
+    return nodeNosGlobalNatural_[nodeNoLocal];
   return (global_no_t)nodeNoLocal;
 }
 
+template <int D, typename BasisFunctionType>
+const std::vector<global_no_t> &MeshPartition<
+    FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>,
+                                 BasisFunctionType>,
+    Mesh::UnstructuredDeformableOfDimension<D>>::elementNosGlobalNatural()
+    const {
+  return elementNosGlobalNatural_;
+}
+
+template <int D, typename BasisFunctionType>
+const std::vector<global_no_t> &MeshPartition<
+    FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>,
+                                 BasisFunctionType>,
+    Mesh::UnstructuredDeformableOfDimension<D>>::nodeNosGlobalNatural() const {
+  return nodeNosGlobalNatural_;
+}
+
+template <int D, typename BasisFunctionType>
+const std::vector<PetscInt> &MeshPartition<
+    FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>,
+                                 BasisFunctionType>,
+    Mesh::UnstructuredDeformableOfDimension<D>>::ghostDofNosGlobalPetsc()
+    const {
+  return ghostDofNosGlobalPetsc_;
+}
+
 template <int D, typename BasisFunctionType>
 void MeshPartition<
     FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>,
@@ -336,6 +624,12 @@ void MeshPartition<
     Mesh::UnstructuredDeformableOfDimension<D>>::
     getDofNoGlobalPetsc(const std::vector<dof_no_t> &dofNosLocal,
                         std::vector<PetscInt> &dofNosGlobalPetsc) const {
+  if (isDistributed_) {
+    dofNosGlobalPetsc.resize(dofNosLocal.size());
+    for (int i = 0; i < dofNosLocal.size(); i++)
+      dofNosGlobalPetsc[i] = getDofNoGlobalPetsc(dofNosLocal[i]);
+    return;
+  }
   dofNosGlobalPetsc.assign(dofNosLocal.begin(), dofNosLocal.end());
 }
 
@@ -345,6 +639,10 @@ global_no_t MeshPartition<
                                  BasisFunctionType>,
     Mesh::UnstructuredDeformableOfDimension<D>>::
     getDofNoGlobalPetsc(dof_no_t dofNoLocal) const {
+  if (isDistributed_) {
+    return nodeNosGlobalPetsc_[dofNoLocal / nDofsPerNode_] * nDofsPerNode_ +
+           dofNoLocal % nDofsPerNode_;
+  }
   return (global_no_t)dofNoLocal;
 }
 
@@ -16,6 +16,14 @@ void Manager::setRankSubsetForNextCreatedPartitioning(
   nextRankSubset_ = nextRankSubset;
 }
 
+std::shared_ptr<RankSubset> Manager::rankSubsetForNextCreatedPartitioning() {
+  // if no nextRankSubset was specified, use all available ranks
+  if (nextRankSubset_ == nullptr)
+    return std::make_shared<RankSubset>();
+
+  return nextRankSubset_;
+}
+
 //! store the ranks which should be used for collective MPI operations
 void Manager::setRankSubsetForCollectiveOperations(
     std::shared_ptr<RankSubset> rankSubset) {
@@ -31,6 +31,20 @@ public:
                                  global_no_t nNodesGlobal,
                                  global_no_t nDofsGlobal);
 
+  //! create a partitioning of an unstructured mesh that is distributed over
+  //! all ranks of rankSubsetForNextCreatedPartitioning(), the elements are
+  //! assigned to the ranks by recursive coordinate bisection of their
+  //! centroids, the optional orderings define the local and petsc numbering
+  template <typename FunctionSpace>
+  std::shared_ptr<MeshPartition<FunctionSpace>> createPartitioningUnstructured(
+      const std::vector<std::vector<global_no_t>> &nodeNosOfElementsGlobal,
+      const std::vector<Vec3> &elementCentroids, global_no_t nNodesGlobal,
+      int nDofsPerNode,
+      const std::vector<global_no_t> &nodeNosOrdering =
+          std::vector<global_no_t>(),
+      const std::vector<global_no_t> &elementNosOrdering =
+          std::vector<global_no_t>());
+
   //! create new partitioning over all available processes, respective the rank
   //! subset that was set by the last call to
   //! setRankSubsetForNextCreatedPartitioning, for a structured mesh, from
@@ -73,6 +87,10 @@ public:
   void setRankSubsetForNextCreatedPartitioning(
       std::shared_ptr<RankSubset> nextRankSubset);
 
+  //! get the rank subset that will be used for the next partitioning, i.e.
+  //! the one set by setRankSubsetForNextCreatedPartitioning or all ranks
+  std::shared_ptr<RankSubset> rankSubsetForNextCreatedPartitioning();
+
   //! store the ranks which should be used for collective MPI operations
   void
   setRankSubsetForCollectiveOperations(std::shared_ptr<RankSubset> rankSubset);
@@ -3,6 +3,7 @@
 #include <cstdlib>
 
 #include "utility/mpi_utility.h"
+#include "partition/recursive_coordinate_bisection.h"
 #include "easylogging++.h"
 
 namespace Partition {
@@ -35,6 +36,31 @@ Manager::createPartitioningUnstructured(global_no_t nElementsGlobal,
       nElementsGlobal, nNodesGlobal, nDofsGlobal, rankSubset);
 }
 
+template <typename FunctionSpace>
+std::shared_ptr<MeshPartition<FunctionSpace>>
+Manager::createPartitioningUnstructured(
+    const std::vector<std::vector<global_no_t>> &nodeNosOfElementsGlobal,
+    const std::vector<Vec3> &elementCentroids, global_no_t nNodesGlobal,
+    int nDofsPerNode, const std::vector<global_no_t> &nodeNosOrdering,
+    const std::vector<global_no_t> &elementNosOrdering) {
+  std::shared_ptr<RankSubset> rankSubset =
+      rankSubsetForNextCreatedPartitioning();
+
+  LOG(DEBUG) << "Partition::Manager::createPartitioningUnstructured, "
+             << "distribute " << nodeNosOfElementsGlobal.size()
+             << " elements and " << nNodesGlobal << " nodes to rankSubset "
+             << *rankSubset;
+
+  // assign the elements to the ranks, this gives the same result on all ranks
+  std::vector<int> elementRankNos =
+      RecursiveCoordinateBisection::partition(elementCentroids,
+                                              rankSubset->size());
+
+  return std::make_shared<MeshPartition<FunctionSpace>>(
+      nodeNosOfElementsGlobal, elementRankNos, nNodesGlobal, nDofsPerNode,
+      rankSubset, nodeNosOrdering, elementNosOrdering);
+}
+
 // use nElementsLocal and nRanks, fill nElementsGlobal
 template <typename FunctionSpace>
 std::shared_ptr<MeshPartition<FunctionSpace>>
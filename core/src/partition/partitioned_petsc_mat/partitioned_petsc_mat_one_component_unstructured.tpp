@@ -135,8 +135,12 @@ void PartitionedPetscMatOneComponent<
   assert(this->meshPartitionRows_);
   assert(this->meshPartitionColumns_);
 
-  dof_no_t nRowDofs = this->meshPartitionRows_->nDofs();
-  dof_no_t nColumnDofs = this->meshPartitionColumns_->nDofs();
+  // the rows and columns of the non-ghost dofs are stored on the own rank
+  dof_no_t nRowDofsLocal = this->meshPartitionRows_->nDofsLocalWithoutGhosts();
+  dof_no_t nColumnDofsLocal =
+      this->meshPartitionColumns_->nDofsLocalWithoutGhosts();
+  global_no_t nRowDofsGlobal = this->meshPartitionRows_->nDofsGlobal();
+  global_no_t nColumnDofsGlobal = this->meshPartitionColumns_->nDofsGlobal();
   // ierr = MatCreateAIJ(rankSubset_->mpiCommunicator(), partition.(),
   // partition.(), n, n,
   //                     nNonZerosDiagonal, NULL, nNonZerosOffdiagonal, NULL,
@@ -144,8 +148,8 @@ void PartitionedPetscMatOneComponent<
 
   ierr = MatCreate(this->meshPartitionRows_->mpiCommunicator(), &this->matrix_);
   CHKERRV(ierr);
-  ierr =
-      MatSetSizes(this->matrix_, nRowDofs, nColumnDofs, nRowDofs, nColumnDofs);
+  ierr = MatSetSizes(this->matrix_, nRowDofsLocal, nColumnDofsLocal,
+                     nRowDofsGlobal, nColumnDofsGlobal);
   CHKERRV(ierr);
 
   ierr = MatSetType(this->matrix_, matrixType);
@@ -184,6 +188,13 @@ void PartitionedPetscMatOneComponent<
     ierr = MatSeqAIJSetPreallocation(this->matrix_, nNonZerosDiagonal, NULL);
     CHKERRV(ierr);
   }
+
+  // set the mapping from local dof nos including ghosts to global petsc dof
+  // nos, such that values can be set with local indices
+  ierr = MatSetLocalToGlobalMapping(
+      this->matrix_, this->meshPartitionRows_->localToGlobalMappingDofs(),
+      this->meshPartitionColumns_->localToGlobalMappingDofs());
+  CHKERRV(ierr);
 }
 
 template <int D, typename BasisFunctionType>
@@ -203,7 +214,7 @@ void PartitionedPetscMatOneComponent<
 
   // this wraps the standard PETSc MatSetValue on the local matrix
   PetscErrorCode ierr;
-  ierr = MatSetValues(this->matrix_, 1, &row, 1, &col, &value, mode);
+  ierr = MatSetValuesLocal(this->matrix_, 1, &row, 1, &col, &value, mode);
   CHKERRV(ierr);
 }
 
@@ -223,8 +234,8 @@ void PartitionedPetscMatOneComponent<
     if (rowNo != -1) {
       PetscInt columnNo = columns[vcComponentNo];
       if (columnNo != -1) {
-        ierr =
-            MatSetValues(this->matrix_, 1, &rowNo, 1, &columnNo, &value, mode);
+        ierr = MatSetValuesLocal(this->matrix_, 1, &rowNo, 1, &columnNo, &value,
+                                 mode);
         CHKERRV(ierr);
       }
     }
@@ -255,8 +266,8 @@ void PartitionedPetscMatOneComponent<
     if (rowNo != -1) {
       PetscInt columnNo = columns[vcComponentNo];
       if (columnNo != -1) {
-        ierr = MatSetValues(this->matrix_, 1, &rowNo, 1, &columnNo,
-                            &(data[vcComponentNo]), mode);
+        ierr = MatSetValuesLocal(this->matrix_, 1, &rowNo, 1, &columnNo,
+                                 &(data[vcComponentNo]), mode);
         CHKERRV(ierr);
       }
     }
@@ -289,7 +300,7 @@ void PartitionedPetscMatOneComponent<
 
   // this wraps the standard PETSc MatSetValues on the local matrix
   PetscErrorCode ierr;
-  ierr = MatSetValues(this->matrix_, m, idxm, n, idxn, v, addv);
+  ierr = MatSetValuesLocal(this->matrix_, m, idxm, n, idxn, v, addv);
   CHKERRV(ierr);
 }
 
@@ -309,8 +320,10 @@ void PartitionedPetscMatOneComponent<
     VLOG(2) << stream.str();
   }
 
+  // the rows are given as local dof nos
   PetscErrorCode ierr;
-  ierr = MatZeroRowsColumns(this->matrix_, numRows, rows, diag, NULL, NULL);
+  ierr =
+      MatZeroRowsColumnsLocal(this->matrix_, numRows, rows, diag, NULL, NULL);
   CHKERRV(ierr);
 
   // assemble the global matrix
@@ -438,12 +451,21 @@ void PartitionedPetscMatOneComponent<
                                  BasisFunctionType>>::
     getValues(PetscInt m, const PetscInt idxm[], PetscInt n,
               const PetscInt idxn[], PetscScalar v[]) const {
-  // this wraps the standard PETSc MatGetValues, for the global indexing, only
-  // retrieves locally stored indices
+  // this wraps the standard PETSc MatGetValues, only retrieves locally stored
+  // indices
   PetscErrorCode ierr;
 
+  // transfer the local indices to global indices
+  std::vector<PetscInt> rowIndicesGlobal;
+  std::vector<PetscInt> columnIndicesGlobal;
+  this->meshPartitionRows_->getDofNoGlobalPetsc(
+      std::vector<dof_no_t>(idxm, idxm + m), rowIndicesGlobal);
+  this->meshPartitionColumns_->getDofNoGlobalPetsc(
+      std::vector<dof_no_t>(idxn, idxn + n), columnIndicesGlobal);
+
   // access the global matrix
-  ierr = MatGetValues(this->matrix_, m, idxm, n, idxn, v);
+  ierr = MatGetValues(this->matrix_, m, rowIndicesGlobal.data(), n,
+                      columnIndicesGlobal.data(), v);
   CHKERRV(ierr);
 }
 
@@ -23,12 +23,14 @@ enum values_modified_t { values_modified, values_unchanged };
  * whole domain. Local numbering: starting with 0, first all non-ghost values,
  * then the ghost indices.
  * *
- *  This particular standard specialization is for non-structured meshes or no
- * meshes and currently completely serial, it is the placeholder as long as the
- * partial specialization for unstructured meshes is not implemented. (It will
- * never be) This means some of the methods here have no effect. Most likely you
- * want to have a look at the partial specialization for structured meshes,
- * below this class.
+ *  This particular standard specialization is for unstructured meshes. There
+ * is one ghosted Petsc Vec per component, created by VecCreateGhost with the
+ * ghost dofs of the meshPartition (none for serial meshes). The local form of
+ * each Vec, which contains the non-ghost values followed by the ghost values,
+ * is kept and used for setValues and getValues with local dof nos. Ghost
+ * values are communicated by startGhostManipulation() and
+ * finishGhostManipulation(), like for structured meshes, see the partial
+ * specialization below this class.
  */
 template <typename FunctionSpaceType, int nComponents,
           typename = typename FunctionSpaceType::Mesh>
@@ -78,6 +80,14 @@ public:
   template <int nComponents2>
   void setValues(PartitionedPetscVec<FunctionSpaceType, nComponents2> &rhs);
 
+  //! set the values of component componentNo from the component
+  //! rhsComponentNo of another vector on the same function space
+  template <int nComponents2>
+  void
+  setComponentValues(int componentNo,
+                     PartitionedPetscVec<FunctionSpaceType, nComponents2> &rhs,
+                     int rhsComponentNo);
+
   //! wrapper to the PETSc VecGetValues, acting only on the local data, the
   //! indices ix are the local dof nos
   void getValues(int componentNo, PetscInt ni, const PetscInt ix[],
@@ -115,11 +125,11 @@ public:
   void restoreValuesContiguous();
 
   //! set the internal representation to be global, for unstructured meshes this
-  //! means "not contiguous", because there is no local or global vector
+  //! means "not contiguous", because the local and global vector share memory
   void setRepresentationGlobal();
 
   //! set the internal representation to be local, for unstructured meshes this
-  //! means "not contiguous", because there is no local or global vector
+  //! means "not contiguous", because the local and global vector share memory
   void setRepresentationLocal();
 
   //! set the internal representation to be contiguous, i.e. using the
@@ -144,8 +154,10 @@ protected:
   void createVector();
 
   std::array<Vec, nComponents>
-      values_; //< the (serial) Petsc vectors that contains all the data, one
+      values_; //< the global ghosted Petsc vectors that contain the data, one
                // for each component
+  std::array<Vec, nComponents>
+      valuesLocal_; //< the local forms of values_, including the ghost values
   Vec valuesContiguous_ =
       PETSC_NULL; //< global vector that has all values of the components
                   // concatenated, i.e. in a "struct of arrays" memory layout
@@ -267,6 +279,20 @@ public:
   //! debugging output
   void setValues(int componentNo, Vec petscVector, std::string name = "");
 
+  //! set the values of component componentNo from the component
+  //! rhsComponentNo of another vector on the same function space. If one of
+  //! the vectors is in contiguous representation, its contiguous vector is
+  //! accessed directly, such that its representation is not changed. This
+  //! avoids copying all components back and forth when only one component is
+  //! transferred.
+  template <int nComponents2>
+  void setComponentValues(
+      int componentNo,
+      PartitionedPetscVec<
+          FunctionSpace::FunctionSpace<MeshType, BasisFunctionType>,
+          nComponents2> &rhs,
+      int rhsComponentNo);
+
   //! extract a single component, this field variable can have any
   //! representation It set the representation of extractedPartitionedPetscVec
   //! to local.
@@ -1370,6 +1370,94 @@ void PartitionedPetscVecNComponentsStructured<MeshType, BasisFunctionType,
   setValues(componentNo, fieldVariable->valuesLocal(0), fieldVariable->name());
 }
 
+//! set the values of a component from a component of another vector, access
+//! contiguous vectors directly
+template <typename MeshType, typename BasisFunctionType, int nComponents>
+template <int nComponents2>
+void PartitionedPetscVecNComponentsStructured<MeshType, BasisFunctionType,
+                                              nComponents>::
+    setComponentValues(
+        int componentNo,
+        PartitionedPetscVec<
+            FunctionSpace::FunctionSpace<MeshType, BasisFunctionType>,
+            nComponents2> &rhs,
+        int rhsComponentNo) {
+  VLOG(3) << "\"" << this->name_ << "\" setComponentValues(" << componentNo
+          << ", rhs \"" << rhs.name() << "\", " << rhsComponentNo
+          << "), own representation: " << this->getCurrentRepresentationString()
+          << ", rhs representation: " << rhs.getCurrentRepresentationString();
+
+  assert(componentNo >= 0 && componentNo < nComponents);
+  assert(rhsComponentNo >= 0 && rhsComponentNo < nComponents2);
+
+  // the rhs vector as base class, to access its contiguous vector
+  PartitionedPetscVecNComponentsStructured<MeshType, BasisFunctionType,
+                                           nComponents2> &rhsStructured = rhs;
+
+  // the contiguous representation is only used with more than one component
+  bool isContiguous =
+      nComponents > 1 &&
+      this->currentRepresentation_ ==
+          Partition::values_representation_t::representationContiguous;
+  bool rhsIsContiguous =
+      nComponents2 > 1 &&
+      rhs.currentRepresentation() ==
+          Partition::values_representation_t::representationContiguous;
+
+  PetscErrorCode ierr;
+
+  // if none of the vectors is contiguous, the global vectors can be copied
+  // without changing the representation of all components. If it is the same
+  // vector, the array of a single contiguous vector would be needed for reading
+  // and writing, then also use the global vectors.
+  if ((!isContiguous && !rhsIsContiguous) ||
+      (void *)&rhsStructured == (void *)this) {
+    ierr = VecCopy(rhs.valuesGlobal(rhsComponentNo), valuesGlobal(componentNo));
+    CHKERRV(ierr);
+    return;
+  }
+
+  const dof_no_t nDofsLocalWithoutGhosts =
+      this->meshPartition_->nDofsLocalWithoutGhosts();
+
+  // determine the source vector and the offset of the component in it, the
+  // global vectors hold the non-ghost values at the beginning of the local
+  // array
+  Vec vectorSource = rhsStructured.valuesContiguous_;
+  dof_no_t dofStartSource = rhsComponentNo * nDofsLocalWithoutGhosts;
+  if (!rhsIsContiguous) {
+    vectorSource = rhs.valuesGlobal(rhsComponentNo);
+    dofStartSource = 0;
+  }
+
+  // determine the target vector and the offset of the component in it
+  Vec vectorTarget = valuesContiguous_;
+  dof_no_t dofStartTarget = componentNo * nDofsLocalWithoutGhosts;
+  if (!isContiguous) {
+    vectorTarget = valuesGlobal(componentNo);
+    dofStartTarget = 0;
+  }
+
+  const double *valuesSource;
+  ierr = VecGetArrayRead(vectorSource, &valuesSource);
+  CHKERRV(ierr);
+
+  double *valuesTarget;
+  ierr = VecGetArray(vectorTarget, &valuesTarget);
+  CHKERRV(ierr);
+
+  VLOG(1) << "  copy " << nDofsLocalWithoutGhosts * sizeof(double)
+          << " bytes from \"" << rhs.name() << "\" component " << rhsComponentNo
+          << " to \"" << this->name_ << "\" component " << componentNo;
+  memcpy(valuesTarget + dofStartTarget, valuesSource + dofStartSource,
+         nDofsLocalWithoutGhosts * sizeof(double));
+
+  ierr = VecRestoreArray(vectorTarget, &valuesTarget);
+  CHKERRV(ierr);
+  ierr = VecRestoreArrayRead(vectorSource, &valuesSource);
+  CHKERRV(ierr);
+}
+
 //! get a vector of local dof nos (from meshPartition), without ghost dofs
 template <typename MeshType, typename BasisFunctionType, int nComponents>
 std::vector<PetscInt> &PartitionedPetscVecNComponentsStructured<
@@ -40,6 +40,8 @@ PartitionedPetscVec<FunctionSpaceType, nComponents, DummyForTraits>::
                    << ", starting at component " << rhsComponentNoBegin;
       }
       values_[componentNo] = rhs.values_[rhsComponentNoBegin + componentNo];
+      valuesLocal_[componentNo] =
+          rhs.valuesLocal_[rhsComponentNoBegin + componentNo];
     }
 
     // create VecNest object, if number of components > 1
@@ -63,27 +65,31 @@ void PartitionedPetscVec<FunctionSpaceType, nComponents,
                          DummyForTraits>::createVector() {
   assert(this->meshPartition_);
 
-  dof_no_t nEntriesLocal = this->meshPartition_->nDofs();
-  dof_no_t nEntriesGlobal = nEntriesLocal;
+  dof_no_t nEntriesLocal = this->meshPartition_->nDofsLocalWithoutGhosts();
+  global_no_t nEntriesGlobal = this->meshPartition_->nDofsGlobal();
+
+  // the ghost dofs, this is empty for serial meshes
+  const std::vector<PetscInt> &ghostDofNosGlobalPetsc =
+      this->meshPartition_->ghostDofNosGlobalPetsc();
 
   PetscErrorCode ierr;
 
   // loop over the components of this field variable
   for (int componentNo = 0; componentNo < nComponents; componentNo++) {
-    // initialize PETSc vector object
-    ierr = VecCreate(this->meshPartition_->mpiCommunicator(),
-                     &values_[componentNo]);
+    // initialize PETSc vector object with ghost entries
+    ierr = VecCreateGhost(
+        this->meshPartition_->mpiCommunicator(), nEntriesLocal, nEntriesGlobal,
+        ghostDofNosGlobalPetsc.size(), ghostDofNosGlobalPetsc.data(),
+        &values_[componentNo]);
     CHKERRV(ierr);
     ierr = PetscObjectSetName((PetscObject)values_[componentNo],
                               this->name_.c_str());
     CHKERRV(ierr);
 
-    // initialize size of vector
-    ierr = VecSetSizes(values_[componentNo], nEntriesLocal, nEntriesGlobal);
-    CHKERRV(ierr);
-
-    // set sparsity type and other options
-    ierr = VecSetFromOptions(values_[componentNo]);
+    // get the local vector that shares the memory and also contains the ghost
+    // values, it is kept for the whole lifetime
+    ierr =
+        VecGhostGetLocalForm(values_[componentNo], &valuesLocal_[componentNo]);
     CHKERRV(ierr);
   }
 
@@ -99,7 +105,22 @@ void PartitionedPetscVec<FunctionSpaceType, nComponents,
 //! vecZeroEntries is called)
 template <typename FunctionSpaceType, int nComponents, typename DummyForTraits>
 void PartitionedPetscVec<FunctionSpaceType, nComponents,
-                         DummyForTraits>::startGhostManipulation() {}
+                         DummyForTraits>::startGhostManipulation() {
+  assert(values_.size() == nComponents);
+
+  PetscErrorCode ierr;
+  // fill the ghost buffers with the values from the owning ranks
+  for (int componentNo = 0; componentNo < nComponents; componentNo++) {
+    ierr = VecGhostUpdateBegin(values_[componentNo], INSERT_VALUES,
+                               SCATTER_FORWARD);
+    CHKERRV(ierr);
+  }
+  for (int componentNo = 0; componentNo < nComponents; componentNo++) {
+    ierr = VecGhostUpdateEnd(values_[componentNo], INSERT_VALUES,
+                             SCATTER_FORWARD);
+    CHKERRV(ierr);
+  }
+}
 
 //! this has to be called after the vector is manipulated (i.e. VecSetValues or
 //! vecZeroEntries is called)
@@ -120,6 +141,17 @@ void PartitionedPetscVec<FunctionSpaceType, nComponents,
     ierr = VecAssemblyEnd(values_[componentNo]);
     CHKERRV(ierr);
   }
+
+  // add the values of the ghost buffers to the values on the owning ranks
+  for (int componentNo = 0; componentNo < nComponents; componentNo++) {
+    ierr = VecGhostUpdateBegin(values_[componentNo], ADD_VALUES,
+                               SCATTER_REVERSE);
+    CHKERRV(ierr);
+  }
+  for (int componentNo = 0; componentNo < nComponents; componentNo++) {
+    ierr = VecGhostUpdateEnd(values_[componentNo], ADD_VALUES, SCATTER_REVERSE);
+    CHKERRV(ierr);
+  }
 }
 
 // set the internal representation to be global, i.e. using the global vectors
@@ -202,7 +234,24 @@ void PartitionedPetscVec<FunctionSpaceType, nComponents, DummyForTraits>::
 
 template <typename FunctionSpaceType, int nComponents, typename DummyForTraits>
 void PartitionedPetscVec<FunctionSpaceType, nComponents,
-                         DummyForTraits>::zeroGhostBuffer() {}
+                         DummyForTraits>::zeroGhostBuffer() {
+  dof_no_t nDofsLocalWithoutGhosts =
+      this->meshPartition_->nDofsLocalWithoutGhosts();
+  dof_no_t nDofsLocalWithGhosts = this->meshPartition_->nDofsLocalWithGhosts();
+
+  PetscErrorCode ierr;
+  for (int componentNo = 0; componentNo < nComponents; componentNo++) {
+    double *valuesLocal;
+    ierr = VecGetArray(valuesLocal_[componentNo], &valuesLocal);
+    CHKERRV(ierr);
+
+    std::fill(valuesLocal + nDofsLocalWithoutGhosts,
+              valuesLocal + nDofsLocalWithGhosts, 0.0);
+
+    ierr = VecRestoreArray(valuesLocal_[componentNo], &valuesLocal);
+    CHKERRV(ierr);
+  }
+}
 
 //! wrapper to the PETSc VecSetValues, acting only on the local data, the
 //! indices ix are the local dof nos
@@ -255,15 +304,11 @@ void PartitionedPetscVec<FunctionSpaceType, nComponents,
       CHKERRV(ierr);
     }
   } else {
+    // this wraps the standard PETSc VecSetValues on the local vector with
+    // ghosts
     PetscErrorCode ierr;
-    ierr = VecSetValues(values_[componentNo], ni, ix, y, iora);
+    ierr = VecSetValues(valuesLocal_[componentNo], ni, ix, y, iora);
     CHKERRV(ierr);
-
-    // get value
-    double value;
-    ierr = VecGetValues(values_[componentNo], ni, ix, &value);
-    CHKERRV(ierr);
-    // LOG(DEBUG) << "retrieved value: " << value;
   }
 }
 
@@ -294,7 +339,7 @@ void PartitionedPetscVec<FunctionSpaceType, nComponents,
   } else {
     // this wraps the standard PETSc VecSetValue on the local vector
     PetscErrorCode ierr;
-    ierr = VecSetValue(values_[componentNo], row, value, mode);
+    ierr = VecSetValue(valuesLocal_[componentNo], row, value, mode);
     CHKERRV(ierr);
   }
 }
@@ -320,14 +365,31 @@ void PartitionedPetscVec<FunctionSpaceType, nComponents, DummyForTraits>::
     ierr = VecCopy(rhs.getValuesContiguous(), valuesContiguous_);
     CHKERRV(ierr);
   } else {
+    // copy the local vectors, such that also the ghost values are copied
     for (int componentNo = 0; componentNo < std::min(nComponents, nComponents2);
          componentNo++) {
-      ierr = VecCopy(rhs.valuesGlobal(componentNo), values_[componentNo]);
+      ierr = VecCopy(rhs.valuesLocal(componentNo), valuesLocal_[componentNo]);
       CHKERRV(ierr);
     }
   }
 }
 
+//! set the values of a component from a component of another vector
+template <typename FunctionSpaceType, int nComponents, typename DummyForTraits>
+template <int nComponents2>
+void PartitionedPetscVec<FunctionSpaceType, nComponents, DummyForTraits>::
+    setComponentValues(
+        int componentNo,
+        PartitionedPetscVec<FunctionSpaceType, nComponents2> &rhs,
+        int rhsComponentNo) {
+  VLOG(3) << "\"" << this->name_ << "\" setComponentValues(" << componentNo
+          << ", rhs \"" << rhs.name() << "\", " << rhsComponentNo << ")";
+
+  PetscErrorCode ierr;
+  ierr = VecCopy(rhs.valuesLocal(rhsComponentNo), valuesLocal(componentNo));
+  CHKERRV(ierr);
+}
+
 //! wrapper to the PETSc VecGetValues, acting only on the local data, the
 //! indices ix are the local dof nos
 template <typename FunctionSpaceType, int nComponents, typename DummyForTraits>
@@ -364,9 +426,10 @@ void PartitionedPetscVec<FunctionSpaceType, nComponents,
       CHKERRV(ierr);
     }
   } else {
-    // this wraps the standard PETSc VecGetValues on the local vector
+    // this wraps the standard PETSc VecGetValues on the local vector with
+    // ghosts
     PetscErrorCode ierr;
-    ierr = VecGetValues(values_[componentNo], ni, ix, y);
+    ierr = VecGetValues(valuesLocal_[componentNo], ni, ix, y);
     CHKERRV(ierr);
   }
 
@@ -391,7 +454,10 @@ template <typename FunctionSpaceType, int nComponents, typename DummyForTraits>
 void PartitionedPetscVec<FunctionSpaceType, nComponents, DummyForTraits>::
     getValuesGlobalPetscIndexing(int componentNo, PetscInt ni,
                                  const PetscInt ix[], PetscScalar y[]) {
-  getValues(componentNo, ni, ix, y);
+  // this only works for indices of dofs that are owned by the own rank
+  PetscErrorCode ierr;
+  ierr = VecGetValues(values_[componentNo], ni, ix, y);
+  CHKERRV(ierr);
 }
 
 //! set all entries to zero, wraps VecZeroEntries
@@ -408,8 +474,9 @@ void PartitionedPetscVec<FunctionSpaceType, nComponents,
     ierr = VecZeroEntries(valuesContiguous_);
     CHKERRV(ierr);
   } else {
+    // zero the local vectors, this includes the ghost values
     for (int componentNo = 0; componentNo < nComponents; componentNo++) {
-      ierr = VecZeroEntries(values_[componentNo]);
+      ierr = VecZeroEntries(valuesLocal_[componentNo]);
       CHKERRV(ierr);
     }
   }
@@ -423,7 +490,7 @@ Vec &PartitionedPetscVec<FunctionSpaceType, nComponents,
   assert(componentNo < values_.size());
   assert(values_.size() == nComponents);
 
-  return values_[componentNo];
+  return valuesLocal_[componentNo];
 }
 
 //! get the global Vector of a specified component
@@ -460,15 +527,17 @@ Vec &PartitionedPetscVec<FunctionSpaceType, nComponents,
 
   // create contiguos vector if it does not exist yet
   if (valuesContiguous_ == PETSC_NULL) {
-    ierr =
-        VecCreate(this->meshPartition_->mpiCommunicator(), &valuesContiguous_);
+    // the contiguous vector only contains the local values without ghosts,
+    // therefore it uses MPI_COMM_SELF, like for structured meshes
+    ierr = VecCreate(MPI_COMM_SELF, &valuesContiguous_);
     CHKERRABORT(this->meshPartition_->mpiCommunicator(), ierr);
     ierr =
         PetscObjectSetName((PetscObject)valuesContiguous_, this->name_.c_str());
     CHKERRABORT(this->meshPartition_->mpiCommunicator(), ierr);
 
     // initialize size of vector
-    int nEntriesLocal = this->meshPartition_->nDofs() * nComponents;
+    int nEntriesLocal =
+        this->meshPartition_->nDofsLocalWithoutGhosts() * nComponents;
     int nEntriesGlobal = nEntriesLocal;
     ierr = VecSetSizes(valuesContiguous_, nEntriesLocal, nEntriesGlobal);
     CHKERRABORT(this->meshPartition_->mpiCommunicator(), ierr);
@@ -487,16 +556,18 @@ Vec &PartitionedPetscVec<FunctionSpaceType, nComponents,
   ierr = VecGetArray(valuesContiguous_, &valuesDataContiguous);
   CHKERRABORT(this->meshPartition_->mpiCommunicator(), ierr);
 
+  const dof_no_t nDofsLocal = this->meshPartition_->nDofsLocalWithoutGhosts();
+
   // copy values from component vectors to contiguous vector
   for (int componentNo = 0; componentNo < nComponents; componentNo++) {
     const double *valuesDataComponent;
     ierr = VecGetArrayRead(values_[componentNo], &valuesDataComponent);
     CHKERRABORT(this->meshPartition_->mpiCommunicator(), ierr);
 
-    VLOG(1) << "  copy " << this->meshPartition_->nDofs() * sizeof(double)
+    VLOG(1) << "  copy " << nDofsLocal * sizeof(double)
             << " bytes to contiguous array";
-    memcpy(valuesDataContiguous + componentNo * this->meshPartition_->nDofs(),
-           valuesDataComponent, this->meshPartition_->nDofs() * sizeof(double));
+    memcpy(valuesDataContiguous + componentNo * nDofsLocal,
+           valuesDataComponent, nDofsLocal * sizeof(double));
 
     ierr = VecRestoreArrayRead(values_[componentNo], &valuesDataComponent);
     CHKERRABORT(this->meshPartition_->mpiCommunicator(), ierr);
@@ -531,6 +602,8 @@ void PartitionedPetscVec<FunctionSpaceType, nComponents,
   ierr = VecGetArrayRead(valuesContiguous_, &valuesDataContiguous);
   CHKERRV(ierr);
 
+  const dof_no_t nDofsLocal = this->meshPartition_->nDofsLocalWithoutGhosts();
+
   // copy values from component vectors to contiguous vector
   for (int componentNo = 0; componentNo < nComponents; componentNo++) {
     double *valuesDataComponent;
@@ -538,12 +611,10 @@ void PartitionedPetscVec<FunctionSpaceType, nComponents,
     CHKERRV(ierr);
 
     VLOG(1) << "  \"" << this->name_ << "\", component " << componentNo
-            << ", copy " << this->meshPartition_->nDofs() << " values, "
-            << this->meshPartition_->nDofs() * sizeof(double)
-            << " bytes from contiguous array";
-    memcpy(valuesDataComponent,
-           valuesDataContiguous + componentNo * this->meshPartition_->nDofs(),
-           this->meshPartition_->nDofs() * sizeof(double));
+            << ", copy " << nDofsLocal << " values, "
+            << nDofsLocal * sizeof(double) << " bytes from contiguous array";
+    memcpy(valuesDataComponent, valuesDataContiguous + componentNo * nDofsLocal,
+           nDofsLocal * sizeof(double));
 
     ierr = VecRestoreArray(values_[componentNo], &valuesDataComponent);
     CHKERRV(ierr);
@@ -565,9 +636,12 @@ void PartitionedPetscVec<FunctionSpaceType, nComponents,
 
   for (int componentNo = 0; componentNo < nComponents; componentNo++) {
     Vec vector = values_[componentNo];
+    Vec vectorLocal = valuesLocal_[componentNo];
     if (this->currentRepresentation_ ==
-        Partition::values_representation_t::representationContiguous)
+        Partition::values_representation_t::representationContiguous) {
       vector = valuesContiguous_;
+      vectorLocal = valuesContiguous_;
+    }
 
     // retrieve local values
     int nDofsLocal = this->meshPartition_->nDofsLocalWithoutGhosts();
@@ -585,7 +659,8 @@ void PartitionedPetscVec<FunctionSpaceType, nComponents,
     }
     std::vector<double> localValues(nDofsLocal);
     PetscErrorCode ierr;
-    ierr = VecGetValues(vector, nDofsLocal, indices.data(), localValues.data());
+    ierr = VecGetValues(vectorLocal, nDofsLocal, indices.data(),
+                        localValues.data());
     CHKERRV(ierr);
 
     if (ownRankNo == 0) {
@@ -0,0 +1,72 @@
+#include "partition/recursive_coordinate_bisection.h"
+
+#include <cassert>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+
+#include "easylogging++.h"
+
+namespace Partition {
+
+std::vector<int>
+RecursiveCoordinateBisection::partition(const std::vector<Vec3> &points,
+                                        int nParts) {
+  assert(nParts > 0);
+
+  std::vector<int> partNos(points.size(), 0);
+  std::vector<int> indices(points.size());
+  std::iota(indices.begin(), indices.end(), 0);
+
+  bisect(points, indices.begin(), indices.end(), 0, nParts, partNos);
+
+  return partNos;
+}
+
+void RecursiveCoordinateBisection::bisect(const std::vector<Vec3> &points,
+                                          std::vector<int>::iterator begin,
+                                          std::vector<int>::iterator end,
+                                          int firstPartNo, int nParts,
+                                          std::vector<int> &partNos) {
+  if (nParts == 1 || end - begin <= 1) {
+    for (std::vector<int>::iterator iter = begin; iter != end; iter++)
+      partNos[*iter] = firstPartNo;
+    return;
+  }
+
+  // determine the coordinate direction with the largest extent
+  Vec3 minimum, maximum;
+  minimum.fill(std::numeric_limits<double>::max());
+  maximum.fill(std::numeric_limits<double>::lowest());
+  for (std::vector<int>::iterator iter = begin; iter != end; iter++) {
+    for (int i = 0; i < 3; i++) {
+      minimum[i] = std::min(minimum[i], points[*iter][i]);
+      maximum[i] = std::max(maximum[i], points[*iter][i]);
+    }
+  }
+
+  int splitDirection = 0;
+  for (int i = 1; i < 3; i++) {
+    if (maximum[i] - minimum[i] >
+        maximum[splitDirection] - minimum[splitDirection])
+      splitDirection = i;
+  }
+
+  // split the points in proportion to the number of parts on both sides, ties
+  // are broken by the point index such that the result is deterministic
+  int nPartsFirstHalf = nParts / 2;
+  long long nPoints = end - begin;
+  std::vector<int>::iterator split = begin + nPoints * nPartsFirstHalf / nParts;
+
+  std::nth_element(begin, split, end, [&points, splitDirection](int a, int b) {
+    if (points[a][splitDirection] != points[b][splitDirection])
+      return points[a][splitDirection] < points[b][splitDirection];
+    return a < b;
+  });
+
+  bisect(points, begin, split, firstPartNo, nPartsFirstHalf, partNos);
+  bisect(points, split, end, firstPartNo + nPartsFirstHalf,
+         nParts - nPartsFirstHalf, partNos);
+}
+
+} // namespace Partition
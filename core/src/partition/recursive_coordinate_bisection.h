@@ -0,0 +1,32 @@
+#pragma once
+
+#include <vector>
+
+#include "control/types.h"
+
+namespace Partition {
+
+/** Geometric partitioner for unstructured meshes. The points (e.g. the element
+ * centroids) are recursively split into two halves at the median of the
+ * coordinate direction with the largest extent, until there are as many parts
+ * as requested. The number of points per part differs by at most one.
+ *
+ *  The result only depends on the input, such that every rank can compute the
+ * same partitioning without communication.
+ */
+class RecursiveCoordinateBisection {
+public:
+  //! compute the part no in [0,nParts) for every point
+  static std::vector<int> partition(const std::vector<Vec3> &points,
+                                    int nParts);
+
+private:
+  //! assign parts [firstPartNo, firstPartNo+nParts) to the points given by
+  //! the indices in [begin,end)
+  static void bisect(const std::vector<Vec3> &points,
+                     std::vector<int>::iterator begin,
+                     std::vector<int>::iterator end, int firstPartNo,
+                     int nParts, std::vector<int> &partNos);
+};
+
+} // namespace Partition
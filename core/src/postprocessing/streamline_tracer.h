@@ -64,6 +64,7 @@ protected:
                                  // streamlines are dropped that are smaller
                                  // than this relative length times the median
                                  // fiber length
+  int nThreads_; //< number of threads that trace the streamlines
   std::string
       csvFilename_; //< a csv output filename to write the node positions of the
                     // streamlines to (after postprocessing)
@@ -1,7 +1,9 @@
 #include "postprocessing/streamline_tracer.h"
 
 #include <algorithm>
+#include <sstream>
 #include <petscvec.h>
+#include <omp.h>
 
 #include "utility/python_utility.h"
 
@@ -23,6 +25,29 @@ StreamlineTracer<DiscretizableInTimeType>::StreamlineTracer(DihuContext context)
   this->useGradientField_ =
       specificSettings_.getOptionBool("useGradientField", false);
 
+  std::string integrationScheme =
+      specificSettings_.getOptionString("integrationScheme", "ExplicitEuler");
+  if (integrationScheme == "RungeKutta45") {
+    this->integrationScheme_ = this->integrationSchemeRungeKutta45;
+  } else {
+    if (integrationScheme != "ExplicitEuler") {
+      LOG(WARNING) << specificSettings_ << "[\"integrationScheme\"] is \""
+                   << integrationScheme << "\", possible values are "
+                   << "\"ExplicitEuler\" and \"RungeKutta45\". "
+                   << "Now using \"ExplicitEuler\".";
+    }
+    this->integrationScheme_ = this->integrationSchemeExplicitEuler;
+  }
+  this->integrationTolerance_ = specificSettings_.getOptionDouble(
+      "integrationTolerance", 1e-5, PythonUtility::Positive);
+  this->maxLineStepWidth_ = specificSettings_.getOptionDouble(
+      "maxLineStepWidth", 10 * this->lineStepWidth_, PythonUtility::Positive);
+
+  nThreads_ =
+      specificSettings_.getOptionInt("nThreads", 1, PythonUtility::NonNegative);
+  if (nThreads_ == 0)
+    nThreads_ = omp_get_max_threads();
+
   targetElementLength_ = specificSettings_.getOptionDouble(
       "targetElementLength", 0.0, PythonUtility::Positive);
   targetLength_ = specificSettings_.getOptionDouble("targetLength", 0.0,
@@ -92,25 +117,67 @@ void StreamlineTracer<DiscretizableInTimeType>::traceStreamlines() {
 
   LOG(DEBUG) << "trace streamline, seedPositions: " << seedPositions_;
 
+  // the field variables are only read by the threads, switch them to the
+  // local representation now, because switching would modify the vectors
+  if (nThreads_ > 1 && nSeedPoints > 1) {
+    this->solution_->setRepresentationLocal();
+    this->gradient_->setRepresentationLocal();
+    this->functionSpace_->geometryField().setRepresentationLocal();
+    for (int faceOrEdgeNo = 0; faceOrEdgeNo < 10; faceOrEdgeNo++) {
+      if (this->ghostMeshSolution_[faceOrEdgeNo])
+        this->ghostMeshSolution_[faceOrEdgeNo]->setRepresentationLocal();
+      if (this->ghostMeshGradient_[faceOrEdgeNo])
+        this->ghostMeshGradient_[faceOrEdgeNo]->setRepresentationLocal();
+      std::shared_ptr<typename DiscretizableInTimeType::FunctionSpace>
+          ghostMesh = this->functionSpace_->ghostMesh(
+              (Mesh::face_or_edge_t)faceOrEdgeNo);
+      if (ghostMesh)
+        ghostMesh->geometryField().setRepresentationLocal();
+    }
+  }
+
+  // the logging library is not thread-safe, disable all log levels except
+  // fatal while the threads trace the streamlines. The warnings of the
+  // streamlines are collected per seed point and logged after the loop.
+  std::vector<std::vector<std::string>> warnings(nSeedPoints);
+  std::vector<el::Level> disabledLogLevels;
+  if (nThreads_ > 1 && nSeedPoints > 1) {
+    el::Logger *logger = el::Loggers::getLogger("default");
+    for (el::Level level :
+         {el::Level::Info, el::Level::Debug, el::Level::Verbose,
+          el::Level::Trace, el::Level::Warning, el::Level::Error}) {
+      if (logger->typedConfigurations()->enabled(level)) {
+        disabledLogLevels.push_back(level);
+        el::Loggers::reconfigureAllLoggers(
+            level, el::ConfigurationType::Enabled, "false");
+      }
+    }
+  }
+
   // loop over seed points
-  //#pragma omp parallel for shared(streamlines)
+#pragma omp parallel for num_threads(nThreads_) schedule(dynamic)              \
+    shared(streamlines, warnings) if (nThreads_ > 1)
   for (int seedPointNo = 0; seedPointNo < nSeedPoints; seedPointNo++) {
     // get starting point
     Vec3 startingPoint = seedPositions_[seedPointNo];
 
     // trace streamline forwards
     std::vector<Vec3> forwardPoints;
-    this->traceStreamline(startingPoint, 1.0, forwardPoints);
+    this->traceStreamline(startingPoint, 1.0, forwardPoints,
+                          warnings[seedPointNo]);
 
     if (forwardPoints.empty()) // if there was not even the first point found
     {
-      LOG(ERROR) << "Seed point " << startingPoint << " is outside of domain.";
+      std::stringstream message;
+      message << "Seed point " << startingPoint << " is outside of domain.";
+      warnings[seedPointNo].push_back(message.str());
       continue;
     }
 
     // trace streamline backwards
     std::vector<Vec3> backwardPoints;
-    this->traceStreamline(startingPoint, -1.0, backwardPoints);
+    this->traceStreamline(startingPoint, -1.0, backwardPoints,
+                          warnings[seedPointNo]);
 
     // copy collected points to result vector, note avoiding this additional
     // copy-step is not really possible, since it would require a push_front
@@ -127,6 +194,18 @@ void StreamlineTracer<DiscretizableInTimeType>::traceStreamlines() {
                << streamlines[seedPointNo].size() << " points";
   }
 
+  // enable the log levels again
+  for (el::Level level : disabledLogLevels) {
+    el::Loggers::reconfigureAllLoggers(level, el::ConfigurationType::Enabled,
+                                       "true");
+  }
+
+  // log the collected warnings in the order of the seed points
+  for (int seedPointNo = 0; seedPointNo < nSeedPoints; seedPointNo++) {
+    for (const std::string &warning : warnings[seedPointNo])
+      LOG(WARNING) << "Seed point " << seedPointNo << ": " << warning;
+  }
+
   // create 1D meshes of streamline from collected node positions
   if (!csvFilenameBeforePostprocessing_.empty()) {
     std::ofstream file(csvFilenameBeforePostprocessing_,
@@ -265,8 +344,11 @@ void StreamlineTracer<DiscretizableInTimeType>::postprocessStreamlines(
   }
 
   // resample streamlines
+  // the points of adaptive Runge-Kutta steps are not equidistant and are
+  // always resampled
   if (targetElementLength_ != 0.0 &&
-      targetElementLength_ != this->lineStepWidth_) {
+      (targetElementLength_ != this->lineStepWidth_ ||
+       this->integrationScheme_ == this->integrationSchemeRungeKutta45)) {
     // loop over streamlines
     for (int i = 0; i < streamlines.size(); i++) {
       std::vector<Vec3> &currentStreamline = streamlines[i];
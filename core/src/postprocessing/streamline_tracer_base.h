@@ -2,6 +2,7 @@
 
 #include <Python.h> // has to be the first included header
 #include <vector>
+#include <string>
 
 #include "interfaces/discretizable_in_time.h"
 #include "interfaces/runnable.h"
@@ -11,15 +12,57 @@ namespace Postprocessing {
 
 /** A class that traces streamlines through a given solution field. This base
  * class only performs the tracing of the streamlines.
+ *  The state of the element search is held per streamline, such that
+ * traceStreamline can be called for different streamlines from multiple
+ * threads, if the field variables are in local representation.
  */
 template <typename FunctionSpace> class StreamlineTracerBase {
 public:
+  //! the method to integrate the streamlines
+  enum integration_scheme_t {
+    integrationSchemeExplicitEuler, //< fixed step width lineStepWidth_
+    integrationSchemeRungeKutta45   //< adaptive Dormand-Prince 5(4) steps
+  };
+
   //! trace the streamline starting from startingPoint in the element
   //! initialElementNo, direction is either 1. or -1. depending on the direction
   void traceStreamline(Vec3 startingPoint, double direction,
                        std::vector<Vec3> &points);
 
+  //! trace the streamline like above, but do not log warnings and errors and
+  //! append them to warnings instead, this can be called from multiple threads
+  void traceStreamline(Vec3 startingPoint, double direction,
+                       std::vector<Vec3> &points,
+                       std::vector<std::string> &warnings);
+
 protected:
+  //! the element in which the last point of a streamline was found, this is
+  //! the starting point for the search of the next point
+  struct ElementSearchState {
+    element_no_t elementNo = 0; //< local element no. of the last point
+    int ghostMeshNo = -1;       //< ghost mesh of the element, -1 for none
+    std::array<double, 3> xi;   //< element coordinate of the last point
+    bool startSearchInCurrentElement =
+        false; //< if elementNo is valid, false before the first search
+  };
+
+  //! get the normalized gradient at point, returns false if the point is
+  //! outside of the domain, warnings are appended to warnings
+  bool computeDirection(Vec3 point, ElementSearchState &searchState,
+                        Vec3 &normalizedGradient,
+                        std::vector<std::string> &warnings);
+
+  //! trace with explicit Euler steps of the fixed width lineStepWidth_
+  void traceStreamlineExplicitEuler(Vec3 startingPoint, double direction,
+                                    std::vector<Vec3> &points,
+                                    std::vector<std::string> &warnings);
+
+  //! trace with the embedded Runge-Kutta method of Dormand and Prince, the
+  //! step width is adapted to meet integrationTolerance_
+  void traceStreamlineRungeKutta45(Vec3 startingPoint, double direction,
+                                   std::vector<Vec3> &points,
+                                   std::vector<std::string> &warnings);
+
   std::shared_ptr<FunctionSpace>
       functionSpace_; //< function space of the solution field in which the
                       // tracing is performed
@@ -41,7 +84,14 @@ protected:
                           // regular subdomain by one layer of elements
 
   double lineStepWidth_; //< the line step width used for integrating the
-                         // streamlines
+                         // streamlines, initial step width for Runge-Kutta
+  integration_scheme_t integrationScheme_ =
+      integrationSchemeExplicitEuler; //< the method to integrate the
+                                      // streamlines
+  double integrationTolerance_ =
+      1e-5; //< tolerance of the local error of a Runge-Kutta step, the error
+            // is the distance between the 4th and 5th order points
+  double maxLineStepWidth_ = 0.1; //< maximum step width for Runge-Kutta
 
   int maxNIterations_;    //< the maximum number of iterations to trace for a
                           // streamline
@@ -1,29 +1,55 @@
 #include "postprocessing/streamline_tracer_base.h"
 
 #include <algorithm>
+#include <cmath>
+#include <sstream>
 
 namespace Postprocessing {
 
 template <typename FunctionSpace>
 void StreamlineTracerBase<FunctionSpace>::traceStreamline(
     Vec3 startingPoint, double direction, std::vector<Vec3> &points) {
-  const int D = FunctionSpace::dim();
-  const int nDofsPerElement = FunctionSpace::nDofsPerElement();
+  std::vector<std::string> warnings;
+  traceStreamline(startingPoint, direction, points, warnings);
+
+  for (const std::string &warning : warnings)
+    LOG(WARNING) << warning;
+}
 
+template <typename FunctionSpace>
+void StreamlineTracerBase<FunctionSpace>::traceStreamline(
+    Vec3 startingPoint, double direction, std::vector<Vec3> &points,
+    std::vector<std::string> &warnings) {
   LOG(DEBUG) << "traceStreamline(startingPoint " << startingPoint
              << ", direction " << direction
              << ", maxNIterations_: " << maxNIterations_
              << "), useGradientField_: " << useGradientField_;
 
-  // functionSpace_->debugOutputGhostMeshSet();
+  if (integrationScheme_ == integrationSchemeRungeKutta45) {
+    traceStreamlineRungeKutta45(startingPoint, direction, points, warnings);
+  } else {
+    traceStreamlineExplicitEuler(startingPoint, direction, points, warnings);
+  }
 
-  Vec3 currentPoint = startingPoint;
-  element_no_t elementNo = 0;
-  int ghostMeshNo = -1;
-  std::array<double, (unsigned long int)3> xi;
-  std::shared_ptr<FunctionSpace> functionSpace =
-      functionSpace_; //< the function space to use, this can be set to one of
-                      // the ghost meshes
+  if (points.empty()) {
+    LOG(DEBUG) << "traced streamline is completely empty, startingPoint: "
+               << startingPoint;
+    points.push_back(startingPoint);
+  } else if (points.size() == 1) {
+    LOG(DEBUG) << "traced streamline has 1 point: " << points[0];
+  } else {
+    LOG(DEBUG) << "traced streamline has " << points.size()
+               << " points, start: " << points[0]
+               << ", end: " << points[points.size() - 1];
+  }
+}
+
+template <typename FunctionSpace>
+bool StreamlineTracerBase<FunctionSpace>::computeDirection(
+    Vec3 point, ElementSearchState &searchState, Vec3 &normalizedGradient,
+    std::vector<std::string> &warnings) {
+  const int D = FunctionSpace::dim();
+  const int nDofsPerElement = FunctionSpace::nDofsPerElement();
 
   // There are 2 implementations of streamline tracing.
   // The first one (useGradientField_) uses a precomputed gradient field that is
@@ -37,143 +63,263 @@ void StreamlineTracerBase<FunctionSpace>::traceStreamline(
   std::array<double, nDofsPerElement> elementalSolutionValues;
   std::array<Vec3, nDofsPerElement> geometryValues;
 
-  bool startSearchInCurrentElement = false;
+  element_no_t &elementNo = searchState.elementNo;
+  int &ghostMeshNo = searchState.ghostMeshNo;
+  std::array<double, 3> &xi = searchState.xi;
+
+  VLOG(1) << "startSearchInCurrentElement="
+          << searchState.startSearchInCurrentElement
+          << ", elementNo: " << elementNo << " ghostMeshNo: " << ghostMeshNo;
+  double residual;
+  bool searchedAllElements;
+
+  // look for the element and xi value of the point, also considers ghost
+  // meshes if they are set
+  bool positionFound = functionSpace_->findPosition(
+      point, elementNo, ghostMeshNo, xi,
+      searchState.startSearchInCurrentElement, residual, searchedAllElements);
+
+  // all subsequent searches start at the element of the last point
+  bool startSearchInCurrentElement = searchState.startSearchInCurrentElement;
+  searchState.startSearchInCurrentElement = true;
+
+  // if no position was found, the streamline exits the domain
+  if (!positionFound) {
+    LOG(DEBUG) << point << " is outside of domain."
+               << " startSearchInCurrentElement: "
+               << startSearchInCurrentElement << ", residual: " << residual
+               << ", searchedAllElements: " << searchedAllElements;
+    return false;
+  }
+
+  VLOG(1) << " findPosition for " << point << " returned ghostMeshNo "
+          << ghostMeshNo << ", elementNo " << elementNo << ", xi " << xi
+          << ", residual: " << residual
+          << ", startSearchInCurrentElement: " << startSearchInCurrentElement
+          << ", searchedAllElements: " << searchedAllElements;
+
+  // get values for element that are later needed to compute the gradient
+  std::shared_ptr<FunctionSpace> functionSpace =
+      functionSpace_; //< the function space to use, this can be set to one of
+                      // the ghost meshes
+
+  // if the streamline passes a normal element
+  if (ghostMeshNo == -1) {
+    VLOG(1) << "use normal mesh";
+
+    if (useGradientField_) {
+      gradient_->getElementValues(elementNo, elementalGradientValues);
+    } else {
+      solution_->getElementValues(elementNo, elementalSolutionValues);
+
+      // get geometry field (which are the node positions for Lagrange basis
+      // and node positions and derivatives for Hermite)
+      functionSpace->getElementGeometry(elementNo, geometryValues);
+    }
+  } else // if the streamline is in an element of a ghost mesh
+  {
+    VLOG(1) << "use ghost mesh";
+
+    // use ghost mesh as current function space
+    functionSpace =
+        functionSpace_->ghostMesh((Mesh::face_or_edge_t)ghostMeshNo);
+
+    if (useGradientField_) {
+      ghostMeshGradient_[ghostMeshNo]->getElementValues(
+          elementNo, elementalGradientValues);
+    } else {
+      ghostMeshSolution_[ghostMeshNo]->getElementValues(
+          elementNo, elementalSolutionValues);
+
+      // get geometry field (which are the node positions for Lagrange basis
+      // and node positions and derivatives for Hermite)
+      functionSpace->getElementGeometry(elementNo, geometryValues);
+    }
+  }
+
+  // get value of gradient
+  Vec3 gradient;
+  if (useGradientField_) {
+    gradient = functionSpace->template interpolateValueInElement<3>(
+        elementalGradientValues, xi);
+    VLOG(2) << "use gradient field";
+  } else {
+    // compute the gradient value in the current value
+    Tensor2<D> inverseJacobian =
+        functionSpace->getInverseJacobian(geometryValues, elementNo, xi);
+    gradient = functionSpace->interpolateGradientInElement(
+        elementalSolutionValues, inverseJacobian, xi);
+
+    VLOG(2) << "use direct gradient";
+  }
+
+  if (fabs(gradient[0] + gradient[1] + gradient[2]) < 1e-15) {
+    std::stringstream message;
+    message << "Gradient at element " << elementNo << ", xi " << xi
+            << " is zero!";
+    warnings.push_back(message.str());
+    if (!useGradientField_) {
+      Tensor2<D> inverseJacobian =
+          functionSpace->getInverseJacobian(geometryValues, elementNo, xi);
+      LOG(DEBUG) << "geometryValues: " << geometryValues
+                 << ", inverseJacobian: " << inverseJacobian
+                 << ", elementalSolutionValues: " << elementalSolutionValues;
+    } else {
+      LOG(DEBUG) << "elementalGradientValues: " << elementalGradientValues;
+    }
+    // LOG(FATAL) << "Abort because of missing gradient.";
+    gradient[2] = 1.0; // fix gradient direction
+  }
+
+  normalizedGradient = MathUtility::normalized<3>(gradient);
+  return true;
+}
+
+template <typename FunctionSpace>
+void StreamlineTracerBase<FunctionSpace>::traceStreamlineExplicitEuler(
+    Vec3 startingPoint, double direction, std::vector<Vec3> &points,
+    std::vector<std::string> &warnings) {
+  Vec3 currentPoint = startingPoint;
+  ElementSearchState searchState;
 
   // loop over length of streamline, avoid loops by limiting the number of
   // iterations
   for (int iterationNo = 0; iterationNo <= maxNIterations_; iterationNo++) {
     if (iterationNo == maxNIterations_) {
-      LOG(WARNING) << "streamline reached maximum number of iterations ("
-                   << maxNIterations_ << ")";
+      warnings.push_back("streamline reached maximum number of iterations (" +
+                         std::to_string(maxNIterations_) + ")");
       points.clear();
       break;
     }
 
-    if (iterationNo == 0) {
-      startSearchInCurrentElement = false;
-    } else {
-      startSearchInCurrentElement = true;
+    // if no position was found, the streamline exits the domain
+    Vec3 normalizedGradient;
+    if (!computeDirection(currentPoint, searchState, normalizedGradient,
+                          warnings)) {
+      LOG(DEBUG) << "streamline ends at iteration " << iterationNo;
+      break;
     }
 
-    VLOG(1) << "startSearchInCurrentElement=" << startSearchInCurrentElement
-            << ", elementNo: " << elementNo << " ghostMeshNo: " << ghostMeshNo;
-    double residual;
-    bool searchedAllElements;
+    // integrate streamline
+    VLOG(1) << "  integrate from " << currentPoint
+            << ", gradient normalized: " << normalizedGradient
+            << ", lineStepWidth: " << lineStepWidth_;
+    currentPoint =
+        currentPoint + normalizedGradient * lineStepWidth_ * direction;
 
-    // look for the element and xi value of the currentPoint, also considers
-    // ghost meshes if they are set
-    bool positionFound = functionSpace_->findPosition(
-        currentPoint, elementNo, ghostMeshNo, xi, startSearchInCurrentElement,
-        residual, searchedAllElements);
+    VLOG(1) << "              to " << currentPoint;
 
-    // if no position was found, the streamline exits the domain
-    if (!positionFound) {
-      LOG(DEBUG) << "streamline ends at iteration " << iterationNo
-                 << " because " << currentPoint << " is outside of domain."
-                 << " startSearchInCurrentElement: "
-                 << startSearchInCurrentElement << ", residual: " << residual
-                 << ", searchedAllElements: " << searchedAllElements;
-      break;
-    }
+    points.push_back(currentPoint);
+  }
+}
+
+template <typename FunctionSpace>
+void StreamlineTracerBase<FunctionSpace>::traceStreamlineRungeKutta45(
+    Vec3 startingPoint, double direction, std::vector<Vec3> &points,
+    std::vector<std::string> &warnings) {
+  // Butcher tableau of the Dormand-Prince method, the last stage is evaluated
+  // at the new 5th order point and is reused as first stage of the next step
+  const int nStages = 7;
+  static const double a[nStages][nStages - 1] = {
+      {0, 0, 0, 0, 0, 0},
+      {1. / 5, 0, 0, 0, 0, 0},
+      {3. / 40, 9. / 40, 0, 0, 0, 0},
+      {44. / 45, -56. / 15, 32. / 9, 0, 0, 0},
+      {19372. / 6561, -25360. / 2187, 64448. / 6561, -212. / 729, 0, 0},
+      {9017. / 3168, -355. / 33, 46732. / 5247, 49. / 176, -5103. / 18656, 0},
+      {35. / 384, 0, 500. / 1113, 125. / 192, -2187. / 6784, 11. / 84}};
 
-    VLOG(1) << " findPosition for " << currentPoint << " returned ghostMeshNo "
-            << ghostMeshNo << ", elementNo " << elementNo << ", xi " << xi
-            << ", residual: " << residual
-            << ", startSearchInCurrentElement: " << startSearchInCurrentElement
-            << ", searchedAllElements: " << searchedAllElements;
+  // difference of the weights of the 5th and the 4th order method
+  static const double e[nStages] = {
+      71. / 57600,     0,           -71. / 16695,  71. / 1920,
+      -17253. / 339200, 22. / 525, -1. / 40};
 
-    // get values for element that are later needed to compute the gradient
+  // steps are not reduced below this width, to not get stuck at the boundary
+  const double minLineStepWidth = 1e-3 * lineStepWidth_;
 
-    // if the streamline passes a normal element
-    if (ghostMeshNo == -1) {
-      VLOG(1) << "use normal mesh";
+  Vec3 currentPoint = startingPoint;
+  ElementSearchState searchState;
+  std::array<Vec3, nStages> k;
 
-      functionSpace = functionSpace_;
+  // the first stage at the starting point, if it is outside of the domain, the
+  // streamline is empty
+  if (!computeDirection(currentPoint, searchState, k[0], warnings)) {
+    LOG(DEBUG) << "streamline ends at iteration 0";
+    return;
+  }
 
-      if (useGradientField_) {
-        gradient_->getElementValues(elementNo, elementalGradientValues);
-      } else {
-        solution_->getElementValues(elementNo, elementalSolutionValues);
+  double stepWidth = lineStepWidth_;
 
-        // get geometry field (which are the node positions for Lagrange basis
-        // and node positions and derivatives for Hermite)
-        functionSpace->getElementGeometry(elementNo, geometryValues);
-      }
-    } else // if the streamline is in an element of a ghost mesh
-    {
-      VLOG(1) << "use ghost mesh";
-
-      // use ghost mesh as current function space
-      functionSpace =
-          functionSpace_->ghostMesh((Mesh::face_or_edge_t)ghostMeshNo);
-
-      if (useGradientField_) {
-        ghostMeshGradient_[ghostMeshNo]->getElementValues(
-            elementNo, elementalGradientValues);
-      } else {
-        ghostMeshSolution_[ghostMeshNo]->getElementValues(
-            elementNo, elementalSolutionValues);
-
-        // get geometry field (which are the node positions for Lagrange basis
-        // and node positions and derivatives for Hermite)
-        functionSpace->getElementGeometry(elementNo, geometryValues);
-      }
+  // loop over length of streamline, avoid loops by limiting the number of
+  // iterations, rejected steps are also counted
+  for (int iterationNo = 0; iterationNo <= maxNIterations_; iterationNo++) {
+    if (iterationNo == maxNIterations_) {
+      warnings.push_back("streamline reached maximum number of iterations (" +
+                         std::to_string(maxNIterations_) + ")");
+      points.clear();
+      break;
     }
 
-    // get value of gradient
-    Vec3 gradient;
-    if (useGradientField_) {
-      gradient = functionSpace->template interpolateValueInElement<3>(
-          elementalGradientValues, xi);
-      VLOG(2) << "use gradient field";
-    } else {
-      // compute the gradient value in the current value
-      Tensor2<D> inverseJacobian =
-          functionSpace->getInverseJacobian(geometryValues, elementNo, xi);
-      gradient = functionSpace->interpolateGradientInElement(
-          elementalSolutionValues, inverseJacobian, xi);
+    // compute the remaining stages, the element search continues from stage
+    // to stage
+    ElementSearchState searchStateAtCurrentPoint = searchState;
+    bool stagesInsideDomain = true;
+    for (int stageNo = 1; stageNo < nStages; stageNo++) {
+      Vec3 stagePoint = currentPoint;
+      for (int j = 0; j < stageNo; j++) {
+        if (a[stageNo][j] != 0)
+          stagePoint += k[j] * (stepWidth * direction * a[stageNo][j]);
+      }
 
-      VLOG(2) << "use direct gradient";
+      if (!computeDirection(stagePoint, searchState, k[stageNo], warnings)) {
+        stagesInsideDomain = false;
+        break;
+      }
     }
 
-    if (fabs(gradient[0] + gradient[1] + gradient[2]) < 1e-15) {
-      LOG(ERROR) << "Gradient at element " << elementNo << ", xi " << xi
-                 << " is zero!";
-      if (!useGradientField_) {
-        Tensor2<D> inverseJacobian =
-            functionSpace->getInverseJacobian(geometryValues, elementNo, xi);
-        LOG(DEBUG) << "geometryValues: " << geometryValues
-                   << ", inverseJacobian: " << inverseJacobian
-                   << ", elementalSolutionValues: " << elementalSolutionValues;
-      } else {
-        LOG(DEBUG) << "elementalGradientValues: " << elementalGradientValues;
+    // if the step leaves the domain, retry with a smaller step, at the
+    // minimum step width, end the streamline with a step of lineStepWidth_
+    // like the explicit Euler scheme, i.e. the last point is outside
+    if (!stagesInsideDomain) {
+      searchState = searchStateAtCurrentPoint;
+      if (stepWidth > minLineStepWidth) {
+        stepWidth = std::max(0.5 * stepWidth, minLineStepWidth);
+        continue;
       }
-      // LOG(FATAL) << "Abort because of missing gradient.";
-      gradient[2] = 1.0; // fix gradient direction
+
+      points.push_back(currentPoint + k[0] * lineStepWidth_ * direction);
+      LOG(DEBUG) << "streamline ends at iteration " << iterationNo;
+      break;
     }
 
-    // integrate streamline
-    VLOG(1) << "  integrate from " << currentPoint << ", gradient: " << gradient
-            << ", gradient normalized: " << MathUtility::normalized<3>(gradient)
-            << ", lineStepWidth: " << lineStepWidth_;
-    currentPoint = currentPoint + MathUtility::normalized<3>(gradient) *
-                                      lineStepWidth_ * direction;
+    // estimate the local error by the difference of the 4th and 5th order
+    Vec3 errorVector{0.0, 0.0, 0.0};
+    for (int stageNo = 0; stageNo < nStages; stageNo++)
+      errorVector += k[stageNo] * e[stageNo];
+    double error = stepWidth * MathUtility::norm<3>(errorVector);
 
-    VLOG(1) << "              to " << currentPoint;
+    // compute the factor for the next step width
+    double factor = 5.0;
+    if (error > 0)
+      factor = std::min(
+          5.0, std::max(0.2, 0.9 * pow(integrationTolerance_ / error, 0.2)));
 
-    points.push_back(currentPoint);
-  }
+    // accept the step, the last stage was evaluated at the new point
+    if (error <= integrationTolerance_ || stepWidth <= minLineStepWidth) {
+      Vec3 newPoint = currentPoint;
+      for (int j = 0; j < nStages - 1; j++)
+        newPoint += k[j] * (stepWidth * direction * a[nStages - 1][j]);
 
-  if (points.empty()) {
-    LOG(DEBUG) << "traced streamline is completely empty, startingPoint: "
-               << startingPoint;
-    points.push_back(startingPoint);
-  } else if (points.size() == 1) {
-    LOG(DEBUG) << "traced streamline has 1 point: " << points[0];
-  } else {
-    LOG(DEBUG) << "traced streamline has " << points.size()
-               << " points, start: " << points[0]
-               << ", end: " << points[points.size() - 1];
+      VLOG(1) << "  integrate from " << currentPoint << " to " << newPoint
+              << ", step width: " << stepWidth << ", error: " << error;
+
+      currentPoint = newPoint;
+      points.push_back(currentPoint);
+      k[0] = k[nStages - 1];
+    }
+
+    stepWidth = std::max(minLineStepWidth,
+                         std::min(maxLineStepWidth_, stepWidth * factor));
   }
 }
 
@@ -276,7 +276,7 @@ void Linear::dumpMatrixRightHandSideSolution(Vec rightHandSide, Vec solution) {
 bool Linear::solve(Vec rightHandSide, Vec solution, std::string message) {
   PetscErrorCode ierr;
 
-  Control::PerformanceMeasurement::start(this->durationLogKey_);
+  Control::PerformanceMeasurement::start(this->durationLogKeyId_);
 
   // reset memory count in MemoryLeakFinder
   // Control::MemoryLeakFinder::nKiloBytesIncreaseSinceLastCheck();
@@ -291,7 +291,7 @@ bool Linear::solve(Vec rightHandSide, Vec solution, std::string message) {
   // Linear::solve, after KSPSolve"); LOG(INFO) << "+" <<
   // Control::MemoryLeakFinder::nKiloBytesIncreaseSinceLastCheck() << "kB";
 
-  Control::PerformanceMeasurement::stop(this->durationLogKey_);
+  Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
 
   // dump files of rhs, solution and system matrix for debugging
   dumpMatrixRightHandSideSolution(rightHandSide, solution);
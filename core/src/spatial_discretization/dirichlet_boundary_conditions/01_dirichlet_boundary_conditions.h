@@ -82,6 +82,12 @@ public:
           FieldVariable::FieldVariable<FunctionSpaceType, nComponents>>
           solution);
 
+  //! create the index set of the local dofs without ghosts that have no
+  //! prescribed value in component componentNo, in global PETSc numbering.
+  //! These are the rows and columns of the condensed system that only
+  //! contains the free dofs. The index set has to be destroyed by the caller.
+  IS createFreeDofsIndexSet(int componentNo = 0);
+
 protected:
   //! fill auxiliary ghost element data structures
   void initializeGhostElements();
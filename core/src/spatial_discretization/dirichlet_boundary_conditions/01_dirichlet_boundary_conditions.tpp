@@ -1318,4 +1318,46 @@ void DirichletBoundaryConditions<FunctionSpaceType, nComponents>::
   }
 }
 
+template <typename FunctionSpaceType, int nComponents>
+IS DirichletBoundaryConditions<FunctionSpaceType, nComponents>::
+    createFreeDofsIndexSet(int componentNo) {
+  assert(componentNo >= 0 && componentNo < nComponents);
+  MPI_Comm mpiCommunicator =
+      this->functionSpace_->meshPartition()->mpiCommunicator();
+
+  // the prescribed dofs of the component are sorted by local dof no
+  const std::vector<dof_no_t> &prescribedDofNosLocal =
+      this->boundaryConditionsByComponent_[componentNo].dofNosLocal;
+  std::vector<dof_no_t>::const_iterator prescribedDofIter =
+      prescribedDofNosLocal.begin();
+
+  const dof_no_t nDofsLocal = this->functionSpace_->nDofsLocalWithoutGhosts();
+  std::vector<PetscInt> freeDofNosGlobalPetsc;
+  freeDofNosGlobalPetsc.reserve(nDofsLocal);
+
+  for (dof_no_t dofNoLocal = 0; dofNoLocal < nDofsLocal; dofNoLocal++) {
+    while (prescribedDofIter != prescribedDofNosLocal.end() &&
+           *prescribedDofIter < dofNoLocal)
+      prescribedDofIter++;
+
+    if (prescribedDofIter != prescribedDofNosLocal.end() &&
+        *prescribedDofIter == dofNoLocal)
+      continue;
+
+    freeDofNosGlobalPetsc.push_back(
+        this->functionSpace_->meshPartition()->getDofNoGlobalPetsc(
+            dofNoLocal));
+  }
+
+  IS indexSet;
+  PetscErrorCode ierr;
+  ierr = ISCreateGeneral(mpiCommunicator, freeDofNosGlobalPetsc.size(),
+                         freeDofNosGlobalPetsc.data(), PETSC_COPY_VALUES,
+                         &indexSet);
+  CHKERRABORT(mpiCommunicator, ierr);
+
+  VLOG(1) << "free dofs (global PETSc): " << freeDofNosGlobalPetsc;
+  return indexSet;
+}
+
 } // namespace SpatialDiscretization
@@ -25,6 +25,9 @@ public:
       FunctionSpaceType, QuadratureType, nComponents,
       Term>::FiniteElementMethodMatrixInverseLumpedMass;
 
+  //! destructor, destroys the index set and matrix of the condensed system
+  virtual ~BoundaryConditions();
+
   //! enable or disable boundary condition handling on initialization, set to
   //! false to not care for boundary conditions
   virtual void
@@ -61,6 +64,27 @@ protected:
   //! apply the neumann type boundary conditions
   void applyNeumannBoundaryConditions();
 
+  //! solve the linear system, with "dirichletBoundaryConditionsMode":
+  //! "condensed", only the free dofs are contained in the system
+  virtual void solve();
+
+  //! parse "dirichletBoundaryConditionsMode" from the settings, if this was
+  //! not yet done
+  void parseDirichletBoundaryConditionsMode();
+
+  //! if the linear system only contains the free dofs, i.e. the system matrix
+  //! does not need zeroed rows and columns of the Dirichlet dofs
+  bool isCondensedMode();
+
+  //! solve the system that only contains the rows and columns of the dofs
+  //! without Dirichlet boundary conditions, the prescribed values are already
+  //! lifted into the rhs by applyDirichletBoundaryConditions
+  void solveCondensedSystem();
+
+  //! destroy the index set and matrix of the condensed system, they are
+  //! created again at the next solve
+  void resetCondensedSystem();
+
   bool boundaryConditionHandlingEnabled_ =
       true; //< if the boundary conditions should be handled in this class, if
             // false, nothing is done here. This is the case if the
@@ -86,6 +110,16 @@ protected:
   bool dirichletBoundaryConditionsApplied_ =
       false; //< if the dirichlet BC were already applied after the last
              // initialize() or setDirichletBoundaryConditions()
+  std::string dirichletBoundaryConditionsMode_; //< "zeroRowsColumns" or
+                                                // "condensed", parsed when
+                                                // the Dirichlet BC are applied
+                                                // or at the first solve
+  bool condensedSystemCreated_ =
+      false; //< if freeDofs_ and condensedStiffnessMatrix_ are created
+  IS freeDofs_; //< the dofs without Dirichlet BC in global PETSc numbering,
+                // the rows and columns of the condensed system
+  Mat condensedStiffnessMatrix_; //< the stiffness matrix without Dirichlet BC
+                                 // restricted to the free dofs
 };
 
 /**
@@ -4,12 +4,29 @@
 #include <memory>
 #include <vector>
 #include <petscsys.h>
+#include <petscksp.h>
 
 #include "quadrature/tensor_product.h"
 #include "utility/vector_operators.h"
+#include "solver/solver_manager.h"
+#include "solver/linear.h"
 
 namespace SpatialDiscretization {
 
+template <typename FunctionSpaceType, typename QuadratureType, int nComponents,
+          typename Term, typename Dummy>
+BoundaryConditions<FunctionSpaceType, QuadratureType, nComponents, Term,
+                   Dummy>::~BoundaryConditions() {
+  // the problem can be destroyed after PETSc was finalized, then nothing can
+  // be done here
+  PetscBool isFinalized;
+  PetscFinalized(&isFinalized);
+  if (isFinalized)
+    return;
+
+  this->resetCondensedSystem();
+}
+
 template <typename FunctionSpaceType, typename QuadratureType, int nComponents,
           typename Term, typename Dummy>
 void BoundaryConditions<FunctionSpaceType, QuadratureType, nComponents, Term,
@@ -28,6 +45,7 @@ void BoundaryConditions<FunctionSpaceType, QuadratureType, nComponents, Term,
             dirichletBoundaryConditions) {
   this->dirichletBoundaryConditions_ = dirichletBoundaryConditions;
   this->dirichletBoundaryConditionsApplied_ = false;
+  this->resetCondensedSystem();
 }
 
 template <typename FunctionSpaceType, typename QuadratureType, int nComponents,
@@ -51,6 +69,7 @@ void BoundaryConditions<FunctionSpaceType, QuadratureType, nComponents, Term,
   this->dirichletBoundaryConditions_ = nullptr;
   this->systemMatrixAlreadySet_ = false;
   this->dirichletBoundaryConditionsApplied_ = false;
+  this->resetCondensedSystem();
 }
 
 template <typename FunctionSpaceType, typename QuadratureType, int nComponents,
@@ -197,12 +216,17 @@ void BoundaryConditions<FunctionSpaceType, QuadratureType, nComponents, Term,
     // (set bc rows and columns of stiffnessMatrix to 0 and diagonal to 1), also
     // add terms with matrix entries to rhs, for the reading of matrix entries,
     // stiffnessMatrixWithoutBc is used.
+    // In condensed mode, the system only contains the free dofs and is
+    // extracted from stiffnessMatrixWithoutBc, then only the prescribed values
+    // are lifted into the rhs and stiffnessMatrix is not changed.
+    parseDirichletBoundaryConditionsMode();
     LOG(DEBUG) << "call applyInSystemMatrix from applyBoundaryConditions, "
                   "this->systemMatrixAlreadySet: "
-               << this->systemMatrixAlreadySet_;
+               << this->systemMatrixAlreadySet_
+               << ", condensed: " << isCondensedMode();
     dirichletBoundaryConditions_->applyInSystemMatrix(
         stiffnessMatrixWithoutBc, stiffnessMatrix, rightHandSide,
-        this->systemMatrixAlreadySet_);
+        this->systemMatrixAlreadySet_ || isCondensedMode());
     this->systemMatrixAlreadySet_ = true;
     dirichletBoundaryConditionsApplied_ = true;
 
@@ -212,4 +236,145 @@ void BoundaryConditions<FunctionSpaceType, QuadratureType, nComponents, Term,
   }
 }
 
+template <typename FunctionSpaceType, typename QuadratureType, int nComponents,
+          typename Term, typename Dummy>
+void BoundaryConditions<FunctionSpaceType, QuadratureType, nComponents, Term,
+                        Dummy>::solve() {
+  parseDirichletBoundaryConditionsMode();
+
+  // the condensed system is only needed if there are Dirichlet BC handled here
+  if (!isCondensedMode() || !boundaryConditionHandlingEnabled_ ||
+      dirichletBoundaryConditions_ == nullptr) {
+    FiniteElementMethodBase<FunctionSpaceType, QuadratureType, nComponents,
+                            Term>::solve();
+    return;
+  }
+
+  solveCondensedSystem();
+}
+
+template <typename FunctionSpaceType, typename QuadratureType, int nComponents,
+          typename Term, typename Dummy>
+void BoundaryConditions<FunctionSpaceType, QuadratureType, nComponents, Term,
+                        Dummy>::parseDirichletBoundaryConditionsMode() {
+  if (!dirichletBoundaryConditionsMode_.empty())
+    return;
+
+  dirichletBoundaryConditionsMode_ = this->specificSettings_.getOptionString(
+      "dirichletBoundaryConditionsMode", "zeroRowsColumns");
+
+  if (dirichletBoundaryConditionsMode_ != "zeroRowsColumns" &&
+      dirichletBoundaryConditionsMode_ != "condensed") {
+    LOG(WARNING) << this->specificSettings_
+                 << "[\"dirichletBoundaryConditionsMode\"] is \""
+                 << dirichletBoundaryConditionsMode_
+                 << "\", but has to be one of \"zeroRowsColumns\" or "
+                 << "\"condensed\". Using \"zeroRowsColumns\".";
+    dirichletBoundaryConditionsMode_ = "zeroRowsColumns";
+  } else if (dirichletBoundaryConditionsMode_ == "condensed" &&
+             nComponents != 1) {
+    LOG(WARNING) << this->specificSettings_
+                 << "[\"dirichletBoundaryConditionsMode\"] \"condensed\" "
+                 << "is only implemented for scalar problems, the problem "
+                 << "has " << nComponents << " components. "
+                 << "Using \"zeroRowsColumns\".";
+    dirichletBoundaryConditionsMode_ = "zeroRowsColumns";
+  }
+}
+
+template <typename FunctionSpaceType, typename QuadratureType, int nComponents,
+          typename Term, typename Dummy>
+bool BoundaryConditions<FunctionSpaceType, QuadratureType, nComponents, Term,
+                        Dummy>::isCondensedMode() {
+  return dirichletBoundaryConditionsMode_ == "condensed" &&
+         !std::is_same<Term, Equation::None>::value;
+}
+
+template <typename FunctionSpaceType, typename QuadratureType, int nComponents,
+          typename Term, typename Dummy>
+void BoundaryConditions<FunctionSpaceType, QuadratureType, nComponents, Term,
+                        Dummy>::solveCondensedSystem() {
+  LOG(TRACE) << "FiniteElementMethod::solveCondensedSystem";
+
+  PetscErrorCode ierr;
+  std::shared_ptr<PartitionedPetscMat<FunctionSpaceType>>
+      stiffnessMatrixWithoutBc = this->data_.stiffnessMatrixWithoutBc();
+
+  // extract the rows and columns of the free dofs, the Dirichlet dofs do not
+  // change, therefore this is only done once
+  if (!condensedSystemCreated_) {
+    stiffnessMatrixWithoutBc->assembly(MAT_FINAL_ASSEMBLY);
+
+    freeDofs_ = dirichletBoundaryConditions_->createFreeDofsIndexSet();
+    ierr = MatCreateSubMatrix(stiffnessMatrixWithoutBc->valuesGlobal(),
+                              freeDofs_, freeDofs_, MAT_INITIAL_MATRIX,
+                              &condensedStiffnessMatrix_);
+    CHKERRV(ierr);
+    condensedSystemCreated_ = true;
+
+    PetscInt nFreeDofsGlobal = 0;
+    ierr = ISGetSize(freeDofs_, &nFreeDofsGlobal);
+    CHKERRV(ierr);
+    LOG(DEBUG) << "condensed system contains " << nFreeDofsGlobal << " of "
+               << this->data_.functionSpace()->nDofsGlobal() << " dofs";
+  }
+
+  // get linear solver context from solver manager
+  std::shared_ptr<Solver::Linear> linearSolver =
+      this->context_.solverManager()->template solver<Solver::Linear>(
+          this->specificSettings_,
+          this->data_.functionSpace()->meshPartition()->mpiCommunicator());
+  std::shared_ptr<KSP> ksp = linearSolver->ksp();
+  assert(ksp != nullptr);
+
+  ierr = KSPSetOperators(*ksp, condensedStiffnessMatrix_,
+                         condensedStiffnessMatrix_);
+  CHKERRV(ierr);
+
+  // The rhs contains the prescribed values at the Dirichlet dofs and the
+  // values f - K*u_prescribed at the free dofs. Copy the prescribed values to
+  // the solution and solve for the free dofs in place.
+  Vec rightHandSide = this->data_.rightHandSide()->valuesGlobal();
+  Vec solution = this->data_.solution()->valuesGlobal();
+  ierr = VecCopy(rightHandSide, solution);
+  CHKERRV(ierr);
+
+  Vec rightHandSideFree;
+  Vec solutionFree;
+  ierr = VecGetSubVector(rightHandSide, freeDofs_, &rightHandSideFree);
+  CHKERRV(ierr);
+  ierr = VecGetSubVector(solution, freeDofs_, &solutionFree);
+  CHKERRV(ierr);
+
+  LOG(DEBUG) << "solve condensed system...";
+  linearSolver->solve(rightHandSideFree, solutionFree, "Solution obtained");
+
+  ierr = VecRestoreSubVector(solution, freeDofs_, &solutionFree);
+  CHKERRV(ierr);
+  ierr = VecRestoreSubVector(rightHandSide, freeDofs_, &rightHandSideFree);
+  CHKERRV(ierr);
+
+  this->data_.solution()->setRepresentationGlobal();
+  this->data_.solution()->startGhostManipulation();
+  this->data_.solution()->zeroGhostBuffer();
+  this->data_.solution()->finishGhostManipulation();
+
+  VLOG(1) << "solution: " << *this->data_.solution();
+}
+
+template <typename FunctionSpaceType, typename QuadratureType, int nComponents,
+          typename Term, typename Dummy>
+void BoundaryConditions<FunctionSpaceType, QuadratureType, nComponents, Term,
+                        Dummy>::resetCondensedSystem() {
+  if (!condensedSystemCreated_)
+    return;
+
+  PetscErrorCode ierr;
+  ierr = MatDestroy(&condensedStiffnessMatrix_);
+  CHKERRV(ierr);
+  ierr = ISDestroy(&freeDofs_);
+  CHKERRV(ierr);
+  condensedSystemCreated_ = false;
+}
+
 } // namespace SpatialDiscretization
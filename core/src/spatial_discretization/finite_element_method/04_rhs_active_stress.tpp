@@ -56,6 +56,10 @@ void FiniteElementMethodRhs<
       samplingPoints = QuadratureDD::samplingPoints();
   EvaluationsArrayType evaluationsArray{};
 
+  // read the active stress values directly from the local arrays
+  FieldVariable::ValuesView<FunctionSpaceType, nComponents * nComponents>
+      activeStressView = activeStress->valuesView();
+
   // set entries in rhs vector
   // loop over local elements
   for (element_no_t elementNoLocal = 0;
@@ -71,7 +75,7 @@ void FiniteElementMethodRhs<
 
     std::array<VecD<nComponents * nComponents>, nDofsPerElement>
         activeStressValues;
-    activeStress->getElementValues(elementNoLocal, activeStressValues);
+    activeStressView.getElementValues(elementNoLocal, activeStressValues);
 
     // compute integral
     for (unsigned int samplingPointIndex = 0;
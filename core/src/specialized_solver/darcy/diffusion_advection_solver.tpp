@@ -38,7 +38,7 @@ void DiffusionAdvectionSolver<FiniteElementMethod>::advanceTimeSpan(
   // start duration measurement, the name of the output variable can be set by
   // "durationLogKey" in the config
   if (this->durationLogKey_ != "")
-    Control::PerformanceMeasurement::start(this->durationLogKey_);
+    Control::PerformanceMeasurement::start(this->durationLogKeyId_);
 
   // compute time span of this method
   double timeSpan = this->endTime_ - this->startTime_;
@@ -127,7 +127,7 @@ void DiffusionAdvectionSolver<FiniteElementMethod>::advanceTimeSpan(
 
     // stop duration measurement
     if (this->durationLogKey_ != "")
-      Control::PerformanceMeasurement::stop(this->durationLogKey_);
+      Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
 
     // if the output writers are enabled, write current output values using the
     // output writers
@@ -137,12 +137,12 @@ void DiffusionAdvectionSolver<FiniteElementMethod>::advanceTimeSpan(
 
     // start duration measurement
     if (this->durationLogKey_ != "")
-      Control::PerformanceMeasurement::start(this->durationLogKey_);
+      Control::PerformanceMeasurement::start(this->durationLogKeyId_);
   }
 
   // stop duration measurement
   if (this->durationLogKey_ != "")
-    Control::PerformanceMeasurement::stop(this->durationLogKey_);
+    Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
 }
 
 template <typename FiniteElementMethod>
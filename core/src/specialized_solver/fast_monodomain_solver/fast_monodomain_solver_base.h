@@ -5,6 +5,7 @@
 #include <vc_or_std_simd.h> // this includes <Vc/Vc> or a Vc-emulating wrapper of <experimental/simd> if available
 
 #include "control/multiple_instances.h"
+#include "control/stimulation/stimulation_schedule.h"
 #include "operator_splitting/strang.h"
 #include "time_stepping_scheme/heun.h"
 #include "cellml/03_cellml_adapter.h"
@@ -163,6 +164,8 @@ public:
                      // which is the current value to use
     bool currentlyStimulating; //< if a stimulation is in progress at the
                                // current time
+    std::size_t stimulationEventIndex; //< index of the next event of the
+                                       // motor unit in stimulationSchedule_
   };
 
 protected:
@@ -268,6 +271,12 @@ protected:
   std::string
       firingTimesFilename_; //< filename of the firingTimesFile, which contains
                             // points in time of stimulation for each motor unit
+  std::string
+      stimulationScheduleFilename_; //< filename of the stimulation schedule,
+                                    // if set, it is used instead of the firing
+                                    // times file
+  Control::StimulationSchedule
+      stimulationSchedule_; //< the stimulation events of all motor units
 
   std::vector<std::vector<bool>>
       firingEvents_; //< if a motor unit fires,
@@ -277,6 +286,8 @@ protected:
                                  // motorUnitNo_[fiberNo]
   std::string durationLogKey0D_; //< duration log key for the 0D problem
   std::string durationLogKey1D_; //< duration log key for the 1D problem
+  int durationLogKey0DId_; //< handle of the measurement durationLogKey0D_
+  int durationLogKey1DId_; //< handle of the measurement durationLogKey1D_
 
   OutputWriter::Manager
       outputWriterManager_; //< manager object holding all output writers
@@ -22,13 +22,14 @@ void FastMonodomainSolverBase<nStates, nAlgebraics,
   // ranks that participate in computing
   fetchFiberData();
 
-  // Control::PerformanceMeasurement::startFlops();
+  // measure flops if hardware counters are enabled
+  Control::PerformanceMeasurement::startFlops();
 
   // do computation of own fibers, stimulation from parsed MU and firing_times
   // files
   computeMonodomain();
 
-  // Control::PerformanceMeasurement::endFlops();
+  Control::PerformanceMeasurement::endFlops();
 
   // loop over fibers and communicate resulting values back
   updateFiberData();
@@ -81,6 +82,11 @@ void FastMonodomainSolverBase<
   LOG(DEBUG) << "durationLogKeys: " << durationLogKey0D_ << ","
              << durationLogKey1D_;
 
+  durationLogKey0DId_ =
+      Control::PerformanceMeasurement::registerMeasurement(durationLogKey0D_);
+  durationLogKey1DId_ =
+      Control::PerformanceMeasurement::registerMeasurement(durationLogKey1D_);
+
   double startTime = instances[0].startTime();
   double timeStepWidthSplitting = instances[0].timeStepWidth();
   nTimeStepsSplitting_ = instances[0].numberTimeSteps();
@@ -152,7 +158,7 @@ void FastMonodomainSolverBase<
                                             double timeStepWidth,
                                             int nTimeSteps,
                                             bool storeAlgebraicsForTransfer) {
-  Control::PerformanceMeasurement::start(durationLogKey0D_);
+  Control::PerformanceMeasurement::start(durationLogKey0DId_);
   LOG(DEBUG) << "compute0D(" << startTime << "), " << nTimeSteps << " time step"
              << (nTimeSteps == 1 ? "" : "s");
 
@@ -291,7 +297,7 @@ void FastMonodomainSolverBase<
 #endif
 
   VLOG(1) << "nFiberPointBuffers: " << nPointBuffers;
-  Control::PerformanceMeasurement::stop(durationLogKey0D_);
+  Control::PerformanceMeasurement::stop(durationLogKey0DId_);
 }
 
 template <int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
@@ -308,7 +314,7 @@ void FastMonodomainSolverBase<
     return;
   }
 
-  Control::PerformanceMeasurement::start(durationLogKey1D_);
+  Control::PerformanceMeasurement::start(durationLogKey1DId_);
 
   LOG(DEBUG) << "compute1D(" << startTime << ")";
 
@@ -548,7 +554,7 @@ void FastMonodomainSolverBase<
     VLOG(1) << " -> " << s.str();
 #endif
   }
-  Control::PerformanceMeasurement::stop(durationLogKey1D_);
+  Control::PerformanceMeasurement::stop(durationLogKey1DId_);
 }
 
 template <int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
@@ -594,7 +600,11 @@ bool FastMonodomainSolverBase<nStates, nAlgebraics,
             << setSpecificStatesCallEnableBegin;
   }
 
-  if (currentTime >=
+  // if a stimulation schedule is used, the firing times are not checked
+  const bool useStimulationSchedule = !stimulationScheduleFilename_.empty();
+
+  if (!useStimulationSchedule &&
+      currentTime >=
           lastStimulationCheckTime +
               1. / (setSpecificStatesCallFrequency + currentJitter) &&
       currentTime >= setSpecificStatesCallEnableBegin - 1e-13) {
@@ -661,6 +671,12 @@ bool FastMonodomainSolverBase<nStates, nAlgebraics,
                     firingEvents_[firingEventsIndex % firingEvents_.size()]
                         .size()];
 
+  // or look up the precomputed events of the motor unit
+  if (useStimulationSchedule) {
+    stimulate = stimulationSchedule_.isStimulated(
+        motorUnitNo, currentTime, fiberDataCurrentPoint.stimulationEventIndex);
+  }
+
   if (checkStimulation && VLOG_IS_ON(1)) {
     VLOG(1)
         << "setSpecificStatesCallFrequency: " << setSpecificStatesCallFrequency
@@ -689,13 +705,15 @@ bool FastMonodomainSolverBase<nStates, nAlgebraics,
 #ifndef NDEBUG
     LOG(DEBUG) << "stimulate fiber " << fiberDataCurrentPoint.fiberNoGlobal
                << ", MU " << motorUnitNo << " at t=" << currentTime;
-    LOG(DEBUG)
-        << "  motorUnitNo: " << motorUnitNo << " ("
-        << motorUnitNo %
-               firingEvents_[firingEventsIndex % firingEvents_.size()].size()
-        << ")";
-    LOG(DEBUG) << "  firing events index: " << firingEventsIndex << " ("
-               << firingEventsIndex % firingEvents_.size() << ")";
+    if (!useStimulationSchedule) {
+      LOG(DEBUG)
+          << "  motorUnitNo: " << motorUnitNo << " ("
+          << motorUnitNo %
+                 firingEvents_[firingEventsIndex % firingEvents_.size()].size()
+          << ")";
+      LOG(DEBUG) << "  firing events index: " << firingEventsIndex << " ("
+                 << firingEventsIndex % firingEvents_.size() << ")";
+    }
     LOG(DEBUG) << "  setSpecificStatesCallEnableBegin: "
                << setSpecificStatesCallEnableBegin
                << ", lastStimulationCheckTime: " << lastStimulationCheckTime
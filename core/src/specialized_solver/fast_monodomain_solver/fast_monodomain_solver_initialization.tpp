@@ -2,6 +2,7 @@
 
 #include <vc_or_std_simd.h> // this includes <Vc/Vc> or a Vc-emulating wrapper of <experimental/simd> if available
 #include "partition/rank_subset.h"
+#include "utility/cpu_utility.h"
 #include "control/diagnostic_tool/stimulation_logging.h"
 #include <random>
 
@@ -77,6 +78,8 @@ void FastMonodomainSolverBase<nStates, nAlgebraics,
       specificSettings_.getOptionString("fiberDistributionFile", "");
   firingTimesFilename_ =
       specificSettings_.getOptionString("firingTimesFile", "");
+  stimulationScheduleFilename_ =
+      specificSettings_.getOptionString("stimulationScheduleFile", "");
   onlyComputeIfHasBeenStimulated_ =
       specificSettings_.getOptionBool("onlyComputeIfHasBeenStimulated", true);
   disableComputationWhenStatesAreCloseToEquilibrium_ =
@@ -124,6 +127,35 @@ void FastMonodomainSolverBase<nStates, nAlgebraics,
   std::shared_ptr<Partition::RankSubset> rankSubset =
       nestedSolvers_.data().functionSpace()->meshPartition()->rankSubset();
 
+  // the stimulation schedule is only evaluated in the vc code
+  if (!useVc_ && !stimulationScheduleFilename_.empty()) {
+    LOG(WARNING) << specificSettings_
+                 << "[\"stimulationScheduleFile\"] is only supported with "
+                 << "optimizationType \"vc\", now using the firing times file.";
+    stimulationScheduleFilename_ = "";
+  }
+
+  // load the stimulation events, the default duration of a stimulation is the
+  // same as for the firing times file
+  if (!stimulationScheduleFilename_.empty()) {
+    double defaultDuration = specificSettings_.getOptionDouble(
+        "stimulationScheduleDuration",
+        cellmlAdapter.setSpecificStatesRepeatAfterFirstCall_,
+        PythonUtility::NonNegative);
+    std::vector<double> jitter;
+    if (specificSettings_.hasKey("stimulationScheduleJitter"))
+      specificSettings_.getOptionVector("stimulationScheduleJitter", jitter);
+
+    stimulationSchedule_.load(stimulationScheduleFilename_,
+                              rankSubset->mpiCommunicator(), defaultDuration,
+                              jitter);
+
+    if (stimulationSchedule_.empty()) {
+      LOG(WARNING) << "Stimulation schedule \"" << stimulationScheduleFilename_
+                   << "\" contains no events, no fiber will be stimulated.";
+    }
+  }
+
   LOG(DEBUG) << "config: " << specificSettings_;
   LOG(DEBUG) << "fiberDistributionFilename: " << fiberDistributionFilename_;
   LOG(DEBUG) << "firingTimesFilename: " << firingTimesFilename_;
@@ -172,12 +204,16 @@ void FastMonodomainSolverBase<
   std::shared_ptr<Partition::RankSubset> rankSubset =
       nestedSolvers_.data().functionSpace()->meshPartition()->rankSubset();
 
-  // parse firingTimesFilename_
-  std::string firingTimesFileContents =
-      MPIUtility::loadFile(firingTimesFilename_, rankSubset->mpiCommunicator());
   gpuFiringEventsNColumns_ = 0;
   gpuFiringEventsNRows_ = 0;
 
+  // parse firingTimesFilename_, not needed if a stimulation schedule is used
+  std::string firingTimesFileContents;
+  if (stimulationScheduleFilename_.empty()) {
+    firingTimesFileContents = MPIUtility::loadFile(
+        firingTimesFilename_, rankSubset->mpiCommunicator());
+  }
+
   // parse file contents of firing times file, loop over rows
   while (!firingTimesFileContents.empty()) {
     // determine end of file
@@ -251,7 +287,7 @@ void FastMonodomainSolverBase<
   if (motorUnitNo_.empty())
     LOG(FATAL) << "Could not parse motor units.";
 
-  if (firingEvents_.empty())
+  if (firingEvents_.empty() && stimulationScheduleFilename_.empty())
     LOG(FATAL) << "Could not parse firing times.";
 }
 
@@ -402,6 +438,7 @@ void FastMonodomainSolverBase<
 
         fiberData_.at(fiberDataNo).valuesOffset = 0;
         fiberData_.at(fiberDataNo).currentlyStimulating = false;
+        fiberData_.at(fiberDataNo).stimulationEventIndex = 0;
         if (fiberDataNo > 0) {
           fiberData_.at(fiberDataNo).valuesOffset =
               fiberData_.at(fiberDataNo - 1).valuesOffset +
@@ -807,11 +844,20 @@ void FastMonodomainSolverBase<
 
       std::stringstream compileCommand;
 
+      // the library exchanges Vc::double_v values with opendihu, therefore it
+      // has to use the same instruction sets as opendihu and not the ones of
+      // the CPU, which may be wider
+      std::string instructionSetFlags =
+          CpuUtility::compiledInstructionSetFlags();
+      if (instructionSetFlags.empty())
+        instructionSetFlags = "-march=native";
+
       // load compiler flags
       std::string compilerFlags = specificSettingsCellML.getOptionString(
           "compilerFlags",
-          "-O3 -march=native -fPIC -finstrument-functions -ftree-vectorize "
-          "-fopt-info-vec-optimized=vectorizer_optimized.log -shared ");
+          std::string("-O3 ") + instructionSetFlags +
+              " -mtune=native -fPIC -finstrument-functions -ftree-vectorize "
+              "-fopt-info-vec-optimized=vectorizer_optimized.log -shared ");
 
 #ifdef NDEBUG
       if (compilerFlags.find("-O3") == std::string::npos) {
@@ -106,6 +106,18 @@ protected:
   //! information to preconditioner
   virtual void initializeLinearSolver();
 
+  //! set the reuse flags of the preconditioner, if fullSetup is false, the
+  //! next setup reuses the AMG hierarchy (GAMG) or the whole preconditioner
+  void setPreconditionerReuse(bool fullSetup);
+
+  //! after a solve, trigger a full setup of the preconditioner if the number of
+  //! iterations increased too much, only if "reusePreconditioner" is set
+  void checkPreconditionerReuse();
+
+  //! set the fieldsplit preconditioner that operates directly on the nested
+  //! system matrix, with a Schur complement for phi_e and AMG for the blocks
+  void setFieldSplitToPreconditioner(PC pc);
+
   Data dataMultidomain_; //< the data object of the multidomain solver which
                          // stores all field variables and matrices
 
@@ -146,6 +158,8 @@ protected:
                             // placed inside the data object
   Vec nestedSolution_;      //< nested Petsc Vec, solution vector
   Vec nestedRightHandSide_; //< nested Petsc Vec, rhs
+  Mat nestedPreconditionerMatrix_; //< nested Petsc Mat of the preconditioner
+                                   // matrix, if the symmetric one is used
   Mat singleSystemMatrix_;  //< non-nested Petsc Mat that contains all entries,
                             // the system matrix
   Mat singlePreconditionerMatrix_; //< non-nested Petsc Mat that contains the
@@ -179,6 +193,11 @@ protected:
                                        // setup the system matrix
   bool useSymmetricPreconditionerMatrix_; //< if the symmetric preconditioner
                                           // matrix should be set up
+  bool useFieldSplitPreconditioner_; //< if the fieldsplit preconditioner is
+                                     // used on nestedSystemMatrix_ instead of
+                                     // converting it to singleSystemMatrix_
+  std::string fieldSplitSubPreconditionerType_; //< the AMG preconditioner of
+                                                // the fieldsplit blocks
   bool updateSystemMatrixEveryTimestep_;  //< if the system matrix will be
                                           // rebuild every first time step, this
                                           // is needed if the geometry changes
@@ -189,6 +208,15 @@ protected:
                                      // deleted and recreated, to remedy memory
                                      // leaks of the PETSc implementation of
                                      // some solvers
+  bool reusePreconditioner_; //< if the preconditioner setup is reused when the
+                             // system matrix gets updated
+  double reusePreconditionerIterationsFactor_; //< a full setup is done when the
+                                               // number of iterations exceeds
+                                               // this factor times the
+                                               // reference
+  int nIterationsAfterPreconditionerSetup_; //< number of iterations of the
+                                            // first solve after the last full
+                                            // setup, -1 if not yet solved
   bool rescaleRelativeFactors_; //< if all relative factors should be rescaled
                                 // such that max Σf_r = 1
   bool setDirichletBoundaryConditionPhiB_; //< if the last dof of the fat layer
@@ -50,6 +50,11 @@ MultidomainSolver<FiniteElementMethodPotentialFlow,
   }
   recreateLinearSolverInterval_ = this->specificSettings_.getOptionInt(
       "recreateLinearSolverInterval", 0, PythonUtility::NonNegative);
+  reusePreconditioner_ =
+      this->specificSettings_.getOptionBool("reusePreconditioner", false);
+  reusePreconditionerIterationsFactor_ =
+      this->specificSettings_.getOptionDouble(
+          "reusePreconditionerIterationsFactor", 2.0, PythonUtility::Positive);
 
   // parse option about dirichlet boundary conditions
   if (this->specificSettings_.hasKey("setDirichletBoundaryCondition")) {
@@ -78,6 +83,18 @@ MultidomainSolver<FiniteElementMethodPotentialFlow,
   useSymmetricPreconditionerMatrix_ = this->specificSettings_.getOptionBool(
       "useSymmetricPreconditionerMatrix", true);
 
+  // parse options for the fieldsplit preconditioner on the nested matrix
+  useFieldSplitPreconditioner_ = this->specificSettings_.getOptionBool(
+      "useFieldSplitPreconditioner", false);
+#if defined(PETSC_HAVE_HYPRE)
+  std::string defaultFieldSplitSubPreconditionerType = "boomeramg";
+#else
+  std::string defaultFieldSplitSubPreconditionerType = "gamg";
+#endif
+  fieldSplitSubPreconditionerType_ = this->specificSettings_.getOptionString(
+      "fieldSplitSubPreconditionerType",
+      defaultFieldSplitSubPreconditionerType);
+
   // create finiteElement objects for diffusion in compartments
   finiteElementMethodDiffusionCompartment_.reserve(nCompartments_);
   for (int k = 0; k < nCompartments_; k++) {
@@ -85,11 +102,14 @@ MultidomainSolver<FiniteElementMethodPotentialFlow,
         this->context_["Activation"]);
   }
 
+  nestedSystemMatrix_ = PETSC_NULL;
   singleSystemMatrix_ = PETSC_NULL;
   singleSolution_ = PETSC_NULL;
   singleRightHandSide_ = PETSC_NULL;
   singlePreconditionerMatrix_ = PETSC_NULL;
+  nestedPreconditionerMatrix_ = PETSC_NULL;
   lastNumberOfIterations_ = 0;
+  nIterationsAfterPreconditionerSetup_ = -1;
 }
 
 template <typename FiniteElementMethodPotentialFlow,
@@ -102,7 +122,7 @@ void MultidomainSolver<FiniteElementMethodPotentialFlow,
   // start duration measurement, the name of the output variable can be set by
   // "durationLogKey" in the config
   if (this->durationLogKey_ != "")
-    Control::PerformanceMeasurement::start(this->durationLogKey_);
+    Control::PerformanceMeasurement::start(this->durationLogKeyId_);
 
   // compute timestep width
   double timeSpan = this->endTime_ - this->startTime_;
@@ -183,6 +203,12 @@ void MultidomainSolver<FiniteElementMethodPotentialFlow,
       this->timeStepWidthOfSystemMatrix_ = this->timeStepWidth_;
       setSystemMatrixSubmatrices(this->timeStepWidthOfSystemMatrix_);
       createSystemMatrixFromSubmatrices();
+
+      // the matrix changes considerably, do a full setup of the preconditioner
+      if (reusePreconditioner_) {
+        nIterationsAfterPreconditionerSetup_ = -1;
+        setPreconditionerReuse(true);
+      }
     } else if (this->updateSystemMatrixEveryTimestep_ && timeStepNo == 0) {
       // update the system matrix every updateSystemMatrixInterval_ calls to
       // advance
@@ -217,7 +243,7 @@ void MultidomainSolver<FiniteElementMethodPotentialFlow,
 
     // stop duration measurement
     if (this->durationLogKey_ != "")
-      Control::PerformanceMeasurement::stop(this->durationLogKey_);
+      Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
 
     // write current output values
     if (withOutputWritersEnabled)
@@ -225,7 +251,7 @@ void MultidomainSolver<FiniteElementMethodPotentialFlow,
 
     // start duration measurement
     if (this->durationLogKey_ != "")
-      Control::PerformanceMeasurement::start(this->durationLogKey_);
+      Control::PerformanceMeasurement::start(this->durationLogKeyId_);
   }
 
   // update total active stress
@@ -233,7 +259,7 @@ void MultidomainSolver<FiniteElementMethodPotentialFlow,
 
   // stop duration measurement
   if (this->durationLogKey_ != "")
-    Control::PerformanceMeasurement::stop(this->durationLogKey_);
+    Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
 }
 
 template <typename FiniteElementMethodPotentialFlow,
@@ -399,9 +425,23 @@ void MultidomainSolver<
   this->timeStepWidthOfSystemMatrix_ = this->timeStepWidth_;
   setSystemMatrixSubmatrices(this->timeStepWidthOfSystemMatrix_);
 
+  // measure duration and memory of the setup, to be able to compare the
+  // fieldsplit preconditioner on the nested matrix with the converted matrix
+  long long int memorySize0 =
+      Control::MemoryLeakFinder::currentMemoryConsumptionKiloBytes();
+  if (this->durationLogKey_ != "")
+    Control::PerformanceMeasurement::start(this->durationLogKey_ +
+                                           std::string("_createSystemMatrix"));
+
   // create nested submatrix
   createSystemMatrixFromSubmatrices();
 
+  if (this->durationLogKey_ != "")
+    Control::PerformanceMeasurement::stop(this->durationLogKey_ +
+                                          std::string("_createSystemMatrix"));
+  long long int memorySize1 =
+      Control::MemoryLeakFinder::currentMemoryConsumptionKiloBytes();
+
   LOG(DEBUG) << "set system matrix to linear solver";
 
   // set the nullspace of the matrix
@@ -426,6 +466,35 @@ void MultidomainSolver<
   // initialize linear solver and preconditioner
   this->initializeLinearSolver();
 
+  // set up the fieldsplit preconditioner already here, such that the setup of
+  // the sub solvers is not included in the duration of the first solve, the
+  // other preconditioners are set up in the first solve as before
+  if (useFieldSplitPreconditioner_) {
+    if (this->durationLogKey_ != "")
+      Control::PerformanceMeasurement::start(
+          this->durationLogKey_ + std::string("_preconditionerSetup"));
+
+    ierr = KSPSetUp(*this->linearSolver_->ksp());
+    CHKERRV(ierr);
+
+    if (this->durationLogKey_ != "")
+      Control::PerformanceMeasurement::stop(
+          this->durationLogKey_ + std::string("_preconditionerSetup"));
+  }
+  long long int memorySize2 =
+      Control::MemoryLeakFinder::currentMemoryConsumptionKiloBytes();
+
+  LOG(INFO) << "Multidomain system matrix "
+            << (useFieldSplitPreconditioner_ ? "(nested, fieldsplit)"
+                                             : "(converted to single Mat)")
+            << ": memory " << memorySize1 - memorySize0
+            << " kB, preconditioner setup: " << memorySize2 - memorySize1
+            << " kB";
+  Control::PerformanceMeasurement::setParameter("memorySystemMatrix_kB",
+                                                memorySize1 - memorySize0);
+  Control::PerformanceMeasurement::setParameter(
+      "memoryPreconditionerSetup_kB", memorySize2 - memorySize1);
+
   // initialize rhs and solution vector
   subvectorsRightHandSide_.resize(nCompartments_ + 1);
   subvectorsSolution_.resize(nCompartments_ + 1);
@@ -504,6 +573,69 @@ void MultidomainSolver<FiniteElementMethodPotentialFlow,
   // set block information in preconditioner for block jacobi and node positions
   // for MG preconditioners
   setInformationToPreconditioner();
+
+  // the first solve with the new linear solver does a full setup
+  if (reusePreconditioner_) {
+    nIterationsAfterPreconditionerSetup_ = -1;
+    setPreconditionerReuse(true);
+  }
+}
+
+template <typename FiniteElementMethodPotentialFlow,
+          typename FiniteElementMethodDiffusion>
+void MultidomainSolver<FiniteElementMethodPotentialFlow,
+                       FiniteElementMethodDiffusion>::
+    setPreconditionerReuse(bool fullSetup) {
+  PetscErrorCode ierr;
+  KSP ksp = *this->linearSolver_->ksp();
+  PC pc;
+  ierr = KSPGetPC(ksp, &pc);
+  CHKERRV(ierr);
+
+  PetscBool isGamg;
+  ierr = PetscObjectTypeCompare((PetscObject)pc, PCGAMG, &isGamg);
+  CHKERRV(ierr);
+
+  if (isGamg) {
+    // GAMG keeps the interpolation operators, i.e. the coarse hierarchy, and
+    // only recomputes the coarse grid operators from the new values
+    ierr =
+        PCGAMGSetReuseInterpolation(pc, fullSetup ? PETSC_FALSE : PETSC_TRUE);
+    CHKERRV(ierr);
+    ierr = KSPSetReusePreconditioner(ksp, PETSC_FALSE);
+    CHKERRV(ierr);
+  } else {
+    // other preconditioners, e.g. BoomerAMG of HYPRE, keep the whole setup
+    // that was computed for a previous system matrix
+    ierr = KSPSetReusePreconditioner(ksp, fullSetup ? PETSC_FALSE : PETSC_TRUE);
+    CHKERRV(ierr);
+  }
+}
+
+template <typename FiniteElementMethodPotentialFlow,
+          typename FiniteElementMethodDiffusion>
+void MultidomainSolver<FiniteElementMethodPotentialFlow,
+                       FiniteElementMethodDiffusion>::
+    checkPreconditionerReuse() {
+  if (!reusePreconditioner_)
+    return;
+
+  if (nIterationsAfterPreconditionerSetup_ == -1) {
+    // this was the first solve after a full setup, its number of iterations is
+    // the reference for the following solves
+    nIterationsAfterPreconditionerSetup_ = lastNumberOfIterations_;
+    setPreconditionerReuse(false);
+  } else if (lastNumberOfIterations_ >
+             reusePreconditionerIterationsFactor_ *
+                 std::max(1, nIterationsAfterPreconditionerSetup_)) {
+    // the reused preconditioner got too bad, do a full setup in the next solve
+    LOG(DEBUG) << "Number of iterations increased from "
+               << nIterationsAfterPreconditionerSetup_ << " to "
+               << lastNumberOfIterations_
+               << ", the preconditioner will be set up again.";
+    nIterationsAfterPreconditionerSetup_ = -1;
+    setPreconditionerReuse(true);
+  }
 }
 
 template <typename FiniteElementMethodPotentialFlow,
@@ -519,6 +651,12 @@ void MultidomainSolver<
   ierr = KSPGetPC(*linearSolver_->ksp(), &pc);
   CHKERRV(ierr);
 
+  // set the block preconditioner on the nested system matrix
+  if (useFieldSplitPreconditioner_) {
+    setFieldSplitToPreconditioner(pc);
+    return;
+  }
+
   // set block information for block jacobi preconditioner
   // check, if block jacobi preconditioner is selected
   PetscBool useBlockJacobiPreconditioner;
@@ -564,6 +702,110 @@ void MultidomainSolver<
   CHKERRV(ierr);
 }
 
+template <typename FiniteElementMethodPotentialFlow,
+          typename FiniteElementMethodDiffusion>
+void MultidomainSolver<FiniteElementMethodPotentialFlow,
+                       FiniteElementMethodDiffusion>::
+    setFieldSplitToPreconditioner(PC pc) {
+  // The system matrix is split into the compartment blocks and the
+  // extracellular block:
+  //
+  // [A_00  A_01] [V_m  ]
+  // [A_10  A_11] [phi_e]
+  //
+  // A_00 is block diagonal with the compartment matrices on the diagonal. The
+  // Schur complement S = A_11 - A_10 A_00^-1 A_01 of phi_e is preconditioned
+  // by an AMG of A_11, the compartment blocks get an AMG each.
+  PetscErrorCode ierr;
+  ierr = PCSetType(pc, PCFIELDSPLIT);
+  CHKERRV(ierr);
+
+  // get the index sets of the blocks of the nested matrix
+  std::vector<IS> indexSetsRows(nColumnSubmatricesSystemMatrix_);
+  ierr = MatNestGetISs(nestedSystemMatrix_, indexSetsRows.data(), NULL);
+  CHKERRV(ierr);
+
+  // the first split contains all compartments, the second split phi_e
+  IS indexSetCompartments;
+  ierr = ISConcatenate(this->rankSubset_->mpiCommunicator(), nCompartments_,
+                       indexSetsRows.data(), &indexSetCompartments);
+  CHKERRV(ierr);
+  ierr = PCFieldSplitSetIS(pc, "vm", indexSetCompartments);
+  CHKERRV(ierr);
+  ierr = PCFieldSplitSetIS(pc, "phie", indexSetsRows[nCompartments_]);
+  CHKERRV(ierr);
+  ierr = ISDestroy(&indexSetCompartments);
+  CHKERRV(ierr);
+
+  ierr = PCFieldSplitSetType(pc, PC_COMPOSITE_SCHUR);
+  CHKERRV(ierr);
+  ierr = PCFieldSplitSetSchurFactType(pc, PC_FIELDSPLIT_SCHUR_FACT_FULL);
+  CHKERRV(ierr);
+  ierr = PCFieldSplitSetSchurPre(pc, PC_FIELDSPLIT_SCHUR_PRE_A11, NULL);
+  CHKERRV(ierr);
+
+  // The sub solvers are only created during the setup of the preconditioner,
+  // therefore they are configured by the options database. Options that are
+  // given on the command line take precedence.
+  KSPType subKspType;
+  PCType subPcType;
+  Solver::Linear::parseSolverTypes("preonly", fieldSplitSubPreconditionerType_,
+                                   subKspType, subPcType);
+
+  const char *kspPrefix = NULL;
+  ierr = KSPGetOptionsPrefix(*linearSolver_->ksp(), &kspPrefix);
+  CHKERRV(ierr);
+  std::string prefix = std::string("-") + (kspPrefix ? kspPrefix : "");
+
+  auto setOptionIfNotSet = [](std::string name, std::string value) {
+    PetscBool isSet;
+    PetscErrorCode ierr =
+        PetscOptionsHasName(NULL, NULL, name.c_str(), &isSet);
+    CHKERRV(ierr);
+    if (!isSet) {
+      ierr = PetscOptionsSetValue(NULL, name.c_str(), value.c_str());
+      CHKERRV(ierr);
+    }
+  };
+
+  // set an AMG as preconditioner of the sub solver with the given prefix
+  auto setSubSolverOptions = [&](std::string subPrefix) {
+    setOptionIfNotSet(subPrefix + "ksp_type", subKspType);
+    setOptionIfNotSet(subPrefix + "pc_type", subPcType);
+    if (subPcType == std::string(PCHYPRE) &&
+        fieldSplitSubPreconditionerType_ != "pchypre") {
+      setOptionIfNotSet(subPrefix + "pc_hypre_type",
+                        fieldSplitSubPreconditionerType_);
+    }
+  };
+
+  // compartment blocks, with more than one compartment the nested matrix A_00
+  // is again split additively into its blocks
+  if (nCompartments_ == 1) {
+    setSubSolverOptions(prefix + "fieldsplit_vm_");
+  } else {
+    setOptionIfNotSet(prefix + "fieldsplit_vm_ksp_type", KSPPREONLY);
+    setOptionIfNotSet(prefix + "fieldsplit_vm_pc_type", PCFIELDSPLIT);
+    setOptionIfNotSet(prefix + "fieldsplit_vm_pc_fieldsplit_type", "additive");
+    for (int k = 0; k < nCompartments_; k++) {
+      std::stringstream subPrefix;
+      subPrefix << prefix << "fieldsplit_vm_fieldsplit_" << k << "_";
+      setSubSolverOptions(subPrefix.str());
+    }
+  }
+
+  // Schur complement of phi_e
+  setSubSolverOptions(prefix + "fieldsplit_phie_");
+
+  // set options from command line, this overrides the settings above
+  ierr = PCSetFromOptions(pc);
+  CHKERRV(ierr);
+
+  LOG(INFO) << "using fieldsplit preconditioner on the nested system matrix, "
+            << "Schur complement for phi_e, sub preconditioner: "
+            << fieldSplitSubPreconditionerType_;
+}
+
 template <typename FiniteElementMethodPotentialFlow,
           typename FiniteElementMethodDiffusion>
 void MultidomainSolver<
@@ -726,10 +968,25 @@ void MultidomainSolver<FiniteElementMethodPotentialFlow,
     VLOG(2) << "k=" << k << ", am: " << am_[k] << ", cm: " << cm_[k]
             << ", prefactor: " << prefactor;
 
+    // if the preconditioner is reused, the existing submatrices keep their
+    // sparsity pattern and only get new values, this reuses the symbolic
+    // matrix product
+    Mat matrixOnRightColumn =
+        submatricesSystemMatrix_[k * nColumnSubmatricesSystemMatrix_ +
+                                 (nCompartments_ + 1) - 1];
+    Mat matrixOnDiagonalBlock =
+        submatricesSystemMatrix_[k * nColumnSubmatricesSystemMatrix_ + k];
+    Mat matrixOnBottomRow =
+        submatricesSystemMatrix_[((nCompartments_ + 1) - 1) *
+                                     nColumnSubmatricesSystemMatrix_ +
+                                 k];
+    bool updateInPlace = reusePreconditioner_ && matrixOnRightColumn &&
+                         matrixOnDiagonalBlock && matrixOnBottomRow;
+
     // create matrix as M^{-1}*K
-    Mat matrixOnRightColumn;
     ierr = MatMatMult(inverseLumpedMassMatrix, stiffnessMatrix,
-                      MAT_INITIAL_MATRIX, PETSC_DEFAULT, &matrixOnRightColumn);
+                      updateInPlace ? MAT_REUSE_MATRIX : MAT_INITIAL_MATRIX,
+                      PETSC_DEFAULT, &matrixOnRightColumn);
     CHKERRV(ierr);
 
     // scale matrix on right column with prefactor
@@ -737,10 +994,15 @@ void MultidomainSolver<FiniteElementMethodPotentialFlow,
     CHKERRV(ierr);
 
     // copy right block matrix also to diagonal matrix
-    Mat matrixOnDiagonalBlock;
-    ierr = MatConvert(matrixOnRightColumn, MATSAME, MAT_INITIAL_MATRIX,
-                      &matrixOnDiagonalBlock);
-    CHKERRV(ierr);
+    if (updateInPlace) {
+      ierr = MatCopy(matrixOnRightColumn, matrixOnDiagonalBlock,
+                     SAME_NONZERO_PATTERN);
+      CHKERRV(ierr);
+    } else {
+      ierr = MatConvert(matrixOnRightColumn, MATSAME, MAT_INITIAL_MATRIX,
+                        &matrixOnDiagonalBlock);
+      CHKERRV(ierr);
+    }
 
     // for debugging zero all entries
 #ifdef MONODOMAIN
@@ -786,10 +1048,15 @@ void MultidomainSolver<FiniteElementMethodPotentialFlow,
             ->valuesGlobal();
 
     // create matrix as copy of stiffnessMatrix
-    Mat matrixOnBottomRow;
-    ierr = MatConvert(stiffnessMatrixWithPrefactor, MATSAME, MAT_INITIAL_MATRIX,
-                      &matrixOnBottomRow);
-    CHKERRV(ierr);
+    if (updateInPlace) {
+      ierr = MatCopy(stiffnessMatrixWithPrefactor, matrixOnBottomRow,
+                     SAME_NONZERO_PATTERN);
+      CHKERRV(ierr);
+    } else {
+      ierr = MatConvert(stiffnessMatrixWithPrefactor, MATSAME,
+                        MAT_INITIAL_MATRIX, &matrixOnBottomRow);
+      CHKERRV(ierr);
+    }
 
 #if 0
     // debugging test, gives slightly different results due to approximation of test
@@ -924,17 +1191,87 @@ void MultidomainSolver<
   }
 #endif
 
+  // if the submatrices were only updated in place, the existing nested matrix
+  // still refers to them and does not need to be created again
+  bool submatricesChanged = true;
+  if (nestedSystemMatrix_ != PETSC_NULL) {
+    PetscInt nNestedMatRows, nNestedMatColumns;
+    Mat **nestedMats;
+    ierr = MatNestGetSubMats(nestedSystemMatrix_, &nNestedMatRows,
+                             &nNestedMatColumns, &nestedMats);
+    CHKERRV(ierr);
+
+    submatricesChanged = false;
+    for (int rowNo = 0; rowNo < nNestedMatRows; rowNo++) {
+      for (int columnNo = 0; columnNo < nNestedMatColumns; columnNo++) {
+        if (nestedMats[rowNo][columnNo] !=
+            submatricesSystemMatrix_[rowNo * nColumnSubmatricesSystemMatrix_ +
+                                     columnNo])
+          submatricesChanged = true;
+      }
+    }
+  }
+
   // create nested matrix
-  ierr = MatCreateNest(this->rankSubset_->mpiCommunicator(),
-                       nColumnSubmatricesSystemMatrix_, NULL,
-                       nColumnSubmatricesSystemMatrix_, NULL,
-                       submatricesSystemMatrix_.data(), &nestedSystemMatrix_);
-  CHKERRV(ierr);
+  if (submatricesChanged) {
+    ierr = MatCreateNest(this->rankSubset_->mpiCommunicator(),
+                         nColumnSubmatricesSystemMatrix_, NULL,
+                         nColumnSubmatricesSystemMatrix_, NULL,
+                         submatricesSystemMatrix_.data(), &nestedSystemMatrix_);
+    CHKERRV(ierr);
+  } else {
+    VLOG(1) << "reuse nested system matrix";
+  }
 
-  // create a single Mat object from the nested Mat
+  // the fieldsplit preconditioner operates directly on the nested matrix, no
+  // copy of the entries to a single Mat is needed
+  if (useFieldSplitPreconditioner_) {
+    Mat previousNestedSystemMatrix = singleSystemMatrix_;
+    singleSystemMatrix_ = nestedSystemMatrix_;
+    singlePreconditionerMatrix_ = nestedSystemMatrix_;
+
+    // if the matrix gets recreated, e.g. in updateSystemMatrix, transfer the
+    // null space and set the new matrix to the linear solvers
+    if (previousNestedSystemMatrix != PETSC_NULL &&
+        previousNestedSystemMatrix != nestedSystemMatrix_) {
+      MatNullSpace nullSpace;
+      ierr = MatGetNullSpace(previousNestedSystemMatrix, &nullSpace);
+      CHKERRV(ierr);
+      if (nullSpace) {
+        ierr = MatSetNullSpace(nestedSystemMatrix_, nullSpace);
+        CHKERRV(ierr);
+        ierr = MatSetNearNullSpace(nestedSystemMatrix_, nullSpace);
+        CHKERRV(ierr);
+      }
+
+      if (this->linearSolver_) {
+        ierr = KSPSetOperators(*this->linearSolver_->ksp(), singleSystemMatrix_,
+                               singlePreconditionerMatrix_);
+        CHKERRV(ierr);
+      }
+      if (this->alternativeLinearSolver_) {
+        ierr = KSPSetOperators(*this->alternativeLinearSolver_->ksp(),
+                               singleSystemMatrix_,
+                               singlePreconditionerMatrix_);
+        CHKERRV(ierr);
+      }
+
+      // the linear solvers hold their own references
+      ierr = MatDestroy(&previousNestedSystemMatrix);
+      CHKERRV(ierr);
+    }
+    return;
+  }
+
+  // create a single Mat object from the nested Mat, if the submatrices were
+  // updated in place, they have the same nonzero pattern and only the values
+  // are copied to the existing single Mat
+  MatReuse reuseSingleMatrix = (reusePreconditioner_ && !submatricesChanged)
+                                   ? MAT_REUSE_MATRIX
+                                   : MAT_INITIAL_MATRIX;
   NestedMatVecUtility::createMatFromNestedMat(
       nestedSystemMatrix_, singleSystemMatrix_,
-      data().functionSpace()->meshPartition()->rankSubset());
+      data().functionSpace()->meshPartition()->rankSubset(), reuseSingleMatrix);
 
   if (useSymmetricPreconditionerMatrix_) {
     this->submatricesPreconditionerMatrix_ = submatricesSystemMatrix_;
@@ -990,19 +1327,21 @@ void MultidomainSolver<
     }
 #endif
 
-    Mat nestedPreconditionerMatrix;
-
     // create nested matrix
-    ierr = MatCreateNest(
-        this->rankSubset_->mpiCommunicator(), nColumnSubmatricesSystemMatrix_,
-        NULL, nColumnSubmatricesSystemMatrix_, NULL,
-        submatricesPreconditionerMatrix_.data(), &nestedPreconditionerMatrix);
-    CHKERRV(ierr);
+    if (submatricesChanged || nestedPreconditionerMatrix_ == PETSC_NULL) {
+      ierr = MatCreateNest(this->rankSubset_->mpiCommunicator(),
+                           nColumnSubmatricesSystemMatrix_, NULL,
+                           nColumnSubmatricesSystemMatrix_, NULL,
+                           submatricesPreconditionerMatrix_.data(),
+                           &nestedPreconditionerMatrix_);
+      CHKERRV(ierr);
+    }
 
     // create a single Mat object from the nested Mat
     NestedMatVecUtility::createMatFromNestedMat(
-        nestedPreconditionerMatrix, singlePreconditionerMatrix_,
-        data().functionSpace()->meshPartition()->rankSubset());
+        nestedPreconditionerMatrix_, singlePreconditionerMatrix_,
+        data().functionSpace()->meshPartition()->rankSubset(),
+        reuseSingleMatrix);
   } else {
     singlePreconditionerMatrix_ = singleSystemMatrix_;
   }
@@ -1031,6 +1370,13 @@ void MultidomainSolver<FiniteElementMethodPotentialFlow,
   // create the system matrix again
   createSystemMatrixFromSubmatrices();
 
+  // inform the linear solver about the new values, if the preconditioner is
+  // reused, it will only be refreshed
+  PetscErrorCode ierr;
+  ierr = KSPSetOperators(*this->linearSolver_->ksp(), this->singleSystemMatrix_,
+                         this->singlePreconditionerMatrix_);
+  CHKERRV(ierr);
+
   // stop duration measurement
   if (this->durationLogKey_ != "")
     Control::PerformanceMeasurement::stop(this->durationLogKey_ +
@@ -1093,6 +1439,9 @@ void MultidomainSolver<FiniteElementMethodPotentialFlow,
   // store the last number of iterations
   lastNumberOfIterations_ = this->linearSolver_->lastNumberOfIterations();
 
+  // decide if the preconditioner can still be reused
+  checkPreconditionerReuse();
+
   // copy the values back from a single Vec that contains all entries to a
   // nested Petsc Vec
   NestedMatVecUtility::fillNestedVec(singleSolution_, nestedSolution_);
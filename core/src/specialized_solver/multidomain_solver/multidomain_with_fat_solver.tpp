@@ -27,6 +27,15 @@ void MultidomainWithFatSolver<FiniteElementMethodPotentialFlow,
   MultidomainSolver<FiniteElementMethodPotentialFlow,
                     FiniteElementMethodDiffusionMuscle>::initializeObjects();
 
+  // the Dirichlet boundary conditions are set in the single system matrix,
+  // this needs the converted matrix
+  if (this->useFieldSplitPreconditioner_) {
+    LOG(WARNING) << this->specificSettings_
+                 << "[\"useFieldSplitPreconditioner\"] is not supported by "
+                    "the MultidomainWithFatSolver, it will be ignored.";
+    this->useFieldSplitPreconditioner_ = false;
+  }
+
   // indicate in solverStructureVisualizer that now a child solver will be
   // initialized
   DihuContext::solverStructureVisualizer()->beginChild("Fat");
@@ -757,6 +766,13 @@ void MultidomainWithFatSolver<
   // zero rows and columns for additional Dirichlet boundary conditions
   setDirichletBoundaryConditionsInSystemMatrix();
 
+  // inform the linear solver about the new values, if the preconditioner is
+  // reused, it will only be refreshed
+  PetscErrorCode ierr;
+  ierr = KSPSetOperators(*this->linearSolver_->ksp(), this->singleSystemMatrix_,
+                         this->singlePreconditionerMatrix_);
+  CHKERRV(ierr);
+
 #ifdef DUMP_REBUILT_SYSTEM_MATRIX
 
   for (int i = 0; i < this->submatricesSystemMatrix_.size(); i++) {
@@ -1085,6 +1101,9 @@ void MultidomainWithFatSolver<
   // store the last number of iterations
   this->lastNumberOfIterations_ = this->linearSolver_->lastNumberOfIterations();
 
+  // decide if the preconditioner can still be reused
+  this->checkPreconditionerReuse();
+
   // copy the values back from the single Vec, singleSolution_, that contains
   // all entries to the nested Petsc Vec, nestedSolution_ which contains the
   // components in subvectorsSolution_
@@ -229,12 +229,16 @@ void fillNestedVec(Vec singleVec, Vec nestedVec) {
 //! (singleMat) that contains all values at once. If the singleMat already
 //! exists, do not create again, only copy the values.
 void createMatFromNestedMat(Mat nestedMat, Mat &singleMat,
-                            std::shared_ptr<Partition::RankSubset> rankSubset) {
+                            std::shared_ptr<Partition::RankSubset> rankSubset,
+                            MatReuse reuse) {
 #ifdef USE_NESTED_MAT
   singleMat = nestedMat;
   return;
 #endif
 
+  // the matrix can only be reused if it exists
+  bool reuseSingleMat = reuse == MAT_REUSE_MATRIX && singleMat != PETSC_NULL;
+
   MPI_Comm mpiCommunicator = rankSubset->mpiCommunicator();
   int nRanks = rankSubset->size();
   int ownRankNo = rankSubset->ownRankNo();
@@ -317,11 +321,12 @@ void createMatFromNestedMat(Mat nestedMat, Mat &singleMat,
              << ", local: " << nRowsLocalNestedMats << " x "
              << nColumnsLocalNestedMats;
 
-  // determine maximum number of nonzeros per row
+  // determine maximum number of nonzeros per row, this is only needed for the
+  // preallocation of a new matrix
   // loop over rows of sub matrices
   int nMaximumNonzerosPerRow = 0;
-  for (int nestedMatRowNo = 0; nestedMatRowNo < nNestedMatRows;
-       nestedMatRowNo++) {
+  for (int nestedMatRowNo = 0;
+       nestedMatRowNo < nNestedMatRows && !reuseSingleMat; nestedMatRowNo++) {
     std::vector<PetscInt> nNonzeroEntriesRows;
     for (int nestedMatColumnNo = 0; nestedMatColumnNo < nNestedMatColumns;
          nestedMatColumnNo++) {
@@ -364,6 +369,14 @@ void createMatFromNestedMat(Mat nestedMat, Mat &singleMat,
 
   LOG(DEBUG) << "nMaximumNonzerosPerRow: " << nMaximumNonzerosPerRow;
 
+  // the reused matrix keeps its nonzero structure, a changed pattern of the
+  // nested matrix is an error instead of a silent new allocation
+  if (reuseSingleMat) {
+    VLOG(1) << "reuse single Mat, only copy the values";
+    ierr = MatSetOption(singleMat, MAT_NEW_NONZERO_LOCATION_ERR, PETSC_TRUE);
+    CHKERRV(ierr);
+  }
+
   // if Mat object does not yet exist, create new one
   if (singleMat == PETSC_NULL) {
     ierr = MatCreate(mpiCommunicator, &singleMat);
@@ -20,9 +20,12 @@ void fillNestedVec(Vec singleVec, Vec nestedVec);
 
 //! from a Petsc Mat with nested type (nestedMat) create a new Petsc Mat
 //! (singleMat) that contains all values at once. If the singleMat already
-//! exists, do not create again, only copy the values.
+//! exists, do not create again, only copy the values. With MAT_REUSE_MATRIX,
+//! the nested Mat has the same nonzero pattern as when singleMat was created,
+//! only the values are copied and no new nonzeros are allowed.
 void createMatFromNestedMat(Mat nestedMat, Mat &singleMat,
-                            std::shared_ptr<Partition::RankSubset> rankSubset);
+                            std::shared_ptr<Partition::RankSubset> rankSubset,
+                            MatReuse reuse = MAT_INITIAL_MATRIX);
 
 } // namespace NestedMatVecUtility
 } // namespace TimeSteppingScheme
@@ -59,7 +59,7 @@ void MuscleContractionSolver<MeshType, Term, withLargeOutputFiles>::
   // start duration measurement, the name of the output variable can be set by
   // "durationLogKey" in the config
   if (this->durationLogKey_ != "")
-    Control::PerformanceMeasurement::start(this->durationLogKey_);
+    Control::PerformanceMeasurement::start(this->durationLogKeyId_);
 
   // compute time span of this method
   double timeSpan = this->endTime_ - this->startTime_;
@@ -116,7 +116,7 @@ void MuscleContractionSolver<MeshType, Term, withLargeOutputFiles>::
 
     // stop duration measurement
     if (this->durationLogKey_ != "")
-      Control::PerformanceMeasurement::stop(this->durationLogKey_);
+      Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
 
     // write current output values using the output writers
     if (withOutputWritersEnabled)
@@ -125,12 +125,12 @@ void MuscleContractionSolver<MeshType, Term, withLargeOutputFiles>::
 
     // start duration measurement
     if (this->durationLogKey_ != "")
-      Control::PerformanceMeasurement::start(this->durationLogKey_);
+      Control::PerformanceMeasurement::start(this->durationLogKeyId_);
   }
 
   // stop duration measurement
   if (this->durationLogKey_ != "")
-    Control::PerformanceMeasurement::stop(this->durationLogKey_);
+    Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
 
   mapGeometryToGivenMeshes();
 
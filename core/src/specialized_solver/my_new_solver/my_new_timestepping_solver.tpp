@@ -41,7 +41,7 @@ void MyNewTimesteppingSolver<TimeStepping>::advanceTimeSpan(
   // start duration measurement, the name of the output variable can be set by
   // "durationLogKey" in the config
   if (this->durationLogKey_ != "")
-    Control::PerformanceMeasurement::start(this->durationLogKey_);
+    Control::PerformanceMeasurement::start(this->durationLogKeyId_);
 
   // compute time span of this method
   double timeSpan = this->endTime_ - this->startTime_;
@@ -93,7 +93,7 @@ void MyNewTimesteppingSolver<TimeStepping>::advanceTimeSpan(
 
     // stop duration measurement
     if (this->durationLogKey_ != "")
-      Control::PerformanceMeasurement::stop(this->durationLogKey_);
+      Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
 
     // if the output writers are enabled, write current output values using the
     // output writers
@@ -103,12 +103,12 @@ void MyNewTimesteppingSolver<TimeStepping>::advanceTimeSpan(
 
     // start duration measurement
     if (this->durationLogKey_ != "")
-      Control::PerformanceMeasurement::start(this->durationLogKey_);
+      Control::PerformanceMeasurement::start(this->durationLogKeyId_);
   }
 
   // stop duration measurement
   if (this->durationLogKey_ != "")
-    Control::PerformanceMeasurement::stop(this->durationLogKey_);
+    Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
 }
 
 template <typename TimeStepping>
@@ -32,7 +32,7 @@ void PrescribedValues<FunctionSpaceType, nComponents1, nComponents2>::
   // start duration measurement, the name of the output variable can be set by
   // "durationLogKey" in the config
   if (this->durationLogKey_ != "")
-    Control::PerformanceMeasurement::start(this->durationLogKey_);
+    Control::PerformanceMeasurement::start(this->durationLogKeyId_);
 
   // compute time span of this method
   double timeSpan = this->endTime_ - this->startTime_;
@@ -68,7 +68,7 @@ void PrescribedValues<FunctionSpaceType, nComponents1, nComponents2>::
 
     // stop duration measurement
     if (this->durationLogKey_ != "")
-      Control::PerformanceMeasurement::stop(this->durationLogKey_);
+      Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
 
     // write current output values using the output writers
     if (withOutputWritersEnabled)
@@ -77,12 +77,12 @@ void PrescribedValues<FunctionSpaceType, nComponents1, nComponents2>::
 
     // start duration measurement
     if (this->durationLogKey_ != "")
-      Control::PerformanceMeasurement::start(this->durationLogKey_);
+      Control::PerformanceMeasurement::start(this->durationLogKeyId_);
   }
 
   // stop duration measurement
   if (this->durationLogKey_ != "")
-    Control::PerformanceMeasurement::stop(this->durationLogKey_);
+    Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
 }
 
 template <typename FunctionSpaceType, int nComponents1, int nComponents2>
@@ -187,6 +187,9 @@ template <typename FunctionSpaceType, int nComponents1, int nComponents2>
 void PrescribedValues<FunctionSpaceType, nComponents1,
                       nComponents2>::callCallbacks(int timeStepNo,
                                                    double currentTime) {
+  // start critical section for python API calls
+  PythonUtility::GlobalInterpreterLock lock;
+
   // call callback functions for field variable 1
   for (int fieldVariable1No = 0; fieldVariable1No < callbackFunctions1_.size();
        fieldVariable1No++) {
@@ -214,6 +214,9 @@ void DynamicHyperelasticitySolver<Term, withLargeOutput, MeshType>::
   }
   updateDirichletBoundaryConditionsFunctionCallCount_++;
 
+  // start critical section for python API calls
+  PythonUtility::GlobalInterpreterLock lock;
+
   // compose callback function
   PyObject *arglist = Py_BuildValue("(d)", t);
   PyObject *returnValue = PyObject_CallObject(
@@ -293,6 +296,9 @@ void DynamicHyperelasticitySolver<Term, withLargeOutput, MeshType>::
   }
   updateNeumannBoundaryConditionsFunctionCallCount_++;
 
+  // start critical section for python API calls
+  PythonUtility::GlobalInterpreterLock lock;
+
   // compose callback function
   PyObject *arglist = Py_BuildValue("(d)", t);
   PyObject *returnValue = PyObject_CallObject(
@@ -433,7 +439,7 @@ void DynamicHyperelasticitySolver<Term, withLargeOutput, MeshType>::
   // start duration measurement, the name of the output variable can be set by
   // "durationLogKey" in the config
   if (this->durationLogKey_ != "")
-    Control::PerformanceMeasurement::start(this->durationLogKey_);
+    Control::PerformanceMeasurement::start(this->durationLogKeyId_);
 
   // update the reference geometry to use the current value, in the first time
   // step
@@ -504,7 +510,7 @@ void DynamicHyperelasticitySolver<Term, withLargeOutput, MeshType>::
 
     // stop duration measurement
     if (this->durationLogKey_ != "")
-      Control::PerformanceMeasurement::stop(this->durationLogKey_);
+      Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
 
     // copy resulting values to data object such that they can be written by
     // output writer
@@ -541,13 +547,13 @@ void DynamicHyperelasticitySolver<Term, withLargeOutput, MeshType>::
 
     // start duration measurement
     if (this->durationLogKey_ != "")
-      Control::PerformanceMeasurement::start(this->durationLogKey_);
+      Control::PerformanceMeasurement::start(this->durationLogKeyId_);
     // this->data_.print();
   }
 
   // stop duration measurement
   if (this->durationLogKey_ != "")
-    Control::PerformanceMeasurement::stop(this->durationLogKey_);
+    Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
 }
 
 template <typename Term, bool withLargeOutput, typename MeshType>
@@ -635,6 +641,9 @@ void DynamicHyperelasticitySolver<Term, withLargeOutput, MeshType>::
     }
     pythonTotalForceFunctionCallCount_++;
 
+    // start critical section for python API calls
+    PythonUtility::GlobalInterpreterLock lock;
+
     // create four python variables
     PyObject *bearingForceBottomList =
         PythonUtility::convertToPython<Vec3>::get(bearingForceBottom);
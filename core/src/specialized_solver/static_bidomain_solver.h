@@ -11,6 +11,15 @@ namespace TimeSteppingScheme {
 
 /** A specialized solver for the bidomain equation,
  * div((sigma_i+sigma_e)*grad(phi_e)) + div(sigma_i*grad(Vm)) = 0
+ *
+ *  If electrode positions are given, the EMG at the electrodes is computed by
+ * lead fields: The potential at an electrode is w^T phi_e = w^T A^-1 R Vm with
+ * the interpolation weights w of the electrode, the system matrix A and the
+ * rhs matrix R. The lead field L = R^T A^-T w is computed by one solve per
+ * electrode at initialization, then every EMG value is a dot product L^T Vm.
+ * The full system is then no longer solved, i.e. phi_e keeps its initial
+ * values in the output writers and slots, unless leadFieldSolveFullSystem is
+ * set.
  */
 template <typename FiniteElementMethodPotentialFlow,
           typename FiniteElementMethodDiffusion>
@@ -28,6 +37,9 @@ public:
   //! constructor
   StaticBidomainSolver(DihuContext context);
 
+  //! destructor, destroys the vectors of the lead fields
+  virtual ~StaticBidomainSolver();
+
   //! advance simulation by the given time span, data in solution is used,
   //! afterwards new data is in solution
   void advanceTimeSpan(bool withOutputWritersEnabled = true);
@@ -66,6 +78,9 @@ public:
   //! output the given data for debugging
   std::string getString(std::shared_ptr<SlotConnectorDataType> data);
 
+  //! get the electrode potentials of the last lead field EMG computation
+  const std::vector<double> &leadFieldEmgValues() const;
+
 protected:
   //! solve the linear system of equations of the implicit scheme with
   //! rightHandSide_ and solution_
@@ -74,6 +89,18 @@ protected:
   //! dump rhs vector
   void debugDumpData();
 
+  //! find the electrodes in the mesh and compute their lead fields, one linear
+  //! solve per electrode
+  void initializeLeadFields();
+
+  //! compute the electrode potentials from the lead fields and the
+  //! transmembrane potential and write them to the lead field file, if the
+  //! full system was solved, compare with the values of phi_e
+  void computeLeadFieldEmg();
+
+  //! destroy the vectors of the electrode weights and lead fields
+  void destroyLeadFields();
+
   DihuContext context_; //< object that contains the python config for the
                         // current context and the global singletons meshManager
                         // and solverManager
@@ -108,6 +135,7 @@ protected:
 
   std::string durationLogKey_; //< key with with the duration of the computation
                                // is written to the performance measurement log
+  int durationLogKeyId_; //< handle of the duration measurement durationLogKey_
 
   bool initialized_;              //< if this object was already initialized
   PythonConfig specificSettings_; //< python object containing the value of the
@@ -115,6 +143,18 @@ protected:
   double endTime_;                //< end time of current time step
   bool initialGuessNonzero_; //< if the initial guess for the linear solver is
                              // set to the previous solution
+
+  std::vector<Vec3>
+      leadFieldElectrodePositions_; //< the positions of the electrodes for the
+                                    // lead field EMG, empty if disabled
+  std::vector<Vec> electrodeWeights_; //< for every electrode the interpolation
+                                      // weights w without the constant part
+  std::vector<Vec>
+      leadFields_; //< for every electrode the lead field R^T A^-T w
+  std::vector<double> leadFieldEmgValues_; //< the current electrode potentials
+  std::string leadFieldFilename_;  //< the csv file for the electrode potentials
+  bool leadFieldSolveFullSystem_;  //< if the full system is still solved when
+                                   // lead fields are used, for validation
 };
 
 } // namespace TimeSteppingScheme
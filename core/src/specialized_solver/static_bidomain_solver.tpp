@@ -2,10 +2,17 @@
 
 #include <Python.h> // has to be the first included header
 
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
 #include "utility/python_utility.h"
 #include "utility/petsc_utility.h"
 #include "data_management/specialized_solver/multidomain.h"
 #include "control/diagnostic_tool/performance_measurement.h"
+#include "output_writer/generic.h"
+#include "output_writer/output_surface/output_points.h"
+#include "utility/mpi_utility.h"
 
 namespace TimeSteppingScheme {
 
@@ -31,11 +38,38 @@ StaticBidomainSolver<
   this->initialGuessNonzero_ =
       specificSettings_.getOptionBool("initialGuessNonzero", true);
 
+  // parse the electrodes for the lead field EMG
+  if (specificSettings_.hasKey("leadFieldElectrodePositions")) {
+    PyObject *electrodePositionsPy =
+        specificSettings_.getOptionPyObject("leadFieldElectrodePositions");
+    this->leadFieldElectrodePositions_ =
+        PythonUtility::convertFromPython<std::vector<Vec3>>::get(
+            electrodePositionsPy);
+  }
+  this->leadFieldFilename_ = specificSettings_.getOptionString(
+      "leadFieldFilename", "out/lead_field_emg.csv");
+  this->leadFieldSolveFullSystem_ =
+      specificSettings_.getOptionBool("leadFieldSolveFullSystem", false);
+
   // initialize output writers
   this->outputWriterManager_.initialize(this->context_,
                                         this->specificSettings_);
 }
 
+template <typename FiniteElementMethodPotentialFlow,
+          typename FiniteElementMethodDiffusion>
+StaticBidomainSolver<FiniteElementMethodPotentialFlow,
+                     FiniteElementMethodDiffusion>::~StaticBidomainSolver() {
+  // the solver can be destroyed after PETSc was finalized, then nothing can be
+  // done here
+  PetscBool isFinalized;
+  PetscFinalized(&isFinalized);
+  if (isFinalized)
+    return;
+
+  this->destroyLeadFields();
+}
+
 template <typename FiniteElementMethodPotentialFlow,
           typename FiniteElementMethodDiffusion>
 void StaticBidomainSolver<FiniteElementMethodPotentialFlow,
@@ -46,7 +80,7 @@ void StaticBidomainSolver<FiniteElementMethodPotentialFlow,
   // start duration measurement, the name of the output variable can be set by
   // "durationLogKey" in the config
   if (this->durationLogKey_ != "")
-    Control::PerformanceMeasurement::start(this->durationLogKey_);
+    Control::PerformanceMeasurement::start(this->durationLogKeyId_);
 
   /*
   Bidomain equation:
@@ -54,19 +88,26 @@ void StaticBidomainSolver<FiniteElementMethodPotentialFlow,
     => K(sigma_i+sigma_e) phi_e = -K(sigma_i) Vm
    */
 
-  // update right hand side: transmembraneFlow = -K(sigma_i) Vm
-  PetscErrorCode ierr;
-  ierr =
-      MatMult(data_.rhsMatrix(), data_.transmembranePotential()->valuesGlobal(),
-              data_.transmembraneFlow()->valuesGlobal());
-  CHKERRV(ierr);
+  // the full system is not needed if the EMG is computed by lead fields
+  if (leadFields_.empty() || leadFieldSolveFullSystem_) {
+    // update right hand side: transmembraneFlow = -K(sigma_i) Vm
+    PetscErrorCode ierr;
+    ierr = MatMult(data_.rhsMatrix(),
+                   data_.transmembranePotential()->valuesGlobal(),
+                   data_.transmembraneFlow()->valuesGlobal());
+    CHKERRV(ierr);
 
-  // solve K(sigma_i+sigma_e) phi_e = transmembraneFlow for phi_e
-  this->solveLinearSystem();
+    // solve K(sigma_i+sigma_e) phi_e = transmembraneFlow for phi_e
+    this->solveLinearSystem();
+  }
+
+  // compute the electrode potentials by the lead fields
+  if (!leadFields_.empty())
+    this->computeLeadFieldEmg();
 
   // stop duration measurement
   if (this->durationLogKey_ != "")
-    Control::PerformanceMeasurement::stop(this->durationLogKey_);
+    Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
 
   // write current output values
   if (withOutputWritersEnabled)
@@ -121,6 +162,14 @@ void StaticBidomainSolver<FiniteElementMethodPotentialFlow,
   LOG(DEBUG) << "initialize static_bidomain_solver";
   assert(this->specificSettings_.pyObject());
 
+  // register the duration measurement such that it can be started and stopped
+  // without lookup of the key in every time step
+  if (this->durationLogKey_ != "") {
+    this->durationLogKeyId_ =
+        Control::PerformanceMeasurement::registerMeasurement(
+            this->durationLogKey_);
+  }
+
   // add this solver to the solvers diagram
   DihuContext::solverStructureVisualizer()->addSolver("StaticBidomainSolver");
 
@@ -241,6 +290,21 @@ void StaticBidomainSolver<FiniteElementMethodPotentialFlow,
   MatSetNearNullSpace(systemMatrix, constantFunctions); // for multigrid methods
   MatNullSpaceDestroy(&constantFunctions);
 
+  // precompute the lead fields of the electrodes
+  if (!leadFieldElectrodePositions_.empty()) {
+    this->initializeLeadFields();
+
+    // phi_e is not computed, the output writers would only get its old values
+    if (!leadFieldSolveFullSystem_ &&
+        this->outputWriterManager_.hasOutputWriters()) {
+      LOG(WARNING) << specificSettings_ << "[\"OutputWriter\"]: The EMG is "
+                   << "computed by lead fields, therefore phi_e is not "
+                   << "updated in the output files. Set "
+                   << "\"leadFieldSolveFullSystem\": True to also compute "
+                   << "phi_e.";
+    }
+  }
+
   // set the slotConnectorData for the solverStructureVisualizer to appear in
   // the solver diagram
   DihuContext::solverStructureVisualizer()->setSlotConnectorData(
@@ -303,6 +367,199 @@ void StaticBidomainSolver<FiniteElementMethodPotentialFlow,
 #endif
 }
 
+template <typename FiniteElementMethodPotentialFlow,
+          typename FiniteElementMethodDiffusion>
+void StaticBidomainSolver<
+    FiniteElementMethodPotentialFlow,
+    FiniteElementMethodDiffusion>::initializeLeadFields() {
+  LOG(DEBUG) << "initialize lead fields for "
+             << leadFieldElectrodePositions_.size() << " electrodes";
+
+  std::shared_ptr<FunctionSpace> functionSpace = data_.functionSpace();
+  const int D = FunctionSpace::dim();
+  const int nDofsPerElement = FunctionSpace::nDofsPerElement();
+  const int nElectrodes = leadFieldElectrodePositions_.size();
+  const double xiTolerance = specificSettings_.getOptionDouble(
+      "leadFieldXiTolerance", 0.3, PythonUtility::NonNegative);
+
+  // find the electrodes in the local domain
+  std::vector<element_no_t> elementNosLocal(nElectrodes, 0);
+  std::vector<std::array<double, D>> xis(nElectrodes);
+  std::vector<int> ownerRankNos(nElectrodes, INT_MAX);
+  element_no_t elementNoLocal = 0;
+
+  for (int electrodeNo = 0; electrodeNo < nElectrodes; electrodeNo++) {
+    int ghostMeshNo = -1;
+    double residual;
+    bool searchedAllElements;
+    bool pointFound = functionSpace->findPosition(
+        leadFieldElectrodePositions_[electrodeNo], elementNoLocal, ghostMeshNo,
+        xis[electrodeNo], true, residual, searchedAllElements, xiTolerance);
+
+    if (pointFound && ghostMeshNo == -1) {
+      elementNosLocal[electrodeNo] = elementNoLocal;
+      ownerRankNos[electrodeNo] = rankSubset_->ownRankNo();
+    }
+  }
+
+  // every electrode is handled by the lowest rank that found it
+  MPIUtility::handleReturnValue(
+      MPI_Allreduce(MPI_IN_PLACE, ownerRankNos.data(), nElectrodes, MPI_INT,
+                    MPI_MIN, rankSubset_->mpiCommunicator()),
+      "MPI_Allreduce");
+
+  // the lead fields of a previous initialization are replaced
+  this->destroyLeadFields();
+
+  Vec transmembranePotential = data_.transmembranePotential()->valuesGlobal();
+  PetscInt nDofsGlobal;
+  PetscErrorCode ierr;
+  ierr = VecGetSize(transmembranePotential, &nDofsGlobal);
+  CHKERRV(ierr);
+
+  electrodeWeights_.resize(nElectrodes);
+  leadFields_.resize(nElectrodes);
+  Vec adjointSolution;
+  ierr = VecDuplicate(transmembranePotential, &adjointSolution);
+  CHKERRV(ierr);
+
+  for (int electrodeNo = 0; electrodeNo < nElectrodes; electrodeNo++) {
+    if (ownerRankNos[electrodeNo] == INT_MAX) {
+      LOG(WARNING) << specificSettings_ << "[\"leadFieldElectrodePositions\"]"
+                   << ": Electrode " << electrodeNo << " at "
+                   << leadFieldElectrodePositions_[electrodeNo]
+                   << " was not found in the mesh, its value will be 0.";
+    }
+
+    // set the interpolation weights of the electrode, w_j = phi_j(xi)
+    ierr =
+        VecDuplicate(transmembranePotential, &electrodeWeights_[electrodeNo]);
+    CHKERRV(ierr);
+    ierr = VecZeroEntries(electrodeWeights_[electrodeNo]);
+    CHKERRV(ierr);
+
+    if (ownerRankNos[electrodeNo] == rankSubset_->ownRankNo()) {
+      std::array<dof_no_t, nDofsPerElement> dofNosLocal =
+          functionSpace->getElementDofNosLocal(elementNosLocal[electrodeNo]);
+
+      std::array<PetscInt, nDofsPerElement> dofNosGlobalPetsc;
+      std::array<double, nDofsPerElement> weights;
+      for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++) {
+        dofNosGlobalPetsc[dofIndex] =
+            functionSpace->meshPartition()->getDofNoGlobalPetsc(
+                dofNosLocal[dofIndex]);
+        weights[dofIndex] = functionSpace->phi(dofIndex, xis[electrodeNo]);
+      }
+      ierr = VecSetValues(electrodeWeights_[electrodeNo], nDofsPerElement,
+                          dofNosGlobalPetsc.data(), weights.data(), ADD_VALUES);
+      CHKERRV(ierr);
+    }
+    ierr = VecAssemblyBegin(electrodeWeights_[electrodeNo]);
+    CHKERRV(ierr);
+    ierr = VecAssemblyEnd(electrodeWeights_[electrodeNo]);
+    CHKERRV(ierr);
+
+    // remove the constant part, such that the singular system can be solved,
+    // the potentials are then relative to the mean of phi_e
+    double weightsSum;
+    ierr = VecSum(electrodeWeights_[electrodeNo], &weightsSum);
+    CHKERRV(ierr);
+    ierr = VecShift(electrodeWeights_[electrodeNo], -weightsSum / nDofsGlobal);
+    CHKERRV(ierr);
+
+    // adjoint solve A^T z = w, A is symmetric
+    ierr = VecZeroEntries(adjointSolution);
+    CHKERRV(ierr);
+    ierr = KSPSetInitialGuessNonzero(*this->linearSolver_->ksp(), PETSC_FALSE);
+    CHKERRV(ierr);
+    this->linearSolver_->solve(electrodeWeights_[electrodeNo], adjointSolution,
+                               "Adjoint system for lead field solved");
+
+    // lead field L = R^T z
+    ierr = VecDuplicate(transmembranePotential, &leadFields_[electrodeNo]);
+    CHKERRV(ierr);
+    ierr = MatMultTranspose(data_.rhsMatrix(), adjointSolution,
+                            leadFields_[electrodeNo]);
+    CHKERRV(ierr);
+  }
+
+  ierr = VecDestroy(&adjointSolution);
+  CHKERRV(ierr);
+
+  // recreate and truncate the output file
+  if (rankSubset_->ownRankNo() == 0) {
+    std::ofstream file;
+    OutputWriter::Generic::openFile(file, leadFieldFilename_);
+    file.close();
+  }
+
+  LOG(INFO) << "Computed lead fields of " << nElectrodes << " electrodes.";
+}
+
+template <typename FiniteElementMethodPotentialFlow,
+          typename FiniteElementMethodDiffusion>
+void StaticBidomainSolver<
+    FiniteElementMethodPotentialFlow,
+    FiniteElementMethodDiffusion>::computeLeadFieldEmg() {
+  const int nElectrodes = leadFields_.size();
+  leadFieldEmgValues_.resize(nElectrodes);
+
+  // phi_e at the electrodes, L^T Vm for all electrodes at once
+  PetscErrorCode ierr;
+  ierr = VecMDot(data_.transmembranePotential()->valuesGlobal(), nElectrodes,
+                 leadFields_.data(), leadFieldEmgValues_.data());
+  CHKERRV(ierr);
+
+  // compare with the solution of the full system, w^T phi_e
+  if (leadFieldSolveFullSystem_) {
+    std::vector<double> fullSolveValues(nElectrodes);
+    ierr = VecMDot(data_.extraCellularPotential()->valuesGlobal(), nElectrodes,
+                   electrodeWeights_.data(), fullSolveValues.data());
+    CHKERRV(ierr);
+
+    double maximumDifference = 0;
+    for (int electrodeNo = 0; electrodeNo < nElectrodes; electrodeNo++) {
+      maximumDifference = std::max(maximumDifference,
+                                   fabs(fullSolveValues[electrodeNo] -
+                                        leadFieldEmgValues_[electrodeNo]));
+    }
+    LOG(INFO) << "Lead field EMG, maximum difference to full solve: "
+              << maximumDifference;
+  }
+
+  // write the values on rank 0
+  if (rankSubset_->ownRankNo() == 0) {
+    std::vector<double> geometry;
+    geometry.reserve(3 * nElectrodes);
+    for (const Vec3 &position : leadFieldElectrodePositions_)
+      geometry.insert(geometry.end(), position.begin(), position.end());
+
+    OutputWriter::OutputPoints::writeCsvFile(leadFieldFilename_, endTime_,
+                                             geometry, leadFieldEmgValues_);
+  }
+}
+
+template <typename FiniteElementMethodPotentialFlow,
+          typename FiniteElementMethodDiffusion>
+void StaticBidomainSolver<FiniteElementMethodPotentialFlow,
+                          FiniteElementMethodDiffusion>::destroyLeadFields() {
+  for (Vec &electrodeWeights : electrodeWeights_)
+    VecDestroy(&electrodeWeights);
+  for (Vec &leadField : leadFields_)
+    VecDestroy(&leadField);
+
+  electrodeWeights_.clear();
+  leadFields_.clear();
+}
+
+template <typename FiniteElementMethodPotentialFlow,
+          typename FiniteElementMethodDiffusion>
+const std::vector<double> &
+StaticBidomainSolver<FiniteElementMethodPotentialFlow,
+                     FiniteElementMethodDiffusion>::leadFieldEmgValues() const {
+  return leadFieldEmgValues_;
+}
+
 //! return whether the underlying discretizableInTime object has a specified
 //! mesh type and is not independent of the mesh type
 template <typename FiniteElementMethodPotentialFlow,
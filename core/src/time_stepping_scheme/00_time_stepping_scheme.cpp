@@ -5,8 +5,8 @@
 namespace TimeSteppingScheme {
 
 TimeSteppingScheme::TimeSteppingScheme(DihuContext context)
-    : Splittable(), context_(context), specificSettings_(NULL),
-      initialized_(false) {
+    : Splittable(), context_(context), durationLogKeyId_(-1),
+      specificSettings_(NULL), initialized_(false) {
   // specificSettings_ needs to be set by deriving class, in
   // time_stepping_scheme_ode.tpp
   isTimeStepWidthSignificant_ = false;
@@ -156,6 +156,14 @@ void TimeSteppingScheme::initialize() {
         specificSettings_.getOptionString("durationLogKey", "");
   }
 
+  // register the duration measurement such that it can be started and stopped
+  // without lookup of the key in every time step
+  if (this->durationLogKey_ != "") {
+    this->durationLogKeyId_ =
+        Control::PerformanceMeasurement::registerMeasurement(
+            this->durationLogKey_);
+  }
+
   timeStepOutputInterval_ = specificSettings_.getOptionInt(
       "timeStepOutputInterval", 100, PythonUtility::Positive);
 
@@ -97,6 +97,7 @@ protected:
                                // settings file
   std::string durationLogKey_; //< the key under which the duration of the time
                                // stepping is saved in the log
+  int durationLogKeyId_; //< handle of the duration measurement durationLogKey_
 
   PythonConfig specificSettings_; //< python object containing the value of the
                                   // python config dict with corresponding key
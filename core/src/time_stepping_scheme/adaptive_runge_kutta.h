@@ -0,0 +1,85 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "time_stepping_scheme/03_time_stepping_explicit.h"
+#include "time_stepping_scheme/step_width_controller.h"
+#include "interfaces/runnable.h"
+#include "data_management/time_stepping/time_stepping_multi_stage.h"
+#include "control/dihu_context.h"
+
+namespace TimeSteppingScheme {
+
+/** Explicit Runge-Kutta scheme with embedded error estimate and adaptive time
+ * step width. The embedded pair is selected by the option "method":
+ *
+ *  "HeunEuler":       orders 2(1), 2 stages
+ *  "BogackiShampine": orders 3(2), 4 stages, first same as last (FSAL)
+ *  "DormandPrince":   orders 5(4), 7 stages, FSAL
+ *
+ *  The solution is advanced with the higher order solution, the difference to
+ * the lower order solution is the error estimate. The time step width is
+ * computed by a PI controller (StepWidthController), rejected steps are
+ * repeated with a smaller width. The error norm is reduced over all ranks of
+ * the solution vector with a nonblocking allreduce, such that all ranks take
+ * the same steps. While the reduction is in progress, the right hand side of
+ * the new solution is computed, which is needed for the next step if the step
+ * gets accepted.
+ *
+ *  The initial time step width is given by "timeStepWidth" or
+ * "numberTimeSteps", afterwards the last width of the previous call to
+ * advanceTimeSpan is used.
+ */
+template <typename DiscretizableInTime>
+class AdaptiveRungeKutta : public TimeSteppingExplicit<DiscretizableInTime>,
+                           public Runnable {
+public:
+  //! constructor
+  AdaptiveRungeKutta(DihuContext context);
+
+  //! initialize the data object
+  virtual void initialize();
+
+  //! advance simulation by the given time span [startTime_, endTime_] with
+  //! adaptive time step widths, data in solution is used, afterwards new data
+  //! is in solution
+  void advanceTimeSpan(bool withOutputWritersEnabled = true);
+
+  //! run the simulation
+  void run();
+
+  //! the time step width that will be used for the next step
+  double adaptiveTimeStepWidth() const;
+
+  //! the controller of the time step width, which counts the accepted and
+  //! rejected steps of the last call to advanceTimeSpan
+  std::shared_ptr<StepWidthController> stepWidthController();
+
+protected:
+  //! set the Butcher tableau of the method given by name
+  void setButcherTableau(std::string method);
+
+  //! compute the local sum of squared scaled errors
+  double computeLocalErrorSum(Vec &solution, Vec &newSolution, Vec &error);
+
+  int nStages_; //< number of stages of the method
+  std::vector<std::vector<double>> a_; //< coefficients of the stages
+  std::vector<double> b_;     //< weights of the higher order solution
+  std::vector<double> bHat_;  //< weights of the lower order solution
+  std::vector<double> c_;     //< relative times of the stages
+  int order_;                 //< order of the lower order solution
+  bool isFirstSameAsLast_;    //< if the last stage is f of the new solution
+
+  std::shared_ptr<StepWidthController>
+      stepWidthController_; //< the PI controller of the time step width
+  double adaptiveTimeStepWidth_; //< the current time step width, -1 before
+                                 // the first call to advanceTimeSpan
+  int hasDirichletBoundaryConditions_; //< if there are Dirichlet boundary
+                                       // conditions on any rank, -1 if not
+                                       // yet determined
+};
+
+} // namespace TimeSteppingScheme
+
+#include "time_stepping_scheme/adaptive_runge_kutta.tpp"
@@ -0,0 +1,332 @@
+#include "time_stepping_scheme/adaptive_runge_kutta.h"
+
+#include <Python.h>
+#include <memory>
+#include <cmath>
+#include <algorithm>
+#include "utility/python_utility.h"
+#include "utility/petsc_utility.h"
+
+namespace TimeSteppingScheme {
+
+template <typename DiscretizableInTime>
+AdaptiveRungeKutta<DiscretizableInTime>::AdaptiveRungeKutta(
+    DihuContext context)
+    : TimeSteppingExplicit<DiscretizableInTime>(context, "AdaptiveRungeKutta"),
+      adaptiveTimeStepWidth_(-1), hasDirichletBoundaryConditions_(-1) {}
+
+template <typename DiscretizableInTime>
+void AdaptiveRungeKutta<DiscretizableInTime>::initialize() {
+  LOG_SCOPE_FUNCTION;
+
+  LOG(TRACE) << "AdaptiveRungeKutta::initialize";
+
+  std::string method =
+      this->specificSettings_.getOptionString("method", "DormandPrince");
+  setButcherTableau(method);
+
+  // create data object with one vector per stage and two vectors for the new
+  // solution and the error estimate
+  this->data_ = std::make_shared<Data::TimeSteppingMultiStage<
+      typename DiscretizableInTime::FunctionSpace,
+      DiscretizableInTime::nComponents()>>(this->context_, nStages_ + 2);
+
+  // initialize already writes the first output file
+  TimeSteppingSchemeOde<DiscretizableInTime>::initialize();
+
+  stepWidthController_ =
+      std::make_shared<StepWidthController>(this->specificSettings_, order_);
+}
+
+template <typename DiscretizableInTime>
+void AdaptiveRungeKutta<DiscretizableInTime>::setButcherTableau(
+    std::string method) {
+  if (method == "HeunEuler") {
+    c_ = {0, 1};
+    a_ = {{}, {1}};
+    b_ = {1. / 2, 1. / 2};
+    bHat_ = {1, 0};
+    order_ = 1;
+    isFirstSameAsLast_ = false;
+  } else if (method == "BogackiShampine") {
+    c_ = {0, 1. / 2, 3. / 4, 1};
+    a_ = {{}, {1. / 2}, {0, 3. / 4}, {2. / 9, 1. / 3, 4. / 9}};
+    b_ = {2. / 9, 1. / 3, 4. / 9, 0};
+    bHat_ = {7. / 24, 1. / 4, 1. / 3, 1. / 8};
+    order_ = 2;
+    isFirstSameAsLast_ = true;
+  } else {
+    if (method != "DormandPrince") {
+      LOG(ERROR) << this->specificSettings_ << "[\"method\"] is \"" << method
+                 << "\", but only \"HeunEuler\", \"BogackiShampine\" and "
+                 << "\"DormandPrince\" are possible. Using \"DormandPrince\".";
+    }
+    c_ = {0, 1. / 5, 3. / 10, 4. / 5, 8. / 9, 1, 1};
+    a_ = {{},
+          {1. / 5},
+          {3. / 40, 9. / 40},
+          {44. / 45, -56. / 15, 32. / 9},
+          {19372. / 6561, -25360. / 2187, 64448. / 6561, -212. / 729},
+          {9017. / 3168, -355. / 33, 46732. / 5247, 49. / 176,
+           -5103. / 18656},
+          {35. / 384, 0, 500. / 1113, 125. / 192, -2187. / 6784, 11. / 84}};
+    b_ = {35. / 384, 0, 500. / 1113, 125. / 192, -2187. / 6784, 11. / 84, 0};
+    bHat_ = {5179. / 57600,    0,           7571. / 16695, 393. / 640,
+             -92097. / 339200, 187. / 2100, 1. / 40};
+    order_ = 4;
+    isFirstSameAsLast_ = true;
+  }
+  nStages_ = c_.size();
+}
+
+template <typename DiscretizableInTime>
+double AdaptiveRungeKutta<DiscretizableInTime>::computeLocalErrorSum(
+    Vec &solution, Vec &newSolution, Vec &error) {
+  const double relativeTolerance = stepWidthController_->relativeTolerance();
+  const double absoluteTolerance = stepWidthController_->absoluteTolerance();
+
+  const double *solutionValues, *newSolutionValues, *errorValues;
+  PetscInt nValuesLocal;
+  VecGetLocalSize(error, &nValuesLocal);
+  VecGetArrayRead(solution, &solutionValues);
+  VecGetArrayRead(newSolution, &newSolutionValues);
+  VecGetArrayRead(error, &errorValues);
+
+  double sum = 0;
+  for (PetscInt i = 0; i < nValuesLocal; i++) {
+    double magnitude = std::max(std::fabs(solutionValues[i]),
+                                std::fabs(newSolutionValues[i]));
+    double scale = absoluteTolerance + relativeTolerance * magnitude;
+    double scaledError = errorValues[i] / scale;
+    sum += scaledError * scaledError;
+  }
+
+  VecRestoreArrayRead(solution, &solutionValues);
+  VecRestoreArrayRead(newSolution, &newSolutionValues);
+  VecRestoreArrayRead(error, &errorValues);
+
+  return sum;
+}
+
+template <typename DiscretizableInTime>
+void AdaptiveRungeKutta<DiscretizableInTime>::advanceTimeSpan(
+    bool withOutputWritersEnabled) {
+  LOG_SCOPE_FUNCTION;
+
+  // start duration measurement, the name of the output variable can be set by
+  // "durationLogKey" in the config
+  if (this->durationLogKey_ != "")
+    Control::PerformanceMeasurement::start(this->durationLogKeyId_);
+
+  // compute timestep width
+  double timeSpan = this->endTime_ - this->startTime_;
+
+  // on the first call, start with the time step width from the settings
+  if (adaptiveTimeStepWidth_ <= 0)
+    adaptiveTimeStepWidth_ = this->timeStepWidth_;
+
+  LOG(DEBUG) << "AdaptiveRungeKutta::advanceTimeSpan, timeSpan=" << timeSpan
+             << ", initial timeStepWidth=" << adaptiveTimeStepWidth_;
+
+  // cast the pointer type to the derived class to get the stage vectors
+  std::shared_ptr<Data::TimeSteppingMultiStage<
+      typename DiscretizableInTime::FunctionSpace,
+      DiscretizableInTime::nComponents()>>
+      dataMultiStage = std::static_pointer_cast<Data::TimeSteppingMultiStage<
+          typename DiscretizableInTime::FunctionSpace,
+          DiscretizableInTime::nComponents()>>(this->data_);
+
+  // get vectors of all components in struct-of-array order, as needed by CellML
+  // (i.e. one long vector with [state0 state0 state0 ... state1 state1...]
+  Vec &solution = this->data_->solution()->getValuesContiguous();
+  std::vector<Vec> stageIncrements(nStages_);
+  for (int stageNo = 0; stageNo < nStages_; stageNo++)
+    stageIncrements[stageNo] =
+        dataMultiStage->stage(stageNo)->getValuesContiguous();
+  Vec &newSolution = dataMultiStage->stage(nStages_)->getValuesContiguous();
+  Vec &error = dataMultiStage->stage(nStages_ + 1)->getValuesContiguous();
+
+  // the error is reduced over the ranks that share the solution vector
+  MPI_Comm communicator;
+  PetscObjectGetComm((PetscObject)solution, &communicator);
+
+  // with Dirichlet boundary conditions, the new solution is changed after the
+  // step, then f(new solution) cannot be reused for the next step
+  if (hasDirichletBoundaryConditions_ == -1) {
+    int hasLocalDirichletBoundaryConditions =
+        this->dirichletBoundaryConditions_ &&
+        !this->dirichletBoundaryConditions_
+             ->boundaryConditionNonGhostDofLocalNos()
+             .empty();
+    MPI_Allreduce(&hasLocalDirichletBoundaryConditions,
+                  &hasDirichletBoundaryConditions_, 1, MPI_INT, MPI_LOR,
+                  communicator);
+  }
+  const bool isRightHandSideReused = !hasDirichletBoundaryConditions_;
+
+  std::vector<double> coefficients(nStages_);
+  stepWidthController_->resetStatistics();
+
+  // loop over time steps
+  double currentTime = this->startTime_;
+  bool isFirstStageValid = false; // if stageIncrements[0] contains f(u_{t})
+  int timeStepNo = 0;
+  while (currentTime < this->endTime_ - 1e-12 * timeSpan) {
+    // do not step over the end of the time span, avoid a tiny last step
+    double timeStepWidth = adaptiveTimeStepWidth_;
+    bool isLastStep = false;
+    if (currentTime + 1.01 * timeStepWidth >= this->endTime_) {
+      timeStepWidth = this->endTime_ - currentTime;
+      isLastStep = true;
+    }
+
+    VLOG(1) << "starting from solution (" << this->data_->solution()
+            << "): " << *this->data_->solution() << ", dt=" << timeStepWidth;
+
+    // compute the stages k_i = f(u_{t} + dt*sum_j a_ij*k_j)
+    if (!isFirstStageValid) {
+      this->discretizableInTime_.evaluateTimesteppingRightHandSideExplicit(
+          solution, stageIncrements[0], timeStepNo, currentTime);
+    }
+    for (int stageNo = 1; stageNo < nStages_; stageNo++) {
+      for (int j = 0; j < stageNo; j++)
+        coefficients[j] = timeStepWidth * a_[stageNo][j];
+
+      VecCopy(solution, newSolution);
+      VecMAXPY(newSolution, stageNo, coefficients.data(),
+               stageIncrements.data());
+
+      this->discretizableInTime_.evaluateTimesteppingRightHandSideExplicit(
+          newSolution, stageIncrements[stageNo], timeStepNo,
+          currentTime + c_[stageNo] * timeStepWidth);
+    }
+
+    // new solution u_{t+1} = u_{t} + dt*sum_j b_j*k_j
+    for (int j = 0; j < nStages_; j++)
+      coefficients[j] = timeStepWidth * b_[j];
+    VecCopy(solution, newSolution);
+    VecMAXPY(newSolution, nStages_, coefficients.data(),
+             stageIncrements.data());
+
+    // error estimate dt*sum_j (b_j - bHat_j)*k_j
+    for (int j = 0; j < nStages_; j++)
+      coefficients[j] = timeStepWidth * (b_[j] - bHat_[j]);
+    VecSet(error, 0.0);
+    VecMAXPY(error, nStages_, coefficients.data(), stageIncrements.data());
+
+    // start the reduction of the error norm over the ranks
+    PetscInt nValuesLocal;
+    VecGetLocalSize(error, &nValuesLocal);
+    double localErrorSum[2] = {computeLocalErrorSum(solution, newSolution,
+                                                    error),
+                               (double)nValuesLocal};
+    double globalErrorSum[2];
+    MPI_Request request;
+    MPI_Iallreduce(localErrorSum, globalErrorSum, 2, MPI_DOUBLE, MPI_SUM,
+                   communicator, &request);
+
+    // meanwhile compute f(u_{t+1}) that will be the first stage of the next
+    // step if this step gets accepted. For FSAL methods, this is the last
+    // stage. If the step gets rejected, the first stage is still f(u_{t}).
+    int nextFirstStageNo = nStages_ - 1;
+    if (!isFirstSameAsLast_ && isRightHandSideReused) {
+      nextFirstStageNo = 1;
+      this->discretizableInTime_.evaluateTimesteppingRightHandSideExplicit(
+          newSolution, stageIncrements[nextFirstStageNo], timeStepNo + 1,
+          currentTime + timeStepWidth);
+    }
+
+    MPI_Wait(&request, MPI_STATUS_IGNORE);
+    double errorNorm = 0;
+    if (globalErrorSum[1] > 0)
+      errorNorm = std::sqrt(globalErrorSum[0] / globalErrorSum[1]);
+
+    // decide if the step is accepted and compute the next time step width
+    double nextTimeStepWidth = timeStepWidth;
+    bool isAccepted =
+        stepWidthController_->adaptTimeStepWidth(errorNorm, nextTimeStepWidth);
+
+    // a shortened last step should not reduce the width for the next time
+    // span
+    if (isLastStep && isAccepted)
+      adaptiveTimeStepWidth_ =
+          std::max(adaptiveTimeStepWidth_, nextTimeStepWidth);
+    else
+      adaptiveTimeStepWidth_ = nextTimeStepWidth;
+
+    if (!isAccepted) {
+      VLOG(1) << "step rejected, error norm: " << errorNorm;
+      isFirstStageValid = true;
+      continue;
+    }
+
+    // accept the step
+    VecCopy(newSolution, solution);
+    if (isRightHandSideReused) {
+      std::swap(stageIncrements[0], stageIncrements[nextFirstStageNo]);
+      isFirstStageValid = true;
+    } else {
+      isFirstStageValid = false;
+    }
+
+    // apply the prescribed boundary condition values
+    this->applyBoundaryConditions();
+
+    VLOG(1) << "final solution (" << this->data_->solution()
+            << "): " << *this->data_->solution();
+
+    // check if the solution contains Nans or Inf values
+    this->checkForNanInf(timeStepNo, currentTime);
+
+    // advance simulation time
+    timeStepNo++;
+    currentTime = isLastStep ? this->endTime_ : currentTime + timeStepWidth;
+
+    if (timeStepNo % this->timeStepOutputInterval_ == 0) {
+      LOG(INFO) << "AdaptiveRungeKutta, timestep " << timeStepNo
+                << ", t=" << currentTime << ", dt=" << timeStepWidth
+                << ", error norm: " << errorNorm;
+    }
+
+    // stop duration measurement
+    if (this->durationLogKey_ != "")
+      Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
+
+    // write current output values
+    if (withOutputWritersEnabled)
+      this->outputWriterManager_.writeOutput(*this->data_, timeStepNo,
+                                             currentTime);
+
+    // start duration measurement
+    if (this->durationLogKey_ != "")
+      Control::PerformanceMeasurement::start(this->durationLogKeyId_);
+  }
+
+  LOG(DEBUG) << "AdaptiveRungeKutta: " << stepWidthController_->nAcceptedSteps()
+             << " accepted and " << stepWidthController_->nRejectedSteps()
+             << " rejected steps in [" << this->startTime_ << ","
+             << this->endTime_ << "], next dt: " << adaptiveTimeStepWidth_;
+
+  // stop duration measurement
+  if (this->durationLogKey_ != "")
+    Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
+}
+
+template <typename DiscretizableInTime>
+void AdaptiveRungeKutta<DiscretizableInTime>::run() {
+  TimeSteppingSchemeOde<DiscretizableInTime>::run();
+}
+
+template <typename DiscretizableInTime>
+double
+AdaptiveRungeKutta<DiscretizableInTime>::adaptiveTimeStepWidth() const {
+  return adaptiveTimeStepWidth_;
+}
+
+template <typename DiscretizableInTime>
+std::shared_ptr<StepWidthController>
+AdaptiveRungeKutta<DiscretizableInTime>::stepWidthController() {
+  return stepWidthController_;
+}
+
+} // namespace TimeSteppingScheme
@@ -21,7 +21,7 @@ void CrankNicolson<DiscretizableInTimeType>::advanceTimeSpan(
   // start duration measurement, the name of the output variable can be set by
   // "durationLogKey" in the config
   if (this->durationLogKey_ != "")
-    Control::PerformanceMeasurement::start(this->durationLogKey_);
+    Control::PerformanceMeasurement::start(this->durationLogKeyId_);
 
   // compute timestep width
   double timeSpan = this->endTime_ - this->startTime_;
@@ -76,7 +76,7 @@ void CrankNicolson<DiscretizableInTimeType>::advanceTimeSpan(
 
     // stop duration measurement
     if (this->durationLogKey_ != "")
-      Control::PerformanceMeasurement::stop(this->durationLogKey_);
+      Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
 
     // write current output values
     if (withOutputWritersEnabled)
@@ -85,14 +85,14 @@ void CrankNicolson<DiscretizableInTimeType>::advanceTimeSpan(
 
     // start duration measurement
     if (this->durationLogKey_ != "")
-      Control::PerformanceMeasurement::start(this->durationLogKey_);
+      Control::PerformanceMeasurement::start(this->durationLogKeyId_);
 
     // this->data_->print();
   }
 
   // stop duration measurement
   if (this->durationLogKey_ != "")
-    Control::PerformanceMeasurement::stop(this->durationLogKey_);
+    Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
 }
 
 template <typename DiscretizableInTimeType>
@@ -33,7 +33,7 @@ void Heun<DiscretizableInTime>::advanceTimeSpan(bool withOutputWritersEnabled) {
   // start duration measurement, the name of the output variable can be set by
   // "durationLogKey" in the config
   if (this->durationLogKey_ != "")
-    Control::PerformanceMeasurement::start(this->durationLogKey_);
+    Control::PerformanceMeasurement::start(this->durationLogKeyId_);
 
   // compute timestep width
   double timeSpan = this->endTime_ - this->startTime_;
@@ -121,7 +121,7 @@ void Heun<DiscretizableInTime>::advanceTimeSpan(bool withOutputWritersEnabled) {
 
     // stop duration measurement
     if (this->durationLogKey_ != "")
-      Control::PerformanceMeasurement::stop(this->durationLogKey_);
+      Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
 
     // write current output values
     if (withOutputWritersEnabled)
@@ -130,12 +130,12 @@ void Heun<DiscretizableInTime>::advanceTimeSpan(bool withOutputWritersEnabled) {
 
     // start duration measurement
     if (this->durationLogKey_ != "")
-      Control::PerformanceMeasurement::start(this->durationLogKey_);
+      Control::PerformanceMeasurement::start(this->durationLogKeyId_);
   }
 
   // stop duration measurement
   if (this->durationLogKey_ != "")
-    Control::PerformanceMeasurement::stop(this->durationLogKey_);
+    Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
 }
 
 template <typename DiscretizableInTime> void Heun<DiscretizableInTime>::run() {
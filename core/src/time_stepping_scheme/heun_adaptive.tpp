@@ -99,7 +99,7 @@ void HeunAdaptive<DiscretizableInTime>::advanceTimeSpan(
   // start duration measurement, the name of the output variable can be set by
   // "durationLogKey" in the config
   if (this->durationLogKey_ != "")
-    Control::PerformanceMeasurement::start(this->durationLogKey_);
+    Control::PerformanceMeasurement::start(this->durationLogKeyId_);
 
   // compute timeSpan of current step
   double timeSpan = this->endTime_ - this->startTime_;
@@ -423,7 +423,7 @@ void HeunAdaptive<DiscretizableInTime>::advanceTimeSpan(
 
       // stop duration measurement
       if (this->durationLogKey_ != "")
-        Control::PerformanceMeasurement::stop(this->durationLogKey_);
+        Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
 
       // log timestep width
       if (!timeStepWidthsLogFilename_.empty()) {
@@ -438,7 +438,7 @@ void HeunAdaptive<DiscretizableInTime>::advanceTimeSpan(
 
       // start duration measurement
       if (this->durationLogKey_ != "")
-        Control::PerformanceMeasurement::start(this->durationLogKey_);
+        Control::PerformanceMeasurement::start(this->durationLogKeyId_);
     }
   } else if (timeStepAdaptOption_ == "modified") // modified option was chosen
   {
@@ -618,7 +618,7 @@ void HeunAdaptive<DiscretizableInTime>::advanceTimeSpan(
 
       // stop duration measurement
       if (this->durationLogKey_ != "")
-        Control::PerformanceMeasurement::stop(this->durationLogKey_);
+        Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
 
       if (!timeStepWidthsLogFilename_.empty()) {
         // log timestep width
@@ -633,7 +633,7 @@ void HeunAdaptive<DiscretizableInTime>::advanceTimeSpan(
 
       // start duration measurement
       if (this->durationLogKey_ != "")
-        Control::PerformanceMeasurement::start(this->durationLogKey_);
+        Control::PerformanceMeasurement::start(this->durationLogKeyId_);
     }
   }
 
@@ -659,7 +659,7 @@ void HeunAdaptive<DiscretizableInTime>::advanceTimeSpan(
 
   // stop duration measurement
   if (this->durationLogKey_ != "")
-    Control::PerformanceMeasurement::stop(this->durationLogKey_);
+    Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
 }
 
 template <typename DiscretizableInTime>
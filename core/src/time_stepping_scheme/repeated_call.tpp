@@ -44,7 +44,7 @@ void RepeatedCall<Solver>::advanceTimeSpan(bool withOutputWritersEnabled) {
   // start duration measurement, the name of the output variable can be set by
   // "durationLogKey" in the config
   if (this->durationLogKey_ != "")
-    Control::PerformanceMeasurement::start(this->durationLogKey_);
+    Control::PerformanceMeasurement::start(this->durationLogKeyId_);
 
   // compute timestep width
   double timeSpan = this->endTime_ - this->startTime_;
@@ -79,7 +79,7 @@ void RepeatedCall<Solver>::advanceTimeSpan(bool withOutputWritersEnabled) {
 
   // stop duration measurement
   if (this->durationLogKey_ != "")
-    Control::PerformanceMeasurement::stop(this->durationLogKey_);
+    Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
 }
 
 template <typename Solver> void RepeatedCall<Solver>::run() {
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <vector>
+
+#include "time_stepping_scheme/03_time_stepping_explicit.h"
+#include "interfaces/runnable.h"
+#include "data_management/time_stepping/time_stepping_multi_stage.h"
+#include "control/dihu_context.h"
+
+namespace TimeSteppingScheme {
+
+/** The second order Runge-Kutta-Chebyshev (RKC) scheme by Sommeijer, Shampine
+ * and Verwer (1997), an explicit scheme for mildly stiff problems like
+ * diffusion. With s stages, the stability region along the negative real axis
+ * is approximately [-0.65*s^2, 0], i.e. it grows quadratically with the number
+ * of right hand side evaluations per time step. Therefore, a time step width
+ * that would be unstable with Heun can be used with only a few stages.
+ *
+ *  The number of stages is either given fixed by "nStages" or computed from
+ * the spectral radius of the Jacobian of the right hand side, which is either
+ * given by "spectralRadius" or estimated by a nonlinear power iteration.
+ *
+ *  The stages are computed by the three-term recursion
+ *
+ *  Y_0 = u_{t},  Y_1 = Y_0 + mu~_1*dt*f(Y_0)
+ *  Y_j = (1-mu_j-nu_j)*Y_0 + mu_j*Y_{j-1} + nu_j*Y_{j-2}
+ *        + mu~_j*dt*f(Y_{j-1}) + gamma~_j*dt*f(Y_0),   j=2,...,s
+ *  u_{t+1} = Y_s
+ *
+ *  such that only three additional vectors are needed, independent of s.
+ */
+template <typename DiscretizableInTime>
+class RungeKuttaChebyshev : public TimeSteppingExplicit<DiscretizableInTime>,
+                            public Runnable {
+public:
+  //! constructor
+  RungeKuttaChebyshev(DihuContext context);
+
+  //! initialize the data object
+  virtual void initialize();
+
+  //! advance simulation by the given time span [startTime_, endTime_] with
+  //! given numberTimeSteps, data in solution is used, afterwards new data is in
+  //! solution
+  void advanceTimeSpan(bool withOutputWritersEnabled = true);
+
+  //! run the simulation
+  void run();
+
+protected:
+  //! estimate the spectral radius of the Jacobian of the right hand side at
+  //! the current solution by a nonlinear power iteration, needs f(u_{t}) in
+  //! rightHandSide
+  double estimateSpectralRadius(Vec &solution, Vec &rightHandSide,
+                                Vec &temporary, Vec &increment, int timeStepNo,
+                                double currentTime);
+
+  //! compute the number of stages for the current spectral radius and the
+  //! coefficients of the scheme, if the number of stages changed
+  void computeCoefficients();
+
+  int nStagesSetting_; //< the fixed number of stages, 0 if it is computed
+  double damping_;     //< damping parameter epsilon of the stability polynomial
+  double spectralRadiusSetting_; //< the given spectral radius, 0 if estimated
+  int spectralRadiusUpdateInterval_; //< every this number of time steps the
+                                     // spectral radius is estimated again, 0
+                                     // means only once at the beginning
+  double spectralRadius_;  //< the current spectral radius
+  bool spectralRadiusValid_; //< if spectralRadius_ has already been estimated
+  int nStages_;            //< the current number of stages s
+  std::vector<double> mu_, nu_, muTilde_, gammaTilde_,
+      c_; //< coefficients of the stages, indexed by stage number j=0,...,s,
+          // c_ are the relative times of the stages in the time step
+};
+
+} // namespace TimeSteppingScheme
+
+#include "time_stepping_scheme/runge_kutta_chebyshev.tpp"
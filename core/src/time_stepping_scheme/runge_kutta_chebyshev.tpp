@@ -0,0 +1,319 @@
+#include "time_stepping_scheme/runge_kutta_chebyshev.h"
+
+#include <Python.h>
+#include <memory>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "utility/python_utility.h"
+#include "utility/petsc_utility.h"
+
+namespace TimeSteppingScheme {
+
+template <typename DiscretizableInTime>
+RungeKuttaChebyshev<DiscretizableInTime>::RungeKuttaChebyshev(
+    DihuContext context)
+    : TimeSteppingExplicit<DiscretizableInTime>(context,
+                                                "RungeKuttaChebyshev") {}
+
+template <typename DiscretizableInTime>
+void RungeKuttaChebyshev<DiscretizableInTime>::initialize() {
+  LOG_SCOPE_FUNCTION;
+
+  LOG(TRACE) << "RungeKuttaChebyshev::initialize";
+
+  // create data object with three stage vectors for Y_0, f(Y_0) and one more
+  // stage Y_j
+  this->data_ = std::make_shared<Data::TimeSteppingMultiStage<
+      typename DiscretizableInTime::FunctionSpace,
+      DiscretizableInTime::nComponents()>>(this->context_, 3);
+
+  // initialize already writes the first output file
+  TimeSteppingSchemeOde<DiscretizableInTime>::initialize();
+
+  // parse options
+  nStagesSetting_ = this->specificSettings_.getOptionInt(
+      "nStages", 0, PythonUtility::NonNegative);
+  damping_ = this->specificSettings_.getOptionDouble(
+      "damping", 2. / 13, PythonUtility::NonNegative);
+  spectralRadiusSetting_ = this->specificSettings_.getOptionDouble(
+      "spectralRadius", 0.0, PythonUtility::NonNegative);
+  spectralRadiusUpdateInterval_ = this->specificSettings_.getOptionInt(
+      "spectralRadiusUpdateInterval", 0, PythonUtility::NonNegative);
+
+  spectralRadius_ = spectralRadiusSetting_;
+  spectralRadiusValid_ = spectralRadiusSetting_ > 0;
+  nStages_ = 0;
+
+  if (nStagesSetting_ == 1) {
+    LOG(WARNING) << this->specificSettings_
+                 << "[\"nStages\"] is 1, but at least 2 stages are needed. "
+                 << "Using 2 stages.";
+  }
+}
+
+template <typename DiscretizableInTime>
+void RungeKuttaChebyshev<DiscretizableInTime>::computeCoefficients() {
+  // determine number of stages, such that the stability region with
+  // beta(s) ~ 0.65*s^2 contains the scaled spectral radius dt*rho
+  int nStages = nStagesSetting_;
+  if (nStages == 0) {
+    nStages =
+        1 + (int)std::sqrt(1.0 + 1.54 * this->timeStepWidth_ * spectralRadius_);
+  }
+  nStages = std::max(2, nStages);
+
+  // the coefficients only depend on the number of stages and the damping
+  if (nStages == nStages_)
+    return;
+
+  nStages_ = nStages;
+  const int s = nStages_;
+
+  // evaluate the Chebyshev polynomials T_j and their first and second
+  // derivatives at w0
+  const double w0 = 1.0 + damping_ / (s * s);
+  std::vector<double> t(s + 1), dT(s + 1), ddT(s + 1);
+  t[0] = 1.0;
+  t[1] = w0;
+  dT[0] = 0.0;
+  dT[1] = 1.0;
+  ddT[0] = 0.0;
+  ddT[1] = 0.0;
+  for (int j = 2; j <= s; j++) {
+    t[j] = 2 * w0 * t[j - 1] - t[j - 2];
+    dT[j] = 2 * t[j - 1] + 2 * w0 * dT[j - 1] - dT[j - 2];
+    ddT[j] = 4 * dT[j - 1] + 2 * w0 * ddT[j - 1] - ddT[j - 2];
+  }
+  const double w1 = dT[s] / ddT[s];
+
+  // b_j = T_j''(w0) / T_j'(w0)^2, b_0 = b_1 = b_2
+  std::vector<double> b(s + 1);
+  for (int j = 2; j <= s; j++)
+    b[j] = ddT[j] / (dT[j] * dT[j]);
+  b[0] = b[1] = b[2];
+
+  mu_.assign(s + 1, 0.0);
+  nu_.assign(s + 1, 0.0);
+  muTilde_.assign(s + 1, 0.0);
+  gammaTilde_.assign(s + 1, 0.0);
+  c_.assign(s + 1, 0.0);
+
+  muTilde_[1] = b[1] * w1;
+  c_[1] = muTilde_[1];
+  for (int j = 2; j <= s; j++) {
+    double aPrevious = 1.0 - b[j - 1] * t[j - 1];
+    mu_[j] = 2 * w0 * b[j] / b[j - 1];
+    nu_[j] = -b[j] / b[j - 2];
+    muTilde_[j] = 2 * w1 * b[j] / b[j - 1];
+    gammaTilde_[j] = -aPrevious * muTilde_[j];
+
+    // the stage times follow from the same recursion applied to f = 1
+    c_[j] = mu_[j] * c_[j - 1] + nu_[j] * c_[j - 2] + muTilde_[j] +
+            gammaTilde_[j];
+  }
+
+  LOG(DEBUG) << "RungeKuttaChebyshev: dt=" << this->timeStepWidth_
+             << ", spectral radius: " << spectralRadius_
+             << ", number of stages: " << nStages_;
+}
+
+template <typename DiscretizableInTime>
+double RungeKuttaChebyshev<DiscretizableInTime>::estimateSpectralRadius(
+    Vec &solution, Vec &rightHandSide, Vec &temporary, Vec &increment,
+    int timeStepNo, double currentTime) {
+  // nonlinear power iteration: repeatedly apply the Jacobian to a small
+  // perturbation v-u_{t}, approximated by f(v) - f(u_{t})
+  const int maxIterations = 50;
+  const double sqrtEpsilon = std::sqrt(std::numeric_limits<double>::epsilon());
+
+  PetscReal solutionNorm, directionNorm;
+  VecNorm(solution, NORM_2, &solutionNorm);
+  VecNorm(rightHandSide, NORM_2, &directionNorm);
+
+  double perturbationNorm = sqrtEpsilon;
+  if (solutionNorm > 0)
+    perturbationNorm *= solutionNorm;
+
+  // start with the direction of f(u_{t}), or a constant vector if it is zero
+  if (directionNorm > 0) {
+    VecCopy(rightHandSide, temporary);
+  } else {
+    VecSet(temporary, 1.0);
+    VecNorm(temporary, NORM_2, &directionNorm);
+  }
+
+  // v = u_{t} + perturbationNorm * direction / |direction|
+  VecAXPBY(temporary, 1.0, perturbationNorm / directionNorm, solution);
+
+  double sigma = 0;
+  int iterationNo = 0;
+  for (; iterationNo < maxIterations; iterationNo++) {
+    // compute f(v) - f(u_{t})
+    this->discretizableInTime_.evaluateTimesteppingRightHandSideExplicit(
+        temporary, increment, timeStepNo, currentTime);
+    VecAXPY(increment, -1.0, rightHandSide);
+
+    PetscReal differenceNorm;
+    VecNorm(increment, NORM_2, &differenceNorm);
+
+    double sigmaPrevious = sigma;
+    sigma = differenceNorm / perturbationNorm;
+
+    if (differenceNorm == 0)
+      break;
+
+    if (iterationNo > 0 && std::fabs(sigma - sigmaPrevious) <= 0.01 * sigma)
+      break;
+
+    // v = u_{t} + perturbationNorm * (f(v) - f(u_{t})) / |f(v) - f(u_{t})|
+    VecWAXPY(temporary, perturbationNorm / differenceNorm, increment,
+             solution);
+  }
+
+  LOG(DEBUG) << "RungeKuttaChebyshev: estimated spectral radius " << sigma
+             << " after " << iterationNo + 1 << " iterations";
+
+  // add a safety margin
+  return 1.2 * sigma;
+}
+
+template <typename DiscretizableInTime>
+void RungeKuttaChebyshev<DiscretizableInTime>::advanceTimeSpan(
+    bool withOutputWritersEnabled) {
+  LOG_SCOPE_FUNCTION;
+
+  // start duration measurement, the name of the output variable can be set by
+  // "durationLogKey" in the config
+  if (this->durationLogKey_ != "")
+    Control::PerformanceMeasurement::start(this->durationLogKeyId_);
+
+  // compute timestep width
+  double timeSpan = this->endTime_ - this->startTime_;
+
+  LOG(DEBUG) << "RungeKuttaChebyshev::advanceTimeSpan, timeSpan=" << timeSpan
+             << ", timeStepWidth=" << this->timeStepWidth_
+             << " n steps: " << this->numberTimeSteps_;
+
+  // cast the pointer type to the derived class to get the stage vectors
+  std::shared_ptr<Data::TimeSteppingMultiStage<
+      typename DiscretizableInTime::FunctionSpace,
+      DiscretizableInTime::nComponents()>>
+      dataMultiStage = std::static_pointer_cast<Data::TimeSteppingMultiStage<
+          typename DiscretizableInTime::FunctionSpace,
+          DiscretizableInTime::nComponents()>>(this->data_);
+
+  // get vectors of all components in struct-of-array order, as needed by CellML
+  // (i.e. one long vector with [state0 state0 state0 ... state1 state1...]
+  Vec &solution = this->data_->solution()->getValuesContiguous();
+  Vec &increment = this->data_->increment()->getValuesContiguous();
+  Vec &initialSolution = dataMultiStage->stage(0)->getValuesContiguous();
+  Vec &initialRightHandSide = dataMultiStage->stage(1)->getValuesContiguous();
+  Vec &stageBuffer = dataMultiStage->stage(2)->getValuesContiguous();
+
+  const double dt = this->timeStepWidth_;
+  const bool isSpectralRadiusEstimated =
+      nStagesSetting_ == 0 && spectralRadiusSetting_ == 0;
+
+  // loop over time steps
+  double currentTime = this->startTime_;
+  for (int timeStepNo = 0; timeStepNo < this->numberTimeSteps_;) {
+    if (timeStepNo % this->timeStepOutputInterval_ == 0 &&
+        (this->timeStepOutputInterval_ <= 10 ||
+         timeStepNo >
+             0)) // show first timestep only if timeStepOutputInterval is <= 10
+    {
+      LOG(INFO) << "RungeKuttaChebyshev, timestep " << timeStepNo << "/"
+                << this->numberTimeSteps_ << ", t=" << currentTime
+                << ", " << nStages_ << " stages";
+    }
+
+    VLOG(1) << "starting from solution (" << this->data_->solution()
+            << "): " << *this->data_->solution();
+
+    // store Y_0 = u_{t} and compute f(Y_0)
+    VecCopy(solution, initialSolution);
+    this->discretizableInTime_.evaluateTimesteppingRightHandSideExplicit(
+        solution, initialRightHandSide, timeStepNo, currentTime);
+
+    // update the spectral radius and the number of stages
+    if (isSpectralRadiusEstimated &&
+        (!spectralRadiusValid_ ||
+         (spectralRadiusUpdateInterval_ > 0 &&
+          timeStepNo % spectralRadiusUpdateInterval_ == 0))) {
+      spectralRadius_ =
+          estimateSpectralRadius(initialSolution, initialRightHandSide,
+                                 stageBuffer, increment, timeStepNo,
+                                 currentTime);
+      spectralRadiusValid_ = true;
+    }
+    computeCoefficients();
+
+    // Y_1 = Y_0 + mu~_1*dt*f(Y_0)
+    VecWAXPY(stageBuffer, muTilde_[1] * dt, initialRightHandSide,
+             initialSolution);
+
+    // the stages Y_{j-1} and Y_{j-2}, the new stage Y_j overwrites Y_{j-2},
+    // solution still contains Y_0
+    Vec previousStage = stageBuffer;
+    Vec secondPreviousStage = solution;
+
+    for (int j = 2; j <= nStages_; j++) {
+      // compute f(Y_{j-1})
+      this->discretizableInTime_.evaluateTimesteppingRightHandSideExplicit(
+          previousStage, increment, timeStepNo, currentTime + c_[j - 1] * dt);
+
+      // Y_j = (1-mu_j-nu_j)*Y_0 + mu_j*Y_{j-1} + nu_j*Y_{j-2}
+      VecAXPBYPCZ(secondPreviousStage, 1.0 - mu_[j] - nu_[j], mu_[j], nu_[j],
+                  initialSolution, previousStage);
+
+      // Y_j += mu~_j*dt*f(Y_{j-1}) + gamma~_j*dt*f(Y_0)
+      VecAXPBYPCZ(secondPreviousStage, muTilde_[j] * dt, gammaTilde_[j] * dt,
+                  1.0, increment, initialRightHandSide);
+
+      std::swap(previousStage, secondPreviousStage);
+    }
+
+    // u_{t+1} = Y_s
+    if (previousStage != solution)
+      VecCopy(previousStage, solution);
+
+    // apply the prescribed boundary condition values
+    this->applyBoundaryConditions();
+
+    VLOG(1) << "final solution (" << this->data_->solution()
+            << "): " << *this->data_->solution();
+
+    // check if the solution contains Nans or Inf values
+    this->checkForNanInf(timeStepNo, currentTime);
+
+    // advance simulation time
+    timeStepNo++;
+    currentTime = this->startTime_ +
+                  double(timeStepNo) / this->numberTimeSteps_ * timeSpan;
+
+    // stop duration measurement
+    if (this->durationLogKey_ != "")
+      Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
+
+    // write current output values
+    if (withOutputWritersEnabled)
+      this->outputWriterManager_.writeOutput(*this->data_, timeStepNo,
+                                             currentTime);
+
+    // start duration measurement
+    if (this->durationLogKey_ != "")
+      Control::PerformanceMeasurement::start(this->durationLogKeyId_);
+  }
+
+  // stop duration measurement
+  if (this->durationLogKey_ != "")
+    Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
+}
+
+template <typename DiscretizableInTime>
+void RungeKuttaChebyshev<DiscretizableInTime>::run() {
+  TimeSteppingSchemeOde<DiscretizableInTime>::run();
+}
+
+} // namespace TimeSteppingScheme
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "time_stepping_scheme/03_time_stepping_explicit.h"
+#include "interfaces/runnable.h"
+#include "data_management/time_stepping/time_stepping_multi_stage.h"
+#include "control/dihu_context.h"
+
+namespace TimeSteppingScheme {
+
+/** The strong stability preserving Runge-Kutta scheme of order 3 by Shu and
+ * Osher, with three stages:
+ *
+ *  u1      = u_{t} + dt*f(u_{t})
+ *  u2      = 3/4*u_{t} + 1/4*(u1 + dt*f(u1))
+ *  u_{t+1} = 1/3*u_{t} + 2/3*(u2 + dt*f(u2))
+ *
+ *  The stability region along the negative real axis is the same as for Heun
+ * ([-2.51,0] compared to [-2,0]), but the scheme is of third order and needs
+ * only one additional vector.
+ */
+template <typename DiscretizableInTime>
+class SspRungeKutta3 : public TimeSteppingExplicit<DiscretizableInTime>,
+                       public Runnable {
+public:
+  //! constructor
+  SspRungeKutta3(DihuContext context);
+
+  //! initialize the data object
+  virtual void initialize();
+
+  //! advance simulation by the given time span [startTime_, endTime_] with
+  //! given numberTimeSteps, data in solution is used, afterwards new data is in
+  //! solution
+  void advanceTimeSpan(bool withOutputWritersEnabled = true);
+
+  //! run the simulation
+  void run();
+};
+
+} // namespace TimeSteppingScheme
+
+#include "time_stepping_scheme/ssp_runge_kutta_3.tpp"
@@ -0,0 +1,135 @@
+#include "time_stepping_scheme/ssp_runge_kutta_3.h"
+
+#include <Python.h>
+#include <memory>
+#include "utility/python_utility.h"
+#include "utility/petsc_utility.h"
+
+namespace TimeSteppingScheme {
+
+template <typename DiscretizableInTime>
+SspRungeKutta3<DiscretizableInTime>::SspRungeKutta3(DihuContext context)
+    : TimeSteppingExplicit<DiscretizableInTime>(context, "SspRungeKutta3") {}
+
+template <typename DiscretizableInTime>
+void SspRungeKutta3<DiscretizableInTime>::initialize() {
+  LOG_SCOPE_FUNCTION;
+
+  LOG(TRACE) << "SspRungeKutta3::initialize";
+
+  // create data object with one stage vector that stores u_{t}
+  this->data_ = std::make_shared<Data::TimeSteppingMultiStage<
+      typename DiscretizableInTime::FunctionSpace,
+      DiscretizableInTime::nComponents()>>(this->context_, 1);
+
+  // initialize already writes the first output file
+  TimeSteppingSchemeOde<DiscretizableInTime>::initialize();
+}
+
+template <typename DiscretizableInTime>
+void SspRungeKutta3<DiscretizableInTime>::advanceTimeSpan(
+    bool withOutputWritersEnabled) {
+  LOG_SCOPE_FUNCTION;
+
+  // start duration measurement, the name of the output variable can be set by
+  // "durationLogKey" in the config
+  if (this->durationLogKey_ != "")
+    Control::PerformanceMeasurement::start(this->durationLogKeyId_);
+
+  // compute timestep width
+  double timeSpan = this->endTime_ - this->startTime_;
+
+  LOG(DEBUG) << "SspRungeKutta3::advanceTimeSpan, timeSpan=" << timeSpan
+             << ", timeStepWidth=" << this->timeStepWidth_
+             << " n steps: " << this->numberTimeSteps_;
+
+  // cast the pointer type to the derived class to get the stage vector
+  std::shared_ptr<Data::TimeSteppingMultiStage<
+      typename DiscretizableInTime::FunctionSpace,
+      DiscretizableInTime::nComponents()>>
+      dataMultiStage = std::static_pointer_cast<Data::TimeSteppingMultiStage<
+          typename DiscretizableInTime::FunctionSpace,
+          DiscretizableInTime::nComponents()>>(this->data_);
+
+  // get vectors of all components in struct-of-array order, as needed by CellML
+  // (i.e. one long vector with [state0 state0 state0 ... state1 state1...]
+  Vec &solution = this->data_->solution()->getValuesContiguous();
+  Vec &increment = this->data_->increment()->getValuesContiguous();
+  Vec &initialSolution = dataMultiStage->stage(0)->getValuesContiguous();
+
+  const double dt = this->timeStepWidth_;
+
+  // loop over time steps
+  double currentTime = this->startTime_;
+  for (int timeStepNo = 0; timeStepNo < this->numberTimeSteps_;) {
+    if (timeStepNo % this->timeStepOutputInterval_ == 0 &&
+        (this->timeStepOutputInterval_ <= 10 ||
+         timeStepNo >
+             0)) // show first timestep only if timeStepOutputInterval is <= 10
+    {
+      LOG(INFO) << "SspRungeKutta3, timestep " << timeStepNo << "/"
+                << this->numberTimeSteps_ << ", t=" << currentTime;
+    }
+
+    VLOG(1) << "starting from solution (" << this->data_->solution()
+            << "): " << *this->data_->solution();
+
+    // store u_{t}
+    VecCopy(solution, initialSolution);
+
+    // first stage: u1 = u_{t} + dt*f(u_{t})
+    this->discretizableInTime_.evaluateTimesteppingRightHandSideExplicit(
+        solution, increment, timeStepNo, currentTime);
+    VecAXPY(solution, dt, increment);
+
+    // second stage: u2 = 3/4*u_{t} + 1/4*(u1 + dt*f(u1))
+    this->discretizableInTime_.evaluateTimesteppingRightHandSideExplicit(
+        solution, increment, timeStepNo, currentTime + dt);
+    VecAXPY(solution, dt, increment);
+    VecAXPBY(solution, 0.75, 0.25, initialSolution);
+
+    // third stage: u_{t+1} = 1/3*u_{t} + 2/3*(u2 + dt*f(u2))
+    this->discretizableInTime_.evaluateTimesteppingRightHandSideExplicit(
+        solution, increment, timeStepNo, currentTime + 0.5 * dt);
+    VecAXPY(solution, dt, increment);
+    VecAXPBY(solution, 1. / 3, 2. / 3, initialSolution);
+
+    // apply the prescribed boundary condition values
+    this->applyBoundaryConditions();
+
+    VLOG(1) << "final solution (" << this->data_->solution()
+            << "): " << *this->data_->solution();
+
+    // check if the solution contains Nans or Inf values
+    this->checkForNanInf(timeStepNo, currentTime);
+
+    // advance simulation time
+    timeStepNo++;
+    currentTime = this->startTime_ +
+                  double(timeStepNo) / this->numberTimeSteps_ * timeSpan;
+
+    // stop duration measurement
+    if (this->durationLogKey_ != "")
+      Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
+
+    // write current output values
+    if (withOutputWritersEnabled)
+      this->outputWriterManager_.writeOutput(*this->data_, timeStepNo,
+                                             currentTime);
+
+    // start duration measurement
+    if (this->durationLogKey_ != "")
+      Control::PerformanceMeasurement::start(this->durationLogKeyId_);
+  }
+
+  // stop duration measurement
+  if (this->durationLogKey_ != "")
+    Control::PerformanceMeasurement::stop(this->durationLogKeyId_);
+}
+
+template <typename DiscretizableInTime>
+void SspRungeKutta3<DiscretizableInTime>::run() {
+  TimeSteppingSchemeOde<DiscretizableInTime>::run();
+}
+
+} // namespace TimeSteppingScheme
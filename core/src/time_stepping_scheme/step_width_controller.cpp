@@ -0,0 +1,107 @@
+#include "time_stepping_scheme/step_width_controller.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "easylogging++.h"
+
+namespace TimeSteppingScheme {
+
+StepWidthController::StepWidthController(PythonConfig specificSettings,
+                                         int order)
+    : previousErrorNorm_(1.0), isPreviousStepRejected_(false),
+      nAcceptedSteps_(0), nRejectedSteps_(0) {
+  relativeTolerance_ = specificSettings.getOptionDouble(
+      "relativeTolerance", 1e-5, PythonUtility::Positive);
+  absoluteTolerance_ = specificSettings.getOptionDouble(
+      "absoluteTolerance", 1e-5, PythonUtility::Positive);
+  minTimeStepWidth_ = specificSettings.getOptionDouble(
+      "minTimeStepWidth", 1e-10, PythonUtility::Positive);
+  maxTimeStepWidth_ = specificSettings.getOptionDouble(
+      "maxTimeStepWidth", 1e10, PythonUtility::Positive);
+  safetyFactor_ = specificSettings.getOptionDouble("safetyFactor", 0.9,
+                                                   PythonUtility::Positive);
+  maxIncreaseFactor_ = specificSettings.getOptionDouble(
+      "maxIncreaseFactor", 5.0, PythonUtility::Positive);
+  maxDecreaseFactor_ = specificSettings.getOptionDouble(
+      "maxDecreaseFactor", 0.2, PythonUtility::Positive);
+
+  // exponents of the PI controller
+  const int k = order + 1;
+  beta_ = specificSettings.getOptionDouble("controllerBeta", 0.4 / k,
+                                           PythonUtility::NonNegative);
+  alpha_ = 1.0 / k - 0.75 * beta_;
+
+  if (alpha_ <= 0) {
+    LOG(WARNING) << specificSettings << "[\"controllerBeta\"] = " << beta_
+                 << " is too high, the exponent of the current error would be "
+                 << alpha_ << ". Using controllerBeta = 0.";
+    beta_ = 0;
+    alpha_ = 1.0 / k;
+  }
+}
+
+double StepWidthController::relativeTolerance() const {
+  return relativeTolerance_;
+}
+
+double StepWidthController::absoluteTolerance() const {
+  return absoluteTolerance_;
+}
+
+bool StepWidthController::adaptTimeStepWidth(double errorNorm,
+                                             double &timeStepWidth) {
+  // steps with the minimum time step width are accepted regardless of the
+  // error, to not get stuck
+  bool isMinimumTimeStepWidth =
+      timeStepWidth <= minTimeStepWidth_ * (1 + 1e-12);
+  bool isAccepted = errorNorm <= 1.0 || isMinimumTimeStepWidth;
+
+  if (errorNorm > 1.0 && isMinimumTimeStepWidth) {
+    LOG(WARNING) << "Adaptive time stepping: error norm " << errorNorm
+                 << " exceeds the tolerance, but the time step width "
+                 << timeStepWidth << " is already at minTimeStepWidth.";
+  }
+
+  // compute the factor for the time step width
+  double factor = maxIncreaseFactor_;
+  if (errorNorm > 0) {
+    factor = safetyFactor_ * std::pow(errorNorm, -alpha_);
+
+    // the integral part is only used after accepted steps
+    if (isAccepted)
+      factor *= std::pow(previousErrorNorm_, beta_);
+  }
+  factor = std::min(maxIncreaseFactor_, std::max(maxDecreaseFactor_, factor));
+
+  // do not increase the time step width directly after a rejected step
+  if (!isAccepted || isPreviousStepRejected_)
+    factor = std::min(1.0, factor);
+
+  if (isAccepted) {
+    previousErrorNorm_ = std::max(errorNorm, 1e-4);
+    nAcceptedSteps_++;
+  } else {
+    nRejectedSteps_++;
+  }
+  isPreviousStepRejected_ = !isAccepted;
+
+  timeStepWidth = std::min(maxTimeStepWidth_,
+                           std::max(minTimeStepWidth_, factor * timeStepWidth));
+
+  VLOG(1) << "error norm: " << errorNorm << ", accepted: " << isAccepted
+          << ", factor: " << factor << ", new dt: " << timeStepWidth;
+
+  return isAccepted;
+}
+
+int StepWidthController::nAcceptedSteps() const { return nAcceptedSteps_; }
+
+int StepWidthController::nRejectedSteps() const { return nRejectedSteps_; }
+
+void StepWidthController::resetStatistics() {
+  nAcceptedSteps_ = 0;
+  nRejectedSteps_ = 0;
+}
+
+} // namespace TimeSteppingScheme
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <Python.h> // has to be the first included header
+
+#include "control/python_config/python_config.h"
+
+namespace TimeSteppingScheme {
+
+/** Proportional-integral (PI) controller of the time step width for
+ * adaptive time stepping schemes with an embedded error estimate.
+ *
+ *  The error norm is the scaled root mean square of the error estimate, where
+ * every entry is divided by absoluteTolerance + relativeTolerance*|u|, such
+ * that a step is accepted if the error norm is at most 1. The new time step
+ * width is
+ *
+ *  dt_new = dt * safetyFactor * err^(-alpha) * errPrevious^beta,
+ *
+ *  with alpha = 1/k - 0.75*beta, k = order+1 and the default beta = 0.4/k,
+ * where order is the order of the lower order solution of the embedded pair.
+ * With beta = 0, this is the classical (integral) controller. After a
+ * rejected step, the time step width is not increased.
+ */
+class StepWidthController {
+public:
+  //! constructor, parse the options from the settings of the time stepping
+  //! scheme
+  StepWidthController(PythonConfig specificSettings, int order);
+
+  //! the tolerance for the error relative to the solution values
+  double relativeTolerance() const;
+
+  //! the tolerance for the absolute error
+  double absoluteTolerance() const;
+
+  //! decide if the step with the given scaled error norm is accepted and set
+  //! timeStepWidth to the width for the next step, returns if the step was
+  //! accepted
+  bool adaptTimeStepWidth(double errorNorm, double &timeStepWidth);
+
+  //! number of accepted steps since the last call to resetStatistics()
+  int nAcceptedSteps() const;
+
+  //! number of rejected steps since the last call to resetStatistics()
+  int nRejectedSteps() const;
+
+  //! reset the number of accepted and rejected steps
+  void resetStatistics();
+
+private:
+  double relativeTolerance_;  //< tolerance relative to the solution values
+  double absoluteTolerance_;  //< tolerance for the absolute error
+  double minTimeStepWidth_;   //< lower bound of the time step width, steps
+                              // with this width are always accepted
+  double maxTimeStepWidth_;   //< upper bound of the time step width
+  double safetyFactor_;       //< factor < 1 applied to the optimal width
+  double maxIncreaseFactor_;  //< maximum factor by which dt is increased
+  double maxDecreaseFactor_;  //< maximum factor by which dt is decreased
+  double alpha_;              //< exponent of the current error
+  double beta_;               //< exponent of the previous error
+  double previousErrorNorm_;  //< error norm of the last accepted step
+  bool isPreviousStepRejected_; //< if the last step was rejected
+  int nAcceptedSteps_;        //< number of accepted steps
+  int nRejectedSteps_;        //< number of rejected steps
+};
+
+} // namespace TimeSteppingScheme
@@ -0,0 +1,157 @@
+#include "utility/cpu_utility.h"
+
+#include <cstdint>
+#include <sstream>
+#include <vector>
+#include <vc_or_std_simd.h>
+
+#include "easylogging++.h"
+
+namespace {
+
+//! compose the compiler flags of the enabled instruction sets
+std::string joinFlags(const std::vector<std::pair<std::string, bool>> &flags) {
+  std::stringstream s;
+  for (const std::pair<std::string, bool> &flag : flags) {
+    if (!flag.second)
+      continue;
+    if (!s.str().empty())
+      s << " ";
+    s << flag.first;
+  }
+  return s.str();
+}
+
+} // namespace
+
+namespace CpuUtility {
+
+std::string detectedInstructionSetFlags() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  // the feature checks also include the support by the operating system
+  __builtin_cpu_init();
+  return joinFlags({{"-msse2", __builtin_cpu_supports("sse2")},
+                    {"-msse3", __builtin_cpu_supports("sse3")},
+                    {"-mssse3", __builtin_cpu_supports("ssse3")},
+                    {"-msse4.1", __builtin_cpu_supports("sse4.1")},
+                    {"-msse4.2", __builtin_cpu_supports("sse4.2")},
+                    {"-mavx", __builtin_cpu_supports("avx")},
+                    {"-mavx2", __builtin_cpu_supports("avx2")},
+                    {"-mfma", __builtin_cpu_supports("fma")},
+                    {"-mavx512f", __builtin_cpu_supports("avx512f")},
+                    {"-mavx512cd", __builtin_cpu_supports("avx512cd")},
+                    {"-mavx512dq", __builtin_cpu_supports("avx512dq")},
+                    {"-mavx512bw", __builtin_cpu_supports("avx512bw")},
+                    {"-mavx512vl", __builtin_cpu_supports("avx512vl")}});
+#else
+  return "";
+#endif
+}
+
+std::string compiledInstructionSetFlags() {
+  std::vector<std::pair<std::string, bool>> flags;
+#ifdef __SSE2__
+  flags.push_back(std::make_pair("-msse2", true));
+#endif
+#ifdef __SSE3__
+  flags.push_back(std::make_pair("-msse3", true));
+#endif
+#ifdef __SSSE3__
+  flags.push_back(std::make_pair("-mssse3", true));
+#endif
+#ifdef __SSE4_1__
+  flags.push_back(std::make_pair("-msse4.1", true));
+#endif
+#ifdef __SSE4_2__
+  flags.push_back(std::make_pair("-msse4.2", true));
+#endif
+#ifdef __AVX__
+  flags.push_back(std::make_pair("-mavx", true));
+#endif
+#ifdef __AVX2__
+  flags.push_back(std::make_pair("-mavx2", true));
+#endif
+#ifdef __FMA__
+  flags.push_back(std::make_pair("-mfma", true));
+#endif
+#ifdef __AVX512F__
+  flags.push_back(std::make_pair("-mavx512f", true));
+#endif
+#ifdef __AVX512CD__
+  flags.push_back(std::make_pair("-mavx512cd", true));
+#endif
+#ifdef __AVX512DQ__
+  flags.push_back(std::make_pair("-mavx512dq", true));
+#endif
+#ifdef __AVX512BW__
+  flags.push_back(std::make_pair("-mavx512bw", true));
+#endif
+#ifdef __AVX512VL__
+  flags.push_back(std::make_pair("-mavx512vl", true));
+#endif
+  return joinFlags(flags);
+}
+
+int instructionSetLevel(std::string instructionSetFlags) {
+  // append a space, such that e.g. "-mavx " does not match "-mavx2"
+  instructionSetFlags += " ";
+
+  if (instructionSetFlags.find("-mavx512f ") != std::string::npos)
+    return 5;
+  if (instructionSetFlags.find("-mavx2 ") != std::string::npos)
+    return 4;
+  if (instructionSetFlags.find("-mavx ") != std::string::npos)
+    return 3;
+  if (instructionSetFlags.find("-msse4.2 ") != std::string::npos)
+    return 2;
+  if (instructionSetFlags.find("-msse2 ") != std::string::npos)
+    return 1;
+  return 0;
+}
+
+std::string instructionSetName(std::string instructionSetFlags) {
+  const char *names[] = {"generic", "sse2", "sse4", "avx", "avx2", "avx512"};
+  return names[instructionSetLevel(instructionSetFlags)];
+}
+
+int instructionSetHash(std::string instructionSetFlags) {
+  // 32 bit FNV-1a hash, std::hash is not guaranteed to be the same for all
+  // ranks
+  uint32_t hash = 2166136261u;
+  for (char character : instructionSetFlags) {
+    hash ^= (unsigned char)character;
+    hash *= 16777619u;
+  }
+  return (int)hash;
+}
+
+void logInstructionSets() {
+  std::string detectedFlags = detectedInstructionSetFlags();
+  std::string compiledFlags = compiledInstructionSetFlags();
+
+  LOG(INFO) << "SIMD instruction sets: CPU supports "
+            << instructionSetName(detectedFlags)
+            << ", opendihu is compiled for "
+            << instructionSetName(compiledFlags) << " ("
+            << Vc::double_v::size() << " doubles per Vc::double_v).";
+  LOG(DEBUG) << "detected instruction set flags: \"" << detectedFlags
+             << "\", compiled instruction set flags: \"" << compiledFlags
+             << "\"";
+
+  // the detection is only available on x86
+  if (detectedFlags.empty())
+    return;
+
+  // check that every instruction set that opendihu uses is supported
+  std::stringstream compiledFlagsStream(compiledFlags);
+  std::string flag;
+  while (compiledFlagsStream >> flag) {
+    if ((detectedFlags + " ").find(flag + " ") == std::string::npos) {
+      LOG(ERROR) << "opendihu was compiled with \"" << flag
+                 << "\", but the CPU does not support this instruction set. "
+                 << "Compile opendihu for the oldest CPU that it runs on.";
+    }
+  }
+}
+
+} // namespace CpuUtility
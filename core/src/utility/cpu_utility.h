@@ -0,0 +1,36 @@
+#pragma once
+
+#include <Python.h> // has to be the first included header
+#include <string>
+
+namespace CpuUtility {
+
+//! get the compiler flags that enable the SIMD instruction sets which are
+//! supported by the CPU of the own rank, e.g. "-msse2 ... -mavx2 -mfma". This
+//! is detected at runtime and can differ between nodes. Empty if the CPU is no
+//! x86 CPU.
+std::string detectedInstructionSetFlags();
+
+//! get the compiler flags of the SIMD instruction sets that opendihu was
+//! compiled for. Code that exchanges Vc::double_v values with opendihu has to
+//! be compiled with these flags, because they determine Vc::double_v::size().
+std::string compiledInstructionSetFlags();
+
+//! get the level of the widest instruction set in the given compiler flags,
+//! from 0 for "generic" to 5 for "avx512", this allows comparing ranks
+int instructionSetLevel(std::string instructionSetFlags);
+
+//! get the name of the widest instruction set in the given compiler flags, one
+//! of "avx512", "avx2", "avx", "sse4", "sse2" or "generic"
+std::string instructionSetName(std::string instructionSetFlags);
+
+//! get a hash of the given compiler flags that is the same on all ranks and
+//! for all runs, CPUs with the same widest instruction set can still differ in
+//! other flags, e.g. "-mfma", and need different libraries
+int instructionSetHash(std::string instructionSetFlags);
+
+//! log the detected and compiled instruction sets, warn if opendihu was
+//! compiled for instructions that the CPU does not support
+void logInstructionSets();
+
+} // namespace CpuUtility
@@ -0,0 +1,88 @@
+#include "utility/memory_mapped_file.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "easylogging++.h"
+
+MemoryMappedFile::MemoryMappedFile(std::string filename, bool useMemoryMapping)
+    : filename_(filename), fileDescriptor_(-1), size_(0), data_(nullptr) {
+  fileDescriptor_ = open(filename.c_str(), O_RDONLY);
+  if (fileDescriptor_ == -1) {
+    LOG(ERROR) << "Could not open file \"" << filename
+               << "\": " << strerror(errno);
+    return;
+  }
+
+  struct stat fileStatus;
+  if (fstat(fileDescriptor_, &fileStatus) == 0)
+    size_ = fileStatus.st_size;
+
+  if (size_ == 0 || !useMemoryMapping)
+    return;
+
+  void *data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fileDescriptor_, 0);
+  if (data == MAP_FAILED) {
+    LOG(DEBUG) << "Could not map file \"" << filename
+               << "\" into memory: " << strerror(errno) << ", use pread.";
+    return;
+  }
+
+  // the ranks access small, scattered portions of the file, disable readahead
+  madvise(data, size_, MADV_RANDOM);
+  data_ = (const char *)data;
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+  if (data_)
+    munmap((void *)data_, size_);
+  if (fileDescriptor_ != -1)
+    close(fileDescriptor_);
+}
+
+bool MemoryMappedFile::isOpen() const { return fileDescriptor_ != -1; }
+
+std::size_t MemoryMappedFile::size() const { return size_; }
+
+bool MemoryMappedFile::read(std::size_t offset, std::size_t nBytes,
+                            void *destination) const {
+  if (!isOpen() || offset > size_ || nBytes > size_ - offset)
+    return false;
+
+  if (data_) {
+    memcpy(destination, data_ + offset, nBytes);
+    return true;
+  }
+
+  // the file could not be mapped, read the range directly
+  char *buffer = (char *)destination;
+  while (nBytes > 0) {
+    ssize_t nBytesRead = pread(fileDescriptor_, buffer, nBytes, offset);
+    if (nBytesRead <= 0) {
+      if (nBytesRead == -1 && errno == EINTR)
+        continue;
+      LOG(ERROR) << "Could not read " << nBytes << " bytes at offset "
+                 << offset << " from file \"" << filename_ << "\".";
+      return false;
+    }
+    buffer += nBytesRead;
+    offset += nBytesRead;
+    nBytes -= nBytesRead;
+  }
+  return true;
+}
+
+bool MemoryMappedFile::readAll(std::string &content) const {
+  content.resize(size_);
+  if (size_ == 0)
+    return isOpen();
+
+  // the whole file is read in order, enable readahead again
+  if (data_)
+    madvise((void *)data_, size_, MADV_SEQUENTIAL);
+  return read(0, size_, &content[0]);
+}
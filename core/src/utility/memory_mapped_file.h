@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/** A read-only file that is mapped into memory. Only the pages that are
+ * accessed are loaded from disk, such that every rank can read its own
+ * portion of a large input file that is shared by all ranks, without reading
+ * the whole file. If the file cannot be mapped, e.g. on file systems that do
+ * not support it, the requested ranges are read with pread instead.
+ */
+class MemoryMappedFile {
+public:
+  //! constructor, open and map the file, check isOpen() afterwards. If
+  //! useMemoryMapping is false, the file is not mapped and always read by pread
+  MemoryMappedFile(std::string filename, bool useMemoryMapping = true);
+
+  //! destructor, unmap and close the file
+  ~MemoryMappedFile();
+
+  MemoryMappedFile(const MemoryMappedFile &) = delete;
+  MemoryMappedFile &operator=(const MemoryMappedFile &) = delete;
+
+  //! if the file could be opened
+  bool isOpen() const;
+
+  //! size of the file in bytes
+  std::size_t size() const;
+
+  //! copy nBytes starting at offset to destination, returns false if the
+  //! range is not contained in the file or could not be read
+  bool read(std::size_t offset, std::size_t nBytes, void *destination) const;
+
+  //! copy the whole file to content, returns false if it could not be read
+  bool readAll(std::string &content) const;
+
+private:
+  std::string filename_; //< the name of the file
+  int fileDescriptor_;   //< the descriptor of the open file, -1 if not open
+  std::size_t size_;     //< size of the file in bytes
+  const char *data_; //< the mapped contents of the file, nullptr if mapping
+                     // was not possible
+};
@@ -21,7 +21,7 @@ int PythonUtility::listIndex = 0;
 bool PythonUtility::hasKey(const PyObject *settings, std::string keyString) {
   if (settings && settings != Py_None) {
     // start critical section for python API calls
-    // PythonUtility::GlobalInterpreterLock lock;
+    PythonUtility::GlobalInterpreterLock lock;
 
     // check if input dictionary contains the key
     PyObject *key = PyUnicode_FromString(keyString.c_str());
@@ -44,7 +44,7 @@ bool PythonUtility::hasKey(const PyObject *settings, std::string keyString) {
 bool PythonUtility::isEmpty(const PyObject *settings, std::string keyString) {
   if (settings && settings != Py_None) {
     // start critical section for python API calls
-    // PythonUtility::GlobalInterpreterLock lock;
+    PythonUtility::GlobalInterpreterLock lock;
 
     // check if input dictionary contains the key
     PyObject *key = PyUnicode_FromString(keyString.c_str());
@@ -71,7 +71,7 @@ bool PythonUtility::isEmpty(const PyObject *settings, std::string keyString) {
 bool PythonUtility::isTypeList(const PyObject *object) {
   if (object) {
     // start critical section for python API calls
-    // PythonUtility::GlobalInterpreterLock lock;
+    PythonUtility::GlobalInterpreterLock lock;
 
     if (PyList_Check(object)) {
       return true;
@@ -92,7 +92,7 @@ PyObject *PythonUtility::getOptionPyObject(const PyObject *settings,
   }
 
   // start critical section for python API calls
-  // PythonUtility::GlobalInterpreterLock lock;
+  PythonUtility::GlobalInterpreterLock lock;
 
   // check if input dictionary contains the key
   PyObject *key = PyUnicode_FromString(keyString.c_str());
@@ -124,7 +124,7 @@ double PythonUtility::getOptionDouble(const PyObject *settings,
   }
 
   // start critical section for python API calls
-  // PythonUtility::GlobalInterpreterLock lock;
+  PythonUtility::GlobalInterpreterLock lock;
 
   // check if input dictionary contains the key
   PyObject *key = PyUnicode_FromString(keyString.c_str());
@@ -214,7 +214,7 @@ int PythonUtility::getOptionInt(const PyObject *settings, std::string keyString,
     return result;
 
   // start critical section for python API calls
-  // PythonUtility::GlobalInterpreterLock lock;
+  PythonUtility::GlobalInterpreterLock lock;
 
   // check if input dictionary contains the key
   PyObject *key = PyUnicode_FromString(keyString.c_str());
@@ -304,7 +304,7 @@ bool PythonUtility::getOptionBool(const PyObject *settings,
     return result;
 
   // start critical section for python API calls
-  // PythonUtility::GlobalInterpreterLock lock;
+  PythonUtility::GlobalInterpreterLock lock;
 
   // check if input dictionary contains the key
   PyObject *key = PyUnicode_FromString(keyString.c_str());
@@ -359,7 +359,7 @@ std::string PythonUtility::getOptionString(const PyObject *settings,
     return result;
 
   // start critical section for python API calls
-  // PythonUtility::GlobalInterpreterLock lock;
+  PythonUtility::GlobalInterpreterLock lock;
 
   // check if input dictionary contains the key
   PyObject *key = PyUnicode_FromString(keyString.c_str());
@@ -388,7 +388,7 @@ PyObject *PythonUtility::getOptionFunction(const PyObject *settings,
     return result;
 
   // start critical section for python API calls
-  // PythonUtility::GlobalInterpreterLock lock;
+  PythonUtility::GlobalInterpreterLock lock;
 
   // check if input dictionary contains the key
   PyObject *key = PyUnicode_FromString(keyString.c_str());
@@ -427,7 +427,7 @@ std::string PythonUtility::getString(PyObject *object, int indent,
   line << std::string(first_indent, ' ');
 
   // start critical section for python API calls
-  // PythonUtility::GlobalInterpreterLock lock;
+  PythonUtility::GlobalInterpreterLock lock;
 
   if (PyUnicode_CheckExact(object)) {
     std::string objectString = pyUnicodeToString(object);
@@ -512,7 +512,7 @@ void PythonUtility::printDict(PyObject *dict) {
   }
 
   // start critical section for python API calls
-  // PythonUtility::GlobalInterpreterLock lock;
+  PythonUtility::GlobalInterpreterLock lock;
 
   if (!PyDict_Check(dict)) {
     LOG(DEBUG) << "printDict: Object is not a dict!";
@@ -529,7 +529,7 @@ bool PythonUtility::getOptionDictEnd(const PyObject *settings,
     return true;
 
   // start critical section for python API calls
-  // PythonUtility::GlobalInterpreterLock lock;
+  PythonUtility::GlobalInterpreterLock lock;
 
   return itemListIndex >= PyList_Size(itemList);
 }
@@ -541,7 +541,7 @@ bool PythonUtility::getOptionListEnd(const PyObject *settings,
     return true;
 
   // start critical section for python API calls
-  // PythonUtility::GlobalInterpreterLock lock;
+  PythonUtility::GlobalInterpreterLock lock;
 
   return listIndex >= PyList_Size(list);
 }
@@ -554,14 +554,21 @@ void PythonUtility::getOptionVector(const PyObject *settings,
 
   if (settings) {
     // start critical section for python API calls
-    // PythonUtility::GlobalInterpreterLock lock;
+    PythonUtility::GlobalInterpreterLock lock;
 
     // check if input dictionary contains the key
     PyObject *key = PyUnicode_FromString(keyString.c_str());
     if (PyDict_Contains((PyObject *)settings, key)) {
       // extract the value of the key and check its type
       PyObject *value = PyDict_GetItem((PyObject *)settings, key);
-      if (PyList_Check(value)) {
+      std::vector<double> bufferValues;
+      if (convertFromBuffer<double>::get(value, bufferValues)) {
+        // it is a numpy array or another object with a numeric buffer
+        std::copy(bufferValues.begin(),
+                  bufferValues.begin() +
+                      std::min((int)bufferValues.size(), nEntries),
+                  values.begin());
+      } else if (PyList_Check(value)) {
         // it is a list
 
         // get the first value from the list
@@ -614,6 +621,8 @@ void PythonUtility::getOptionVector(const PyObject *settings,
 }
 
 void PythonUtility::checkForError() {
+  // start critical section for python API calls
+  PythonUtility::GlobalInterpreterLock lock;
 
   if (PyErr_Occurred()) {
     // LOG(ERROR) << "Python exception";
@@ -688,7 +697,7 @@ void PythonUtility::checkForError() {
 
 PyObject *PythonUtility::convertToPythonList(std::vector<double> &data) {
   // start critical section for python API calls
-  // PythonUtility::GlobalInterpreterLock lock;
+  PythonUtility::GlobalInterpreterLock lock;
 
   PyObject *result = PyList_New((Py_ssize_t)data.size());
   for (unsigned int i = 0; i < data.size(); i++) {
@@ -700,7 +709,7 @@ PyObject *PythonUtility::convertToPythonList(std::vector<double> &data) {
 
 PyObject *PythonUtility::convertToPythonList(double *value, int nValues) {
   // start critical section for python API calls
-  // PythonUtility::GlobalInterpreterLock lock;
+  PythonUtility::GlobalInterpreterLock lock;
 
   //! create a python list from a double *
 
@@ -714,7 +723,7 @@ PyObject *PythonUtility::convertToPythonList(double *value, int nValues) {
 
 PyObject *PythonUtility::convertToPythonList(std::vector<long> &data) {
   // start critical section for python API calls
-  // PythonUtility::GlobalInterpreterLock lock;
+  PythonUtility::GlobalInterpreterLock lock;
 
   PyObject *result = PyList_New((Py_ssize_t)data.size());
   for (unsigned int i = 0; i < data.size(); i++) {
@@ -726,7 +735,7 @@ PyObject *PythonUtility::convertToPythonList(std::vector<long> &data) {
 
 PyObject *PythonUtility::convertToPythonList(std::vector<global_no_t> &data) {
   // start critical section for python API calls
-  // PythonUtility::GlobalInterpreterLock lock;
+  PythonUtility::GlobalInterpreterLock lock;
 
   PyObject *result = PyList_New((Py_ssize_t)data.size());
   for (unsigned int i = 0; i < data.size(); i++) {
@@ -738,7 +747,7 @@ PyObject *PythonUtility::convertToPythonList(std::vector<global_no_t> &data) {
 
 PyObject *PythonUtility::convertToPythonList(std::vector<int> &data) {
   // start critical section for python API calls
-  // PythonUtility::GlobalInterpreterLock lock;
+  PythonUtility::GlobalInterpreterLock lock;
 
   PyObject *result = PyList_New((Py_ssize_t)data.size());
   for (unsigned int i = 0; i < data.size(); i++) {
@@ -750,7 +759,7 @@ PyObject *PythonUtility::convertToPythonList(std::vector<int> &data) {
 
 PyObject *PythonUtility::convertToPythonList(std::vector<bool> &data) {
   // start critical section for python API calls
-  // PythonUtility::GlobalInterpreterLock lock;
+  PythonUtility::GlobalInterpreterLock lock;
 
   PyObject *result = PyList_New((Py_ssize_t)data.size());
   for (unsigned int i = 0; i < data.size(); i++) {
@@ -763,7 +772,7 @@ PyObject *PythonUtility::convertToPythonList(std::vector<bool> &data) {
 PyObject *PythonUtility::convertToPythonList(unsigned int nEntries,
                                              double *data) {
   // start critical section for python API calls
-  // PythonUtility::GlobalInterpreterLock lock;
+  PythonUtility::GlobalInterpreterLock lock;
 
   PyObject *result = PyList_New((Py_ssize_t)nEntries);
   for (unsigned int i = 0; i < nEntries; i++) {
@@ -773,9 +782,135 @@ PyObject *PythonUtility::convertToPythonList(unsigned int nEntries,
   return result; // return value: new reference
 }
 
+PyObject *PythonUtility::createArrayView(double *data, int nRows,
+                                         int nColumns, bool writable) {
+  // start critical section for python API calls
+  PythonUtility::GlobalInterpreterLock lock;
+
+  // the memoryview references the memory of data without copying
+  Py_ssize_t nBytes = (Py_ssize_t)nRows * nColumns * sizeof(double);
+  PyObject *memoryView = PyMemoryView_FromMemory(
+      (char *)data, nBytes, writable ? PyBUF_WRITE : PyBUF_READ);
+  if (memoryView == NULL) {
+    checkForError();
+    return NULL;
+  }
+
+  PyObject *result = NULL;
+  PyObject *numpy = numpyModule();
+  if (numpy) {
+    // numpy.frombuffer(memoryView, dtype="float64").reshape((nRows, nColumns))
+    PyObject *flatArray = PyObject_CallMethod(numpy, "frombuffer", "(O,s)",
+                                              memoryView, "float64");
+    if (flatArray)
+      result = PyObject_CallMethod(flatArray, "reshape", "((i,i))", nRows,
+                                   nColumns);
+    Py_CLEAR(flatArray);
+  } else {
+    // without numpy, cast the raw bytes to a two-dimensional memoryview
+    result = PyObject_CallMethod(memoryView, "cast", "(s,(i,i))", "d", nRows,
+                                 nColumns);
+  }
+
+  if (result == NULL)
+    checkForError();
+
+  Py_CLEAR(memoryView);
+  return result; // return value: new reference
+}
+
+PyObject *PythonUtility::convertToPythonArray(std::vector<global_no_t> &data) {
+  // start critical section for python API calls
+  PythonUtility::GlobalInterpreterLock lock;
+
+  PyObject *dataList = convertToPythonList(data);
+
+  PyObject *numpy = numpyModule();
+  if (!numpy)
+    return dataList;
+
+  PyObject *result =
+      PyObject_CallMethod(numpy, "array", "(O,s)", dataList, "int64");
+  if (result == NULL) {
+    checkForError();
+    return dataList;
+  }
+
+  Py_CLEAR(dataList);
+  return result; // return value: new reference
+}
+
+PyObject *PythonUtility::numpyModule() {
+  static bool importAttempted = false;
+
+  // an imported module is in sys.modules, a value of None there blocks the
+  // import, e.g. to use the memoryview fallback without numpy
+  PyObject *modules = PyImport_GetModuleDict(); // borrowed reference
+  PyObject *numpy = PyDict_GetItemString(modules, "numpy"); // borrowed
+  if (numpy == Py_None)
+    return NULL;
+  if (numpy != NULL || importAttempted)
+    return numpy;
+
+  // only try to import numpy once, the module stays in sys.modules
+  importAttempted = true;
+  numpy = PyImport_ImportModule("numpy");
+  if (numpy == NULL) {
+    PyErr_Clear();
+    LOG(DEBUG) << "numpy could not be imported, use memoryview instead.";
+    return NULL;
+  }
+  Py_DECREF(numpy);
+  return numpy;
+}
+
+bool PythonUtility::getBuffer(PyObject *object, Py_buffer &buffer,
+                              const char *&data, char &format,
+                              std::vector<char> &contiguousData) {
+  // bytes and bytearray are no numeric arrays, they are handled as strings
+  if (object == NULL || !PyObject_CheckBuffer(object) ||
+      PyBytes_Check(object) || PyByteArray_Check(object))
+    return false;
+
+  if (PyObject_GetBuffer(object, &buffer, PyBUF_RECORDS_RO) != 0) {
+    PyErr_Clear();
+    return false;
+  }
+
+  // parse the format string, only single values in native byte order are
+  // supported, e.g. "d" for float64 or "<i" for int32 on little endian systems
+  const char *formatString = (buffer.format == NULL ? "B" : buffer.format);
+  if (formatString[0] == '@' || formatString[0] == '=' ||
+      (formatString[0] == '<' && PY_LITTLE_ENDIAN) ||
+      ((formatString[0] == '>' || formatString[0] == '!') &&
+       !PY_LITTLE_ENDIAN))
+    formatString++;
+
+  if (formatString[0] == '\0' || formatString[1] != '\0' ||
+      buffer.itemsize <= 0) {
+    PyBuffer_Release(&buffer);
+    return false;
+  }
+  format = formatString[0];
+
+  // sliced or transposed numpy arrays have to be copied to C order first
+  data = (const char *)buffer.buf;
+  if (!PyBuffer_IsContiguous(&buffer, 'C')) {
+    contiguousData.resize(buffer.len);
+    if (PyBuffer_ToContiguous(contiguousData.data(), &buffer, buffer.len,
+                              'C') != 0) {
+      PyErr_Clear();
+      PyBuffer_Release(&buffer);
+      return false;
+    }
+    data = contiguousData.data();
+  }
+  return true;
+}
+
 std::string PythonUtility::pyUnicodeToString(PyObject *object) {
   // start critical section for python API calls
-  // PythonUtility::GlobalInterpreterLock lock;
+  PythonUtility::GlobalInterpreterLock lock;
 
   PyObject *asciiString = PyUnicode_AsASCIIString(object);
   std::string result;
@@ -786,8 +921,8 @@ std::string PythonUtility::pyUnicodeToString(PyObject *object) {
   return result;
 }
 
-// python GIL handling is only needed for multi-threading. It does not work
-// properly with openmp.
+// python GIL handling is only needed for multi-threading. It is only active
+// while setMultithreaded(true) is set and the main thread has released the GIL.
 // int PythonUtility::GlobalInterpreterLock::nGILS_ = 0;
 /*std::recursive_mutex PythonUtility::GlobalInterpreterLock::mutex_;
 std::unique_lock<std::recursive_mutex>
@@ -799,7 +934,15 @@ omp_nest_lock_t PythonUtility::GlobalInterpreterLock::lock_;
 bool PythonUtility::GlobalInterpreterLock::lockInitialized_ = false;
 std::map<int, int> PythonUtility::GlobalInterpreterLock::nGilsThreads_;
 */
-PythonUtility::GlobalInterpreterLock::GlobalInterpreterLock() {
+bool PythonUtility::GlobalInterpreterLock::multithreaded_ = false;
+
+void PythonUtility::GlobalInterpreterLock::setMultithreaded(
+    bool multithreaded) {
+  multithreaded_ = multithreaded;
+}
+
+PythonUtility::GlobalInterpreterLock::GlobalInterpreterLock()
+    : locked_(multithreaded_) {
   // start critical section for python interpreter
   // store GlobalInterpreterLock state
   // nGILS_++;
@@ -822,12 +965,10 @@ PythonUtility::GlobalInterpreterLock::GlobalInterpreterLock() {
   */
   // if (nGilsThreads_[omp_get_thread_num()] == 1)
 
-#if 0  
-  LOG(INFO) << "[" << omp_get_thread_num() << "/" << omp_get_thread_num() << "] (wait for GIL)";
-  gstate_ = PyGILState_Ensure();
-  
-  LOG(INFO) << "[" << omp_get_thread_num() << "/" << omp_get_thread_num() << "] (acquired)";
-#endif
+  // only acquire the GIL if python code is called from multiple threads, the
+  // main thread then has released the GIL, e.g. in MultipleInstances
+  if (locked_)
+    gstate_ = PyGILState_Ensure();
 
   // mainThreadState_ = PyEval_SaveThread();
 
@@ -842,9 +983,8 @@ PythonUtility::GlobalInterpreterLock::~GlobalInterpreterLock() {
    // Release the thread. No Python API allowed beyond this point.
    if (nGilsThreads_[omp_get_thread_num()] == 0)
    {*/
-#if 0 
-  PyGILState_Release(gstate_);
-#endif
+  if (locked_)
+    PyGILState_Release(gstate_);
 }
 
 std::ostream &operator<<(std::ostream &stream, PyObject *object) {
@@ -153,6 +153,15 @@ public:
     static PyObject *get(T value);
   };
 
+  template <typename T, typename Enable = void> struct convertFromBuffer {
+    //! convert a python object that supports the buffer protocol, e.g. a numpy
+    //! array, to a vector by copying the raw data, without converting every
+    //! entry to a python object. Returns false if the object provides no
+    //! numeric buffer or T is no numeric type, then the entries have to be
+    //! converted one by one.
+    static bool get(PyObject *object, std::vector<T> &values) { return false; }
+  };
+
   //! create a python list out of the double vector
   static PyObject *convertToPythonList(std::vector<double> &data);
 
@@ -182,6 +191,17 @@ public:
   //! create a python list from a double *
   static PyObject *convertToPythonList(double *value, int nValues);
 
+  //! create a two-dimensional array with shape (nRows, nColumns) that directly
+  //! references the row-major data without copying. This is a numpy array if
+  //! numpy can be imported, otherwise a memoryview. The array must not be used
+  //! any more after data was deallocated.
+  static PyObject *createArrayView(double *data, int nRows, int nColumns,
+                                   bool writable = true);
+
+  //! create a numpy array out of the vector, or a list if numpy is not
+  //! available
+  static PyObject *convertToPythonArray(std::vector<global_no_t> &data);
+
   //! convert a PyUnicode object to a std::string
   static std::string pyUnicodeToString(PyObject *object);
 
@@ -206,8 +226,16 @@ public:
     //! destructor
     ~GlobalInterpreterLock();
 
+    //! set if python code is currently called from multiple threads. Only
+    //! then the GIL is acquired and released by objects of this class. The
+    //! main thread has to release the GIL by PyEval_SaveThread before.
+    static void setMultithreaded(bool multithreaded);
+
   private:
     PyGILState_STATE gstate_;
+    bool locked_; //< if the GIL was acquired by this object
+
+    static bool multithreaded_; //< if multiple threads call python code
     // static int nGILS_;
     // static std::map<int, int> nGilsThreads_;
     // PyThreadState *mainThreadState_;
@@ -220,6 +248,31 @@ public:
   };
 
 private:
+  //! get the numpy module, NULL if it cannot be imported or if
+  //! sys.modules["numpy"] is None, borrowed reference
+  static PyObject *numpyModule();
+
+  //! get the buffer of a python object that supports the buffer protocol and
+  //! set data to its C-contiguous data, non-contiguous buffers are copied to
+  //! contiguousData. format is the element type in the syntax of the struct
+  //! module. Returns false if the object provides no numeric buffer, otherwise
+  //! the buffer has to be released by PyBuffer_Release.
+  static bool getBuffer(PyObject *object, Py_buffer &buffer, const char *&data,
+                        char &format, std::vector<char> &contiguousData);
+
+  //! convert all entries of the buffer with given data and format to
+  //! ValueType and store them in values, which has to be large enough.
+  //! Returns false if the format is not supported.
+  template <typename ValueType>
+  static bool copyBufferValues(const Py_buffer &buffer, const char *data,
+                               char format, ValueType *values);
+
+  //! convert nValues entries of type SourceType to ValueType, returns false if
+  //! the item size of the buffer does not match SourceType
+  template <typename SourceType, typename ValueType>
+  static bool convertBufferValues(const char *data, Py_ssize_t itemSize,
+                                  Py_ssize_t nValues, ValueType *values);
+
   static PyObject
       *itemList; //< list of items (key,value) for dictionary,  to use for
                  // getOptionDictBegin, getOptionDictEnd, getOptionDictNext
@@ -234,5 +287,6 @@ private:
 std::ostream &operator<<(std::ostream &stream, PyObject *object);
 
 #include "utility/python_utility.tpp"
+#include "utility/python_utility_convert_buffer.tpp"
 #include "utility/python_utility_convert_scalar.tpp"
 #include "utility/python_utility_convert_lists.tpp"
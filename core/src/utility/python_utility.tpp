@@ -19,7 +19,7 @@ std::pair<Key, Value> PythonUtility::getOptionDictBegin(
 
   if (settings && PyDict_Check(settings)) {
     // start critical section for python API calls
-    // PythonUtility::GlobalInterpreterLock lock;
+    PythonUtility::GlobalInterpreterLock lock;
 
     // check if input dictionary contains the key
     PyObject *key = PyUnicode_FromString(keyString.c_str());
@@ -71,7 +71,7 @@ void PythonUtility::getOptionDictNext(const PyObject *settings,
   itemListIndex++;
 
   // start critical section for python API calls
-  // PythonUtility::GlobalInterpreterLock lock;
+  PythonUtility::GlobalInterpreterLock lock;
 
   if (itemListIndex < PyList_Size(itemList)) {
     PyObject *tuple = PyList_GetItem(itemList, (Py_ssize_t)itemListIndex);
@@ -89,7 +89,7 @@ Value PythonUtility::getOptionListBegin(const PyObject *settings,
                                         std::string pathString) {
   if (settings && PyDict_Check(settings)) {
     // start critical section for python API calls
-    // PythonUtility::GlobalInterpreterLock lock;
+    PythonUtility::GlobalInterpreterLock lock;
 
     // check if input dictionary contains the key
     PyObject *key = PyUnicode_FromString(keyString.c_str());
@@ -129,7 +129,7 @@ void PythonUtility::getOptionListNext(const PyObject *settings,
   listIndex++;
 
   // start critical section for python API calls
-  // PythonUtility::GlobalInterpreterLock lock;
+  PythonUtility::GlobalInterpreterLock lock;
 
   if (listIndex < PyList_Size(list)) {
     PyObject *item = PyList_GetItem(list, (Py_ssize_t)listIndex);
@@ -163,7 +163,7 @@ PythonUtility::getOptionArray(PyObject *settings, std::string keyString,
 
   if (settings) {
     // start critical section for python API calls
-    // PythonUtility::GlobalInterpreterLock lock;
+    PythonUtility::GlobalInterpreterLock lock;
 
     // check if input dictionary contains the key
     PyObject *key = PyUnicode_FromString(keyString.c_str());
@@ -246,32 +246,14 @@ void PythonUtility::getOptionVector(const PyObject *settings,
     if (PyDict_Contains((PyObject *)settings, key)) {
       // extract the value of the key and check its type
       PyObject *value = PyDict_GetItem((PyObject *)settings, key);
-      if (PyList_Check(value)) {
-        // it is a list
-        int listNEntries = PyList_Size(value);
-
-        // do nothing if it is an empty list
-        if (listNEntries == 0)
-          return;
-
-        // get the first value from the list
-        ValueType currentValue = PythonUtility::getOptionListBegin<ValueType>(
-            settings, keyString, pathString);
-
-        // loop over other values
-        for (;
-             !PythonUtility::getOptionListEnd(settings, keyString, pathString);
-             PythonUtility::getOptionListNext<ValueType>(
-                 settings, keyString, pathString, currentValue)) {
-          values.push_back(currentValue);
-        }
 
-        values = convertFromPython<std::vector<ValueType>>::get(value);
-      } else {
-        // Convert using the convertFromPython helper. This is less efficient
-        // because the vector gets copied.
-        values = convertFromPython<std::vector<ValueType>>::get(value);
-      }
+      // do nothing if it is an empty list
+      if (PyList_Check(value) && PyList_Size(value) == 0)
+        return;
+
+      // convert the whole list at once, numpy arrays are copied without
+      // iterating over the entries, see convertFromBuffer
+      values = convertFromPython<std::vector<ValueType>>::get(value);
     } else {
       LOG(WARNING) << "" << pathString << "[\"" << keyString
                    << "\"] not set in \"" << Control::settingsFileName
@@ -284,7 +266,7 @@ void PythonUtility::getOptionVector(const PyObject *settings,
 template <int D>
 PyObject *PythonUtility::convertToPythonList(std::array<long, D> &data) {
   // start critical section for python API calls
-  // PythonUtility::GlobalInterpreterLock lock;
+  PythonUtility::GlobalInterpreterLock lock;
 
   PyObject *result = PyList_New((Py_ssize_t)D);
   for (unsigned int i = 0; i < D; i++) {
@@ -297,7 +279,7 @@ PyObject *PythonUtility::convertToPythonList(std::array<long, D> &data) {
 template <int D>
 PyObject *PythonUtility::convertToPythonList(std::array<bool, D> &data) {
   // start critical section for python API calls
-  // PythonUtility::GlobalInterpreterLock lock;
+  PythonUtility::GlobalInterpreterLock lock;
 
   PyObject *result = PyList_New((Py_ssize_t)D);
   for (unsigned int i = 0; i < D; i++) {
@@ -0,0 +1,155 @@
+#include "utility/python_utility.h"
+
+#include <Python.h>
+#include "easylogging++.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <type_traits>
+
+template <typename SourceType, typename ValueType>
+bool PythonUtility::convertBufferValues(const char *data, Py_ssize_t itemSize,
+                                        Py_ssize_t nValues, ValueType *values) {
+  if (itemSize != (Py_ssize_t)sizeof(SourceType))
+    return false;
+
+  // if the types match, e.g. for float64 numpy arrays, copy the whole block
+  if (std::is_same<SourceType, ValueType>::value) {
+    memcpy(values, data, nValues * sizeof(ValueType));
+    return true;
+  }
+
+  for (Py_ssize_t i = 0; i < nValues; i++) {
+    // the data is not necessarily aligned for SourceType
+    SourceType value;
+    memcpy(&value, data + i * itemSize, sizeof(SourceType));
+    values[i] = static_cast<ValueType>(value);
+  }
+  return true;
+}
+
+template <typename ValueType>
+bool PythonUtility::copyBufferValues(const Py_buffer &buffer, const char *data,
+                                     char format, ValueType *values) {
+  const Py_ssize_t itemSize = buffer.itemsize;
+  const Py_ssize_t nValues = buffer.len / itemSize;
+
+  // the type codes are those of the struct module
+  switch (format) {
+  case 'd':
+    return convertBufferValues<double>(data, itemSize, nValues, values);
+  case 'f':
+    return convertBufferValues<float>(data, itemSize, nValues, values);
+  case 'b':
+    return convertBufferValues<signed char>(data, itemSize, nValues, values);
+  case 'B':
+    return convertBufferValues<unsigned char>(data, itemSize, nValues, values);
+  case '?':
+    return convertBufferValues<bool>(data, itemSize, nValues, values);
+  case 'h':
+    return convertBufferValues<short>(data, itemSize, nValues, values);
+  case 'H':
+    return convertBufferValues<unsigned short>(data, itemSize, nValues,
+                                               values);
+  case 'i':
+    return convertBufferValues<int>(data, itemSize, nValues, values);
+  case 'I':
+    return convertBufferValues<unsigned int>(data, itemSize, nValues, values);
+  case 'l':
+    return convertBufferValues<long>(data, itemSize, nValues, values);
+  case 'L':
+    return convertBufferValues<unsigned long>(data, itemSize, nValues, values);
+  case 'q':
+    return convertBufferValues<long long>(data, itemSize, nValues, values);
+  case 'Q':
+    return convertBufferValues<unsigned long long>(data, itemSize, nValues,
+                                                   values);
+  case 'n':
+    return convertBufferValues<Py_ssize_t>(data, itemSize, nValues, values);
+  case 'N':
+    return convertBufferValues<std::size_t>(data, itemSize, nValues, values);
+  default:
+    return false;
+  }
+}
+
+// partial specialization for numeric types
+template <typename T>
+struct PythonUtility::convertFromBuffer<
+    T, typename std::enable_if<std::is_arithmetic<T>::value &&
+                               !std::is_same<T, bool>::value>::type> {
+  //! convert a python object that supports the buffer protocol, e.g. a numpy
+  //! array, to a vector, multi-dimensional arrays are flattened in row-major
+  //! order
+  static bool get(PyObject *object, std::vector<T> &values) {
+    Py_buffer buffer;
+    const char *data = nullptr;
+    char format;
+    std::vector<char> contiguousData;
+    if (!getBuffer(object, buffer, data, format, contiguousData))
+      return false;
+
+    values.resize(buffer.len / buffer.itemsize);
+    bool successful = copyBufferValues(buffer, data, format, values.data());
+    PyBuffer_Release(&buffer);
+
+    if (!successful)
+      values.clear();
+    return successful;
+  }
+};
+
+// partial specialization for std::array of numeric types, e.g. Vec3
+template <typename T, std::size_t nComponents>
+struct PythonUtility::convertFromBuffer<
+    std::array<T, nComponents>,
+    typename std::enable_if<std::is_arithmetic<T>::value &&
+                            !std::is_same<T, bool>::value>::type> {
+  //! convert a python object that supports the buffer protocol to a vector of
+  //! arrays, every row of a two-dimensional array, e.g. a numpy array with
+  //! shape (nPoints,3), gives one entry. If a row has less than nComponents
+  //! values, the remaining components are set to 0, a one-dimensional array
+  //! is interpreted as a single column.
+  static bool get(PyObject *object,
+                  std::vector<std::array<T, nComponents>> &values) {
+    Py_buffer buffer;
+    const char *data = nullptr;
+    char format;
+    std::vector<char> contiguousData;
+    if (!getBuffer(object, buffer, data, format, contiguousData))
+      return false;
+
+    Py_ssize_t nColumns = 1;
+    if (buffer.ndim >= 2)
+      nColumns = buffer.shape[buffer.ndim - 1];
+    Py_ssize_t nRows = 0;
+    if (nColumns > 0)
+      nRows = buffer.len / buffer.itemsize / nColumns;
+
+    values.resize(nRows);
+    bool successful = true;
+    if (nRows == 0) {
+      // empty array, nothing to convert
+    } else if (nColumns == (Py_ssize_t)nComponents) {
+      // the rows have the layout of the arrays, convert directly into values
+      successful = copyBufferValues(buffer, data, format, values[0].data());
+    } else {
+      std::vector<T> bufferValues(nRows * nColumns);
+      successful = copyBufferValues(buffer, data, format, bufferValues.data());
+
+      Py_ssize_t nCopiedColumns = std::min(nColumns, (Py_ssize_t)nComponents);
+      for (Py_ssize_t rowNo = 0; rowNo < nRows; rowNo++) {
+        values[rowNo].fill(T());
+        std::copy(bufferValues.begin() + rowNo * nColumns,
+                  bufferValues.begin() + rowNo * nColumns + nCopiedColumns,
+                  values[rowNo].begin());
+      }
+    }
+    PyBuffer_Release(&buffer);
+
+    if (!successful)
+      values.clear();
+    return successful;
+  }
+};
@@ -22,7 +22,7 @@ struct PythonUtility::convertFromPython<std::array<ValueType, nComponents>> {
   get(PyObject *object, std::array<ValueType, nComponents> defaultValue,
       bool enableWarnings = true) {
     // start critical section for python API calls
-    // PythonUtility::GlobalInterpreterLock lock;
+    PythonUtility::GlobalInterpreterLock lock;
 
     std::array<ValueType, nComponents> result;
     assert(object != nullptr);
@@ -122,7 +122,7 @@ struct PythonUtility::convertFromPython<std::array<ValueType, nComponents>> {
   get(PyObject *object, std::array<ValueType, nComponents> defaultValue,
       bool enableWarnings = true) {
     // start critical section for python API calls
-    // PythonUtility::GlobalInterpreterLock lock;
+    PythonUtility::GlobalInterpreterLock lock;
 
     std::array<ValueType, nComponents> result;
     assert(object != nullptr);
@@ -220,9 +220,10 @@ struct PythonUtility::convertFromPython<std::array<ValueType, nComponents>> {
   get(PyObject *object, std::array<ValueType, nComponents> defaultValue,
       bool enableWarnings = true) {
     // start critical section for python API calls
-    // PythonUtility::GlobalInterpreterLock lock;
+    PythonUtility::GlobalInterpreterLock lock;
 
     std::array<ValueType, nComponents> result;
+    std::vector<ValueType> bufferValues;
     assert(object != nullptr);
     if (PyList_Check(object)) {
       unsigned long i = 0;
@@ -280,6 +281,26 @@ struct PythonUtility::convertFromPython<std::array<ValueType, nComponents>> {
         }
       }
       return result;
+    } else if (convertFromBuffer<ValueType>::get(object, bufferValues)) {
+      // numpy array of numbers
+      unsigned long i = 0;
+      unsigned long iEnd =
+          std::min((unsigned long)bufferValues.size(), nComponents);
+      for (; i < iEnd; i++) {
+        result[i] = bufferValues[i];
+      }
+
+      // fill rest of values with default values
+      for (; i < nComponents; i++) {
+        result[i] = defaultValue[i];
+      }
+      if (iEnd < nComponents && enableWarnings) {
+        LOG(WARNING) << "Python array only contains " << iEnd
+                     << " values, but " << nComponents
+                     << " are required. Filling rest with default values."
+                     << " Parsed values: " << result;
+      }
+      return result;
     } else {
       ValueType valueDouble = PythonUtility::convertFromPython<ValueType>::get(
           object, defaultValue[0]);
@@ -318,7 +339,7 @@ struct PythonUtility::convertFromPython<std::map<KeyType, ValueType>> {
   //! if conversion is not possible, use defaultValue
   static std::map<KeyType, ValueType> get(PyObject *object) {
     // start critical section for python API calls
-    // PythonUtility::GlobalInterpreterLock lock;
+    PythonUtility::GlobalInterpreterLock lock;
 
     std::map<KeyType, ValueType> result;
     assert(object != nullptr);
@@ -373,10 +394,15 @@ struct PythonUtility::convertFromPython<std::vector<ValueType>> {
   static std::vector<ValueType> get(PyObject *object,
                                     std::vector<ValueType> defaultValue) {
     // start critical section for python API calls
-    // PythonUtility::GlobalInterpreterLock lock;
+    PythonUtility::GlobalInterpreterLock lock;
 
     std::vector<ValueType> result;
     assert(object != nullptr);
+
+    // numpy arrays of numbers are copied directly
+    if (convertFromBuffer<ValueType>::get(object, result))
+      return result;
+
     if (PyList_Check(object)) {
       int nEntries = (int)PyList_Size(object);
       result.resize(nEntries);
@@ -434,10 +460,15 @@ struct PythonUtility::convertFromPython<std::vector<ValueType>> {
   //! convert a python object to its corresponding c type, with type checking
   static std::vector<ValueType> get(PyObject *object, ValueType defaultValue) {
     // start critical section for python API calls
-    // PythonUtility::GlobalInterpreterLock lock;
+    PythonUtility::GlobalInterpreterLock lock;
 
     std::vector<ValueType> result;
     assert(object != nullptr);
+
+    // numpy arrays of numbers are copied directly
+    if (convertFromBuffer<ValueType>::get(object, result))
+      return result;
+
     if (PyList_Check(object)) {
       int nEntries = (int)PyList_Size(object);
       result.resize(nEntries);
@@ -496,10 +527,15 @@ struct PythonUtility::convertFromPython<std::vector<ValueType>> {
   //! if conversion is not possible use trivial default value (0 or 0.0 or "")
   static std::vector<ValueType> get(PyObject *object) {
     // start critical section for python API calls
-    // PythonUtility::GlobalInterpreterLock lock;
+    PythonUtility::GlobalInterpreterLock lock;
 
     std::vector<ValueType> result;
     assert(object != nullptr);
+
+    // numpy arrays of numbers are copied directly
+    if (convertFromBuffer<ValueType>::get(object, result))
+      return result;
+
     if (PyList_Check(object)) {
       int nEntries = (int)PyList_Size(object);
       result.resize(nEntries);
@@ -564,7 +600,7 @@ struct PythonUtility::convertFromPython<
   //! if conversion is not possible use trivial default value (0 or 0.0 or "")
   static std::vector<std::pair<KeyType, ValueType>> get(PyObject *object) {
     // start critical section for python API calls
-    // PythonUtility::GlobalInterpreterLock lock;
+    PythonUtility::GlobalInterpreterLock lock;
 
     std::vector<std::pair<KeyType, ValueType>> result;
     assert(object != nullptr);
@@ -629,7 +665,7 @@ struct PythonUtility::convertFromPython<std::pair<ValueType1, ValueType2>> {
   static std::pair<ValueType1, ValueType2>
   get(PyObject *object, std::pair<ValueType1, ValueType2> defaultValue) {
     // start critical section for python API calls
-    // PythonUtility::GlobalInterpreterLock lock;
+    PythonUtility::GlobalInterpreterLock lock;
 
     std::pair<ValueType1, ValueType2> result;
     assert(object != nullptr);
@@ -693,7 +729,7 @@ struct PythonUtility::convertFromPython<std::tuple<ValueTypes...>> {
   //! if conversion is not possible, use defaultValue
   static std::tuple<ValueTypes...> get(PyObject *object) {
     // start critical section for python API calls
-    // PythonUtility::GlobalInterpreterLock lock;
+    PythonUtility::GlobalInterpreterLock lock;
 
     std::tuple<ValueTypes...> result;
     assert(object != nullptr);
@@ -22,7 +22,7 @@ template <> struct PythonUtility::convertFromPython<long> {
       return defaultValue;
 
     // start critical section for python API calls
-    // PythonUtility::GlobalInterpreterLock lock;
+    PythonUtility::GlobalInterpreterLock lock;
 
     assert(object != nullptr);
     if (PyLong_Check(object)) {
@@ -42,6 +42,16 @@ template <> struct PythonUtility::convertFromPython<long> {
     } else if (PyUnicode_Check(object)) {
       std::string valueString = pyUnicodeToString(object);
       return atoi(valueString.c_str());
+    } else if (PyIndex_Check(object)) {
+      // other integers like numpy.int64
+      PyObject *valueIndex = PyNumber_Index(object);
+      if (valueIndex != NULL) {
+        long valueLong = PyLong_AsLong(valueIndex);
+        Py_CLEAR(valueIndex);
+        return valueLong;
+      }
+      PyErr_Clear();
+      LOG(WARNING) << "convertFromPython<long>: object is no long: " << object;
     } else if (object == Py_None) {
       LOG(DEBUG) << "convertFromPython<long>: object is None, parse as -1";
       return -1; // None translates to -1
@@ -67,7 +77,7 @@ template <> struct PythonUtility::convertFromPython<int> {
       return defaultValue;
 
     // start critical section for python API calls
-    // PythonUtility::GlobalInterpreterLock lock;
+    PythonUtility::GlobalInterpreterLock lock;
 
     assert(object != nullptr);
     if (PyLong_Check(object)) {
@@ -86,6 +96,16 @@ template <> struct PythonUtility::convertFromPython<int> {
     } else if (PyUnicode_Check(object)) {
       std::string valueString = pyUnicodeToString(object);
       return atoi(valueString.c_str());
+    } else if (PyIndex_Check(object)) {
+      // other integers like numpy.int32
+      PyObject *valueIndex = PyNumber_Index(object);
+      if (valueIndex != NULL) {
+        long valueLong = PyLong_AsLong(valueIndex);
+        Py_CLEAR(valueIndex);
+        return int(valueLong);
+      }
+      PyErr_Clear();
+      LOG(WARNING) << "convertFromPython<int>: object is no int: " << object;
     } else if (object == Py_None) {
       LOG(DEBUG) << "convertFromPython<int>: object is None, parse as -1";
       return -1; // None translates to -1
@@ -111,7 +131,7 @@ template <> struct PythonUtility::convertFromPython<double> {
       return defaultValue;
 
     // start critical section for python API calls
-    // PythonUtility::GlobalInterpreterLock lock;
+    PythonUtility::GlobalInterpreterLock lock;
 
     if (PyFloat_Check(object)) {
       double valueDouble = PyFloat_AsDouble(object);
@@ -129,17 +149,17 @@ template <> struct PythonUtility::convertFromPython<double> {
     } else if (PyComplex_Check(object)) {
       return PyComplex_RealAsDouble(object);
     }
-    /*
-  #ifdef HAVE_NUMPYC
-    else if (PyArray_Check(object))
-    {
-      //if (object->descr->type_num != NPY_DOUBLE || vec->nd != 1)  {
-
-      LOG(WARNING) << "convertFromPython: object is a numpy array: " << object;
-    }
-  #endif
-  */
-    else {
+    else if (PyNumber_Check(object)) {
+      // other numbers like numpy.float32 or numpy.int64
+      PyObject *valueFloat = PyNumber_Float(object);
+      if (valueFloat != NULL) {
+        double valueDouble = PyFloat_AsDouble(valueFloat);
+        Py_CLEAR(valueFloat);
+        return valueDouble;
+      }
+      PyErr_Clear();
+      LOG(WARNING) << "convertFromPython: object is no double: " << object;
+    } else {
       LOG(WARNING) << "convertFromPython: object is no double: " << object;
     }
     return defaultValue;
@@ -162,7 +182,7 @@ template <> struct PythonUtility::convertFromPython<std::string> {
       return defaultValue;
 
     // start critical section for python API calls
-    // PythonUtility::GlobalInterpreterLock lock;
+    PythonUtility::GlobalInterpreterLock lock;
 
     if (PyUnicode_Check(object)) {
       // if it is a string, directly use it
@@ -201,7 +221,7 @@ template <> struct PythonUtility::convertFromPython<global_no_t> {
       return defaultValue;
 
     // start critical section for python API calls
-    // PythonUtility::GlobalInterpreterLock lock;
+    PythonUtility::GlobalInterpreterLock lock;
 
     if (PyLong_Check(object)) {
       long valueLong = PyLong_AsLong(object);
@@ -221,6 +241,16 @@ template <> struct PythonUtility::convertFromPython<global_no_t> {
     } else if (PyUnicode_Check(object)) {
       std::string valueString = pyUnicodeToString(object);
       return atoi(valueString.c_str());
+    } else if (PyIndex_Check(object)) {
+      // other integers like numpy.int64
+      PyObject *valueIndex = PyNumber_Index(object);
+      if (valueIndex != NULL) {
+        long long valueLong = PyLong_AsLongLong(valueIndex);
+        Py_CLEAR(valueIndex);
+        return global_no_t(valueLong);
+      }
+      PyErr_Clear();
+      LOG(WARNING) << "convertFromPython: object is no long int: " << object;
     } else {
       LOG(WARNING) << "convertFromPython: object is no long int: " << object;
     }
@@ -243,7 +273,7 @@ template <> struct PythonUtility::convertFromPython<std::size_t> {
       return defaultValue;
 
     // start critical section for python API calls
-    // PythonUtility::GlobalInterpreterLock lock;
+    PythonUtility::GlobalInterpreterLock lock;
 
     if (PyLong_Check(object)) {
       long valueLong = PyLong_AsLong(object);
@@ -284,7 +314,7 @@ template <> struct PythonUtility::convertFromPython<long long> {
       return defaultValue;
 
     // start critical section for python API calls
-    // PythonUtility::GlobalInterpreterLock lock;
+    PythonUtility::GlobalInterpreterLock lock;
 
     if (PyLong_Check(object)) {
       long long valueLong = PyLong_AsLongLong(object);
@@ -339,7 +369,7 @@ template <> struct PythonUtility::convertFromPython<bool> {
       return defaultValue;
 
     // start critical section for python API calls
-    // PythonUtility::GlobalInterpreterLock lock;
+    PythonUtility::GlobalInterpreterLock lock;
 
     if (PyBool_Check(object)) {
       if (object == Py_True) {
@@ -16,6 +16,11 @@ std::string extractUntil(std::string &line, std::string key);
 //! remove whitespace (' ', '\t', '\n') at the beginning and end of the string
 void trim(std::string &str);
 
+//! parse all whitespace separated numbers in line and append them to values,
+//! without copying substrings, a token that is no number gives 0
+template <typename T>
+void appendNumbers(const std::string &line, std::vector<T> &values);
+
 //! output the values separated by spaces, after nValuesPerRow there will be a
 //! line break, disabled if -1
 template <typename IterType>
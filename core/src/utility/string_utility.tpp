@@ -3,9 +3,33 @@
 #include <iostream>
 #include <algorithm>
 #include <iomanip>
+#include <cctype>
+#include <cstdlib>
 
 namespace StringUtility {
 
+template <typename T>
+void appendNumbers(const std::string &line, std::vector<T> &values) {
+  const char *position = line.c_str();
+  for (;;) {
+    while (isspace((unsigned char)*position))
+      position++;
+    if (*position == '\0')
+      break;
+
+    char *end = nullptr;
+    double value = strtod(position, &end);
+    if (end == position) {
+      // skip the token that could not be parsed
+      value = 0;
+      while (*end != '\0' && !isspace((unsigned char)*end))
+        end++;
+    }
+    values.push_back(static_cast<T>(value));
+    position = end;
+  }
+}
+
 template <typename IterType>
 void outputValuesBlock(std::ostream &stream, IterType valuesBegin,
                        IterType valuesEnd, int nValuesPerRow) {
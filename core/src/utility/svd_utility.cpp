@@ -12,6 +12,8 @@
 #include <fstream>
 #include <algorithm>
 #include <sstream>
+#include <cmath>
+#include <limits>
 
 using namespace std;
 
@@ -178,6 +180,174 @@ void SvdUtility::printMatrix(std::string name, double input[], int rows,
   cout << endl;
 }
 
+// takes real matrix input (rows x cols) as double[] in column major order
+// performs singular-value decomposition by one-sided Jacobi rotations, which
+// does not need LAPACK and is accurate for the small matrices of incremental
+// SVD updates, stores the left-singular vectors (column-wise, rows x cols) and
+// the singular values in descending order
+void SvdUtility::getSVDJacobi(double input[], int rows, int cols,
+                              double leftSingVec[], double singVal[]) {
+  vector<double> columns(input, input + rows * cols);
+  const double epsilon = 1e-15;
+  const int maxSweeps = 60;
+
+  // orthogonalize all pairs of columns until no rotation is necessary
+  for (int sweepNo = 0; sweepNo < maxSweeps; ++sweepNo) {
+    bool rotated = false;
+    for (int p = 0; p < cols - 1; ++p) {
+      for (int q = p + 1; q < cols; ++q) {
+        double alpha = 0, beta = 0, gamma = 0;
+        for (int row = 0; row < rows; ++row) {
+          alpha += columns[p * rows + row] * columns[p * rows + row];
+          beta += columns[q * rows + row] * columns[q * rows + row];
+          gamma += columns[p * rows + row] * columns[q * rows + row];
+        }
+        if (fabs(gamma) <= epsilon * sqrt(alpha * beta) || gamma == 0)
+          continue;
+
+        rotated = true;
+        double zeta = (beta - alpha) / (2 * gamma);
+        double t = (zeta >= 0 ? 1.0 : -1.0) /
+                   (fabs(zeta) + sqrt(1 + zeta * zeta));
+        double c = 1 / sqrt(1 + t * t);
+        double s = c * t;
+        for (int row = 0; row < rows; ++row) {
+          double valueP = columns[p * rows + row];
+          double valueQ = columns[q * rows + row];
+          columns[p * rows + row] = c * valueP - s * valueQ;
+          columns[q * rows + row] = s * valueP + c * valueQ;
+        }
+      }
+    }
+    if (!rotated)
+      break;
+  }
+
+  // the singular values are the norms of the columns, sort them descending
+  vector<double> norms(cols);
+  vector<int> order(cols);
+  for (int col = 0; col < cols; ++col) {
+    double norm = 0;
+    for (int row = 0; row < rows; ++row)
+      norm += columns[col * rows + row] * columns[col * rows + row];
+    norms[col] = sqrt(norm);
+    order[col] = col;
+  }
+  std::sort(order.begin(), order.end(),
+            [&norms](int a, int b) { return norms[a] > norms[b]; });
+
+  for (int col = 0; col < cols; ++col) {
+    int colNo = order[col];
+    singVal[col] = norms[colNo];
+    for (int row = 0; row < rows; ++row) {
+      leftSingVec[col * rows + row] =
+          norms[colNo] > 0 ? columns[colNo * rows + row] / norms[colNo] : 0;
+    }
+  }
+}
+
+// takes real matrix basis (rows x cols) as double[] in column major order
+// selects one row index per column with the greedy discrete empirical
+// interpolation method (DEIM): the next index is the position of the largest
+// entry of the residual of interpolating the next column by the previous ones
+std::vector<int> SvdUtility::getDEIMIndices(double basis[], int rows,
+                                            int cols) {
+  vector<int> indices;
+  vector<double> residual(basis, basis + rows);
+
+  for (int col = 0; col < cols; ++col) {
+    if (col > 0) {
+      // interpolation matrix P^T U and right hand side P^T u of the column
+      int n = col;
+      vector<double> matrix(n * n);
+      vector<double> coefficients(n);
+      for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j)
+          matrix[j * n + i] = basis[j * rows + indices[i]];
+        coefficients[i] = basis[col * rows + indices[i]];
+      }
+      if (!solveLinearSystem(matrix.data(), n, coefficients.data(), 1)) {
+        LOG(FATAL) << "The first " << n << " columns of the DEIM basis are "
+                   << "linearly dependent, no further DEIM index can be "
+                   << "selected.";
+      }
+
+      // residual r = u - U c
+      for (int row = 0; row < rows; ++row) {
+        residual[row] = basis[col * rows + row];
+        for (int j = 0; j < n; ++j)
+          residual[row] -= basis[j * rows + row] * coefficients[j];
+      }
+    }
+
+    int index = 0;
+    for (int row = 1; row < rows; ++row) {
+      if (fabs(residual[row]) > fabs(residual[index]))
+        index = row;
+    }
+    indices.push_back(index);
+  }
+  return indices;
+}
+
+// takes real matrix (n x n) as double[] in column major order and the right
+// hand sides (n x nRhs), solves the systems by Gaussian elimination with
+// partial pivoting, overwrites matrix and stores the solutions in rhs
+// returns false and leaves rhs unsolved if the matrix is numerically singular
+bool SvdUtility::solveLinearSystem(double matrix[], int n, double rhs[],
+                                   int nRhs) {
+  // pivots below this tolerance relative to the largest entry are treated as
+  // zero
+  double maximumEntry = 0;
+  for (int i = 0; i < n * n; ++i)
+    maximumEntry = std::max(maximumEntry, fabs(matrix[i]));
+  const double pivotTolerance =
+      n * std::numeric_limits<double>::epsilon() * maximumEntry;
+
+  for (int col = 0; col < n; ++col) {
+    // find pivot row
+    int pivot = col;
+    for (int row = col + 1; row < n; ++row) {
+      if (fabs(matrix[col * n + row]) > fabs(matrix[col * n + pivot]))
+        pivot = row;
+    }
+    if (fabs(matrix[col * n + pivot]) <= pivotTolerance) {
+      LOG(ERROR) << "Matrix is singular, pivot " << matrix[col * n + pivot]
+                 << " in column " << col << " of " << n
+                 << ", solveLinearSystem is not possible.";
+      return false;
+    }
+
+    // swap rows
+    if (pivot != col) {
+      for (int j = 0; j < n; ++j)
+        std::swap(matrix[j * n + col], matrix[j * n + pivot]);
+      for (int j = 0; j < nRhs; ++j)
+        std::swap(rhs[j * n + col], rhs[j * n + pivot]);
+    }
+
+    // eliminate entries below the pivot
+    for (int row = col + 1; row < n; ++row) {
+      double factor = matrix[col * n + row] / matrix[col * n + col];
+      for (int j = col; j < n; ++j)
+        matrix[j * n + row] -= factor * matrix[j * n + col];
+      for (int j = 0; j < nRhs; ++j)
+        rhs[j * n + row] -= factor * rhs[j * n + col];
+    }
+  }
+
+  // back substitution
+  for (int j = 0; j < nRhs; ++j) {
+    for (int row = n - 1; row >= 0; --row) {
+      double value = rhs[j * n + row];
+      for (int col = row + 1; col < n; ++col)
+        value -= matrix[col * n + row] * rhs[j * n + col];
+      rhs[j * n + row] = value / matrix[row * n + row];
+    }
+  }
+  return true;
+}
+
 // reads CSV cell by cell as vector
 std::vector<double> SvdUtility::readCSV(string filename) {
   ifstream data(filename);
@@ -31,6 +31,14 @@ public:
 
   static void printMatrix(std::string name, double input[], int rows, int cols);
 
+  static void getSVDJacobi(double input[], int rows, int cols,
+                           double leftSingVec[], double singVal[]);
+
+  static vector<int> getDEIMIndices(double basis[], int rows, int cols);
+
+  static bool solveLinearSystem(double matrix[], int n, double rhs[],
+                                int nRhs);
+
   static vector<double> readCSV(string filename);
 
   static vector<double> readCSV(string filename, int rows);
@@ -21,6 +21,11 @@ rm  -rf out_snapshots
 #cp ./out/*.py ./out_snapshots
 #python ../../scripts/snapshots.py ./out_snapshots
 
+# creating the snapshots of the nonlinear term for DEIM, needs
+# write_nonlinear_snapshots = True in the settings of the full-order run,
+# then set nonlinear_snapshots_file in settings_hodgkin_huxley_pod.py
+#python ../scripts/nonlinear_snapshots.py --path ./out/nonlinear/ --output ./out/nonlinear_snapshots.csv
+
 # run the reduced-order scheme
 #./hodgkin_huxley_pod ../settings_hodgkin_huxley_pod.py
   
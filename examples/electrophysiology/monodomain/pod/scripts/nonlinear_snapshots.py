@@ -0,0 +1,85 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+#
+# Create the snapshots of the nonlinear term (the CellML right hand side) for
+# the DEIM hyper-reduction, option "nonlinearSnapshots" of ModelOrderReduction.
+#
+# Input are the output files of the CellML term of the full-order scheme,
+# written after every time step by an ExplicitEuler scheme (set
+# write_nonlinear_snapshots = True in settings_hodgkin_huxley.py). Two
+# consecutive files of the same call to the CellML term differ only by one
+# explicit Euler step, u_{i+1} = u_i + dt*f(u_i), such that
+# f(u_i) = (u_{i+1} - u_i)/dt. Pairs where the diffusion term was computed in
+# between are detected by the time step number and skipped. States that are
+# set by the setSpecificStates callback are included in the difference.
+#
+# Arguments: [--path <path>] [--output <filename>]
+#
+
+import sys
+import numpy as np
+import csv
+import os
+from argparse import ArgumentParser
+import py_reader
+import json
+
+parser=ArgumentParser()
+parser.add_argument('--path')
+parser.add_argument('--output')
+args=parser.parse_args()
+
+if args.path is not None:
+  path = args.path
+else:
+  path='./'
+
+if args.output is not None:
+  output_filename = args.output
+else:
+  output_filename = path + 'nonlinear_snapshots.csv'
+
+# get the python output files in the directory, sorted by number in file name
+solution_files = sorted([filename for filename in os.listdir(path) if ".py" in filename])
+
+print("{} files".format(len(solution_files)))
+
+data = []
+for solution in solution_files:
+  with open(path + solution,'rt') as f:
+    data.append(json.load(f))
+
+if len(data) == 0:
+  print("no data found.")
+  sys.exit(0)
+
+def get_states(dataset):
+  values = py_reader.get_values(dataset, "solution", "V")
+  values += py_reader.get_values(dataset, "solution", "m")
+  values += py_reader.get_values(dataset, "solution", "h")
+  values += py_reader.get_values(dataset, "solution", "n")
+  return np.array(values)
+
+n_snapshots = 0
+with open(output_filename, "wt") as csvfile:
+  csvwriter = csv.writer(csvfile, delimiter=',', quotechar='"', quoting=csv.QUOTE_MINIMAL)
+  for dataset, next_dataset in zip(data[:-1], data[1:]):
+    
+    # only use consecutive time steps of the same call to the CellML term
+    if next_dataset["timeStepNo"] != dataset["timeStepNo"] + 1:
+      continue
+    
+    dt = next_dataset["currentTime"] - dataset["currentTime"]
+    if dt <= 0:
+      continue
+    
+    rhs = (get_states(next_dataset) - get_states(dataset)) / dt
+    csvwriter.writerow(list(rhs))
+    n_snapshots += 1
+
+print("wrote {} snapshots of the nonlinear term to \"{}\"".format(n_snapshots, output_filename))
+if n_snapshots == 0:
+  print("no consecutive time steps found, the CellML term needs at least 2 time steps per splitting step and an output writer with outputInterval 1.")
+
+sys.exit(0)
@@ -30,6 +30,7 @@ dt_0D = 0.002                     # timestep width of ODEs
 dt_3D = dt_1D                      # overall timestep width of splitting
 
 output_timestep = 1e-1            # timestep for output files
+write_nonlinear_snapshots = False # write every time step of the CellML term to out/nonlinear/, for scripts/nonlinear_snapshots.py
 
 # input files
 #cellml_file = "../../../input/shorten_ocallaghan_davidson_soboleva_2007.c"
@@ -247,7 +248,9 @@ config = {
         "OutputWriter" : [
           #{"format": "PythonFile", "outputInterval": int(1./dt_0D*output_timestep), "filename": "out/states", "binary": False, "onlyNodalValues": True},
           {"format": "PythonFile", "outputInterval": 50, "filename": "out/states", "binary": False, "onlyNodalValues": True},
-        ],
+        ] + ([
+          {"format": "PythonFile", "outputInterval": 1, "filename": "out/nonlinear/states", "binary": False, "onlyNodalValues": True},
+        ] if write_nonlinear_snapshots else []),
       },
     },
     "Term2": {     # Diffusion
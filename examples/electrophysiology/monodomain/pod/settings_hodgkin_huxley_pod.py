@@ -11,6 +11,8 @@ n_elements = 100 # elements of pysical mesh
 n_total = 403 # rows of the snapshot matrix
 n_reduced = 99 # number of reduced bases, columns of the left singular vector, is equal to n_reduced+1
 snapshots_file = "./out/snapshots.csv"
+nonlinear_snapshots_file = ""   # snapshots of the cellml rhs for DEIM hyper-reduction, created by scripts/nonlinear_snapshots.py, "" = evaluate the full rhs
+n_deim = n_reduced              # number of DEIM bases, i.e. sampled rows of the rhs
 
 # global parameters
 PMax = 7.3              # maximum stress [N/cm^2]
@@ -217,6 +219,8 @@ config = {
         "nRowsSnapshots" : n_total,
         "nReducedBases" : n_reduced,
         "snapshots" : snapshots_file,
+        "nonlinearSnapshots" : nonlinear_snapshots_file,
+        "nDeimBases" : n_deim,
         "nRowsComponents" : 1,
         "ExplicitEuler" : {
           "timeStepWidth": dt_0D,  # 5e-5
@@ -137,7 +137,11 @@ config = {
     "seedPoints":           seed_points,                  # a list of seed points where to start the fibers
     "maxIterations":        5e5,                          # the maximum number of iterations for tracing a single fiber
     "useGradientField":     use_gradient_field,           # if the computed gradient field should be used, There are 2 implementations of streamline tracing. The first one (useGradientField_) uses a precomputed gradient field that is interpolated linearly and the second uses the gradient directly from the Laplace solution field. // The first one seems more stable, because the gradient is zero and the position of the boundary conditions.
-    "lineStepWidth":        1e-1,                         # the step width of the tracing
+    "lineStepWidth":        1e-1,                         # the step width of the tracing, for "RungeKutta45" this is the initial step width
+    "integrationScheme":    "ExplicitEuler",              # "ExplicitEuler" with fixed lineStepWidth or "RungeKutta45" with adaptive step width (Dormand-Prince), the points are resampled to targetElementLength afterwards
+    "integrationTolerance": 1e-5,                         # only for "RungeKutta45": tolerance of the local error of a step, i.e. the distance between the 4th and 5th order points
+    "maxLineStepWidth":     1.0,                          # only for "RungeKutta45": maximum step width, default 10*lineStepWidth
+    "nThreads":             1,                            # number of threads that trace the streamlines of the seed points in parallel, 0 for all OpenMP threads (OMP_NUM_THREADS), while tracing, the warnings are collected and logged afterwards
     "targetElementLength":  target_element_length,        # length per element, i.e. distance between nodes, length = 1/100 cm (100 per cm)
     "targetLength":         target_fiber_length,          # length of longest streamline, all streamlines are equally scaled to fit this value, set to 0 to disable
     "discardRelativeLength": 0.7,                         # a relative length (in [0,1]), at the end streamlines are dropped that are smaller than this relative length times the median fiber length
@@ -0,0 +1,38 @@
+/*
+   There are a total of 1 entries in the algebraic variable array.
+   There are a total of 2 entries in each of the rate and state variable arrays.
+   There are a total of 4 entries in the constant variable array.
+ */
+/*
+ * VOI is time in component environment (millisecond).
+ * STATES[0] is y0 in component power (dimensionless).
+ * STATES[1] is y1 in component power (dimensionless).
+ * CONSTANTS[0] is k in component power (per_millisecond).
+ * CONSTANTS[1] is p in component power (dimensionless).
+ * CONSTANTS[2] is q in component power (dimensionless).
+ * CONSTANTS[3] is i_Stim in component power (per_millisecond).
+ * ALGEBRAIC[0] is y0_p in component power (dimensionless).
+ * RATES[0] is d/dt y0 in component power (dimensionless).
+ * RATES[1] is d/dt y1 in component power (dimensionless).
+ */
+void
+initConsts(double* CONSTANTS, double* RATES, double *STATES)
+{
+STATES[0] = 4;
+STATES[1] = 4;
+CONSTANTS[0] = 0.5;
+CONSTANTS[1] = 1.5;
+CONSTANTS[2] = 2;
+CONSTANTS[3] = 0;
+}
+void
+computeRates(double VOI, double* CONSTANTS, double* RATES, double* STATES, double* ALGEBRAIC)
+{
+RATES[0] = CONSTANTS[3] -  CONSTANTS[0]*pow(STATES[0], CONSTANTS[1]);
+RATES[1] = -  CONSTANTS[0]*pow(STATES[1], CONSTANTS[2]);
+}
+void
+computeVariables(double VOI, double* CONSTANTS, double* RATES, double* STATES, double* ALGEBRAIC)
+{
+ALGEBRAIC[0] = pow(STATES[0], CONSTANTS[1]);
+}
@@ -3,6 +3,7 @@
 #include <iostream>
 #include <cstdlib>
 #include <fstream>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "opendihu.h"
@@ -77,6 +78,74 @@ config = {
   assertFileMatchesContent("out_0000009.py", referenceOutput);
 }
 
+TEST(CellMLTest, HodgkinHuxleySimdEliminateUnusedAlgebraics) {
+  // delete so libraries from previous runs
+  int ret = system("rm lib/*.so");
+  std::cout << "deleted old library files: "
+            << (ret == 0 ? "yes" : "no there were none") << std::endl;
+
+  std::string pythonConfig = R"(
+
+# timing parameters
+stimulation_frequency = 10.0      # [1/ms] frequency if which stimulation current can be switched on and off
+dt_0D = 5e-5                      # timestep width of ODEs, cellml integration
+
+# CellML Hodgkin-Huxley from cpp file
+config = {
+  "ExplicitEuler" : {
+    "timeStepWidth": 1e-5,
+    "endTime" : 1.0,
+    "initialValues": [],
+    "timeStepOutputInterval": 1e5,
+
+    "OutputWriter" : [
+      {"format": "PythonFile", "filename": "out", "binary": False, "outputInterval": 1e4}
+    ],
+
+    "CellML" : {
+      "modelFilename": "../input/hodgkin_huxley_1952.c",
+      "optimizationType": "simd",
+      "optimizeSourceCode": True,
+      "eliminateUnusedAlgebraics": True,
+      "setParametersCallInterval": 1e3,
+      "useGivenLibrary": False,
+      #"statesInitialValues": [-75,  .05, 0.6, 0.325],
+      "statesInitialValues": [-20, 0.05, 0.6, 0.325],
+      "parametersInitialValues": [400.0],      # initial values for the parameters: I_Stim
+      #"setParametersFunction": set_parameters,    # callback function that sets parameters like stimulation current
+      #"setParametersCallInterval": 1./stimulation_frequency/dt_0D,     # set_parameters should be called every 0.1, 5e-5 * 1e3 = 5e-2 = 0.05
+
+      "parametersUsedAsAlgebraic": [],       # list of algebraic value indices, that will be set by parameters. Explicitely defined parameters that will be copied to algebraics, this vector contains the indices of the algebraic array. This is ignored if the input is generated from OpenCMISS generated c code.
+      "parametersUsedAsConstant": [2],           # list of constant value indices, that will be set by parameters. This is ignored if the input is generated from OpenCMISS generated c code.
+    },
+  }
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  TimeSteppingScheme::ExplicitEuler<CellmlAdapter<4>> problem(settings);
+
+  problem.run();
+
+  std::string referenceOutput =
+      "{\"meshType\": \"StructuredRegularFixed\", \"dimension\": 1, "
+      "\"nElementsGlobal\": [0], \"nElementsLocal\": [0], "
+      "\"beginNodeGlobalNatural\": [0], \"hasFullNumberOfNodes\": [true], "
+      "\"basisFunction\": \"Lagrange\", \"basisOrder\": 1, "
+      "\"onlyNodalValues\": true, \"nRanks\": 1, \"ownRankNo\": 0, \"data\": "
+      "[{\"name\": \"geometry\", \"components\": [{\"name\": \"x\", "
+      "\"values\": [0.0]}, {\"name\": \"y\", \"values\": [0.0]}, {\"name\": "
+      "\"z\", \"values\": [0.0]}]}, {\"name\": \"solution\", \"components\": "
+      "[{\"name\": \"membrane/V\", \"values\": [36.18142823585638]}, "
+      "{\"name\": \"sodium_channel_m_gate/m\", \"values\": "
+      "[0.9987345768519429]}, {\"name\": \"sodium_channel_h_gate/h\", "
+      "\"values\": [0.2446134695357078]}, {\"name\": "
+      "\"potassium_channel_n_gate/n\", \"values\": [0.5789949501440312]}]}], "
+      "\"timeStepNo\": 90001, \"currentTime\": 0.90001}";
+  assertFileMatchesContent("out_0000009.py", referenceOutput);
+}
+
 TEST(CellMLTest, HodgkinHuxleyVc) {
   std::string pythonConfig = R"(
 
@@ -752,3 +821,239 @@ print("gpu avg error: {}".format(total_error))
 
   ASSERT_LE(error, 1.35);
 }
+
+TEST(CellMLTest, HandleResultArraysAreReadOnly) {
+  std::string pythonConfig = R"(
+# for every call of handle_result, if writing to the states and algebraics
+# raised an exception
+write_raised = []
+
+def handle_result(n_instances, time_step_no, current_time, states, algebraics,
+                  name_information, additional_argument):
+  for values in [states, algebraics]:
+    try:
+      values[0,0] = 0.0
+      write_raised.append(False)
+    except (ValueError, TypeError):
+      write_raised.append(True)
+
+config = {
+  "ExplicitEuler" : {
+    "timeStepWidth": 1e-5,
+    "endTime" : 1e-4,
+    "initialValues": [],
+    "timeStepOutputInterval": 1e5,
+
+    "CellML" : {
+      "modelFilename": "../input/hodgkin_huxley_1952.c",
+      "optimizationType": "simd",
+      "useGivenLibrary": False,
+      "statesInitialValues": [-20, 0.05, 0.6, 0.325],
+      "parametersInitialValues": [400.0],
+      "parametersUsedAsAlgebraic": [],
+      "parametersUsedAsConstant": [2],
+      "callbackArgumentsAsArrays": True,
+      "handleResultFunction": handle_result,
+      "handleResultCallInterval": 2,
+    },
+  }
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  TimeSteppingScheme::ExplicitEuler<CellmlAdapter<4>> problem(settings);
+
+  problem.run();
+
+  // every write to the arrays in the callback has to raise an exception
+  PyObject *mainModule = PyImport_AddModule("__main__");
+  PyObject *writeRaised = PyObject_GetAttrString(mainModule, "write_raised");
+  ASSERT_TRUE(writeRaised != NULL);
+  ASSERT_TRUE(PyList_Check(writeRaised));
+  ASSERT_GT(PyList_Size(writeRaised), 0);
+
+  for (Py_ssize_t i = 0; i < PyList_Size(writeRaised); i++)
+    ASSERT_TRUE(PyObject_IsTrue(PyList_GetItem(writeRaised, i)));
+  Py_CLEAR(writeRaised);
+}
+
+namespace {
+//! call the setSpecificStates and setSpecificParameters callbacks with
+//! "callbackArgumentsAsArrays" and check that the values written by the
+//! callbacks are stored in the given buffers, if blockNumpy is set, numpy
+//! cannot be imported and the arrays are memoryviews
+void checkSetSpecificCallbackArrays(bool blockNumpy) {
+  std::string pythonConfig = R"(
+import sys
+numpy_module = sys.modules.get("numpy")
+if block_numpy:
+  sys.modules["numpy"] = None
+
+# type names of the values and dof nos arguments of the callbacks
+argument_types = []
+
+# the callbacks set state_no*10 + global dof no and 100 + global dof no
+def set_specific_states(n_instances, time_step_no, current_time, states,
+                        dof_nos_global_natural, additional_argument):
+  argument_types.append(type(states).__name__)
+  argument_types.append(type(dof_nos_global_natural).__name__)
+  for state_no in range(4):
+    for i in range(n_instances):
+      states[state_no, i] = state_no*10 + int(dof_nos_global_natural[i])
+
+def set_specific_parameters(n_instances, time_step_no, current_time,
+                            parameters, dof_nos_global_natural,
+                            additional_argument):
+  argument_types.append(type(parameters).__name__)
+  for i in range(n_instances):
+    parameters[0, i] = 100 + int(dof_nos_global_natural[i])
+
+config = {
+  "Meshes": {
+    "MeshFiber": {
+      "nElements": [4],
+      "physicalExtent": [4.0],
+    },
+  },
+  "CellML" : {
+    "modelFilename": "../input/hodgkin_huxley_1952.c",
+    "meshName": "MeshFiber",
+    "statesInitialValues": [-20, 0.05, 0.6, 0.325],
+    "parametersInitialValues": [400.0],
+    "parametersUsedAsAlgebraic": [],
+    "parametersUsedAsConstant": [2],
+    "callbackArgumentsAsArrays": True,
+    "setSpecificStatesFunction": set_specific_states,
+    "setSpecificStatesCallInterval": 1,
+    "setSpecificParametersFunction": set_specific_parameters,
+    "setSpecificParametersCallInterval": 1,
+  }
+}
+)";
+
+  DihuContext settings(argc, argv,
+                       std::string("block_numpy = ") +
+                           (blockNumpy ? "True" : "False") + pythonConfig);
+
+  CellmlAdapter<4> cellml(settings);
+  cellml.initialize();
+
+  const int nInstances = cellml.functionSpace()->nDofsLocalWithoutGhosts();
+  ASSERT_EQ(nInstances, 5);
+
+  std::vector<double> states(4 * nInstances, -1.0);
+  std::vector<double> parameters(nInstances, -1.0);
+  cellml.callPythonSetSpecificStatesFunction(nInstances, 0, 0.0,
+                                             states.data());
+  cellml.callPythonSetSpecificParametersFunction(nInstances, 0, 0.0,
+                                                 parameters.data(), 1);
+
+  // get the type names of the arguments and restore the numpy module
+  std::vector<std::string> argumentTypes;
+  PyObject *mainModule = PyImport_AddModule("__main__");
+  PyObject *pyArgumentTypes =
+      PyObject_GetAttrString(mainModule, "argument_types");
+  ASSERT_TRUE(pyArgumentTypes != NULL);
+  argumentTypes =
+      PythonUtility::convertFromPython<std::vector<std::string>>::get(
+          pyArgumentTypes);
+  Py_CLEAR(pyArgumentTypes);
+  ASSERT_EQ(PyRun_SimpleString("if numpy_module is None:\n"
+                               "  sys.modules.pop('numpy', None)\n"
+                               "else:\n"
+                               "  sys.modules['numpy'] = numpy_module\n"),
+            0);
+
+  if (blockNumpy) {
+    ASSERT_EQ(argumentTypes, std::vector<std::string>(
+                                 {"memoryview", "list", "memoryview"}));
+  } else {
+    ASSERT_EQ(argumentTypes, std::vector<std::string>(
+                                 {"ndarray", "ndarray", "ndarray"}));
+  }
+
+  // the global natural dof nos of the local dofs
+  std::vector<global_no_t> dofNosGlobalNatural;
+  cellml.functionSpace()->meshPartition()->getDofNosGlobalNatural(
+      dofNosGlobalNatural);
+  ASSERT_EQ(dofNosGlobalNatural,
+            std::vector<global_no_t>({0, 1, 2, 3, 4}));
+
+  // the values are stored in struct-of-array layout
+  for (int dofNoLocal = 0; dofNoLocal < nInstances; dofNoLocal++) {
+    for (int stateNo = 0; stateNo < 4; stateNo++) {
+      ASSERT_EQ(states[stateNo * nInstances + dofNoLocal],
+                stateNo * 10.0 + dofNosGlobalNatural[dofNoLocal]);
+    }
+    ASSERT_EQ(parameters[dofNoLocal],
+              100.0 + dofNosGlobalNatural[dofNoLocal]);
+  }
+}
+} // namespace
+
+TEST(CellMLTest, SetSpecificCallbackArraysReferenceValues) {
+  checkSetSpecificCallbackArrays(false);
+}
+
+TEST(CellMLTest, SetSpecificCallbackArraysWithoutNumpy) {
+  checkSetSpecificCallbackArrays(true);
+}
+
+namespace {
+//! solve the model with y0' = -k*y0^1.5 and y1' = -k*y1^2 with the given
+//! optimization type and return the states at t=1
+std::vector<double> solvePowerModel(std::string optimizationType) {
+  std::string pythonConfig = R"(
+config = {
+  "ExplicitEuler" : {
+    "timeStepWidth": 1e-4,
+    "endTime" : 1.0,
+    "initialValues": [],
+    "timeStepOutputInterval": 1e5,
+
+    "CellML" : {
+      "modelFilename": "../input/power_model.c",
+      "optimizationType": optimization_type,
+      "useGivenLibrary": False,
+      "statesInitialValues": [4.0, 4.0],
+      "parametersInitialValues": [0.0],
+      "parametersUsedAsAlgebraic": [],
+      "parametersUsedAsConstant": [3],
+    },
+  }
+}
+)";
+
+  DihuContext settings(argc, argv,
+                       "optimization_type = \"" + optimizationType + "\"" +
+                           pythonConfig);
+
+  TimeSteppingScheme::ExplicitEuler<CellmlAdapter<2, 1>> problem(settings);
+  problem.run();
+
+  std::vector<double> states;
+  for (int componentNo = 0; componentNo < 2; componentNo++) {
+    std::vector<double> values;
+    problem.data().solution()->getValuesWithoutGhosts(componentNo, values);
+    states.push_back(values[0]);
+  }
+  return states;
+}
+} // namespace
+
+TEST(CellMLTest, VcNonIntegralConstantExponent) {
+  // the exponents are constants, which are replaced by the literals 1.5 and 2
+  // in the generated code, only the integral exponent uses the pow2 helper
+  std::vector<double> reference = solvePowerModel("simd");
+  std::vector<double> values = solvePowerModel("vc");
+
+  ASSERT_EQ(values.size(), (std::size_t)2);
+  ASSERT_NEAR(values[0], reference[0], 1e-10);
+  ASSERT_NEAR(values[1], reference[1], 1e-10);
+
+  // analytic solutions y0 = (4^-0.5 + k/2*t)^-2 and y1 = (1/4 + k*t)^-1,
+  // a truncation of the exponent 1.5 to 1 would give y0 = 4*exp(-k*t) = 2.43
+  ASSERT_NEAR(values[0], 1.0 / (0.75 * 0.75), 1e-3);
+  ASSERT_NEAR(values[1], 1.0 / 0.75, 1e-3);
+}
@@ -0,0 +1,66 @@
+#include <Python.h> // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <cstdint>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "opendihu.h"
+#include "arg.h"
+#include "utility/cpu_utility.h"
+
+TEST(CpuUtilityTest, InstructionSetLevelAndName) {
+  using namespace CpuUtility;
+
+  ASSERT_EQ(instructionSetLevel(""), 0);
+  ASSERT_EQ(instructionSetName(""), "generic");
+  ASSERT_EQ(instructionSetLevel("-msse2 -msse3"), 1);
+  ASSERT_EQ(instructionSetName("-msse2 -msse3"), "sse2");
+  ASSERT_EQ(instructionSetName("-msse2 -msse4.1 -msse4.2"), "sse4");
+
+  // "-mavx " must not match "-mavx2" and vice versa, also at the end
+  ASSERT_EQ(instructionSetName("-msse2 -mavx"), "avx");
+  ASSERT_EQ(instructionSetName("-msse2 -mavx -mfma"), "avx");
+  ASSERT_EQ(instructionSetName("-msse2 -mavx2"), "avx2");
+  ASSERT_EQ(instructionSetName("-msse2 -mavx2 -mfma"), "avx2");
+  ASSERT_EQ(instructionSetName("-mavx2 -mavx512cd"), "avx2");
+  ASSERT_EQ(instructionSetName("-mavx -mavx2 -mavx512f -mavx512vl"),
+            "avx512");
+  ASSERT_EQ(instructionSetLevel("-mavx -mavx2 -mavx512f"), 5);
+
+  // the order of the flags does not matter
+  ASSERT_EQ(instructionSetLevel("-mfma -mavx2 -msse2"), 4);
+}
+
+TEST(CpuUtilityTest, InstructionSetHashIsStable) {
+  using namespace CpuUtility;
+
+  // the 32 bit FNV-1a hash has fixed values, which are the same on all ranks
+  // and in all runs
+  ASSERT_EQ((uint32_t)instructionSetHash(""), 0x811c9dc5u);
+  ASSERT_EQ((uint32_t)instructionSetHash("a"), 0xe40c292cu);
+  ASSERT_EQ((uint32_t)instructionSetHash("-msse2 -mavx"), 0xad0f0eb5u);
+  ASSERT_EQ((uint32_t)instructionSetHash("-msse2 -mavx2"), 0xf5b3de85u);
+
+  std::string flags = CpuUtility::detectedInstructionSetFlags();
+  ASSERT_EQ(instructionSetHash(flags), instructionSetHash(flags));
+
+  // flags with the same widest instruction set give different hashes
+  ASSERT_NE(instructionSetHash("-msse2 -mavx2"),
+            instructionSetHash("-msse2 -mavx2 -mfma"));
+}
+
+TEST(CpuUtilityTest, CpuSupportsCompiledInstructionSets) {
+  using namespace CpuUtility;
+
+  // the detection is only available on x86
+  std::string detectedFlags = detectedInstructionSetFlags();
+  if (detectedFlags.empty())
+    return;
+
+  // the tests run, so the cpu supports the instruction sets that opendihu was
+  // compiled for
+  ASSERT_GE(instructionSetLevel(detectedFlags),
+            instructionSetLevel(compiledInstructionSetFlags()));
+}
@@ -3,6 +3,9 @@
 #include <iostream>
 #include <cstdlib>
 #include <fstream>
+#include <cmath>
+#include <algorithm>
+#include <sstream>
 
 #include "gtest/gtest.h"
 #include "opendihu.h"
@@ -75,6 +78,86 @@ config = {
   }
 }
 
+namespace {
+//! compute four independent diffusion problems in MultipleInstances with the
+//! given number of threads, return the solutions of all instances
+std::vector<std::vector<double>> solveMultipleInstances(int nThreads) {
+  std::stringstream pythonConfig;
+  pythonConfig << R"(
+n_threads = )" << nThreads
+               << R"(
+instance_config = lambda i: {
+  "ranks": [0],
+  "ExplicitEuler" : {
+    "initialValues": [2,2,4+i,5,2,2-i],
+    "numberTimeSteps": 50,
+    "endTime": 0.1,
+    "timeStepOutputInterval": 100,
+    "dirichletBoundaryConditions": {},
+    "FiniteElementMethod" : {
+      "nElements": 5,
+      "physicalExtent": 4.0,
+      "diffusionTensor": [1.0+i],
+      "inputMeshIsGlobal": True,
+      "relativeTolerance": 1e-15,
+      "solverType": "gmres",
+      "preconditionerType": "none",
+    },
+  },
+}
+config = {
+  "MultipleInstances": {
+    "nInstances": 4,
+    "nThreads": n_threads,
+    "instances": [instance_config(i) for i in range(4)],
+  },
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig.str());
+
+  Control::MultipleInstances<TimeSteppingScheme::ExplicitEuler<
+      SpatialDiscretization::FiniteElementMethod<
+          Mesh::StructuredRegularFixedOfDimension<1>,
+          BasisFunction::LagrangeOfOrder<>, Quadrature::None,
+          Equation::Dynamic::IsotropicDiffusion>>>
+      problem(settings);
+
+  problem.initialize();
+  problem.advanceTimeSpan();
+
+  std::vector<std::vector<double>> solutions;
+  for (auto &instance : problem.instancesLocal()) {
+    std::vector<double> values;
+    instance.data().solution()->getValuesWithoutGhosts(0, values);
+    solutions.push_back(values);
+  }
+  return solutions;
+}
+} // namespace
+
+TEST(DiffusionTest, MultipleInstancesThreadsGiveSerialResult) {
+  // if MPI does not provide MPI_THREAD_MULTIPLE, e.g. for OMP_NUM_THREADS=1,
+  // the threaded run falls back to the serial loop
+  std::vector<std::vector<double>> serialSolutions = solveMultipleInstances(1);
+  std::vector<std::vector<double>> threadedSolutions =
+      solveMultipleInstances(4);
+
+  ASSERT_EQ(serialSolutions.size(), 4);
+  ASSERT_EQ(threadedSolutions.size(), 4);
+  for (int instanceNo = 0; instanceNo < 4; instanceNo++) {
+    ASSERT_EQ(serialSolutions[instanceNo].size(), 6);
+    for (int i = 0; i < 6; i++) {
+      ASSERT_EQ(threadedSolutions[instanceNo][i],
+                serialSolutions[instanceNo][i])
+          << "instance " << instanceNo << ", dof " << i;
+    }
+  }
+
+  // the instances have different initial values and diffusion tensors
+  ASSERT_NE(serialSolutions[0][2], serialSolutions[1][2]);
+}
+
 TEST(DiffusionTest, Heun1D) {
   std::string pythonConfig = R"(
 
@@ -126,6 +209,231 @@ config = {
   assertFileMatchesContent("out_diffusion1d_heun_0000004.py", referenceOutput);
 }
 
+TEST(DiffusionTest, SspRungeKutta31D) {
+  // solve with 20, 40 and 80 time steps, for a third order scheme the
+  // difference between two solutions decreases by a factor of 8 when the time
+  // step width is halved
+  auto solve = [](int numberTimeSteps) {
+    std::string pythonConfig = R"(
+# Diffusion 1D
+config = {
+  "SspRungeKutta3" : {
+    "initialValues": [2,2,4,5,2,2],
+    "numberTimeSteps": )" + std::to_string(numberTimeSteps) +
+                               R"(,
+    "endTime": 0.1,
+    "FiniteElementMethod" : {
+      "nElements": 5,
+      "physicalExtent": 4.0,
+      "relativeTolerance": 1e-15,
+      "diffusionTensor": [5.0],
+    },
+  },
+}
+)";
+    DihuContext settings(argc, argv, pythonConfig);
+
+    TimeSteppingScheme::SspRungeKutta3<
+        SpatialDiscretization::FiniteElementMethod<
+            Mesh::StructuredRegularFixedOfDimension<1>,
+            BasisFunction::LagrangeOfOrder<>, Quadrature::None,
+            Equation::Dynamic::IsotropicDiffusion>>
+        problem(settings);
+
+    problem.run();
+
+    std::vector<double> values;
+    problem.data().solution()->getValuesWithoutGhosts(0, values);
+    return values;
+  };
+
+  std::vector<std::vector<double>> solutions = {solve(20), solve(40),
+                                                solve(80)};
+
+  std::vector<double> differences(2, 0.0);
+  for (int i = 0; i < 2; i++) {
+    ASSERT_EQ(solutions[i].size(), solutions[i + 1].size());
+    for (int j = 0; j < solutions[i].size(); j++)
+      differences[i] = std::max(
+          differences[i], std::fabs(solutions[i][j] - solutions[i + 1][j]));
+  }
+
+  ASSERT_GT(differences[1], 0.0);
+  double ratio = differences[0] / differences[1];
+  LOG(INFO) << "SSP-RK3 differences: " << differences << ", ratio: " << ratio;
+  EXPECT_GT(ratio, 7.0);
+  EXPECT_LT(ratio, 10.0);
+}
+
+TEST(DiffusionTest, RungeKuttaChebyshev1D) {
+  // solve with 20, 40 and 80 time steps, for the second order scheme the
+  // difference between two solutions decreases by a factor of 4 when the time
+  // step width is halved
+  auto solve = [](int numberTimeSteps) {
+    std::string pythonConfig = R"(
+# Diffusion 1D
+config = {
+  "RungeKuttaChebyshev" : {
+    "initialValues": [2,2,4,5,2,2],
+    "numberTimeSteps": )" + std::to_string(numberTimeSteps) +
+                               R"(,
+    "endTime": 0.1,
+    "nStages": 5,
+    "FiniteElementMethod" : {
+      "nElements": 5,
+      "physicalExtent": 4.0,
+      "relativeTolerance": 1e-15,
+      "diffusionTensor": [5.0],
+    },
+  },
+}
+)";
+    DihuContext settings(argc, argv, pythonConfig);
+
+    TimeSteppingScheme::RungeKuttaChebyshev<
+        SpatialDiscretization::FiniteElementMethod<
+            Mesh::StructuredRegularFixedOfDimension<1>,
+            BasisFunction::LagrangeOfOrder<>, Quadrature::None,
+            Equation::Dynamic::IsotropicDiffusion>>
+        problem(settings);
+
+    problem.run();
+
+    std::vector<double> values;
+    problem.data().solution()->getValuesWithoutGhosts(0, values);
+    return values;
+  };
+
+  std::vector<std::vector<double>> solutions = {solve(20), solve(40),
+                                                solve(80)};
+
+  std::vector<double> differences(2, 0.0);
+  for (int i = 0; i < 2; i++) {
+    ASSERT_EQ(solutions[i].size(), solutions[i + 1].size());
+    for (int j = 0; j < solutions[i].size(); j++)
+      differences[i] = std::max(
+          differences[i], std::fabs(solutions[i][j] - solutions[i + 1][j]));
+  }
+
+  ASSERT_GT(differences[1], 0.0);
+  double ratio = differences[0] / differences[1];
+  LOG(INFO) << "RKC differences: " << differences << ", ratio: " << ratio;
+  EXPECT_GT(ratio, 3.5);
+  EXPECT_LT(ratio, 4.8);
+}
+
+TEST(DiffusionTest, AdaptiveRungeKuttaSmooth1D) {
+  // smooth initial values, the time step width grows from the small initial
+  // value and no step gets rejected
+  std::string pythonConfig = R"(
+# Diffusion 1D
+import math
+config = {
+  "AdaptiveRungeKutta" : {
+    "initialValues": [math.cos(math.pi*i/5) for i in range(6)],
+    "timeStepWidth": 1e-5,
+    "endTime": 0.1,
+    "method": "DormandPrince",
+    "relativeTolerance": 1e-6,
+    "absoluteTolerance": 1e-6,
+    "FiniteElementMethod" : {
+      "nElements": 5,
+      "physicalExtent": 4.0,
+      "relativeTolerance": 1e-15,
+      "diffusionTensor": [5.0],
+    },
+  },
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  TimeSteppingScheme::AdaptiveRungeKutta<
+      SpatialDiscretization::FiniteElementMethod<
+          Mesh::StructuredRegularFixedOfDimension<1>,
+          BasisFunction::LagrangeOfOrder<>, Quadrature::None,
+          Equation::Dynamic::IsotropicDiffusion>>
+      problem(settings);
+
+  problem.initialize();
+  problem.setTimeSpan(0.0, 0.1);
+  problem.advanceTimeSpan(false);
+
+  int nAcceptedSteps = problem.stepWidthController()->nAcceptedSteps();
+  int nRejectedSteps = problem.stepWidthController()->nRejectedSteps();
+  LOG(INFO) << "smooth: " << nAcceptedSteps << " accepted, " << nRejectedSteps
+            << " rejected, dt=" << problem.adaptiveTimeStepWidth();
+
+  // the width can grow by at most a factor of 5 per step, at least 5 steps are
+  // needed to reach dt=0.01
+  EXPECT_GE(nAcceptedSteps, 5);
+  EXPECT_LE(nAcceptedSteps, 20);
+  EXPECT_EQ(nRejectedSteps, 0);
+  EXPECT_GT(problem.adaptiveTimeStepWidth(), 1e-2);
+}
+
+TEST(DiffusionTest, AdaptiveRungeKuttaStiff1D) {
+  // the initial time step width is too large for the fast decaying modes of
+  // the initial values, steps get rejected and the width shrinks. After the
+  // transient, the width grows again.
+  std::string pythonConfig = R"(
+# Diffusion 1D
+config = {
+  "AdaptiveRungeKutta" : {
+    "initialValues": [2,2,4,5,2,2],
+    "timeStepWidth": 0.05,
+    "endTime": 1.0,
+    "method": "DormandPrince",
+    "relativeTolerance": 1e-6,
+    "absoluteTolerance": 1e-6,
+    "FiniteElementMethod" : {
+      "nElements": 5,
+      "physicalExtent": 4.0,
+      "relativeTolerance": 1e-15,
+      "diffusionTensor": [5.0],
+    },
+  },
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  TimeSteppingScheme::AdaptiveRungeKutta<
+      SpatialDiscretization::FiniteElementMethod<
+          Mesh::StructuredRegularFixedOfDimension<1>,
+          BasisFunction::LagrangeOfOrder<>, Quadrature::None,
+          Equation::Dynamic::IsotropicDiffusion>>
+      problem(settings);
+
+  problem.initialize();
+
+  // transient
+  problem.setTimeSpan(0.0, 0.05);
+  problem.advanceTimeSpan(false);
+
+  int nRejectedStepsTransient =
+      problem.stepWidthController()->nRejectedSteps();
+  double timeStepWidthTransient = problem.adaptiveTimeStepWidth();
+  LOG(INFO) << "transient: "
+            << problem.stepWidthController()->nAcceptedSteps()
+            << " accepted, " << nRejectedStepsTransient
+            << " rejected, dt=" << timeStepWidthTransient;
+
+  EXPECT_GE(nRejectedStepsTransient, 1);
+  EXPECT_LT(timeStepWidthTransient, 0.05);
+
+  // smooth part
+  problem.setTimeSpan(0.05, 1.0);
+  problem.advanceTimeSpan(false);
+
+  LOG(INFO) << "smooth: " << problem.stepWidthController()->nAcceptedSteps()
+            << " accepted, " << problem.stepWidthController()->nRejectedSteps()
+            << " rejected, dt=" << problem.adaptiveTimeStepWidth();
+
+  EXPECT_LE(problem.stepWidthController()->nRejectedSteps(), 2);
+  EXPECT_GT(problem.adaptiveTimeStepWidth(), 2 * timeStepWidthTransient);
+}
+
 TEST(DiffusionTest, ImplicitEuler1D) {
   std::string pythonConfig = R"(
 
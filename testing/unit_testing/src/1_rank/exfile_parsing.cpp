@@ -0,0 +1,219 @@
+#include <Python.h> // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <fstream>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h> // truncate
+#include <utime.h>
+
+#include "gtest/gtest.h"
+#include "opendihu.h"
+#include "arg.h"
+#include "utility/string_utility.h"
+#include "field_variable/unstructured/exfile_representation.h"
+
+namespace {
+
+typedef SpatialDiscretization::FiniteElementMethod<
+    Mesh::UnstructuredDeformableOfDimension<2>,
+    BasisFunction::LagrangeOfOrder<1>, Quadrature::Gauss<2>, Equation::None>
+    FiniteElementMethodType;
+
+//! write the exfiles exfile_cache.exelem and exfile_cache.exnode of a mesh
+//! with 3x3 nodes and 4 elements
+void writeExfiles() {
+  std::string pythonConfig = R"(
+config = {
+  "FiniteElementMethod" : {
+    "nodePositions": [[0,0], [1,0], [2,0], [0,1], [1,1], [2,1],
+                      [0,2], [1,2], [2,2]],
+    "elements": [[0,1,3,4], [1,2,4,5], [3,4,6,7], [4,5,7,8]],
+    "initialValues": 0,
+    "OutputWriter" : [
+      {"format": "Exfile", "interval": 1, "filename": "exfile_cache"},
+    ]
+  }
+}
+)";
+  DihuContext settings(argc, argv, pythonConfig);
+  FiniteElementMethodType problem(settings);
+  problem.run();
+}
+
+//! load the exfiles with "exfileCache" and return the node positions
+std::vector<Vec3> loadNodePositions() {
+  std::string pythonConfig = R"(
+config = {
+  "FiniteElementMethod" : {
+    "exelem": "exfile_cache.exelem",
+    "exnode": "exfile_cache.exnode",
+    "exfileCache": True,
+  }
+}
+)";
+  DihuContext settings(argc, argv, pythonConfig);
+  FiniteElementMethodType problem(settings);
+  problem.initialize();
+
+  std::vector<Vec3> nodePositions;
+  auto functionSpace = problem.functionSpace();
+  for (dof_no_t dofNo = 0; dofNo < functionSpace->nDofsLocalWithoutGhosts();
+       dofNo++)
+    nodePositions.push_back(functionSpace->geometryField().getValue(dofNo));
+  return nodePositions;
+}
+
+//! overwrite the x coordinate of the first node in the cache file
+void modifyCacheFile(double x) {
+  const int nNodes = 9;
+  const std::size_t offsetNodePositions = 8 * sizeof(long long) + // key
+                                          2 * sizeof(long long);  // sizes
+  const std::size_t offsetNodalDofValues =
+      offsetNodePositions + nNodes * sizeof(Vec3);
+
+  std::fstream file("exfile_cache.exelem.cache",
+                    std::ios::in | std::ios::out | std::ios::binary);
+  ASSERT_TRUE(file.is_open());
+  file.seekp(offsetNodePositions);
+  file.write((const char *)&x, sizeof(double));
+  file.seekp(offsetNodalDofValues);
+  file.write((const char *)&x, sizeof(double));
+}
+
+//! get the size of a file, -1 if it does not exist
+long long getFileSize(std::string filename) {
+  struct stat fileStatus;
+  if (stat(filename.c_str(), &fileStatus) != 0)
+    return -1;
+  return fileStatus.st_size;
+}
+
+} // namespace
+
+TEST(ExfileParsingTest, ExfileCacheRoundTrip) {
+  writeExfiles();
+  std::remove("exfile_cache.exelem.cache");
+
+  std::vector<Vec3> reference = {{0, 0, 0}, {1, 0, 0}, {2, 0, 0},
+                                 {0, 1, 0}, {1, 1, 0}, {2, 1, 0},
+                                 {0, 2, 0}, {1, 2, 0}, {2, 2, 0}};
+
+  // the first run parses the exfiles and writes the cache: a key of 8 entries,
+  // the numbers of nodes and elements, the node positions, the nodal dof
+  // values and the nodes of the elements
+  ASSERT_EQ(loadNodePositions(), reference);
+  const long long cacheSize = 10 * sizeof(long long) + 2 * 9 * sizeof(Vec3) +
+                              4 * 4 * sizeof(long long);
+  ASSERT_EQ(getFileSize("exfile_cache.exelem.cache"), cacheSize);
+
+  // the second run loads the cache, a changed value in the cache shows that
+  // the exfiles were not parsed
+  modifyCacheFile(42.0);
+  std::vector<Vec3> nodePositions = loadNodePositions();
+  ASSERT_EQ(nodePositions[0][0], 42.0);
+  for (int nodeNo = 1; nodeNo < 9; nodeNo++)
+    ASSERT_EQ(nodePositions[nodeNo], reference[nodeNo]);
+}
+
+TEST(ExfileParsingTest, ExfileCacheIsStale) {
+  writeExfiles();
+  std::remove("exfile_cache.exelem.cache");
+  ASSERT_EQ(loadNodePositions()[0][0], 0.0);
+  modifyCacheFile(42.0);
+
+  // a changed modification time of the exnode file invalidates the key of the
+  // cache, the exfiles are parsed again and the cache is written again
+  struct stat fileStatus;
+  ASSERT_EQ(stat("exfile_cache.exnode", &fileStatus), 0);
+  struct utimbuf times;
+  times.actime = fileStatus.st_atime;
+  times.modtime = fileStatus.st_mtime + 100;
+  ASSERT_EQ(utime("exfile_cache.exnode", &times), 0);
+
+  ASSERT_EQ(loadNodePositions()[0][0], 0.0);
+
+  // the new cache is valid
+  modifyCacheFile(43.0);
+  ASSERT_EQ(loadNodePositions()[0][0], 43.0);
+}
+
+TEST(ExfileParsingTest, ExfileCacheIsTruncated) {
+  writeExfiles();
+  std::remove("exfile_cache.exelem.cache");
+  ASSERT_EQ(loadNodePositions()[0][0], 0.0);
+  modifyCacheFile(42.0);
+
+  // an incomplete cache file is ignored and replaced
+  const long long cacheSize = getFileSize("exfile_cache.exelem.cache");
+  ASSERT_EQ(truncate("exfile_cache.exelem.cache", cacheSize - 8), 0);
+  ASSERT_EQ(loadNodePositions()[0][0], 0.0);
+  ASSERT_EQ(getFileSize("exfile_cache.exelem.cache"), cacheSize);
+
+  // a file that is too short for the key is also ignored
+  ASSERT_EQ(truncate("exfile_cache.exelem.cache", 20), 0);
+  ASSERT_EQ(loadNodePositions()[0][0], 0.0);
+  ASSERT_EQ(getFileSize("exfile_cache.exelem.cache"), cacheSize);
+}
+
+TEST(ExfileParsingTest, AppendNumbers) {
+  std::vector<double> values = {-1.0};
+  StringUtility::appendNumbers("  1.5 -2e3\t+4.25E-1  7 \n", values);
+  ASSERT_EQ(values, std::vector<double>({-1.0, 1.5, -2000.0, 0.425, 7.0}));
+
+  // tokens that are no numbers give 0, the following numbers are still parsed
+  values.clear();
+  StringUtility::appendNumbers("1 abc 3 x7", values);
+  ASSERT_EQ(values, std::vector<double>({1.0, 0.0, 3.0, 0.0}));
+
+  // an empty line or a line with only whitespace adds no value
+  values.clear();
+  StringUtility::appendNumbers("", values);
+  StringUtility::appendNumbers(" \t ", values);
+  ASSERT_TRUE(values.empty());
+
+  // integer values are converted
+  std::vector<int> nodeNos;
+  StringUtility::appendNumbers(" 1 2 4 5", nodeNos);
+  ASSERT_EQ(nodeNos, std::vector<int>({1, 2, 4, 5}));
+}
+
+TEST(ExfileParsingTest, UnifyExfileElementRepresentations) {
+  using FieldVariable::ExfileElementRepresentation;
+
+  // a representation of 4 nodes, the first node uses the given version
+  auto createRepresentation = [](int versionNo) {
+    auto representation = std::make_shared<ExfileElementRepresentation>();
+    representation->setNumberNodes(4);
+    for (int nodeIndex = 0; nodeIndex < 4; nodeIndex++) {
+      int offset = (nodeIndex == 0 ? versionNo : 0);
+      representation->getNode(nodeIndex).valueIndices = {offset};
+      representation->getNode(nodeIndex).scaleFactorIndices = {-1};
+    }
+    return representation;
+  };
+
+  // every element has its own object, elements 0, 2 and 3 are equal
+  FieldVariable::ExfileRepresentation exfileRepresentation;
+  exfileRepresentation.setNumberElements(4);
+  exfileRepresentation.getExfileElementRepresentation(0) =
+      createRepresentation(0);
+  exfileRepresentation.getExfileElementRepresentation(1) =
+      createRepresentation(1);
+  exfileRepresentation.getExfileElementRepresentation(2) =
+      createRepresentation(0);
+  exfileRepresentation.getExfileElementRepresentation(3) =
+      createRepresentation(0);
+  ASSERT_FALSE(exfileRepresentation.haveSameExfileRepresentation(0, 2));
+
+  exfileRepresentation.unifyExfileElementRepresentations();
+
+  ASSERT_TRUE(exfileRepresentation.haveSameExfileRepresentation(0, 2));
+  ASSERT_TRUE(exfileRepresentation.haveSameExfileRepresentation(0, 3));
+  ASSERT_FALSE(exfileRepresentation.haveSameExfileRepresentation(0, 1));
+  ASSERT_EQ(exfileRepresentation.getExfileElementRepresentation(1)
+                ->getNode(0)
+                .valueIndices[0],
+            1);
+}
@@ -980,4 +980,131 @@ config = {
   ASSERT_EQ(values7, reference7);
 }
 
+TEST(FieldVariableTest, ValuesViewGatherScatter) {
+  std::string pythonConfig = R"(
+config = {
+  "Meshes" : {
+    "testMesh": {
+      "nElements": [2,2],
+      "physicalExtent": [1.0,1.0],
+    }
+  },
+  "FiniteElementMethod" : {
+    "relativeTolerance": 1e-15,
+    "meshName": "testMesh",
+  },
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  SpatialDiscretization::FiniteElementMethod<
+      Mesh::StructuredDeformableOfDimension<2>,
+      BasisFunction::LagrangeOfOrder<1>, Quadrature::Gauss<2>,
+      Equation::Static::Laplace>
+      finiteElementMethod(settings);
+
+  typedef FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<2>,
+                                       BasisFunction::LagrangeOfOrder<1>>
+      FunctionSpaceType;
+  typedef FieldVariable::ValuesView<FunctionSpaceType, 2> ValuesViewType;
+  const int nDofsPerElement = FunctionSpaceType::nDofsPerElement();
+
+  std::shared_ptr<FunctionSpaceType> functionSpace =
+      finiteElementMethod.functionSpace();
+  functionSpace->initialize();
+
+  // 3x3 nodes, 4 elements, the dofs of element 3 are 4,5,7,8
+  std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceType, 2>> a =
+      functionSpace->template createFieldVariable<2>("a");
+
+  // the values at dof i are (i, 10*i)
+  for (dof_no_t dofNo = 0; dofNo < 9; dofNo++)
+    a->setValue(dofNo, Vec2({1.0 * dofNo, 10.0 * dofNo}));
+
+  // gather the element values
+  a->startGhostManipulation();
+  {
+    ValuesViewType view = a->valuesView();
+    ASSERT_EQ(view.nDofsLocalWithGhosts(), 9);
+
+    for (element_no_t elementNo = 0; elementNo < 4; elementNo++) {
+      std::array<dof_no_t, nDofsPerElement> dofNos =
+          functionSpace->getElementDofNosLocal(elementNo);
+
+      ValuesViewType::ElementValues values;
+      view.getElementValues(elementNo, values);
+
+      for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++) {
+        ASSERT_EQ(values[dofIndex][0], 1.0 * dofNos[dofIndex]);
+        ASSERT_EQ(values[dofIndex][1], 10.0 * dofNos[dofIndex]);
+      }
+    }
+
+    ValuesViewType::ElementValues values3;
+    view.getElementValues(3, values3);
+    ValuesViewType::ElementValues reference3 = {
+        Vec2({4.0, 40.0}), Vec2({5.0, 50.0}), Vec2({7.0, 70.0}),
+        Vec2({8.0, 80.0})};
+    ASSERT_EQ(values3, reference3);
+
+    // structure of arrays layout, elements are contiguous
+    std::vector<double> buffer;
+    view.getAllElementValues(buffer);
+    ASSERT_EQ(buffer.size(), 2 * nDofsPerElement * 4);
+    for (element_no_t elementNo = 0; elementNo < 4; elementNo++) {
+      ValuesViewType::ElementValues values;
+      view.getElementValues(elementNo, values);
+      for (int componentNo = 0; componentNo < 2; componentNo++) {
+        for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++) {
+          ASSERT_EQ(buffer[(componentNo * nDofsPerElement + dofIndex) * 4 +
+                           elementNo],
+                    values[dofIndex][componentNo]);
+        }
+      }
+    }
+  }
+
+  // scatter the doubled element values back, shared dofs get the same value
+  // from every element
+  {
+    ValuesViewType view = a->valuesView(true);
+    for (element_no_t elementNo = 0; elementNo < 4; elementNo++) {
+      ValuesViewType::ElementValues values;
+      view.getElementValues(elementNo, values);
+      for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++) {
+        values[dofIndex][0] *= 2.0;
+        values[dofIndex][1] *= 2.0;
+      }
+      view.setElementValues(elementNo, values);
+    }
+  }
+  a->finishGhostManipulation();
+
+  for (dof_no_t dofNo = 0; dofNo < 9; dofNo++) {
+    ASSERT_EQ(a->getValue(0, dofNo), 2.0 * dofNo);
+    ASSERT_EQ(a->getValue(1, dofNo), 20.0 * dofNo);
+  }
+
+  // adding 1 in every element counts the adjacent elements of every dof
+  a->setValues(0.0);
+  a->startGhostManipulation();
+  {
+    ValuesViewType view = a->valuesView(true);
+    ValuesViewType::ElementValues ones;
+    for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+      ones[dofIndex] = Vec2({1.0, 0.0});
+
+    for (element_no_t elementNo = 0; elementNo < 4; elementNo++)
+      view.setElementValues(elementNo, ones, ADD_VALUES);
+  }
+  a->finishGhostManipulation();
+
+  std::vector<double> nAdjacentElements = {1, 2, 1, 2, 4, 2, 1, 2, 1};
+  for (dof_no_t dofNo = 0; dofNo < 9; dofNo++) {
+    ASSERT_EQ(a->getValue(0, dofNo), nAdjacentElements[dofNo]);
+    ASSERT_EQ(a->getValue(1, dofNo), 0.0);
+  }
+}
+
 } // namespace Testing
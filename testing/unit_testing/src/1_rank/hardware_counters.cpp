@@ -0,0 +1,92 @@
+#include <Python.h> // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+
+#include "gtest/gtest.h"
+#include "opendihu.h"
+#include "arg.h"
+#include "control/diagnostic_tool/hardware_counters.h"
+
+TEST(HardwareCountersTest, Values) {
+  using Control::HardwareCounters;
+
+  HardwareCounters::Values start, end, total;
+  for (int i = 0; i < HardwareCounters::nCounters; i++) {
+    ASSERT_EQ(total.values[i], 0);
+    start.values[i] = 10 * i;
+    end.values[i] = 10 * i + i + 1;
+  }
+
+  // the differences are accumulated
+  total.addDifference(start, end);
+  total.addDifference(start, end);
+  for (int i = 0; i < HardwareCounters::nCounters; i++)
+    ASSERT_EQ(total.values[i], 2 * (i + 1));
+
+  // the packed instructions count for 2, 4 and 8 operations, a cache miss for
+  // 64 bytes
+  ASSERT_EQ(total.flops(), 2 * (4 + 2 * 5 + 4 * 6 + 8 * 7));
+  ASSERT_EQ(total.bytes(), 64.0 * 2 * 3);
+}
+
+TEST(HardwareCountersTest, DisabledCountersAreNotRead) {
+  using Control::HardwareCounters;
+
+  // without counters, the values are not changed and the log file contains
+  // no counter values
+  HardwareCounters::setEnabled(false);
+  ASSERT_FALSE(HardwareCounters::enabled());
+
+  HardwareCounters::Values values;
+  values.values.fill(-1);
+  HardwareCounters::read(values);
+  for (int i = 0; i < HardwareCounters::nCounters; i++) {
+    ASSERT_EQ(values.values[i], -1);
+    ASSERT_FALSE(HardwareCounters::available((HardwareCounters::counter_t)i));
+  }
+  ASSERT_FALSE(HardwareCounters::flopsAvailable());
+}
+
+TEST(HardwareCountersTest, UnavailableCountersAreNotRead) {
+  using Control::HardwareCounters;
+
+  // depending on the CPU and the permissions, some or all counters cannot be
+  // opened, only the available counters are read
+  HardwareCounters::setEnabled(true);
+
+  HardwareCounters::Values start;
+  start.values.fill(-1);
+  HardwareCounters::read(start);
+
+  volatile double sum = 0;
+  for (int i = 0; i < 100000; i++)
+    sum += 1e-3 * i;
+
+  HardwareCounters::Values end;
+  end.values.fill(-1);
+  HardwareCounters::read(end);
+
+  for (int i = 0; i < HardwareCounters::nCounters; i++) {
+    HardwareCounters::counter_t counter = (HardwareCounters::counter_t)i;
+    if (HardwareCounters::available(counter)) {
+      ASSERT_GE(start.values[i], 0) << HardwareCounters::counterName(counter);
+      ASSERT_GE(end.values[i], start.values[i]);
+    } else {
+      ASSERT_EQ(start.values[i], -1) << HardwareCounters::counterName(counter);
+      ASSERT_EQ(end.values[i], -1);
+    }
+  }
+
+  // the instructions of the loop are counted
+  if (HardwareCounters::available(HardwareCounters::counterInstructions)) {
+    ASSERT_GT(end.values[HardwareCounters::counterInstructions],
+              start.values[HardwareCounters::counterInstructions] + 100000);
+  }
+
+  // the flops are available only with the floating point counters
+  ASSERT_EQ(HardwareCounters::flopsAvailable(),
+            HardwareCounters::available(
+                HardwareCounters::counterFpScalarDouble));
+  HardwareCounters::setEnabled(false);
+}
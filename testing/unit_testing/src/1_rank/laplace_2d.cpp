@@ -233,4 +233,71 @@ config = {
   StiffnessMatrixTester::compareMatrix(equationDiscretized, referenceMatrix);
 }
 
+TEST(LaplaceTest, CondensedDirichletSystemGivesSameSolution) {
+  // 5x5 nodes, Dirichlet BC at the left and bottom boundary and at one inner
+  // node, the prescribed values are not constant to test the lifting into rhs
+  std::string pythonConfig = R"(
+bc = {}
+for i in range(5):
+  bc[i] = 0.1*i*i           # bottom boundary
+  bc[5*i] = 1.0 - 0.2*i     # left boundary, overrides bc[0]
+bc[12] = 2.0
+
+config = {
+  "FiniteElementMethod" : {
+    "nElements": [4, 4],
+    "physicalExtent": [4.0, 4.0],
+    "dirichletBoundaryConditions": bc,
+    "dirichletBoundaryConditionsMode": dirichlet_boundary_conditions_mode,
+    "relativeTolerance": 1e-15,
+    "absoluteTolerance": 1e-15,
+    "maxIterations": 1000,
+    "solverType": "gmres",
+    "preconditionerType": "none",
+  },
+}
+)";
+
+  std::vector<std::vector<double>> solutionValues;
+  for (std::string mode : {"zeroRowsColumns", "condensed"}) {
+    DihuContext settings(
+        argc, argv,
+        "dirichlet_boundary_conditions_mode = \"" + mode + "\"" + pythonConfig);
+
+    FiniteElementMethod<Mesh::StructuredRegularFixedOfDimension<2>,
+                        BasisFunction::LagrangeOfOrder<>, Quadrature::None,
+                        Equation::Static::Laplace>
+        equationDiscretized(settings);
+
+    equationDiscretized.run();
+
+    std::vector<double> values;
+    equationDiscretized.data().solution()->getValuesWithoutGhosts(values);
+    solutionValues.push_back(values);
+
+    std::map<int, double> dirichletBC = {{0, 1.0}, {1, 0.1}, {2, 0.4},
+                                         {3, 0.9}, {4, 1.6}, {5, 0.8},
+                                         {10, 0.6}, {12, 2.0}, {15, 0.4},
+                                         {20, 0.2}};
+    StiffnessMatrixTester::checkDirichletBCInSolution(equationDiscretized,
+                                                      dirichletBC);
+
+    // in condensed mode, the rows and columns of the Dirichlet dofs are not
+    // zeroed in the full system matrix
+    PetscBool isEqual = PETSC_FALSE;
+    MatEqual(
+        equationDiscretized.data().stiffnessMatrix()->valuesGlobal(),
+        equationDiscretized.data().stiffnessMatrixWithoutBc()->valuesGlobal(),
+        &isEqual);
+    EXPECT_EQ(isEqual == PETSC_TRUE, mode == "condensed") << mode;
+  }
+
+  ASSERT_EQ(solutionValues[0].size(), 25);
+  ASSERT_EQ(solutionValues[1].size(), 25);
+  for (int dofNo = 0; dofNo < 25; dofNo++) {
+    EXPECT_NEAR(solutionValues[0][dofNo], solutionValues[1][dofNo], 1e-10)
+        << "dof " << dofNo;
+  }
+}
+
 } // namespace SpatialDiscretization
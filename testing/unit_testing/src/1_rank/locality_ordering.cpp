@@ -0,0 +1,83 @@
+#include <Python.h> // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "opendihu.h"
+#include "arg.h"
+#include "partition/locality_ordering.h"
+
+TEST(LocalityOrderingTest, Morton) {
+  // 4x4 grid of points in lexicographic order, the Z-order curve visits the
+  // 2x2 blocks one after the other
+  std::vector<Vec3> points;
+  for (int j = 0; j < 4; j++) {
+    for (int i = 0; i < 4; i++)
+      points.push_back(Vec3({(double)i, (double)j, 0.0}));
+  }
+
+  std::vector<global_no_t> ordering =
+      Partition::LocalityOrdering::morton(points);
+
+  std::vector<global_no_t> referenceOrdering = {0, 1, 4,  5,  2,  3,  6,  7,
+                                                8, 9, 12, 13, 10, 11, 14, 15};
+  ASSERT_EQ(ordering, referenceOrdering);
+
+  // shuffled corners of a square, x is the lowest bit of the key
+  std::vector<Vec3> corners = {Vec3({1.0, 1.0, 0.0}), Vec3({0.0, 0.0, 0.0}),
+                               Vec3({1.0, 0.0, 0.0}), Vec3({0.0, 1.0, 0.0})};
+
+  ordering = Partition::LocalityOrdering::morton(corners);
+
+  referenceOrdering = {1, 2, 3, 0};
+  ASSERT_EQ(ordering, referenceOrdering);
+}
+
+TEST(LocalityOrderingTest, ReverseCuthillMcKee) {
+  // chain 2-0-4-1-3 and the isolated node 5, the search starts at the node
+  // with the lowest degree, i.e. 5, then at the end 2 of the chain
+  std::vector<std::vector<global_no_t>> nodeNosOfElements = {
+      {2, 0}, {0, 4}, {4, 1}, {1, 3}};
+
+  std::vector<global_no_t> ordering =
+      Partition::LocalityOrdering::reverseCuthillMcKee(nodeNosOfElements, 6);
+
+  std::vector<global_no_t> referenceOrdering = {3, 1, 4, 0, 2, 5};
+  ASSERT_EQ(ordering, referenceOrdering);
+
+  // node 0 has the neighbours 1, 2 and 3, the neighbours are visited in
+  // order of increasing degree, i.e. 1 (start), then 2 before 3
+  nodeNosOfElements = {{0, 1}, {0, 2}, {0, 3}, {3, 4}};
+
+  ordering =
+      Partition::LocalityOrdering::reverseCuthillMcKee(nodeNosOfElements, 5);
+
+  referenceOrdering = {4, 3, 2, 0, 1};
+  ASSERT_EQ(ordering, referenceOrdering);
+}
+
+TEST(LocalityOrderingTest, ElementsByNodes) {
+  // reversed node ordering reverses the elements of a chain
+  std::vector<std::vector<global_no_t>> nodeNosOfElements = {
+      {0, 1}, {1, 2}, {2, 3}};
+  std::vector<global_no_t> nodeOrdering = {3, 2, 1, 0};
+
+  std::vector<global_no_t> ordering =
+      Partition::LocalityOrdering::elementsByNodes(nodeNosOfElements,
+                                                   nodeOrdering);
+
+  std::vector<global_no_t> referenceOrdering = {2, 1, 0};
+  ASSERT_EQ(ordering, referenceOrdering);
+
+  // elements with the same lowest node keep their order
+  nodeNosOfElements = {{0, 1}, {0, 2}, {2, 3}};
+  nodeOrdering = {0, 1, 2, 3};
+
+  ordering = Partition::LocalityOrdering::elementsByNodes(nodeNosOfElements,
+                                                          nodeOrdering);
+
+  referenceOrdering = {0, 1, 2};
+  ASSERT_EQ(ordering, referenceOrdering);
+}
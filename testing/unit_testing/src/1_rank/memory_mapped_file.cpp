@@ -0,0 +1,154 @@
+#include <Python.h> // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "opendihu.h"
+#include "arg.h"
+#include "utility/memory_mapped_file.h"
+
+namespace {
+
+const int nBytesHeader = 16;
+const int nPoints = 8;
+
+//! write a binary file with a header of 16 bytes, followed by 8 points with
+//! the coordinates (i, 10*i, 100*i) as doubles
+void writeNodePositionsFile(std::string filename) {
+  std::ofstream file(filename, std::ios::out | std::ios::binary);
+  std::string header(nBytesHeader, 'h');
+  file.write(header.c_str(), nBytesHeader);
+  for (int pointNo = 0; pointNo < nPoints; pointNo++) {
+    double point[3] = {1.0 * pointNo, 10.0 * pointNo, 100.0 * pointNo};
+    file.write((const char *)point, 3 * sizeof(double));
+  }
+}
+
+//! check reading of ranges in and out of the file
+void checkRead(const MemoryMappedFile &file) {
+  const std::size_t fileSize = nBytesHeader + nPoints * 3 * sizeof(double);
+  ASSERT_TRUE(file.isOpen());
+  ASSERT_EQ(file.size(), fileSize);
+
+  // the second point
+  double point[3] = {-1, -1, -1};
+  ASSERT_TRUE(file.read(nBytesHeader + 3 * sizeof(double),
+                        3 * sizeof(double), point));
+  ASSERT_EQ(point[0], 1.0);
+  ASSERT_EQ(point[1], 10.0);
+  ASSERT_EQ(point[2], 100.0);
+
+  // the last value of the file and an empty range at the end
+  double value = -1;
+  ASSERT_TRUE(file.read(fileSize - sizeof(double), sizeof(double), &value));
+  ASSERT_EQ(value, 700.0);
+  ASSERT_TRUE(file.read(fileSize, 0, &value));
+
+  // ranges that are not contained in the file do not change the destination
+  value = -1;
+  ASSERT_FALSE(file.read(fileSize - sizeof(double), 2 * sizeof(double),
+                         &value));
+  ASSERT_FALSE(file.read(fileSize + 1, 0, &value));
+  ASSERT_FALSE(file.read(fileSize + 8, sizeof(double), &value));
+  ASSERT_FALSE(file.read(8, (std::size_t)-1, &value));
+  ASSERT_EQ(value, -1.0);
+
+  // the whole file
+  std::string content;
+  ASSERT_TRUE(file.readAll(content));
+  ASSERT_EQ(content.size(), fileSize);
+  ASSERT_EQ(content.substr(0, nBytesHeader), std::string(nBytesHeader, 'h'));
+}
+
+typedef SpatialDiscretization::FiniteElementMethod<
+    Mesh::StructuredDeformableOfDimension<1>,
+    BasisFunction::LagrangeOfOrder<1>, Quadrature::Gauss<2>, Equation::None>
+    FiniteElementMethodType;
+
+//! get the node positions of the mesh of a finite element method
+std::vector<Vec3> getNodePositions(FiniteElementMethodType &problem) {
+  std::vector<Vec3> nodePositions;
+  auto functionSpace = problem.functionSpace();
+  for (dof_no_t dofNo = 0; dofNo < functionSpace->nDofsLocalWithoutGhosts();
+       dofNo++)
+    nodePositions.push_back(functionSpace->geometryField().getValue(dofNo));
+  return nodePositions;
+}
+
+} // namespace
+
+TEST(MemoryMappedFileTest, ReadRanges) {
+  writeNodePositionsFile("memory_mapped_file.bin");
+
+  MemoryMappedFile file("memory_mapped_file.bin");
+  checkRead(file);
+}
+
+TEST(MemoryMappedFileTest, ReadRangesWithPread) {
+  writeNodePositionsFile("memory_mapped_file.bin");
+
+  // without memory mapping, the ranges are read by pread
+  MemoryMappedFile file("memory_mapped_file.bin", false);
+  checkRead(file);
+}
+
+TEST(MemoryMappedFileTest, FileDoesNotExist) {
+  MemoryMappedFile file("memory_mapped_file_does_not_exist.bin");
+  ASSERT_FALSE(file.isOpen());
+  ASSERT_EQ(file.size(), (std::size_t)0);
+
+  double value = -1;
+  ASSERT_FALSE(file.read(0, 0, &value));
+  std::string content;
+  ASSERT_FALSE(file.readAll(content));
+}
+
+TEST(MemoryMappedFileTest, NodePositionsFromChunks) {
+  // the file has to exist before the meshes are created
+  writeNodePositionsFile("memory_mapped_file.bin");
+
+  // the chunks are [offset, nPoints], as list or as numpy array
+  std::string pythonConfig = R"(
+import numpy as np
+
+point_size = 3*8
+config = {
+  "Meshes": {
+    "meshList": {
+      "nElements": 3,
+      "inputMeshIsGlobal": True,
+      "nodePositions": ["memory_mapped_file.bin",
+                        [[16, 2], [16 + 5*point_size, 2]]],
+    },
+    "meshArray": {
+      "nElements": 3,
+      "inputMeshIsGlobal": True,
+      "nodePositions": ["memory_mapped_file.bin",
+                        np.array([[16 + 7*point_size, 1],
+                                  [16 + 2*point_size, 3]], dtype=np.int64)],
+    },
+  },
+  "List": {"FiniteElementMethod": {"meshName": "meshList"}},
+  "Array": {"FiniteElementMethod": {"meshName": "meshArray"}},
+}
+)";
+  DihuContext settings(argc, argv, pythonConfig);
+
+  auto point = [](int pointNo) {
+    return Vec3({1.0 * pointNo, 10.0 * pointNo, 100.0 * pointNo});
+  };
+
+  FiniteElementMethodType problemList(settings["List"]);
+  problemList.initialize();
+  std::vector<Vec3> reference = {point(0), point(1), point(5), point(6)};
+  ASSERT_EQ(getNodePositions(problemList), reference);
+
+  FiniteElementMethodType problemArray(settings["Array"]);
+  problemArray.initialize();
+  reference = {point(7), point(2), point(3), point(4)};
+  ASSERT_EQ(getNodePositions(problemArray), reference);
+}
@@ -0,0 +1,72 @@
+#include <Python.h> // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "opendihu.h"
+#include "arg.h"
+#include "utility/svd_utility.h"
+
+TEST(ModelOrderReductionTest, DEIMIndices) {
+  // basis with the columns u1 = (1,3,2,0), u2 = (2,1,0,4), column major
+  std::vector<double> basis = {1, 3, 2, 0, 2, 1, 0, 4};
+
+  // the first index is the largest entry of u1, i.e. 1. Interpolating u2 at
+  // index 1 gives u2 - u1/3 = (5/3, 0, -2/3, 4), the largest entry is at 3.
+  std::vector<int> indices = SvdUtility::getDEIMIndices(basis.data(), 4, 2);
+
+  std::vector<int> referenceIndices = {1, 3};
+  ASSERT_EQ(indices, referenceIndices);
+}
+
+TEST(ModelOrderReductionTest, SolveLinearSystem) {
+  // matrix ((2,1),(4,3)) in column major order, the pivot of the first column
+  // is in the second row
+  std::vector<double> matrix = {2, 4, 1, 3};
+
+  // two right hand sides with the solutions (1,1) and (1,-1)
+  std::vector<double> rhs = {3, 7, 1, 1};
+
+  ASSERT_TRUE(SvdUtility::solveLinearSystem(matrix.data(), 2, rhs.data(), 2));
+
+  std::vector<double> referenceSolution = {1, 1, 1, -1};
+  for (int i = 0; i < 4; i++)
+    EXPECT_NEAR(rhs[i], referenceSolution[i], 1e-14);
+}
+
+TEST(ModelOrderReductionTest, SolveLinearSystemSingular) {
+  // matrix ((1,2),(2,4)) is singular
+  std::vector<double> matrix = {1, 2, 2, 4};
+  std::vector<double> rhs = {1, 2};
+
+  EXPECT_FALSE(SvdUtility::solveLinearSystem(matrix.data(), 2, rhs.data(), 1));
+}
+
+TEST(ModelOrderReductionTest, SVDJacobi) {
+  // matrix ((2,0),(1,1),(0,2)) in column major order, A^T A = ((5,1),(1,5))
+  // has the eigenvalues 6 and 4
+  std::vector<double> matrix = {2, 1, 0, 0, 1, 2};
+  std::vector<double> leftSingularVectors(6);
+  std::vector<double> singularValues(2);
+
+  SvdUtility::getSVDJacobi(matrix.data(), 3, 2, leftSingularVectors.data(),
+                           singularValues.data());
+
+  EXPECT_NEAR(singularValues[0], std::sqrt(6.0), 1e-14);
+  EXPECT_NEAR(singularValues[1], 2.0, 1e-14);
+
+  // the left singular vectors are (1,1,1)/sqrt(3) and (1,0,-1)/sqrt(2), up to
+  // the sign
+  std::vector<double> referenceVectors = {
+      1 / std::sqrt(3.0), 1 / std::sqrt(3.0), 1 / std::sqrt(3.0),
+      1 / std::sqrt(2.0), 0, -1 / std::sqrt(2.0)};
+  for (int col = 0; col < 2; col++) {
+    double sign = leftSingularVectors[col * 3] > 0 ? 1 : -1;
+    for (int row = 0; row < 3; row++)
+      EXPECT_NEAR(sign * leftSingularVectors[col * 3 + row],
+                  referenceVectors[col * 3 + row], 1e-14);
+  }
+}
@@ -0,0 +1,263 @@
+#include <Python.h> // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <sstream>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "opendihu.h"
+#include "arg.h"
+
+namespace {
+
+typedef Mesh::StructuredDeformableOfDimension<3> MeshType;
+
+typedef TimeSteppingScheme::MultidomainSolver<
+    SpatialDiscretization::FiniteElementMethod<
+        MeshType, BasisFunction::LagrangeOfOrder<1>, Quadrature::Gauss<3>,
+        Equation::Static::Laplace>,
+    SpatialDiscretization::FiniteElementMethod<
+        MeshType, BasisFunction::LagrangeOfOrder<1>, Quadrature::Gauss<5>,
+        Equation::Dynamic::DirectionalDiffusion>>
+    MultidomainSolverType;
+
+//! multidomain solver with access to the state of the preconditioner reuse
+class MultidomainSolverWithReuseState : public MultidomainSolverType {
+public:
+  using MultidomainSolverType::MultidomainSolverType;
+  using MultidomainSolverType::checkPreconditionerReuse;
+
+  //! the single Mat that contains all entries of the system matrix
+  Mat singleSystemMatrix() { return this->singleSystemMatrix_; }
+
+  //! the reference number of iterations, -1 if the next solve is a full setup
+  int nIterationsAfterPreconditionerSetup() {
+    return this->nIterationsAfterPreconditionerSetup_;
+  }
+
+  //! set the number of iterations of the last solve
+  void setLastNumberOfIterations(int nIterations) {
+    this->lastNumberOfIterations_ = nIterations;
+  }
+
+  //! if the ksp of the linear solver reuses the preconditioner
+  bool isPreconditionerReused() {
+    PetscBool reuse;
+    KSPGetReusePreconditioner(*this->linearSolver_->ksp(), &reuse);
+    return reuse == PETSC_TRUE;
+  }
+};
+
+//! settings of a multidomain problem with 2 compartments on a mesh with
+//! 3x3x5 nodes, options are additional entries of the MultidomainSolver
+std::string multidomainSettings(std::string options) {
+  std::stringstream pythonConfig;
+  pythonConfig << R"(
+n_nodes = 3*3*5
+
+# the fibers go in z direction, from the bottom to the top nodes
+potential_flow_bc = {}
+for i in range(9):
+  potential_flow_bc[i] = 0.0
+  potential_flow_bc[n_nodes-9+i] = 1.0
+
+relative_factors = [[0.2 + 0.1*(i%3) for i in range(n_nodes)],
+                    [0.8 - 0.1*(i%3) - 0.05*(i//9) for i in range(n_nodes)]]
+
+config = {
+  "Meshes": {
+    "mesh": {
+      "nElements": [2, 2, 4],
+      "physicalExtent": [2.0, 2.0, 4.0],
+      "inputMeshIsGlobal": True,
+    },
+  },
+  "Solvers": {
+    "potentialFlowSolver": {
+      "relativeTolerance": 1e-12,
+      "absoluteTolerance": 1e-14,
+      "maxIterations": 1e4,
+      "solverType": "gmres",
+      "preconditionerType": "none",
+    },
+    "activationSolver": {
+      "relativeTolerance": 1e-12,
+      "absoluteTolerance": 1e-14,
+      "maxIterations": 1e4,
+      "solverType": "gmres",
+      "preconditionerType": "jacobi",
+    },
+  },
+  "MultidomainSolver": {
+    "nCompartments": 2,
+    "am": 500.0,
+    "cm": 0.58,
+    "timeStepWidth": 1e-2,
+    "endTime": 3e-2,
+    "timeStepOutputInterval": 100,
+    "solverName": "activationSolver",
+    "initialGuessNonzero": True,
+    "inputIsGlobal": True,
+    "showLinearSolverOutput": False,
+    "compartmentRelativeFactors": relative_factors,
+    "useSymmetricPreconditionerMatrix": False,
+    )" << options
+               << R"(
+    "PotentialFlow": {
+      "FiniteElementMethod": {
+        "meshName": "mesh",
+        "solverName": "potentialFlowSolver",
+        "prefactor": 1.0,
+        "dirichletBoundaryConditions": potential_flow_bc,
+        "neumannBoundaryConditions": [],
+        "inputMeshIsGlobal": True,
+      },
+    },
+    "Activation": {
+      "FiniteElementMethod": {
+        "meshName": "mesh",
+        "solverName": "activationSolver",
+        "prefactor": 1.0,
+        "dirichletBoundaryConditions": {},
+        "neumannBoundaryConditions": [],
+        "inputMeshIsGlobal": True,
+        "diffusionTensor": [[8.93, 0, 0, 0, 0, 0, 0, 0, 0]],
+        "extracellularDiffusionTensor": [[6.7, 0, 0, 0, 6.7, 0, 0, 0, 6.7]],
+      },
+    },
+  },
+}
+)";
+  return pythonConfig.str();
+}
+
+//! set a transmembrane potential with a peak in the center to all compartments
+void setTransmembranePotential(MultidomainSolverType &problem) {
+  const int nDofs = 3 * 3 * 5;
+  for (int k = 0; k < 2; k++) {
+    std::vector<double> values(nDofs, -75.0);
+    values[nDofs / 2] = 20.0 + 5.0 * k;
+    values[nDofs / 2 + 1] = 10.0;
+    problem.data().transmembranePotential(k)->setValuesWithoutGhosts(values);
+
+    // the right hand side of the solver refers to the global vector
+    problem.data().transmembranePotential(k)->valuesGlobal();
+  }
+}
+
+//! get the new transmembrane potentials of all compartments and the
+//! extracellular potential, which is only determined up to a constant, shifted
+//! to zero mean
+std::vector<double> getSolution(MultidomainSolverType &problem) {
+  std::vector<double> solution;
+  for (int k = 0; k < 2; k++) {
+    std::vector<double> values;
+    problem.data().transmembranePotentialSolution(k)->getValuesWithoutGhosts(
+        values);
+    solution.insert(solution.end(), values.begin(), values.end());
+  }
+
+  std::vector<double> values;
+  problem.data().extraCellularPotential()->getValuesWithoutGhosts(values);
+  double mean = 0;
+  for (double value : values)
+    mean += value / values.size();
+  for (double value : values)
+    solution.push_back(value - mean);
+  return solution;
+}
+
+//! run 3 time steps of the multidomain problem and return the solution
+std::vector<double> solveMultidomain(std::string options) {
+  DihuContext settings(argc, argv, multidomainSettings(options));
+
+  MultidomainSolverType problem(settings);
+  problem.initialize();
+  setTransmembranePotential(problem);
+  problem.advanceTimeSpan(false);
+
+  return getSolution(problem);
+}
+
+} // namespace
+
+TEST(MultidomainTest, FieldSplitPreconditionerGivesSameSolution) {
+  std::vector<double> reference =
+      solveMultidomain(R"("useFieldSplitPreconditioner": False,)");
+
+  // the nested matrix with the fieldsplit preconditioner that is already set
+  // up in initialize gives the same solution as the converted matrix
+  std::vector<double> values =
+      solveMultidomain(R"("useFieldSplitPreconditioner": True,
+    "fieldSplitSubPreconditionerType": "gamg",)");
+
+  ASSERT_EQ(values.size(), reference.size());
+  ASSERT_EQ(values.size(), 3 * 45);
+  for (int i = 0; i < (int)values.size(); i++)
+    ASSERT_NEAR(values[i], reference[i], 1e-6) << "entry " << i;
+
+  // the peak of the transmembrane potential has diffused
+  ASSERT_LT(reference[22], 20.0 - 1e-3);
+  ASSERT_GT(reference[22], -75.0);
+}
+
+TEST(MultidomainTest, ReusePreconditionerKeepsSystemMatrix) {
+  std::vector<double> reference =
+      solveMultidomain(R"("updateSystemMatrixEveryTimestep": True,)");
+
+  DihuContext settings(argc, argv, multidomainSettings(R"(
+    "updateSystemMatrixEveryTimestep": True,
+    "reusePreconditioner": True,
+    "reusePreconditionerIterationsFactor": 2.0,)"));
+
+  MultidomainSolverWithReuseState problem(settings);
+  problem.initialize();
+  setTransmembranePotential(problem);
+
+  Mat systemMatrix = problem.singleSystemMatrix();
+  Mat systemMatrixBefore;
+  ASSERT_EQ(MatDuplicate(systemMatrix, MAT_COPY_VALUES, &systemMatrixBefore),
+            0);
+  ASSERT_EQ(problem.nIterationsAfterPreconditionerSetup(), -1);
+
+  // the update of the system matrix copies the values to the existing single
+  // Mat, the geometry does not change, so do the values
+  problem.advanceTimeSpan(false);
+  ASSERT_EQ(problem.singleSystemMatrix(), systemMatrix);
+  PetscBool isEqual;
+  ASSERT_EQ(MatEqual(systemMatrixBefore, systemMatrix, &isEqual), 0);
+  ASSERT_TRUE(isEqual);
+  MatDestroy(&systemMatrixBefore);
+
+  std::vector<double> values = getSolution(problem);
+  ASSERT_EQ(values.size(), reference.size());
+  for (int i = 0; i < (int)values.size(); i++)
+    ASSERT_NEAR(values[i], reference[i], 1e-6) << "entry " << i;
+
+  // the first solve after the setup gives the reference number of iterations,
+  // the following solves reuse the preconditioner
+  int nIterationsReference = problem.nIterationsAfterPreconditionerSetup();
+  ASSERT_GT(nIterationsReference, 0);
+  ASSERT_TRUE(problem.isPreconditionerReused());
+
+  // up to the factor of 2 times the reference iterations, the preconditioner
+  // is still reused
+  problem.setLastNumberOfIterations(2 * nIterationsReference);
+  problem.checkPreconditionerReuse();
+  ASSERT_EQ(problem.nIterationsAfterPreconditionerSetup(),
+            nIterationsReference);
+  ASSERT_TRUE(problem.isPreconditionerReused());
+
+  // more iterations trigger a full setup in the next solve
+  problem.setLastNumberOfIterations(2 * nIterationsReference + 1);
+  problem.checkPreconditionerReuse();
+  ASSERT_EQ(problem.nIterationsAfterPreconditionerSetup(), -1);
+  ASSERT_FALSE(problem.isPreconditionerReused());
+
+  // the solve after the full setup gives the new reference
+  problem.setLastNumberOfIterations(3);
+  problem.checkPreconditionerReuse();
+  ASSERT_EQ(problem.nIterationsAfterPreconditionerSetup(), 3);
+  ASSERT_TRUE(problem.isPreconditionerReused());
+}
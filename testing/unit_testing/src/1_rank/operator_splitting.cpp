@@ -3,6 +3,7 @@
 #include <iostream>
 #include <cstdlib>
 #include <fstream>
+#include <sstream>
 
 #include "gtest/gtest.h"
 #include "opendihu.h"
@@ -211,3 +212,97 @@ config = {
       problem(settings);
   problem.run();
 }
+
+namespace {
+//! run a Strang splitting of the Hodgkin-Huxley model and diffusion until
+//! endTime and return the transmembrane potential
+std::vector<double> solveStrang(bool fuseHalfSteps, double endTime,
+                                std::string term1TimeStepping) {
+  std::stringstream pythonConfig;
+  pythonConfig << R"(
+config = {
+  "Meshes": {
+    "MeshFibre": {
+      "nElements": 5,
+      "physicalExtent": 5.0,
+    },
+  },
+  "Solvers": {
+    "linearSolver": {
+      "relativeTolerance": 1e-15,
+    }
+  },
+  "StrangSplitting": {
+    "timeStepWidth": 1e-2,
+    "endTime": )" << endTime
+               << R"(,
+    "fuseHalfSteps": )"
+               << (fuseHalfSteps ? "True" : "False") << R"(,
+    "fuseHalfStepsOutputInterval": 5,
+    "Term1": {
+      "ExplicitEuler" : {
+        )" << term1TimeStepping
+               << R"(,
+        "initialValues": [],
+        "timeStepOutputInterval": 1e4,
+        "CellML" : {
+          "modelFilename": "../input/hodgkin_huxley_1952.c",
+          "compilerFlags": "-O3 -march=native -fPIC -g -shared ",
+          "meshName": "MeshFibre",
+          "prefactor": 1.0,
+        },
+      },
+    },
+    "Term2": {
+      "ExplicitEuler" : {
+        "timeStepWidth": 1e-4,
+        "timeStepOutputInterval": 1e4,
+        "FiniteElementMethod" : {
+          "meshName": "MeshFibre",
+          "prefactor": 3.828/(500.0*0.58),
+          "solverName": "linearSolver",
+        },
+      },
+    },
+  }
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig.str());
+
+  OperatorSplitting::Strang<
+      TimeSteppingScheme::ExplicitEuler<CellmlAdapter<4>>,
+      TimeSteppingScheme::ExplicitEuler<
+          SpatialDiscretization::FiniteElementMethod<
+              Mesh::StructuredRegularFixedOfDimension<1>,
+              BasisFunction::LagrangeOfOrder<1>, Quadrature::Gauss<2>,
+              Equation::Dynamic::IsotropicDiffusion>>>
+      problem(settings);
+  problem.run();
+
+  std::vector<double> values;
+  problem.timeStepping1().data().solution()->getValuesWithoutGhosts(0,
+                                                                    values);
+  return values;
+}
+} // namespace
+
+TEST(OperatorSplittingTest, StrangFusedHalfStepsGiveSameResult) {
+  // Term1 is specified by timeStepWidth and by numberTimeSteps, the latter
+  // has to be doubled for the fused half steps. The full Strang step is
+  // completed every 5 time steps, i.e. at t=0.05 and t=0.1.
+  for (std::string term1TimeStepping :
+       {"\"timeStepWidth\": 5e-5", "\"numberTimeSteps\": 100"}) {
+    for (double endTime : {0.05, 0.1}) {
+      std::vector<double> reference =
+          solveStrang(false, endTime, term1TimeStepping);
+      std::vector<double> values =
+          solveStrang(true, endTime, term1TimeStepping);
+
+      ASSERT_EQ(values.size(), reference.size());
+      for (int i = 0; i < (int)values.size(); i++)
+        ASSERT_NEAR(values[i], reference[i], 1e-8)
+            << term1TimeStepping << ", endTime " << endTime << ", dof " << i;
+    }
+  }
+}
@@ -0,0 +1,169 @@
+#include <Python.h> // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "opendihu.h"
+#include "arg.h"
+
+namespace {
+
+typedef SpatialDiscretization::FiniteElementMethod<
+    Mesh::StructuredDeformableOfDimension<1>,
+    BasisFunction::LagrangeOfOrder<1>, Quadrature::Gauss<2>, Equation::None>
+    FiniteElementMethodType;
+
+typedef FieldVariable::FieldVariable<FiniteElementMethodType::FunctionSpace, 3>
+    FieldVariableType;
+
+const int nDofs = 5;
+
+//! the value of a dof of a component, offset distinguishes the field variables
+double value(int componentNo, int dofNo, double offset) {
+  return offset + 10.0 * componentNo + dofNo;
+}
+
+//! create a field variable with 3 components and the values value(...)
+std::shared_ptr<FieldVariableType>
+createFieldVariable(FiniteElementMethodType &problem, std::string name,
+                    double offset) {
+  std::shared_ptr<FieldVariableType> fieldVariable =
+      problem.functionSpace()->createFieldVariable<3>(name);
+  for (int componentNo = 0; componentNo < 3; componentNo++) {
+    std::vector<double> values;
+    for (int dofNo = 0; dofNo < nDofs; dofNo++)
+      values.push_back(value(componentNo, dofNo, offset));
+    fieldVariable->setValuesWithoutGhosts(componentNo, values);
+  }
+  return fieldVariable;
+}
+
+//! get the values of a component, this does not change the representation
+std::vector<double> getValues(std::shared_ptr<FieldVariableType> fieldVariable,
+                              int componentNo) {
+  std::vector<double> values;
+  fieldVariable->getValuesWithoutGhosts(componentNo, values);
+  return values;
+}
+
+//! check that the target has the values of component componentNoSource of the
+//! source in component componentNoTarget and its own values otherwise
+void checkValues(std::shared_ptr<FieldVariableType> fieldVariableTarget,
+                 double offsetTarget, int componentNoTarget,
+                 double offsetSource, int componentNoSource) {
+  for (int componentNo = 0; componentNo < 3; componentNo++) {
+    std::vector<double> values = getValues(fieldVariableTarget, componentNo);
+    ASSERT_EQ(values.size(), (std::size_t)nDofs);
+    for (int dofNo = 0; dofNo < nDofs; dofNo++) {
+      double reference = value(componentNo, dofNo, offsetTarget);
+      if (componentNo == componentNoTarget)
+        reference = value(componentNoSource, dofNo, offsetSource);
+      ASSERT_EQ(values[dofNo], reference)
+          << "component " << componentNo << ", dof " << dofNo;
+    }
+  }
+}
+
+//! if the field variable is in contiguous representation
+bool isContiguous(std::shared_ptr<FieldVariableType> fieldVariable) {
+  return fieldVariable->partitionedPetscVec()->currentRepresentation() ==
+         Partition::values_representation_t::representationContiguous;
+}
+
+const std::string pythonConfig = R"(
+config = {
+  "FiniteElementMethod": {
+    "nElements": 4,
+    "physicalExtent": 4.0,
+    "inputMeshIsGlobal": True,
+  },
+}
+)";
+
+} // namespace
+
+TEST(PartitionedPetscVecTest, SetComponentValuesContiguous) {
+  DihuContext settings(argc, argv, pythonConfig);
+  FiniteElementMethodType problem(settings);
+  problem.initialize();
+
+  // contiguous source, the target is not contiguous
+  std::shared_ptr<FieldVariableType> source =
+      createFieldVariable(problem, "source", 100.0);
+  std::shared_ptr<FieldVariableType> target =
+      createFieldVariable(problem, "target", 200.0);
+  source->partitionedPetscVec()->setRepresentationContiguous();
+
+  target->partitionedPetscVec()->setComponentValues(
+      2, *source->partitionedPetscVec(), 1);
+  ASSERT_TRUE(isContiguous(source));
+  ASSERT_FALSE(isContiguous(target));
+  checkValues(target, 200.0, 2, 100.0, 1);
+  checkValues(source, 100.0, -1, 100.0, -1);
+
+  // contiguous target, the source is not contiguous
+  source = createFieldVariable(problem, "source2", 300.0);
+  target = createFieldVariable(problem, "target2", 400.0);
+  target->partitionedPetscVec()->setRepresentationContiguous();
+
+  target->partitionedPetscVec()->setComponentValues(
+      0, *source->partitionedPetscVec(), 2);
+  ASSERT_FALSE(isContiguous(source));
+  ASSERT_TRUE(isContiguous(target));
+  checkValues(target, 400.0, 0, 300.0, 2);
+  checkValues(source, 300.0, -1, 300.0, -1);
+
+  // both contiguous
+  source = createFieldVariable(problem, "source3", 500.0);
+  target = createFieldVariable(problem, "target3", 600.0);
+  source->partitionedPetscVec()->setRepresentationContiguous();
+  target->partitionedPetscVec()->setRepresentationContiguous();
+
+  target->partitionedPetscVec()->setComponentValues(
+      1, *source->partitionedPetscVec(), 1);
+  ASSERT_TRUE(isContiguous(source));
+  ASSERT_TRUE(isContiguous(target));
+  checkValues(target, 600.0, 1, 500.0, 1);
+  checkValues(source, 500.0, -1, 500.0, -1);
+
+  // another component of the same vector
+  target->partitionedPetscVec()->setComponentValues(
+      0, *target->partitionedPetscVec(), 2);
+  checkValues(target, 600.0, 0, 600.0, 2);
+}
+
+TEST(PartitionedPetscVecTest, MapCopiesSingleComponentOnSameMesh) {
+  DihuContext settings(argc, argv, pythonConfig);
+  FiniteElementMethodType problem(settings);
+  problem.initialize();
+
+  // the source has the contiguous representation of the states of a CellML
+  // adapter, the explicit copy of one component on the same mesh keeps it
+  std::shared_ptr<FieldVariableType> source =
+      createFieldVariable(problem, "source", 100.0);
+  std::shared_ptr<FieldVariableType> target =
+      createFieldVariable(problem, "target", 200.0);
+  source->partitionedPetscVec()->setRepresentationContiguous();
+
+  DihuContext::mappingBetweenMeshesManager()->map(source, target, 1, 2, false);
+  ASSERT_TRUE(isContiguous(source));
+  checkValues(target, 200.0, 2, 100.0, 1);
+  checkValues(source, 100.0, -1, 100.0, -1);
+
+  // the transfer back writes only the component to the contiguous vector
+  std::shared_ptr<FieldVariableType> result =
+      createFieldVariable(problem, "result", 300.0);
+  DihuContext::mappingBetweenMeshesManager()->map(result, source, 0, 1, false);
+  ASSERT_TRUE(isContiguous(source));
+  checkValues(source, 100.0, 1, 300.0, 0);
+
+  // all components
+  DihuContext::mappingBetweenMeshesManager()->map(source, target, -1, -1,
+                                                   false);
+  ASSERT_TRUE(isContiguous(source));
+  for (int componentNo = 0; componentNo < 3; componentNo++)
+    ASSERT_EQ(getValues(target, componentNo), getValues(source, componentNo));
+}
@@ -0,0 +1,139 @@
+#include <Python.h> // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "opendihu.h"
+#include "arg.h"
+#include "control/diagnostic_tool/performance_trace.h"
+
+namespace {
+//! get an integer variable of the python main module
+long getMainVariable(std::string name) {
+  PyObject *mainModule = PyImport_AddModule("__main__");
+  PyObject *variable = PyObject_GetAttrString(mainModule, name.c_str());
+  long value = PythonUtility::convertFromPython<long>::get(variable);
+  Py_CLEAR(variable);
+  return value;
+}
+} // namespace
+
+TEST(PerformanceTraceTest, RegistrationReturnsSameHandle) {
+  using Control::PerformanceTrace;
+
+  PerformanceTrace::RegionId regionId =
+      PerformanceTrace::registerRegion("traceTestRegistration");
+  ASSERT_GE(regionId, 0);
+  ASSERT_EQ(PerformanceTrace::registerRegion("traceTestRegistration"),
+            regionId);
+  ASSERT_NE(PerformanceTrace::registerRegion("traceTestRegistration2"),
+            regionId);
+  ASSERT_EQ(PerformanceTrace::regionName(regionId), "traceTestRegistration");
+  ASSERT_EQ(PerformanceTrace::regionName(-1), "");
+}
+
+TEST(PerformanceTraceTest, NestedRegionsAreWrittenToFiles) {
+  using Control::PerformanceTrace;
+
+  std::string pythonConfig = R"(
+config = {}
+)";
+  DihuContext settings(argc, argv, pythonConfig);
+
+  PerformanceTrace::RegionId outer =
+      PerformanceTrace::registerRegion("traceTestOuter");
+  PerformanceTrace::RegionId inner =
+      PerformanceTrace::registerRegion("traceTestInner");
+  PerformanceTrace::RegionId unclosed =
+      PerformanceTrace::registerRegion("traceTestUnclosed");
+  PerformanceTrace::RegionId disabled =
+      PerformanceTrace::registerRegion("traceTestDisabled");
+
+  // regions are not recorded while tracing is disabled
+  PerformanceTrace::setEnabled(false);
+  PerformanceTrace::begin(disabled);
+  PerformanceTrace::end(disabled);
+
+  PerformanceTrace::setEnabled(true);
+  ASSERT_TRUE(PerformanceTrace::enabled());
+
+  // two calls of outer with a nested inner region each, the second inner
+  // region uses the RAII helper
+  PerformanceTrace::begin(outer);
+  PerformanceTrace::begin(inner);
+  PerformanceTrace::end(inner);
+  PerformanceTrace::end(outer);
+
+  PerformanceTrace::begin(outer);
+  {
+    PerformanceTrace::Scope scope(inner);
+  }
+  // ending outer also closes the region that was opened inside
+  PerformanceTrace::begin(unclosed);
+  PerformanceTrace::end(outer);
+
+  // end of a region that is not open is ignored
+  PerformanceTrace::end(inner);
+
+  PerformanceTrace::setFilenames("out/performance_trace",
+                                 "out/performance_trace_statistics");
+  PerformanceTrace::writeFiles();
+  PerformanceTrace::setEnabled(false);
+
+  // parse the trace file, which also checks that it is valid json
+  std::string command = R"(
+import json
+with open("out/performance_trace.0000000.json") as f:
+  trace = json.load(f)
+
+events = {}
+for event in trace["traceEvents"]:
+  if event["ph"] == "X":
+    events.setdefault(event["name"], []).append(event)
+
+n_outer = len(events.get("traceTestOuter", []))
+n_inner = len(events.get("traceTestInner", []))
+n_unclosed = len(events.get("traceTestUnclosed", []))
+n_disabled = len(events.get("traceTestDisabled", []))
+
+# the depth of the inner regions is one more than the depth of the outer
+# regions and they are contained in the outer regions
+depth_difference = 1
+contained = 1
+for outer_event, inner_event in zip(events["traceTestOuter"],
+                                    events["traceTestInner"]):
+  if inner_event["args"]["depth"] != outer_event["args"]["depth"] + 1:
+    depth_difference = 0
+  if inner_event["ts"] < outer_event["ts"] or inner_event["ts"] + \
+    inner_event["dur"] > outer_event["ts"] + outer_event["dur"] + 1e-3:
+    contained = 0
+
+# the statistics file contains a line per region
+statistics = {}
+with open("out/performance_trace_statistics.csv") as f:
+  for line in f:
+    if not line.startswith("#"):
+      values = line.strip().split(";")
+      statistics[values[0]] = values
+n_calls_outer = int(statistics["traceTestOuter"][2])
+n_calls_inner = int(statistics["traceTestInner"][2])
+n_ranks_outer = int(statistics["traceTestOuter"][1])
+has_statistics_disabled = int("traceTestDisabled" in statistics)
+)";
+  ASSERT_EQ(PyRun_SimpleString(command.c_str()), 0);
+
+  ASSERT_EQ(getMainVariable("n_outer"), 2);
+  ASSERT_EQ(getMainVariable("n_inner"), 2);
+  ASSERT_EQ(getMainVariable("n_unclosed"), 1);
+  ASSERT_EQ(getMainVariable("n_disabled"), 0);
+  ASSERT_EQ(getMainVariable("depth_difference"), 1);
+  ASSERT_EQ(getMainVariable("contained"), 1);
+
+  ASSERT_EQ(getMainVariable("n_calls_outer"), 2);
+  ASSERT_EQ(getMainVariable("n_calls_inner"), 2);
+  ASSERT_EQ(getMainVariable("n_ranks_outer"), 1);
+  ASSERT_EQ(getMainVariable("has_statistics_disabled"), 0);
+}
@@ -0,0 +1,128 @@
+#include <Python.h> // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include "gtest/gtest.h"
+#include "opendihu.h"
+#include "arg.h"
+
+TEST(PythonSettingsTest, SerializeSettingsWithSkippedValue) {
+  // the lock cannot be pickled, therefore also the config dict that contains
+  // it cannot be transferred to other ranks
+  std::string pythonConfig = R"(
+import threading
+lock = threading.Lock()
+scale = 2.0
+
+def scaled(x):
+  return scale*x
+
+config = {"lock": lock, "factor": scaled(1.5)}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  PyObject *helperModule = DihuContext::settingsSerializationModule();
+  ASSERT_TRUE(helperModule != NULL);
+
+  PyObject *result =
+      PyObject_CallMethod(helperModule, "serialize_settings", NULL);
+  ASSERT_TRUE(result != NULL);
+
+  PyObject *data = PyTuple_GetItem(result, 0); // borrowed reference
+  ASSERT_GT(PyBytes_Size(data), 0);
+
+  std::vector<std::string> skipped =
+      PythonUtility::convertFromPython<std::vector<std::string>>::get(
+          PyTuple_GetItem(result, 1));
+
+  auto isSkipped = [&skipped](std::string name) {
+    return std::find(skipped.begin(), skipped.end(), name) != skipped.end();
+  };
+  ASSERT_TRUE(isSkipped("__main__.lock"));
+  ASSERT_TRUE(isSkipped("__main__.config"));
+  ASSERT_FALSE(isSkipped("__main__.scale"));
+  ASSERT_FALSE(isSkipped("__main__.scaled"));
+
+  // remove the variables and load them again, as on the receiving ranks
+  ASSERT_EQ(PyRun_SimpleString("del scale, scaled, config"), 0);
+
+  PyObject *loadResult = PyObject_CallMethod(
+      helperModule, "deserialize_settings", "(O)", data);
+  ASSERT_TRUE(loadResult != NULL);
+  Py_CLEAR(loadResult);
+
+  // the function and the value it uses are restored, the skipped config dict
+  // is not, therefore the receiving ranks have to execute the script
+  ASSERT_EQ(PyRun_SimpleString("restored_value = scaled(3.0)\n"
+                               "has_config = 'config' in globals()"),
+            0);
+
+  PyObject *mainModule = PyImport_AddModule("__main__");
+  PyObject *restoredValue =
+      PyObject_GetAttrString(mainModule, "restored_value");
+  PyObject *hasConfig = PyObject_GetAttrString(mainModule, "has_config");
+  ASSERT_EQ(PythonUtility::convertFromPython<double>::get(restoredValue), 6.0);
+  ASSERT_FALSE(PyObject_IsTrue(hasConfig));
+
+  Py_CLEAR(restoredValue);
+  Py_CLEAR(hasConfig);
+  Py_CLEAR(result);
+  Py_CLEAR(helperModule);
+}
+
+TEST(PythonSettingsTest, DetectRankDependentSettings) {
+  std::string pythonConfig = R"(
+config = {}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  PyObject *helperModule = DihuContext::settingsSerializationModule();
+  ASSERT_TRUE(helperModule != NULL);
+
+  // returns the reason why the script can depend on the rank or "" if it
+  // cannot, the script is executed as on rank 0
+  auto getRankDependency = [helperModule](std::string script) {
+    PyObject *result =
+        PyObject_CallMethod(helperModule, "record_rank_no_access", NULL);
+    Py_CLEAR(result);
+    EXPECT_EQ(PyRun_SimpleString(script.c_str()), 0);
+
+    result = PyObject_CallMethod(helperModule, "get_rank_dependency", NULL);
+    std::string reason;
+    if (result != NULL && result != Py_None)
+      reason = PythonUtility::convertFromPython<std::string>::get(result);
+    Py_CLEAR(result);
+    return reason;
+  };
+
+  ASSERT_EQ(getRankDependency("import sys\n"
+                              "n_ranks = int(sys.argv[-1])\n"
+                              "args = sys.argv[:-2]\n"
+                              "script_name = sys.argv[0]"),
+            "");
+  ASSERT_NE(getRankDependency("import sys\n"
+                              "rank_no = int(sys.argv[-2])"),
+            "");
+  ASSERT_NE(getRankDependency("import sys\n"
+                              "rank_no = int(sys.argv[len(sys.argv)-2])"),
+            "");
+  ASSERT_NE(getRankDependency("import sys\n"
+                              "arguments = sys.argv[1:]"),
+            "");
+  ASSERT_NE(getRankDependency("from sys import argv\n"
+                              "arguments = [a for a in argv]"),
+            "");
+
+  // sys.argv is a plain list again
+  ASSERT_EQ(PyRun_SimpleString("import sys\n"
+                               "assert type(sys.argv) is list"),
+            0);
+
+  Py_CLEAR(helperModule);
+}
@@ -0,0 +1,180 @@
+#include <Python.h> // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include <array>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "opendihu.h"
+#include "arg.h"
+
+namespace {
+//! get a variable of the settings script, returns a borrowed reference
+PyObject *getMainVariable(std::string name) {
+  PyObject *mainModule = PyImport_AddModule("__main__");
+  PyObject *variable = PyObject_GetAttrString(mainModule, name.c_str());
+  Py_XDECREF(variable); // the module still holds a reference
+  return variable;
+}
+} // namespace
+
+TEST(PythonUtilityTest, ConvertNonContiguousNumpyArrays) {
+  std::string pythonConfig = R"(
+import numpy as np
+a = np.arange(12.0).reshape(3,4)
+sliced = a[:, ::2]          # every second column
+transposed = a.T            # Fortran order
+reversed = np.arange(5.0)[::-1]
+points = np.arange(18.0).reshape(3,6)[:, ::2]   # three points with stride
+config = {}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  // the entries are flattened in row-major order of the view
+  std::vector<double> values;
+  ASSERT_TRUE(PythonUtility::convertFromBuffer<double>::get(
+      getMainVariable("sliced"), values));
+  std::vector<double> reference = {0, 2, 4, 6, 8, 10};
+  ASSERT_EQ(values, reference);
+
+  ASSERT_TRUE(PythonUtility::convertFromBuffer<double>::get(
+      getMainVariable("transposed"), values));
+  reference = {0, 4, 8, 1, 5, 9, 2, 6, 10, 3, 7, 11};
+  ASSERT_EQ(values, reference);
+
+  values = PythonUtility::convertFromPython<std::vector<double>>::get(
+      getMainVariable("reversed"));
+  reference = {4, 3, 2, 1, 0};
+  ASSERT_EQ(values, reference);
+
+  std::vector<Vec3> points;
+  ASSERT_TRUE(PythonUtility::convertFromBuffer<Vec3>::get(
+      getMainVariable("points"), points));
+  ASSERT_EQ(points.size(), 3);
+  for (int pointNo = 0; pointNo < 3; pointNo++) {
+    for (int i = 0; i < 3; i++)
+      ASSERT_EQ(points[pointNo][i], 6.0 * pointNo + 2.0 * i);
+  }
+}
+
+TEST(PythonUtilityTest, ConvertNumpyArraysOfOtherTypes) {
+  std::string pythonConfig = R"(
+import numpy as np
+int32_values = np.array([-3, 0, 7], dtype=np.int32)
+uint8_values = np.array([0, 200, 255], dtype=np.uint8)
+int64_values = np.array([1, 2**40], dtype=np.int64)
+float32_values = np.array([0.5, -1.25], dtype=np.float32)
+bool_values = np.array([True, False, True])
+float64_for_int = np.array([1.0, 2.0, 3.0])
+big_endian = np.array([1.0, 2.0], dtype=">f8")
+points_2d = np.array([[1, 2], [3, 4]], dtype=np.int32)
+config = {}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  std::vector<double> values;
+  ASSERT_TRUE(PythonUtility::convertFromBuffer<double>::get(
+      getMainVariable("int32_values"), values));
+  ASSERT_EQ(values, std::vector<double>({-3, 0, 7}));
+
+  ASSERT_TRUE(PythonUtility::convertFromBuffer<double>::get(
+      getMainVariable("uint8_values"), values));
+  ASSERT_EQ(values, std::vector<double>({0, 200, 255}));
+
+  ASSERT_TRUE(PythonUtility::convertFromBuffer<double>::get(
+      getMainVariable("int64_values"), values));
+  ASSERT_EQ(values, std::vector<double>({1, 1099511627776.0}));
+
+  ASSERT_TRUE(PythonUtility::convertFromBuffer<double>::get(
+      getMainVariable("float32_values"), values));
+  ASSERT_EQ(values, std::vector<double>({0.5, -1.25}));
+
+  ASSERT_TRUE(PythonUtility::convertFromBuffer<double>::get(
+      getMainVariable("bool_values"), values));
+  ASSERT_EQ(values, std::vector<double>({1, 0, 1}));
+
+  std::vector<int> intValues;
+  ASSERT_TRUE(PythonUtility::convertFromBuffer<int>::get(
+      getMainVariable("float64_for_int"), intValues));
+  ASSERT_EQ(intValues, std::vector<int>({1, 2, 3}));
+
+  // a byte order other than the native one is not copied, the entries are
+  // converted one by one instead
+  ASSERT_FALSE(PythonUtility::convertFromBuffer<double>::get(
+      getMainVariable("big_endian"), values));
+
+  // rows with less than 3 components are filled with 0
+  std::vector<Vec3> points;
+  ASSERT_TRUE(PythonUtility::convertFromBuffer<Vec3>::get(
+      getMainVariable("points_2d"), points));
+  ASSERT_EQ(points.size(), 2);
+  ASSERT_EQ(points[0], Vec3({1.0, 2.0, 0.0}));
+  ASSERT_EQ(points[1], Vec3({3.0, 4.0, 0.0}));
+}
+
+TEST(PythonUtilityTest, ConvertListBackedValues) {
+  std::string pythonConfig = R"(
+import array
+import numpy as np
+plain_list = [1.0, 2, 3.5]
+list_array = np.array([1.0, 2, 3.5])
+stdlib_array = array.array("i", [4, 5, 6])
+byte_string = b"abc"
+config = {
+  "values": plain_list,
+  "array_values": list_array,
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  // lists provide no buffer, their entries are converted one by one
+  std::vector<double> values;
+  ASSERT_FALSE(PythonUtility::convertFromBuffer<double>::get(
+      getMainVariable("plain_list"), values));
+  ASSERT_TRUE(values.empty());
+
+  std::vector<double> reference = {1.0, 2.0, 3.5};
+  values = PythonUtility::convertFromPython<std::vector<double>>::get(
+      getMainVariable("plain_list"));
+  ASSERT_EQ(values, reference);
+
+  // a numpy array created from the list gives the same values
+  values = PythonUtility::convertFromPython<std::vector<double>>::get(
+      getMainVariable("list_array"));
+  ASSERT_EQ(values, reference);
+
+  std::array<double, 3> arrayValues =
+      PythonUtility::convertFromPython<std::array<double, 3>>::get(
+          getMainVariable("list_array"));
+  ASSERT_EQ(arrayValues, Vec3({1.0, 2.0, 3.5}));
+
+  // other objects with a numeric buffer are also copied directly
+  ASSERT_TRUE(PythonUtility::convertFromBuffer<double>::get(
+      getMainVariable("stdlib_array"), values));
+  ASSERT_EQ(values, std::vector<double>({4, 5, 6}));
+
+  // bytes are handled as strings
+  ASSERT_FALSE(PythonUtility::convertFromBuffer<double>::get(
+      getMainVariable("byte_string"), values));
+
+  // the options of the settings give the same values for lists and arrays
+  PythonConfig specificSettings(settings.getPythonConfig());
+  std::vector<double> listOption;
+  std::vector<double> arrayOption;
+  specificSettings.getOptionVector("values", listOption);
+  specificSettings.getOptionVector("array_values", arrayOption);
+  ASSERT_EQ(listOption, reference);
+  ASSERT_EQ(arrayOption, reference);
+
+  // with a given number of entries, the missing entries are set to 0
+  specificSettings.getOptionVector("values", 4, listOption);
+  specificSettings.getOptionVector("array_values", 4, arrayOption);
+  reference.push_back(0.0);
+  ASSERT_EQ(listOption, reference);
+  ASSERT_EQ(arrayOption, reference);
+}
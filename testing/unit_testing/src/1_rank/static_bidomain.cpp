@@ -0,0 +1,145 @@
+#include <Python.h> // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "opendihu.h"
+#include "arg.h"
+
+TEST(StaticBidomainTest, LeadFieldEmgMatchesFullSolve) {
+  std::string pythonConfig = R"(
+# 3x3x5 nodes, the potential flow goes from the bottom (z=0) to the top (z=2)
+potential_flow_bc = {}
+for i in range(9):
+  potential_flow_bc[i] = 0.0
+  potential_flow_bc[36+i] = 1.0
+
+config = {
+  "Meshes": {
+    "3Dmesh": {
+      "nElements": [2, 2, 4],
+      "physicalExtent": [1.0, 1.0, 2.0],
+      "inputMeshIsGlobal": True,
+    },
+  },
+  "Solvers": {
+    "potentialFlowSolver": {
+      "relativeTolerance": 1e-15,
+      "absoluteTolerance": 1e-15,
+      "maxIterations": 1e4,
+      "solverType": "gmres",
+      "preconditionerType": "none",
+      "dumpFilename": "",
+      "dumpFormat": "matlab",
+    },
+    "emgSolver": {
+      "relativeTolerance": 1e-15,
+      "absoluteTolerance": 1e-15,
+      "maxIterations": 1e4,
+      "solverType": "gmres",
+      "preconditionerType": "none",
+      "dumpFilename": "",
+      "dumpFormat": "matlab",
+    },
+  },
+  "StaticBidomainSolver": {
+    "timeStepWidth": 1.0,
+    "solverName": "emgSolver",
+    "initialGuessNonzero": False,
+    "slotNames": [],
+    # both electrodes are at nodes, node (1,1,1) and node (2,0,3)
+    "leadFieldElectrodePositions": [[0.5, 0.5, 0.5], [1.0, 0.0, 1.5]],
+    "leadFieldFilename": "out/lead_field_emg.csv",
+    "leadFieldSolveFullSystem": True,
+    "PotentialFlow": {
+      "FiniteElementMethod": {
+        "meshName": "3Dmesh",
+        "solverName": "potentialFlowSolver",
+        "prefactor": 1.0,
+        "dirichletBoundaryConditions": potential_flow_bc,
+        "dirichletOutputFilename": None,
+        "neumannBoundaryConditions": [],
+        "inputMeshIsGlobal": True,
+        "slotName": "",
+      },
+    },
+    "Activation": {
+      "FiniteElementMethod": {
+        "meshName": "3Dmesh",
+        "solverName": "emgSolver",
+        "prefactor": 1.0,
+        "inputMeshIsGlobal": True,
+        "dirichletBoundaryConditions": {},
+        "dirichletOutputFilename": None,
+        "neumannBoundaryConditions": [],
+        "slotName": "",
+        "diffusionTensor": [[8.93, 0, 0, 0, 0.893, 0, 0, 0, 0.893]],
+        "extracellularDiffusionTensor": [[6.7, 0, 0, 0, 6.7, 0, 0, 0, 6.7]],
+      },
+    },
+    "OutputWriter": [],
+  },
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  TimeSteppingScheme::StaticBidomainSolver<
+      SpatialDiscretization::FiniteElementMethod<
+          Mesh::StructuredDeformableOfDimension<3>,
+          BasisFunction::LagrangeOfOrder<1>, Quadrature::Gauss<3>,
+          Equation::Static::Laplace>,
+      SpatialDiscretization::FiniteElementMethod<
+          Mesh::StructuredDeformableOfDimension<3>,
+          BasisFunction::LagrangeOfOrder<1>, Quadrature::Gauss<3>,
+          Equation::Dynamic::DirectionalDiffusion>>
+      problem(settings);
+
+  problem.initialize();
+
+  // set Vm = z^2 + x, the nodes have a spacing of 0.5
+  const int nDofs = 45;
+  problem.data().transmembranePotential()->startGhostManipulation();
+  for (dof_no_t dofNo = 0; dofNo < nDofs; dofNo++) {
+    double x = 0.5 * (dofNo % 3);
+    double z = 0.5 * (dofNo / 9);
+    problem.data().transmembranePotential()->setValue(dofNo, z * z + x);
+  }
+  problem.data().transmembranePotential()->finishGhostManipulation();
+
+  problem.setTimeSpan(0.0, 1.0);
+  problem.advanceTimeSpan(false);
+
+  // the lead field values are w^T phi_e, where the weights w are the basis
+  // functions at the electrode minus their mean, i.e. phi_e at the electrode
+  // minus the mean of phi_e over all dofs
+  std::vector<double> extracellularPotential;
+  problem.data().extraCellularPotential()->getValuesWithoutGhosts(
+      extracellularPotential);
+  ASSERT_EQ(extracellularPotential.size(), nDofs);
+
+  double mean = 0;
+  for (double value : extracellularPotential)
+    mean += value;
+  mean /= nDofs;
+
+  double maximumDeviation = 0;
+  for (double value : extracellularPotential)
+    maximumDeviation = std::max(maximumDeviation, fabs(value - mean));
+  ASSERT_GT(maximumDeviation, 1e-3);
+
+  const std::vector<double> &leadFieldEmgValues = problem.leadFieldEmgValues();
+  ASSERT_EQ(leadFieldEmgValues.size(), 2);
+
+  std::vector<dof_no_t> electrodeDofNos = {13, 29};
+  for (int electrodeNo = 0; electrodeNo < 2; electrodeNo++) {
+    double fullSolveValue =
+        extracellularPotential[electrodeDofNos[electrodeNo]] - mean;
+    EXPECT_NEAR(leadFieldEmgValues[electrodeNo], fullSolveValue,
+                1e-8 * maximumDeviation)
+        << "electrode " << electrodeNo;
+  }
+}
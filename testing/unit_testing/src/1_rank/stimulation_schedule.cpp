@@ -0,0 +1,144 @@
+#include <Python.h> // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <vector>
+#include <cstdint>
+
+#include "gtest/gtest.h"
+#include "opendihu.h"
+#include "arg.h"
+#include "control/stimulation/stimulation_schedule.h"
+
+namespace {
+//! check isStimulated for the given times in order, with one event index per
+//! motor unit as the callers do
+void checkStimulation(const Control::StimulationSchedule &schedule,
+                      int motorUnitNo,
+                      const std::vector<std::pair<double, bool>> &expected) {
+  std::size_t eventIndex = 0;
+  for (const std::pair<double, bool> &timeAndValue : expected) {
+    EXPECT_EQ(
+        schedule.isStimulated(motorUnitNo, timeAndValue.first, eventIndex),
+        timeAndValue.second)
+        << "motor unit " << motorUnitNo << ", t=" << timeAndValue.first;
+  }
+}
+} // namespace
+
+TEST(StimulationScheduleTest, FiringTimesAndMerging) {
+  DihuContext settings(argc, argv, "config = {}");
+
+  // the events of motor unit 1 overlap or touch and are merged to [2,4)
+  std::ofstream file("stimulation_schedule_test.txt");
+  file << "# motorUnitNo startTime [duration]\n"
+       << "0 5.0 0.5\n"
+       << "0 1.0\n"
+       << "\n"
+       << "1 2.0 1.0\n"
+       << "1 2.5 1.0\n"
+       << "1 3.5 0.5\n"
+       << "2 0.0 0.1\n";
+  file.close();
+
+  Control::StimulationSchedule schedule;
+  ASSERT_TRUE(schedule.empty());
+
+  schedule.load("stimulation_schedule_test.txt", MPI_COMM_WORLD, 0.2,
+                std::vector<double>());
+  ASSERT_FALSE(schedule.empty());
+  ASSERT_EQ(schedule.nEvents(), 4);
+
+  // the events of motor unit 0 are sorted, the first one has the default
+  // duration 0.2
+  checkStimulation(schedule, 0,
+                   {{0.5, false},
+                    {1.0, true},
+                    {1.1, true},
+                    {1.3, false},
+                    {5.2, true},
+                    {5.6, false}});
+
+  // the time can also go back, e.g. for the next point of a fiber
+  checkStimulation(schedule, 1,
+                   {{1.9, false},
+                    {2.0, true},
+                    {3.0, true},
+                    {3.7, true},
+                    {4.1, false},
+                    {2.2, true}});
+
+  checkStimulation(schedule, 2, {{0.05, true}, {0.2, false}});
+
+  // motor units without events are never stimulated
+  checkStimulation(schedule, 5, {{1.0, false}});
+  checkStimulation(schedule, -1, {{1.0, false}});
+}
+
+TEST(StimulationScheduleTest, BinaryFormat) {
+  DihuContext settings(argc, argv, "config = {}");
+
+  // events (motor unit 1, t=3, 0.5) and (motor unit 0, t=1, 1.0)
+  std::vector<int32_t> motorUnitNos = {1, 0};
+  std::vector<double> startTimes = {3.0, 1.0};
+  std::vector<double> durations = {0.5, 1.0};
+
+  std::ofstream file("stimulation_schedule_test.bin", std::ios::binary);
+  int32_t nEvents = motorUnitNos.size();
+  file.write("DIHUSTIM", 8);
+  file.write((const char *)&nEvents, sizeof(int32_t));
+  for (int i = 0; i < nEvents; i++) {
+    file.write((const char *)&motorUnitNos[i], sizeof(int32_t));
+    file.write((const char *)&startTimes[i], sizeof(double));
+    file.write((const char *)&durations[i], sizeof(double));
+  }
+  file.close();
+
+  Control::StimulationSchedule schedule;
+  schedule.load("stimulation_schedule_test.bin", MPI_COMM_WORLD, 0.2,
+                std::vector<double>());
+  ASSERT_EQ(schedule.nEvents(), 2);
+
+  checkStimulation(schedule, 0, {{0.9, false}, {1.5, true}, {2.1, false}});
+  checkStimulation(schedule, 1, {{2.9, false}, {3.2, true}, {3.6, false}});
+}
+
+TEST(StimulationScheduleTest, JitterWithFixedSeed) {
+  DihuContext settings(argc, argv, "config = {}");
+
+  // four events of motor unit 0 at t=10,20,30,40 with duration 0.5
+  std::ofstream file("stimulation_schedule_test_jitter.txt");
+  for (int eventNo = 0; eventNo < 4; eventNo++)
+    file << "0 " << 10.0 * (eventNo + 1) << " 0.5\n";
+  file.close();
+
+  // three jitter values, they are applied cyclically
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> distribution(-0.1, 0.1);
+  std::vector<double> jitter(3);
+  for (double &value : jitter)
+    value = distribution(generator);
+
+  Control::StimulationSchedule schedule;
+  schedule.load("stimulation_schedule_test_jitter.txt", MPI_COMM_WORLD, 0.2,
+                jitter);
+  ASSERT_EQ(schedule.nEvents(), 4);
+
+  std::vector<std::pair<double, bool>> expected;
+  for (int eventNo = 0; eventNo < 4; eventNo++) {
+    double startTime = 10.0 * (eventNo + 1) + jitter[eventNo % 3];
+    expected.push_back(std::make_pair(startTime - 0.01, false));
+    expected.push_back(std::make_pair(startTime + 0.01, true));
+    expected.push_back(std::make_pair(startTime + 0.49, true));
+    expected.push_back(std::make_pair(startTime + 0.51, false));
+  }
+  checkStimulation(schedule, 0, expected);
+
+  // loading again with the same jitter gives the same schedule
+  Control::StimulationSchedule schedule2;
+  schedule2.load("stimulation_schedule_test_jitter.txt", MPI_COMM_WORLD, 0.2,
+                 jitter);
+  checkStimulation(schedule2, 0, expected);
+}
@@ -0,0 +1,111 @@
+#include <Python.h> // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include "gtest/gtest.h"
+#include "opendihu.h"
+#include "arg.h"
+
+TEST(StreamlineTracerTest, RungeKutta45) {
+  std::string pythonConfig = R"(
+# Laplace 3D on [0,2]x[0,2]x[0,4] with u=0 at the bottom and u=1 at the top,
+# the gradient is (0,0,1/4) everywhere, the streamlines are straight lines
+nx, ny, nz = 2, 2, 4
+n_nodes_per_layer = (nx+1)*(ny+1)
+
+bc = {}
+for i in range(n_nodes_per_layer):
+  bc[i] = 0.0
+  bc[nz*n_nodes_per_layer + i] = 1.0
+
+config = {
+  "StreamlineTracer": {
+    "seedPoints": [[0.5, 0.5, 2.0], [1.5, 1.2, 1.0]],
+    "maxIterations": 1000,
+    "useGradientField": False,
+    "lineStepWidth": 0.1,
+    "integrationScheme": "RungeKutta45",
+    "integrationTolerance": 1e-5,
+    "maxLineStepWidth": 1.0,
+    "nThreads": 2,
+    "targetElementLength": 0.5,
+    "targetLength": 0,
+    "discardRelativeLength": 0,
+    "csvFilenameBeforePostprocessing": "streamline_tracer_rk45_raw.csv",
+    "csvFilename": "",
+
+    "FiniteElementMethod": {
+      "nElements": [nx, ny, nz],
+      "physicalExtent": [2.0, 2.0, 4.0],
+      "inputMeshIsGlobal": True,
+      "dirichletBoundaryConditions": bc,
+      "relativeTolerance": 1e-15,
+      "solverType": "lu",
+      "preconditionerType": "none",
+      "maxIterations": 1000,
+    },
+    "OutputWriter": [],
+  }
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  Postprocessing::StreamlineTracer<SpatialDiscretization::FiniteElementMethod<
+      Mesh::StructuredDeformableOfDimension<3>,
+      BasisFunction::LagrangeOfOrder<1>, Quadrature::Gauss<2>,
+      Equation::Static::Laplace>>
+      problem(settings);
+
+  problem.run();
+
+  // read the points of the streamlines, one streamline per line
+  std::vector<std::vector<Vec3>> streamlines;
+  std::ifstream file("streamline_tracer_rk45_raw.csv");
+  ASSERT_TRUE(file.is_open());
+  std::string line;
+  while (std::getline(file, line)) {
+    std::vector<double> values;
+    std::stringstream lineStream(line);
+    std::string value;
+    while (std::getline(lineStream, value, ';'))
+      values.push_back(atof(value.c_str()));
+
+    std::vector<Vec3> points;
+    for (int i = 0; i + 2 < values.size(); i += 3)
+      points.push_back(Vec3{values[i], values[i + 1], values[i + 2]});
+    streamlines.push_back(points);
+  }
+
+  std::vector<Vec3> seedPoints = {Vec3{0.5, 0.5, 2.0}, Vec3{1.5, 1.2, 1.0}};
+  ASSERT_EQ(streamlines.size(), seedPoints.size());
+
+  for (int streamlineNo = 0; streamlineNo < streamlines.size();
+       streamlineNo++) {
+    const std::vector<Vec3> &points = streamlines[streamlineNo];
+    ASSERT_GE(points.size(), 3);
+
+    // the streamline goes straight through the seed point
+    for (const Vec3 &point : points) {
+      EXPECT_NEAR(point[0], seedPoints[streamlineNo][0], 1e-8);
+      EXPECT_NEAR(point[1], seedPoints[streamlineNo][1], 1e-8);
+    }
+
+    // the z coordinates increase from the bottom to the top, the first and
+    // last points are about lineStepWidth outside of the domain
+    for (int i = 1; i < points.size(); i++)
+      EXPECT_GT(points[i][2], points[i - 1][2]);
+
+    EXPECT_LE(points.front()[2], 0.0 + 1e-8);
+    EXPECT_GE(points.front()[2], -0.2);
+    EXPECT_GE(points.back()[2], 4.0 - 1e-8);
+    EXPECT_LE(points.back()[2], 4.2);
+
+    // the error of the steps is zero, the step width grows up to
+    // maxLineStepWidth, explicit Euler would need 40 steps of lineStepWidth
+    EXPECT_LT(points.size(), 30);
+  }
+}
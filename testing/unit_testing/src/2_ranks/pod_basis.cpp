@@ -0,0 +1,192 @@
+#include <Python.h> // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <fstream>
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "arg.h"
+#include "opendihu.h"
+#include "output_writer/pod_basis/pod_basis.h"
+
+namespace {
+
+typedef Mesh::StructuredRegularFixedOfDimension<1> MeshType;
+typedef FunctionSpace::FunctionSpace<MeshType,
+                                     BasisFunction::LagrangeOfOrder<1>>
+    FunctionSpaceType;
+typedef FieldVariable::FieldVariable<FunctionSpaceType, 2> FieldVariableType;
+
+//! minimal data object that provides the snapshot field variable to the
+//! output writer
+struct SnapshotData {
+  typedef std::tuple<std::shared_ptr<FieldVariableType>>
+      FieldVariablesForOutputWriter;
+
+  std::shared_ptr<FunctionSpaceType> functionSpace() const {
+    return functionSpace_;
+  }
+
+  FieldVariablesForOutputWriter getFieldVariablesForOutputWriter() {
+    return FieldVariablesForOutputWriter(fieldVariable_);
+  }
+
+  std::shared_ptr<FunctionSpaceType> functionSpace_;
+  std::shared_ptr<FieldVariableType> fieldVariable_;
+};
+
+//! value of component componentNo of snapshot snapshotNo at position x
+double snapshotValue(int snapshotNo, int componentNo, double x) {
+  return (componentNo + 1.0) * std::pow(x, snapshotNo) +
+         componentNo * (snapshotNo == 3 ? 1.0 : 0.0);
+}
+
+} // namespace
+
+TEST(PodBasisTest, SnapshotsAreInGlobalOrder) {
+  std::string pythonConfig = R"(
+config = {
+  "Meshes" : {
+    "testMesh": {
+      "nElements": [8],
+      "physicalExtent": [1.0],
+    }
+  },
+  "FiniteElementMethod" : {
+    "meshName": "testMesh",
+  },
+  "PodBasis" : {
+    "filename": "out/pod_basis_2_ranks",
+    "outputInterval": 1,
+    "nBases": 4,
+    "blockSize": 3,
+  },
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  SpatialDiscretization::FiniteElementMethod<
+      MeshType, BasisFunction::LagrangeOfOrder<1>, Quadrature::Gauss<2>,
+      Equation::Static::Laplace>
+      finiteElementMethod(settings);
+
+  SnapshotData data;
+  data.functionSpace_ = finiteElementMethod.functionSpace();
+  data.functionSpace_->initialize();
+  data.fieldVariable_ =
+      data.functionSpace_->createFieldVariable<2>("snapshot");
+
+  const int nDofsLocal =
+      data.functionSpace_->meshPartition()->nDofsLocalWithoutGhosts();
+  const int nDofsGlobal = data.functionSpace_->meshPartition()->nDofsGlobal();
+  ASSERT_EQ(nDofsGlobal, 9);
+  ASSERT_LT(nDofsLocal, nDofsGlobal);
+
+  // four snapshots, the first block of three is merged before the last one
+  const int nSnapshots = 4;
+  {
+    OutputWriter::PodBasis writer(
+        settings, PythonConfig(settings.getPythonConfig(), "PodBasis"));
+
+    for (int snapshotNo = 0; snapshotNo < nSnapshots; snapshotNo++) {
+      std::array<std::vector<double>, 2> values;
+      for (int componentNo = 0; componentNo < 2; componentNo++) {
+        for (int dofNoLocal = 0; dofNoLocal < nDofsLocal; dofNoLocal++) {
+          double x = data.functionSpace_->getGeometry(dofNoLocal)[0];
+          values[componentNo].push_back(
+              snapshotValue(snapshotNo, componentNo, x));
+        }
+      }
+      data.fieldVariable_->setValuesWithoutGhosts(values);
+      writer.write(data, snapshotNo, snapshotNo * 0.1);
+    }
+    // the destructor merges the last snapshot and writes the file
+  }
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  // every rank reads the whole file
+  PetscErrorCode ierr;
+  PetscViewer viewer;
+  ierr = PetscViewerBinaryOpen(PETSC_COMM_SELF, "out/pod_basis_2_ranks.bin",
+                               FILE_MODE_READ, &viewer);
+  ASSERT_EQ(ierr, 0);
+
+  Vec singularValues;
+  VecCreate(PETSC_COMM_SELF, &singularValues);
+  ASSERT_EQ(VecLoad(singularValues, viewer), 0);
+  PetscInt nBases;
+  VecGetSize(singularValues, &nBases);
+  ASSERT_EQ(nBases, nSnapshots);
+
+  const int nRows = 2 * nDofsGlobal;
+  std::vector<std::vector<double>> basis(nBases);
+  for (int baseNo = 0; baseNo < nBases; baseNo++) {
+    Vec basisVector;
+    VecCreate(PETSC_COMM_SELF, &basisVector);
+    ASSERT_EQ(VecLoad(basisVector, viewer), 0);
+    PetscInt size;
+    VecGetSize(basisVector, &size);
+    ASSERT_EQ(size, nRows);
+
+    const double *values;
+    VecGetArrayRead(basisVector, &values);
+    basis[baseNo].assign(values, values + nRows);
+    VecRestoreArrayRead(basisVector, &values);
+    VecDestroy(&basisVector);
+  }
+  PetscViewerDestroy(&viewer);
+
+  // the basis is orthonormal
+  for (int i = 0; i < nBases; i++) {
+    for (int j = 0; j < nBases; j++) {
+      double product = 0;
+      for (int rowNo = 0; rowNo < nRows; rowNo++)
+        product += basis[i][rowNo] * basis[j][rowNo];
+      ASSERT_NEAR(product, (i == j ? 1.0 : 0.0), 1e-10);
+    }
+  }
+
+  // the snapshots in global order, component after component and then by the
+  // node position, lie in the span of the basis, the squared singular values
+  // sum up to the squared norm of all snapshots
+  double frobeniusNormSquared = 0;
+  for (int snapshotNo = 0; snapshotNo < nSnapshots; snapshotNo++) {
+    std::vector<double> snapshot(nRows);
+    for (int componentNo = 0; componentNo < 2; componentNo++) {
+      for (int nodeNo = 0; nodeNo < nDofsGlobal; nodeNo++) {
+        double x = nodeNo / 8.0;
+        snapshot[componentNo * nDofsGlobal + nodeNo] =
+            snapshotValue(snapshotNo, componentNo, x);
+      }
+    }
+
+    std::vector<double> residual(snapshot);
+    for (int baseNo = 0; baseNo < nBases; baseNo++) {
+      double coefficient = 0;
+      for (int rowNo = 0; rowNo < nRows; rowNo++)
+        coefficient += snapshot[rowNo] * basis[baseNo][rowNo];
+      for (int rowNo = 0; rowNo < nRows; rowNo++)
+        residual[rowNo] -= coefficient * basis[baseNo][rowNo];
+    }
+    for (int rowNo = 0; rowNo < nRows; rowNo++) {
+      ASSERT_NEAR(residual[rowNo], 0.0, 1e-10);
+      frobeniusNormSquared += snapshot[rowNo] * snapshot[rowNo];
+    }
+  }
+
+  const double *values;
+  VecGetArrayRead(singularValues, &values);
+  double singularValuesSquared = 0;
+  for (int baseNo = 0; baseNo < nBases; baseNo++) {
+    if (baseNo > 0)
+      ASSERT_LE(values[baseNo], values[baseNo - 1]);
+    singularValuesSquared += values[baseNo] * values[baseNo];
+  }
+  VecRestoreArrayRead(singularValues, &values);
+  VecDestroy(&singularValues);
+  ASSERT_NEAR(singularValuesSquared, frobeniusNormSquared, 1e-8);
+
+  nFails += ::testing::Test::HasFailure();
+}
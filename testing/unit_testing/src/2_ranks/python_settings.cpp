@@ -0,0 +1,84 @@
+#include <Python.h> // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <unistd.h> // getpid
+
+#include "gtest/gtest.h"
+#include "arg.h"
+#include "opendihu.h"
+
+namespace {
+//! get an integer variable of the settings script
+long getMainVariable(std::string name) {
+  PyObject *mainModule = PyImport_AddModule("__main__");
+  PyObject *variable = PyObject_GetAttrString(mainModule, name.c_str());
+  long value = PythonUtility::convertFromPython<long>::get(variable);
+  Py_CLEAR(variable);
+  return value;
+}
+} // namespace
+
+TEST(PythonSettingsTest, SettingsOnRankZeroAreBroadcast) {
+  // the process id tells which rank executed the script
+  std::string pythonConfig = R"(
+import os
+pid = os.getpid()
+factor = 3
+
+def scaled(x):
+  return factor*x
+
+config = {"factor": scaled(2)}
+)";
+
+  PetscOptionsSetValue(NULL, "-settings_on_rank_zero", "");
+  {
+    DihuContext settings(argc, argv, pythonConfig);
+
+    // all ranks have the variables of the script that rank 0 executed
+    long pidRankZero = getpid();
+    MPI_Bcast(&pidRankZero, 1, MPI_LONG, 0, MPI_COMM_WORLD);
+    ASSERT_EQ(getMainVariable("pid"), pidRankZero);
+    if (settings.ownRankNoCommWorld() == 1)
+      ASSERT_NE(getMainVariable("pid"), (long)getpid());
+
+    // the transferred function can be called
+    ASSERT_EQ(PyRun_SimpleString("result = scaled(5)"), 0);
+    ASSERT_EQ(getMainVariable("result"), 15);
+
+    PythonConfig config = settings.getPythonConfig();
+    ASSERT_EQ(config.getOptionInt("factor", 0), 6);
+  }
+  PetscOptionsClearValue(NULL, "-settings_on_rank_zero");
+
+  nFails += ::testing::Test::HasFailure();
+}
+
+TEST(PythonSettingsTest, RankDependentSettingsAreExecutedOnAllRanks) {
+  std::string pythonConfig = R"(
+import os
+import sys
+pid = os.getpid()
+rank_no = int(sys.argv[-2])
+
+config = {"rankNo": rank_no}
+)";
+
+  PetscOptionsSetValue(NULL, "-settings_on_rank_zero", "");
+  {
+    DihuContext settings(argc, argv, pythonConfig);
+
+    // every rank executed the script itself and has its own rank number
+    ASSERT_EQ(getMainVariable("pid"), (long)getpid());
+    ASSERT_EQ(getMainVariable("rank_no"), settings.ownRankNoCommWorld());
+
+    PythonConfig config = settings.getPythonConfig();
+    ASSERT_EQ(config.getOptionInt("rankNo", -1),
+              settings.ownRankNoCommWorld());
+  }
+  PetscOptionsClearValue(NULL, "-settings_on_rank_zero");
+
+  nFails += ::testing::Test::HasFailure();
+}
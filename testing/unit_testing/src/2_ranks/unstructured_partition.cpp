@@ -0,0 +1,119 @@
+#include <Python.h> // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <fstream>
+#include <numeric>
+
+#include "gtest/gtest.h"
+#include "arg.h"
+#include "opendihu.h"
+#include "../utility.h"
+
+// 2D unstructured mesh with 5x2 nodes and 4 elements in a row, the recursive
+// coordinate bisection assigns elements 0,1 to rank 0 and elements 2,3 to
+// rank 1, the nodes at x=2 are owned by rank 0 and are ghosts on rank 1
+const std::string pythonConfigUnstructured2D = R"(
+# Laplace 2D, unstructured
+node_positions = [[float(i), float(j), 0.0] for j in range(2) for i in range(5)]
+elements = [[i, i+1, 5+i, 5+i+1] for i in range(4)]
+
+# boundary conditions, u = 1 at x = 0 and u = 0 at x = 4
+bc = {0: 1.0, 5: 1.0, 4: 0.0, 9: 0.0}
+
+config = {
+  "FiniteElementMethod": {
+    "inputMeshIsGlobal": True,
+    "nodePositions": node_positions,
+    "elements": elements,
+    "dirichletBoundaryConditions": bc,
+    "relativeTolerance": 1e-15,
+    "solverType": "gmres",
+    "preconditionerType": "none",
+    "maxIterations": 1000,
+  }
+}
+)";
+
+typedef SpatialDiscretization::FiniteElementMethod<
+    Mesh::UnstructuredDeformableOfDimension<2>,
+    BasisFunction::LagrangeOfOrder<>, Quadrature::Gauss<2>,
+    Equation::Static::Laplace>
+    UnstructuredLaplace2D;
+
+TEST(UnstructuredPartitionTest, GlobalDofNumberingAndGhosts) {
+  DihuContext settings(argc, argv, pythonConfigUnstructured2D);
+
+  UnstructuredLaplace2D problem(settings);
+  problem.initialize();
+
+  auto meshPartition = problem.data().functionSpace()->meshPartition();
+  ASSERT_TRUE(meshPartition->isDistributed());
+  ASSERT_EQ(meshPartition->nDofsGlobal(), 10);
+  ASSERT_EQ(meshPartition->nElementsLocal(), 2);
+
+  // the owned nodes come first, in natural order, then the ghost nodes
+  std::vector<global_no_t> nodeNosGlobalNatural;
+  std::vector<global_no_t> dofNosGlobalPetsc;
+  std::vector<PetscInt> ghostDofNosGlobalPetsc;
+  if (settings.ownRankNo() == 0) {
+    ASSERT_EQ(meshPartition->nDofsLocalWithoutGhosts(), 6);
+    ASSERT_EQ(meshPartition->nDofsLocalWithGhosts(), 6);
+    nodeNosGlobalNatural = {0, 1, 2, 5, 6, 7};
+    dofNosGlobalPetsc = {0, 1, 2, 3, 4, 5};
+  } else {
+    ASSERT_EQ(meshPartition->nDofsLocalWithoutGhosts(), 4);
+    ASSERT_EQ(meshPartition->nDofsLocalWithGhosts(), 6);
+    nodeNosGlobalNatural = {3, 4, 8, 9, 2, 7};
+    dofNosGlobalPetsc = {6, 7, 8, 9, 2, 5};
+    ghostDofNosGlobalPetsc = {2, 5};
+  }
+
+  ASSERT_EQ(meshPartition->nodeNosGlobalNatural(), nodeNosGlobalNatural);
+  ASSERT_EQ(meshPartition->ghostDofNosGlobalPetsc(), ghostDofNosGlobalPetsc);
+  for (dof_no_t dofNoLocal = 0; dofNoLocal < dofNosGlobalPetsc.size();
+       dofNoLocal++) {
+    ASSERT_EQ(meshPartition->getDofNoGlobalPetsc(dofNoLocal),
+              dofNosGlobalPetsc[dofNoLocal]);
+  }
+
+  // the local to global mapping is created once and gives the same numbering
+  ISLocalToGlobalMapping localToGlobalMapping =
+      meshPartition->localToGlobalMappingDofs();
+  ASSERT_EQ(meshPartition->localToGlobalMappingDofs(), localToGlobalMapping);
+
+  std::vector<PetscInt> dofNosLocal(dofNosGlobalPetsc.size());
+  std::iota(dofNosLocal.begin(), dofNosLocal.end(), 0);
+  std::vector<PetscInt> dofNosMapped(dofNosLocal.size());
+  ISLocalToGlobalMappingApply(localToGlobalMapping, dofNosLocal.size(),
+                              dofNosLocal.data(), dofNosMapped.data());
+  for (int i = 0; i < dofNosMapped.size(); i++)
+    ASSERT_EQ(dofNosMapped[i], dofNosGlobalPetsc[i]);
+
+  nFails += ::testing::Test::HasFailure();
+}
+
+TEST(UnstructuredPartitionTest, LaplaceMatchesSerialSolution) {
+  DihuContext settings(argc, argv, pythonConfigUnstructured2D);
+
+  UnstructuredLaplace2D problem(settings);
+  problem.run();
+
+  // the serial solution is exactly linear in x, u = 1 - x/4, the distributed
+  // solve has to give the same values at the owned nodes
+  std::vector<Vec3> geometryValues;
+  problem.data().functionSpace()->geometryField().getValuesWithoutGhosts(
+      geometryValues);
+
+  std::vector<double> solutionValues;
+  problem.data().solution()->getValuesWithoutGhosts(solutionValues);
+
+  ASSERT_EQ(solutionValues.size(), geometryValues.size());
+  ASSERT_EQ(solutionValues.size(), settings.ownRankNo() == 0 ? 6 : 4);
+  for (int i = 0; i < solutionValues.size(); i++) {
+    EXPECT_NEAR(solutionValues[i], 1.0 - geometryValues[i][0] / 4.0, 1e-10)
+        << "node at x=" << geometryValues[i][0];
+  }
+
+  nFails += ::testing::Test::HasFailure();
+}